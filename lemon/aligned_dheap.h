@@ -0,0 +1,394 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_ALIGNED_DHEAP_H
+#define LEMON_ALIGNED_DHEAP_H
+
+///\ingroup heaps
+///\file
+///\brief Cache-aligned D-ary heap implementation.
+
+#include <vector>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include <cstddef>
+
+namespace lemon {
+
+  /// \ingroup heaps
+  ///
+  ///\brief Cache-aligned D-ary heap data structure.
+  ///
+  /// This class implements the \e D-ary \e heap data structure with a
+  /// memory layout tuned for the cache.
+  /// It fully conforms to the \ref concepts::Heap "heap concept".
+  ///
+  /// Contrary to \ref DHeap, the priorities and the items are stored
+  /// in two separate arrays, so the comparisons performed while
+  /// sifting an element down the heap read only the priority array.
+  /// Moreover, the priority array is shifted and aligned so that the
+  /// \c D children of each node occupy a single aligned block of
+  /// <tt>D*sizeof(PR)</tt> bytes (as long as it does not exceed the
+  /// usual cache line size of 64 bytes). Therefore, selecting the
+  /// minimum child of a node touches only one cache line.
+  ///
+  /// \tparam PR Type of the priorities of the items.
+  /// \tparam IM A read-writable item map with \c int values, used
+  /// internally to handle the cross references.
+  /// \tparam D The degree of the heap, each node have at most \e D
+  /// children. The default is 8. It should be a power of two,
+  /// typically 4 or 8.
+  /// \tparam CMP A functor class for comparing the priorities.
+  /// The default is \c std::less<PR>.
+  ///
+  ///\sa DHeap
+  ///\sa QuadHeap
+#ifdef DOXYGEN
+  template <typename PR, typename IM, int D, typename CMP>
+#else
+  template <typename PR, typename IM, int D = 8,
+            typename CMP = std::less<PR> >
+#endif
+  class AlignedDHeap {
+  public:
+    /// Type of the item-int map.
+    typedef IM ItemIntMap;
+    /// Type of the priorities.
+    typedef PR Prio;
+    /// Type of the items stored in the heap.
+    typedef typename ItemIntMap::Key Item;
+    /// Type of the item-priority pairs.
+    typedef std::pair<Item,Prio> Pair;
+    /// Functor type for comparing the priorities.
+    typedef CMP Compare;
+
+    /// \brief Type to represent the states of the items.
+    ///
+    /// Each item has a state associated to it. It can be "in heap",
+    /// "pre-heap" or "post-heap". The latter two are indifferent from the
+    /// heap's point of view, but may be useful to the user.
+    ///
+    /// The item-int map must be initialized in such way that it assigns
+    /// \c PRE_HEAP (<tt>-1</tt>) to any element to be put in the heap.
+    enum State {
+      IN_HEAP = 0,    ///< = 0.
+      PRE_HEAP = -1,  ///< = -1.
+      POST_HEAP = -2  ///< = -2.
+    };
+
+  private:
+    // The priority of the i-th node is stored at _prio[_off + i].
+    // The offset is chosen so that the children of each node, i.e.
+    // D*i+1, ..., D*i+D, start at an aligned position.
+    std::vector<Prio> _prio;
+    int _off;
+    std::vector<Item> _item;
+    ItemIntMap &_iim;
+    Compare _comp;
+
+  public:
+    /// \brief Constructor.
+    ///
+    /// Constructor.
+    /// \param map A map that assigns \c int values to the items.
+    /// It is used internally to handle the cross references.
+    /// The assigned value must be \c PRE_HEAP (<tt>-1</tt>) for each item.
+    explicit AlignedDHeap(ItemIntMap &map) : _off(D - 1), _iim(map) {}
+
+    /// \brief Constructor.
+    ///
+    /// Constructor.
+    /// \param map A map that assigns \c int values to the items.
+    /// It is used internally to handle the cross references.
+    /// The assigned value must be \c PRE_HEAP (<tt>-1</tt>) for each item.
+    /// \param comp The function object used for comparing the priorities.
+    AlignedDHeap(ItemIntMap &map, const Compare &comp)
+      : _off(D - 1), _iim(map), _comp(comp) {}
+
+    /// \brief The number of items stored in the heap.
+    ///
+    /// This function returns the number of items stored in the heap.
+    int size() const { return _item.size(); }
+
+    /// \brief Check if the heap is empty.
+    ///
+    /// This function returns \c true if the heap is empty.
+    bool empty() const { return _item.empty(); }
+
+    /// \brief Make the heap empty.
+    ///
+    /// This functon makes the heap empty.
+    /// It does not change the cross reference map. If you want to reuse
+    /// a heap that is not surely empty, you should first clear it and
+    /// then you should set the cross reference map to \c PRE_HEAP
+    /// for each item.
+    void clear() { _item.clear(); }
+
+  private:
+    static int parent(int i) { return (i-1)/D; }
+    static int firstChild(int i) { return D*i+1; }
+
+    Prio& pr(int i) { return _prio[_off + i]; }
+    const Prio& pr(int i) const { return _prio[_off + i]; }
+
+    // Reallocates the priority array so that it can store at least
+    // n elements and the sibling groups are aligned.
+    void reserve(int n) {
+      const int cap = static_cast<int>(_prio.size()) - _off;
+      if (n <= cap) return;
+      const std::size_t sz = sizeof(Prio);
+      std::size_t align = D * sz;
+      if (align > 64) align = 64;
+      const int pad = static_cast<int>(align / sz) + D;
+      std::vector<Prio> prio(std::max(2 * cap, std::max(n, 16)) + pad);
+      int shift = 0;
+      if ((sz & (sz - 1)) == 0 && (align & (align - 1)) == 0) {
+        while (shift < pad - D &&
+               reinterpret_cast<std::size_t>(&prio[shift + D]) % align
+               != 0) {
+          ++shift;
+        }
+        if (shift == pad - D) shift = 0;
+      }
+      int num = _item.size();
+      for (int i = 0; i < num; ++i) {
+        prio[shift + D - 1 + i] = pr(i);
+      }
+      _prio.swap(prio);
+      _off = shift + D - 1;
+    }
+
+    void move(const Item &i, const Prio &p, int h) {
+      _item[h] = i;
+      pr(h) = p;
+      _iim.set(i, h);
+    }
+
+    void bubbleUp(int hole, const Item &i, const Prio &p) {
+      int par = parent(hole);
+      while( hole>0 && _comp(p, pr(par)) ) {
+        move(_item[par], pr(par), hole);
+        hole = par;
+        par = parent(hole);
+      }
+      move(i, p, hole);
+    }
+
+    void bubbleDown(int hole, const Item &i, const Prio &p, int length) {
+      int child = firstChild(hole);
+      while( child+D<=length ) {
+        int min = child;
+        for (int c = child+1; c < child+D; ++c) {
+          if( _comp(pr(c), pr(min)) ) min = c;
+        }
+        if( !_comp(pr(min), p) )
+          goto ok;
+        move(_item[min], pr(min), hole);
+        hole = min;
+        child = firstChild(hole);
+      }
+      if( child<length ) {
+        int min = child;
+        for (int c = child+1; c < length; ++c) {
+          if( _comp(pr(c), pr(min)) ) min = c;
+        }
+        if( _comp(pr(min), p) ) {
+          move(_item[min], pr(min), hole);
+          hole = min;
+        }
+      }
+    ok:
+      move(i, p, hole);
+    }
+
+  public:
+    /// \brief Insert a pair of item and priority into the heap.
+    ///
+    /// This function inserts \c p.first to the heap with priority
+    /// \c p.second.
+    /// \param p The pair to insert.
+    /// \pre \c p.first must not be stored in the heap.
+    void push(const Pair &p) {
+      push(p.first, p.second);
+    }
+
+    /// \brief Insert an item into the heap with the given priority.
+    ///
+    /// This function inserts the given item into the heap with the
+    /// given priority.
+    /// \param i The item to insert.
+    /// \param p The priority of the item.
+    /// \pre \e i must not be stored in the heap.
+    void push(const Item &i, const Prio &p) {
+      int n = _item.size();
+      reserve(n+1);
+      _item.push_back(i);
+      bubbleUp(n, i, p);
+    }
+
+    /// \brief Return the item having minimum priority.
+    ///
+    /// This function returns the item having minimum priority.
+    /// \pre The heap must be non-empty.
+    Item top() const { return _item[0]; }
+
+    /// \brief The minimum priority.
+    ///
+    /// This function returns the minimum priority.
+    /// \pre The heap must be non-empty.
+    Prio prio() const { return pr(0); }
+
+    /// \brief Remove the item having minimum priority.
+    ///
+    /// This function removes the item having minimum priority.
+    /// \pre The heap must be non-empty.
+    void pop() {
+      int n = _item.size()-1;
+      _iim.set(_item[0], POST_HEAP);
+      if (n>0) {
+        Item i = _item[n];
+        Prio p = pr(n);
+        bubbleDown(0, i, p, n);
+      }
+      _item.pop_back();
+    }
+
+    /// \brief Remove the given item from the heap.
+    ///
+    /// This function removes the given item from the heap if it is
+    /// already stored.
+    /// \param i The item to delete.
+    /// \pre \e i must be in the heap.
+    void erase(const Item &i) {
+      int h = _iim[i];
+      int n = _item.size()-1;
+      _iim.set(_item[h], POST_HEAP);
+      if( h<n ) {
+        Item j = _item[n];
+        Prio p = pr(n);
+        if( h>0 && _comp(p, pr(parent(h))) )
+          bubbleUp(h, j, p);
+        else
+          bubbleDown(h, j, p, n);
+      }
+      _item.pop_back();
+    }
+
+    /// \brief The priority of the given item.
+    ///
+    /// This function returns the priority of the given item.
+    /// \param i The item.
+    /// \pre \e i must be in the heap.
+    Prio operator[](const Item &i) const {
+      int idx = _iim[i];
+      return pr(idx);
+    }
+
+    /// \brief Set the priority of an item or insert it, if it is
+    /// not stored in the heap.
+    ///
+    /// This method sets the priority of the given item if it is
+    /// already stored in the heap. Otherwise it inserts the given
+    /// item into the heap with the given priority.
+    /// \param i The item.
+    /// \param p The priority.
+    void set(const Item &i, const Prio &p) {
+      int idx = _iim[i];
+      if( idx<0 )
+        push(i,p);
+      else if( _comp(p, pr(idx)) )
+        bubbleUp(idx, i, p);
+      else
+        bubbleDown(idx, i, p, _item.size());
+    }
+
+    /// \brief Decrease the priority of an item to the given value.
+    ///
+    /// This function decreases the priority of an item to the given value.
+    /// \param i The item.
+    /// \param p The priority.
+    /// \pre \e i must be stored in the heap with priority at least \e p.
+    void decrease(const Item &i, const Prio &p) {
+      int idx = _iim[i];
+      bubbleUp(idx, i, p);
+    }
+
+    /// \brief Increase the priority of an item to the given value.
+    ///
+    /// This function increases the priority of an item to the given value.
+    /// \param i The item.
+    /// \param p The priority.
+    /// \pre \e i must be stored in the heap with priority at most \e p.
+    void increase(const Item &i, const Prio &p) {
+      int idx = _iim[i];
+      bubbleDown(idx, i, p, _item.size());
+    }
+
+    /// \brief Return the state of an item.
+    ///
+    /// This method returns \c PRE_HEAP if the given item has never
+    /// been in the heap, \c IN_HEAP if it is in the heap at the moment,
+    /// and \c POST_HEAP otherwise.
+    /// In the latter case it is possible that the item will get back
+    /// to the heap again.
+    /// \param i The item.
+    State state(const Item &i) const {
+      int s = _iim[i];
+      if (s>=0) s=0;
+      return State(s);
+    }
+
+    /// \brief Set the state of an item in the heap.
+    ///
+    /// This function sets the state of the given item in the heap.
+    /// It can be used to manually clear the heap when it is important
+    /// to achive better time complexity.
+    /// \param i The item.
+    /// \param st The state. It should not be \c IN_HEAP.
+    void state(const Item& i, State st) {
+      switch (st) {
+        case POST_HEAP:
+        case PRE_HEAP:
+          if (state(i) == IN_HEAP) erase(i);
+          _iim[i] = st;
+          break;
+        case IN_HEAP:
+          break;
+      }
+    }
+
+    /// \brief Replace an item in the heap.
+    ///
+    /// This function replaces item \c i with item \c j.
+    /// Item \c i must be in the heap, while \c j must be out of the heap.
+    /// After calling this method, item \c i will be out of the
+    /// heap and \c j will be in the heap with the same prioriority
+    /// as item \c i had before.
+    void replace(const Item& i, const Item& j) {
+      int idx = _iim[i];
+      _iim.set(i, _iim[j]);
+      _iim.set(j, idx);
+      _item[idx] = j;
+    }
+
+  }; // class AlignedDHeap
+
+} // namespace lemon
+
+#endif // LEMON_ALIGNED_DHEAP_H
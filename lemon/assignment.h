@@ -0,0 +1,691 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_ASSIGNMENT_H
+#define LEMON_ASSIGNMENT_H
+
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+#include <iterator>
+
+#include <lemon/core.h>
+#include <lemon/maps.h>
+#include <lemon/bipartite_matching.h>
+#include <lemon/bits/parallel.h>
+
+///\ingroup matching
+///\file
+///\brief Hungarian and auction algorithms for the assignment problem.
+
+namespace lemon {
+
+  namespace _assignment_bits {
+
+    // Jonker-Volgenant style shortest augmenting path version of the
+    // Hungarian method on a dense row-major matrix. It maximizes the
+    // total weight of an assignment of all rows (rows <= cols). The
+    // entries with allowed[k] == 0 cannot be used.
+    template <typename V>
+    bool hungarian(int rows, int cols, const V* weight,
+                   const char* allowed, int* mate) {
+      std::vector<V> u(rows + 1, V(0)), v(cols + 1, V(0));
+      std::vector<V> minv(cols + 1);
+      std::vector<int> p(cols + 1, 0), way(cols + 1, 0);
+      std::vector<char> used(cols + 1), finite(cols + 1);
+      for (int i = 1; i <= rows; ++i) {
+        p[0] = i;
+        int j0 = 0;
+        std::fill(used.begin(), used.end(), 0);
+        std::fill(finite.begin(), finite.end(), 0);
+        do {
+          used[j0] = 1;
+          int i0 = p[j0];
+          const V* row = weight + static_cast<long long>(i0 - 1) * cols;
+          const char* arow = allowed ?
+            allowed + static_cast<long long>(i0 - 1) * cols : 0;
+          V ui = u[i0];
+          V delta = V(0);
+          int j1 = -1;
+          for (int j = 1; j <= cols; ++j) {
+            if (used[j]) continue;
+            if (!arow || arow[j - 1]) {
+              V cur = - row[j - 1] - ui - v[j];
+              if (!finite[j] || cur < minv[j]) {
+                minv[j] = cur;
+                way[j] = j0;
+                finite[j] = 1;
+              }
+            }
+            if (finite[j] && (j1 == -1 || minv[j] < delta)) {
+              delta = minv[j];
+              j1 = j;
+            }
+          }
+          if (j1 == -1) return false;
+          for (int j = 0; j <= cols; ++j) {
+            if (used[j]) {
+              u[p[j]] += delta;
+              v[j] -= delta;
+            } else if (finite[j]) {
+              minv[j] -= delta;
+            }
+          }
+          j0 = j1;
+        } while (p[j0] != 0);
+        do {
+          int j1 = way[j0];
+          p[j0] = p[j1];
+          j0 = j1;
+        } while (j0 != 0);
+      }
+      for (int i = 0; i < rows; ++i) {
+        mate[i] = -1;
+      }
+      for (int j = 1; j <= cols; ++j) {
+        if (p[j] != 0) mate[p[j] - 1] = j - 1;
+      }
+      return true;
+    }
+
+    // The benefits of the auction algorithm are scaled integers for
+    // integer weights (which makes the result exact) and doubles
+    // otherwise.
+    template <bool integer>
+    struct AuctionTraits {
+      typedef long long Value;
+      static Value scale(int n) { return n + 1; }
+      static Value finalEpsilon(Value, int) { return 1; }
+      // Checks that the scaled benefits, including the ones of the
+      // forbidden entries, are representable
+      static bool representable(Value minw, Value maxw, int n) {
+        double m = std::max(std::abs(double(minw)), std::abs(double(maxw)));
+        double bound = (double(maxw) - double(minw) + 1.0) * (n + 1) *
+          (n + 2) + m * (n + 1);
+        return bound < double(std::numeric_limits<Value>::max()) / 2;
+      }
+    };
+
+    template <>
+    struct AuctionTraits<false> {
+      typedef double Value;
+      static Value scale(int) { return 1.0; }
+      static Value finalEpsilon(Value magnitude, int n) {
+        return (magnitude > 0 ? magnitude : 1.0) * 1e-9 / n;
+      }
+      static bool representable(Value, Value, int) { return true; }
+    };
+
+    template <typename B>
+    class BidTask {
+    public:
+      BidTask(int n, const std::vector<B>& benefit,
+              const std::vector<B>& price, const std::vector<int>& bidders,
+              std::vector<int>& bid_col, std::vector<B>& bid_val, B eps)
+        : _n(n), _benefit(benefit), _price(price), _bidders(bidders),
+          _bid_col(bid_col), _bid_val(bid_val), _eps(eps) {}
+
+      void operator()(int first, int last) {
+        for (int k = first; k < last; ++k) {
+          const B* row = &_benefit[static_cast<long long>(_bidders[k]) * _n];
+          int j1 = 0;
+          B v1 = row[0] - _price[0];
+          B v2 = v1;
+          bool second = false;
+          for (int j = 1; j < _n; ++j) {
+            B val = row[j] - _price[j];
+            if (val > v1) {
+              v2 = v1;
+              v1 = val;
+              j1 = j;
+              second = true;
+            } else if (!second || val > v2) {
+              v2 = val;
+              second = true;
+            }
+          }
+          _bid_col[k] = j1;
+          _bid_val[k] = _price[j1] + v1 - v2 + _eps;
+        }
+      }
+
+    private:
+      int _n;
+      const std::vector<B>& _benefit;
+      const std::vector<B>& _price;
+      const std::vector<int>& _bidders;
+      std::vector<int>& _bid_col;
+      std::vector<B>& _bid_val;
+      B _eps;
+    };
+
+    // Jacobi-style epsilon-scaling auction algorithm on a dense
+    // row-major matrix (rows <= cols). The bids of the unassigned rows
+    // are computed in parallel. A feasible assignment must exist.
+    template <typename V>
+    void auction(int rows, int cols, const V* weight,
+                 const char* allowed, int* mate, int threads) {
+      typedef AuctionTraits<std::numeric_limits<V>::is_integer> Traits;
+      typedef typename Traits::Value B;
+      if (rows == 0) return;
+      const int n = cols;
+      const long long size = static_cast<long long>(rows) * cols;
+
+      bool first = true;
+      B minw = 0, maxw = 0;
+      for (long long k = 0; k < size; ++k) {
+        if (allowed && !allowed[k]) continue;
+        B w = static_cast<B>(weight[k]);
+        if (first || w < minw) minw = w;
+        if (first || w > maxw) maxw = w;
+        first = false;
+      }
+      LEMON_ASSERT(Traits::representable(minw, maxw, n),
+                   "The weights are too large for the auction algorithm");
+      B scale = Traits::scale(n);
+      B range = (maxw - minw) * scale;
+      B forbidden = minw * scale - (range + 1) * (n + 1);
+
+      // Rows are padded with dummy rows to obtain a square problem
+      std::vector<B> benefit(static_cast<long long>(n) * n, B(0));
+      for (long long k = 0; k < size; ++k) {
+        benefit[k] = (allowed && !allowed[k]) ? forbidden :
+          static_cast<B>(weight[k]) * scale;
+      }
+
+      std::vector<B> price(n, B(0));
+      std::vector<int> owner(n), assigned(n);
+      std::vector<int> bidders, next;
+      std::vector<int> bid_col(n);
+      std::vector<B> bid_val(n), best_val(n);
+      std::vector<int> best_bidder(n, -1);
+      std::vector<int> touched;
+
+      B magnitude = (maxw > -minw ? maxw : -minw) * scale;
+      B final_eps = Traits::finalEpsilon(magnitude, n);
+      B eps = range / 4 > final_eps ? range / 4 : final_eps;
+      int grain = 4096 / n > 0 ? 4096 / n : 1;
+
+      while (true) {
+        bidders.clear();
+        for (int i = 0; i < n; ++i) {
+          owner[i] = -1;
+          assigned[i] = -1;
+          bidders.push_back(i);
+        }
+        while (!bidders.empty()) {
+          int num = bidders.size();
+          BidTask<B> task(n, benefit, price, bidders, bid_col, bid_val, eps);
+          bits::parallelFor(threads, 0, num, task, grain);
+
+          touched.clear();
+          for (int k = 0; k < num; ++k) {
+            int j = bid_col[k];
+            if (best_bidder[j] == -1) {
+              touched.push_back(j);
+              best_bidder[j] = k;
+              best_val[j] = bid_val[k];
+            } else if (bid_val[k] > best_val[j]) {
+              best_bidder[j] = k;
+              best_val[j] = bid_val[k];
+            }
+          }
+          next.clear();
+          for (int k = 0; k < num; ++k) {
+            if (best_bidder[bid_col[k]] != k) next.push_back(bidders[k]);
+          }
+          for (int t = 0; t < int(touched.size()); ++t) {
+            int j = touched[t];
+            int i = bidders[best_bidder[j]];
+            if (owner[j] != -1) {
+              assigned[owner[j]] = -1;
+              next.push_back(owner[j]);
+            }
+            owner[j] = i;
+            assigned[i] = j;
+            price[j] = best_val[j];
+            best_bidder[j] = -1;
+          }
+          bidders.swap(next);
+        }
+        if (!(eps > final_eps)) break;
+        eps = eps / 4 > final_eps ? eps / 4 : final_eps;
+      }
+
+      for (int i = 0; i < rows; ++i) {
+        mate[i] = assigned[i];
+      }
+    }
+
+    struct HungarianSolver {
+      template <typename V>
+      bool operator()(int rows, int cols, const V* weight,
+                      const char* allowed, int* mate) const {
+        return hungarian(rows, cols, weight, allowed, mate);
+      }
+    };
+
+    struct AuctionSolver {
+      int threads;
+      AuctionSolver(int t) : threads(t) {}
+
+      template <typename V>
+      bool operator()(int rows, int cols, const V* weight,
+                      const char* allowed, int* mate) const {
+        auction(rows, cols, weight, allowed, mate, threads);
+        return true;
+      }
+    };
+
+    // Solves the problem for any shape of the matrix by transposing it
+    // if it has more rows than columns.
+    template <typename Solver, typename V>
+    bool solve(const Solver& solver, int rows, int cols,
+               const std::vector<V>& weight, const std::vector<char>& allowed,
+               std::vector<int>& mate) {
+      mate.assign(rows, -1);
+      if (rows == 0 || cols == 0) return true;
+      const char* aptr = allowed.empty() ? 0 : &allowed[0];
+      if (rows <= cols) {
+        return solver(rows, cols, &weight[0], aptr, &mate[0]);
+      }
+      std::vector<V> tweight(weight.size());
+      std::vector<char> tallowed(allowed.size());
+      for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+          long long k = static_cast<long long>(i) * cols + j;
+          long long l = static_cast<long long>(j) * rows + i;
+          tweight[l] = weight[k];
+          if (aptr) tallowed[l] = allowed[k];
+        }
+      }
+      std::vector<int> tmate(cols);
+      if (!solver(cols, rows, &tweight[0], aptr ? &tallowed[0] : 0,
+                  &tmate[0])) {
+        return false;
+      }
+      for (int j = 0; j < cols; ++j) {
+        if (tmate[j] != -1) mate[tmate[j]] = j;
+      }
+      return true;
+    }
+
+    template <typename Solver, typename V, typename WIt, typename MIt>
+    V solveDense(const Solver& solver, int rows, int cols,
+                 WIt weight, MIt mate) {
+      std::vector<V> w(weight, weight + static_cast<long long>(rows) * cols);
+      std::vector<int> m;
+      solve(solver, rows, cols, w, std::vector<char>(), m);
+      V sum = V(0);
+      for (int i = 0; i < rows; ++i, ++mate) {
+        *mate = m[i];
+        if (m[i] != -1) sum += w[static_cast<long long>(i) * cols + m[i]];
+      }
+      return sum;
+    }
+
+    template <typename BGR, typename WM>
+    class AssignmentBase {
+    public:
+
+      typedef BGR BpGraph;
+      typedef WM WeightMap;
+      typedef typename WeightMap::Value Value;
+      typedef typename BpGraph::template NodeMap<typename BpGraph::Arc>
+      MatchingMap;
+
+    protected:
+
+      TEMPLATE_BPGRAPH_TYPEDEFS(BpGraph);
+
+      const BpGraph& _graph;
+      const WeightMap& _weight;
+      MatchingMap _matching;
+
+      AssignmentBase(const BpGraph& graph, const WeightMap& weight)
+        : _graph(graph), _weight(weight), _matching(graph, INVALID) {}
+
+      // Builds the dense red x blue weight matrix and solves it. Of
+      // parallel edges the heaviest one is used.
+      template <typename Solver>
+      bool solveGraph(const Solver& solver) {
+        std::vector<RedNode> reds;
+        std::vector<BlueNode> blues;
+        IntRedNodeMap red_index(_graph);
+        IntBlueNodeMap blue_index(_graph);
+        for (RedNodeIt n(_graph); n != INVALID; ++n) {
+          red_index[n] = reds.size();
+          reds.push_back(n);
+        }
+        for (BlueNodeIt n(_graph); n != INVALID; ++n) {
+          blue_index[n] = blues.size();
+          blues.push_back(n);
+        }
+        int rows = reds.size(), cols = blues.size();
+        long long size = static_cast<long long>(rows) * cols;
+
+        std::vector<Value> weight(size, Value(0));
+        std::vector<char> allowed(size, 0);
+        std::vector<Edge> edges(size, INVALID);
+        long long count = 0;
+        for (EdgeIt e(_graph); e != INVALID; ++e) {
+          long long k = static_cast<long long>(red_index[_graph.redNode(e)])
+            * cols + blue_index[_graph.blueNode(e)];
+          if (!allowed[k]) {
+            allowed[k] = 1;
+            ++count;
+          } else if (!(_weight[e] > weight[k])) {
+            continue;
+          }
+          weight[k] = _weight[e];
+          edges[k] = e;
+        }
+        if (count == size) {
+          allowed.clear();
+        } else {
+          // The auction algorithm needs a feasible assignment, so it
+          // is checked on the incomplete graphs before the solution
+          MaxBipartiteMatching<BpGraph> mm(_graph);
+          mm.run();
+          if (mm.matchingSize() < std::min(rows, cols)) {
+            for (NodeIt n(_graph); n != INVALID; ++n) {
+              _matching[n] = INVALID;
+            }
+            return false;
+          }
+        }
+
+        for (NodeIt n(_graph); n != INVALID; ++n) {
+          _matching[n] = INVALID;
+        }
+        std::vector<int> mate;
+        if (!solve(solver, rows, cols, weight, allowed, mate)) {
+          return false;
+        }
+        for (int i = 0; i < rows; ++i) {
+          if (mate[i] != -1) {
+            Edge e = edges[static_cast<long long>(i) * cols + mate[i]];
+            _matching[reds[i]] = _graph.direct(e, reds[i]);
+            _matching[blues[mate[i]]] = _graph.direct(e, blues[mate[i]]);
+          }
+        }
+        return true;
+      }
+
+    public:
+
+      /// \name Primal Solution
+      /// Functions to get the primal solution, i.e. the optimal
+      /// assignment.\n
+      /// The \c run() function should be called before using them.
+
+      /// @{
+
+      /// \brief Return the weight of the matching.
+      ///
+      /// This function returns the weight of the found matching.
+      Value matchingWeight() const {
+        Value sum = 0;
+        for (RedNodeIt n(_graph); n != INVALID; ++n) {
+          if (_matching[n] != INVALID) {
+            sum += _weight[_matching[n]];
+          }
+        }
+        return sum;
+      }
+
+      /// \brief Return the size (cardinality) of the matching.
+      ///
+      /// This function returns the size (cardinality) of the found
+      /// matching.
+      int matchingSize() const {
+        int size = 0;
+        for (RedNodeIt n(_graph); n != INVALID; ++n) {
+          if (_matching[n] != INVALID) {
+            ++size;
+          }
+        }
+        return size;
+      }
+
+      /// \brief Return \c true if the given edge is in the matching.
+      ///
+      /// This function returns \c true if the given edge is in the found
+      /// matching.
+      bool matching(const Edge& edge) const {
+        return edge == _matching[_graph.redNode(edge)];
+      }
+
+      /// \brief Return the matching arc (or edge) incident to the given
+      /// node.
+      ///
+      /// This function returns the matching arc (or edge) incident to the
+      /// given node in the found matching or \c INVALID if the node is
+      /// not covered by the matching.
+      Arc matching(const Node& node) const {
+        return _matching[node];
+      }
+
+      /// \brief Return a const reference to the matching map.
+      ///
+      /// This function returns a const reference to a node map that stores
+      /// the matching arc (or edge) incident to each node.
+      const MatchingMap& matchingMap() const {
+        return _matching;
+      }
+
+      /// \brief Return the mate of the given node.
+      ///
+      /// This function returns the mate of the given node in the found
+      /// matching or \c INVALID if the node is not covered by the matching.
+      Node mate(const Node& node) const {
+        return _matching[node] != INVALID ?
+          _graph.target(_matching[node]) : INVALID;
+      }
+
+      /// @}
+
+    };
+
+  }
+
+  /// \ingroup matching
+  ///
+  /// \brief Hungarian algorithm for the assignment problem
+  ///
+  /// This class solves the assignment problem in a bipartite graph,
+  /// i.e. it finds a maximum weight matching among the matchings that
+  /// cover all nodes of the smaller color class. It is mainly intended
+  /// for dense graphs, e.g. \ref FullBpGraph, for which it is much faster
+  /// than \ref MaxWeightedPerfectMatching.
+  ///
+  /// The weights are copied into a dense row-major matrix, and the
+  /// Jonker-Volgenant variant of the Hungarian method (successive
+  /// shortest augmenting paths with node potentials) is applied on it,
+  /// thus the running time is \f$O(n^2m)\f$ and the memory usage is
+  /// \f$O(nm)\f$, where \f$n\f$ and \f$m\f$ are the sizes of the two
+  /// color classes (\f$n\le m\f$).
+  ///
+  /// For a raw dense matrix, use \ref hungarianAssignment().
+  ///
+  /// \tparam BGR The bipartite graph type the algorithm runs on.
+  /// \tparam WM The type of the edge weight map. The default type is
+  /// \ref concepts::BpGraph::EdgeMap "BGR::EdgeMap<int>".
+#ifdef DOXYGEN
+  template <typename BGR, typename WM>
+#else
+  template <typename BGR,
+            typename WM = typename BGR::template EdgeMap<int> >
+#endif
+  class HungarianAssignment
+    : public _assignment_bits::AssignmentBase<BGR, WM> {
+    typedef _assignment_bits::AssignmentBase<BGR, WM> Parent;
+  public:
+
+    /// The bipartite graph type of the algorithm
+    typedef BGR BpGraph;
+    /// The type of the edge weight map
+    typedef WM WeightMap;
+    /// The value type of the edge weights
+    typedef typename WeightMap::Value Value;
+    /// The type of the matching map
+    typedef typename Parent::MatchingMap MatchingMap;
+
+    /// \brief Constructor
+    ///
+    /// Constructor.
+    HungarianAssignment(const BpGraph& graph, const WeightMap& weight)
+      : Parent(graph, weight) {}
+
+    /// \brief Run the algorithm.
+    ///
+    /// This function runs the algorithm.
+    ///
+    /// \return \c false if there is no matching that covers the smaller
+    /// color class.
+    bool run() {
+      return Parent::solveGraph(_assignment_bits::HungarianSolver());
+    }
+
+  };
+
+  /// \ingroup matching
+  ///
+  /// \brief Parallel auction algorithm for the assignment problem
+  ///
+  /// This class solves the same problem as \ref HungarianAssignment
+  /// using Bertsekas' auction algorithm with epsilon-scaling. The
+  /// unassigned rows (the nodes of the smaller color class) bid for their
+  /// best columns simultaneously (Jacobi auction), and the bids are
+  /// computed on several threads.
+  ///
+  /// For integer weights the weights are scaled so that the result is
+  /// optimal. For floating-point weights the weight of the result is
+  /// optimal up to a relative error of about \f$10^{-9}\f$.
+  /// The scaled integer benefits are of magnitude about
+  /// \f$(w_{max}-w_{min})n^2\f$, where \e n is the size of the larger
+  /// color class, and they must be representable by \c long \c long.
+  /// This is checked by an \ref LEMON_ASSERT "assertion".
+  ///
+  /// For a raw dense matrix, use \ref auctionAssignment().
+  ///
+  /// \tparam BGR The bipartite graph type the algorithm runs on.
+  /// \tparam WM The type of the edge weight map. The default type is
+  /// \ref concepts::BpGraph::EdgeMap "BGR::EdgeMap<int>".
+#ifdef DOXYGEN
+  template <typename BGR, typename WM>
+#else
+  template <typename BGR,
+            typename WM = typename BGR::template EdgeMap<int> >
+#endif
+  class AuctionAssignment
+    : public _assignment_bits::AssignmentBase<BGR, WM> {
+    typedef _assignment_bits::AssignmentBase<BGR, WM> Parent;
+  public:
+
+    /// The bipartite graph type of the algorithm
+    typedef BGR BpGraph;
+    /// The type of the edge weight map
+    typedef WM WeightMap;
+    /// The value type of the edge weights
+    typedef typename WeightMap::Value Value;
+    /// The type of the matching map
+    typedef typename Parent::MatchingMap MatchingMap;
+
+  private:
+
+    int _thread_num;
+
+  public:
+
+    /// \brief Constructor
+    ///
+    /// Constructor.
+    AuctionAssignment(const BpGraph& graph, const WeightMap& weight)
+      : Parent(graph, weight), _thread_num(0) {}
+
+    /// \brief Set the number of threads.
+    ///
+    /// This function sets the number of threads used for computing the
+    /// bids. The value 0 (the default) stands for the number of hardware
+    /// threads.
+    /// \return <tt>(*this)</tt>
+    AuctionAssignment& threadNum(int num) {
+      _thread_num = num;
+      return *this;
+    }
+
+    /// \brief Run the algorithm.
+    ///
+    /// This function runs the algorithm.
+    ///
+    /// \return \c false if there is no matching that covers the smaller
+    /// color class.
+    bool run() {
+      return Parent::solveGraph(_assignment_bits::AuctionSolver(_thread_num));
+    }
+
+  };
+
+  /// \ingroup matching
+  ///
+  /// \brief Hungarian algorithm on a dense weight matrix.
+  ///
+  /// This function finds a maximum weight assignment of the rows of a
+  /// dense weight matrix to its columns, such that all rows are assigned
+  /// if <tt>rows <= cols</tt>, and all columns are assigned otherwise.
+  ///
+  /// \param rows, cols The size of the matrix.
+  /// \param weight A random access iterator (e.g. a pointer) to the
+  /// elements of the matrix in row-major order.
+  /// \param mate An output iterator, the column assigned to each row
+  /// (or -1) is written to it.
+  /// \return The total weight of the assignment.
+  ///
+  /// \see HungarianAssignment
+  template <typename WIt, typename MIt>
+  typename std::iterator_traits<WIt>::value_type
+  hungarianAssignment(int rows, int cols, WIt weight, MIt mate) {
+    typedef typename std::iterator_traits<WIt>::value_type Value;
+    return _assignment_bits::solveDense<_assignment_bits::HungarianSolver,
+      Value>(_assignment_bits::HungarianSolver(), rows, cols, weight, mate);
+  }
+
+  /// \ingroup matching
+  ///
+  /// \brief Parallel auction algorithm on a dense weight matrix.
+  ///
+  /// This function solves the same problem as \ref hungarianAssignment()
+  /// using the auction algorithm on the given number of threads
+  /// (0 stands for the number of hardware threads).
+  ///
+  /// \see AuctionAssignment
+  template <typename WIt, typename MIt>
+  typename std::iterator_traits<WIt>::value_type
+  auctionAssignment(int rows, int cols, WIt weight, MIt mate,
+                    int threads = 0) {
+    typedef typename std::iterator_traits<WIt>::value_type Value;
+    return _assignment_bits::solveDense<_assignment_bits::AuctionSolver,
+      Value>(_assignment_bits::AuctionSolver(threads),
+             rows, cols, weight, mate);
+  }
+
+} //END OF NAMESPACE LEMON
+
+#endif //LEMON_ASSIGNMENT_H
@@ -30,8 +30,10 @@
 #include <lemon/maps.h>
 #include <lemon/path.h>
 #include <lemon/bits/stl_iterators.h>
+#include <lemon/bits/parallel.h>
 
 #include <limits>
+#include <vector>
 
 namespace lemon {
 
@@ -145,6 +147,59 @@ namespace lemon {
 
   };
 
+  namespace _bellman_ford_bits {
+
+    // Scans a part of the active nodes and collects the improving
+    // relaxations into per-thread buffers. The maps are only read.
+    template <typename GR, typename LEN, typename DM, typename OT>
+    class RelaxTask {
+    public:
+      typedef typename GR::Node Node;
+      typedef typename GR::Arc Arc;
+      typedef typename GR::OutArcIt OutArcIt;
+      typedef typename LEN::Value Value;
+
+      RelaxTask(const GR& graph, const LEN& length, const DM& dist,
+                const std::vector<Node>& process,
+                const std::vector<Value>& values, int threads,
+                std::vector<std::vector<Arc> >& arcs,
+                std::vector<std::vector<Value> >& relaxed)
+        : _graph(graph), _length(length), _dist(dist), _process(process),
+          _values(values), _threads(threads), _arcs(arcs),
+          _relaxed(relaxed) {}
+
+      void operator()(int id) {
+        long long size = _process.size();
+        int first = static_cast<int>(size * id / _threads);
+        int last = static_cast<int>(size * (id + 1) / _threads);
+        std::vector<Arc>& arcs = _arcs[id];
+        std::vector<Value>& relaxed = _relaxed[id];
+        arcs.clear();
+        relaxed.clear();
+        for (int i = first; i < last; ++i) {
+          for (OutArcIt it(_graph, _process[i]); it != INVALID; ++it) {
+            Value val = OT::plus(_values[i], _length[it]);
+            if (OT::less(val, _dist[_graph.target(it)])) {
+              arcs.push_back(it);
+              relaxed.push_back(val);
+            }
+          }
+        }
+      }
+
+    private:
+      const GR& _graph;
+      const LEN& _length;
+      const DM& _dist;
+      const std::vector<Node>& _process;
+      const std::vector<Value>& _values;
+      int _threads;
+      std::vector<std::vector<Arc> >& _arcs;
+      std::vector<std::vector<Value> >& _relaxed;
+    };
+
+  }
+
   /// \brief %BellmanFord algorithm class.
   ///
   /// \ingroup shortest_path
@@ -163,6 +218,11 @@ namespace lemon {
   /// kind of length. The type of the length values is determined by the
   /// \ref concepts::ReadMap::Value "Value" type of the length map.
   ///
+  /// The rounds of the algorithm can be executed on several threads
+  /// (see \ref threadNum()), and there is also a queue-based variant
+  /// (SPFA) that detects negative cycles as soon as they appear in the
+  /// shortest path tree (see \ref spfaStart()).
+  ///
   /// There is also a \ref bellmanFord() "function-type interface" for the
   /// Bellman-Ford algorithm, which is convenient in the simplier cases and
   /// it can be used easier.
@@ -234,6 +294,8 @@ namespace lemon {
 
     std::vector<Node> _process;
 
+    int _thread_num;
+
     // Creates the maps if necessary.
     void create_maps() {
       if(!_pred) {
@@ -333,7 +395,7 @@ namespace lemon {
     BellmanFord(const Digraph& g, const LengthMap& length) :
       _gr(&g), _length(&length),
       _pred(0), _local_pred(false),
-      _dist(0), _local_dist(false), _mask(0) {}
+      _dist(0), _local_dist(false), _mask(0), _thread_num(1) {}
 
     ///Destructor.
     ~BellmanFord() {
@@ -386,6 +448,21 @@ namespace lemon {
       return *this;
     }
 
+    /// \brief Sets the number of threads.
+    ///
+    /// Sets the number of threads used by \ref processNextParallelRound().
+    /// If it is not 1, then \ref start() and \ref checkedStart() also
+    /// perform parallel rounds. The value 0 stands for the number of
+    /// hardware threads. The default value is 1.
+    ///
+    /// \note The maps are read concurrently during the parallel rounds,
+    /// but they are written only by the calling thread.
+    /// \return <tt>(*this)</tt>
+    BellmanFord &threadNum(int num) {
+      _thread_num = num;
+      return *this;
+    }
+
     /// \name Execution Control
     /// The simplest way to execute the Bellman-Ford algorithm is to use
     /// one of the member functions called \ref run().\n
@@ -516,6 +593,51 @@ namespace lemon {
       return _process.empty();
     }
 
+    /// \brief Executes one round from the Bellman-Ford algorithm on
+    /// several threads.
+    ///
+    /// This function does the same as \ref processNextRound(), but the
+    /// active nodes are scanned on several threads (see \ref threadNum()).
+    /// The improving relaxations are collected by the threads and then
+    /// applied by the calling thread, so the result of the round is the
+    /// same as that of \ref processNextRound().
+    ///
+    /// \return \c true when the algorithm have not found more shorter
+    /// paths.
+    bool processNextParallelRound() {
+      int threads = bits::parallelThreadNum(_thread_num, _process.size(), 256);
+      if (threads == 1) return processNextRound();
+      for (int i = 0; i < int(_process.size()); ++i) {
+        _mask->set(_process[i], false);
+      }
+      std::vector<Value> values(_process.size());
+      for (int i = 0; i < int(_process.size()); ++i) {
+        values[i] = (*_dist)[_process[i]];
+      }
+      std::vector<std::vector<Arc> > arcs(threads);
+      std::vector<std::vector<Value> > relaxed(threads);
+      _bellman_ford_bits::RelaxTask<Digraph, LengthMap, DistMap,
+        OperationTraits> task(*_gr, *_length, *_dist, _process, values,
+                              threads, arcs, relaxed);
+      bits::parallelRun(threads, task);
+      std::vector<Node> nextProcess;
+      for (int t = 0; t < threads; ++t) {
+        for (int i = 0; i < int(arcs[t].size()); ++i) {
+          Node target = _gr->target(arcs[t][i]);
+          if (OperationTraits::less(relaxed[t][i], (*_dist)[target])) {
+            _pred->set(target, arcs[t][i]);
+            _dist->set(target, relaxed[t][i]);
+            if (!(*_mask)[target]) {
+              _mask->set(target, true);
+              nextProcess.push_back(target);
+            }
+          }
+        }
+      }
+      _process.swap(nextProcess);
+      return _process.empty();
+    }
+
     /// \brief Executes the algorithm.
     ///
     /// Executes the algorithm.
@@ -532,7 +654,8 @@ namespace lemon {
     void start() {
       int num = countNodes(*_gr) - 1;
       for (int i = 0; i < num; ++i) {
-        if (processNextWeakRound()) break;
+        if (_thread_num != 1 ? processNextParallelRound() :
+            processNextWeakRound()) break;
       }
     }
 
@@ -555,11 +678,103 @@ namespace lemon {
     bool checkedStart() {
       int num = countNodes(*_gr);
       for (int i = 0; i < num; ++i) {
-        if (processNextWeakRound()) return true;
+        if (_thread_num != 1 ? processNextParallelRound() :
+            processNextWeakRound()) return true;
       }
       return _process.empty();
     }
 
+    /// \brief Executes the queue-based variant of the algorithm and
+    /// checks the negative cycles.
+    ///
+    /// This method runs the queue-based variant of the Bellman-Ford
+    /// algorithm (also known as SPFA) from the root node(s) in order to
+    /// compute the shortest path to each node and also checks if the
+    /// digraph contains cycles with negative total length.
+    ///
+    /// The current shortest path tree is maintained during the search.
+    /// When the distance of a node decreases, its subtree is removed from
+    /// the tree and the removed nodes are not scanned until they are
+    /// reached again (subtree disassembly, Tarjan). If the node that
+    /// improves the distance is in this subtree, a negative cycle is
+    /// found, and the algorithm stops immediately, thus negative cycles
+    /// are usually detected much earlier than by \ref checkedStart().
+    /// The cycle can be obtained using \ref negativeCycle().
+    ///
+    /// The algorithm computes
+    /// - the shortest path tree (forest),
+    /// - the distance of each node from the root(s).
+    ///
+    /// \return \c false if there is a negative cycle in the digraph.
+    ///
+    /// \pre init() must be called and at least one root node should be
+    /// added with addSource() before using this function.
+    bool spfaStart() {
+      typedef typename Digraph::template NodeMap<Node> ThreadMap;
+      ThreadMap prev(*_gr, INVALID), next(*_gr, INVALID);
+      typename Digraph::template NodeMap<int> depth(*_gr, -1);
+
+      // The shortest path forest is stored in a preorder list
+      Node head = INVALID;
+      for (int i = int(_process.size()) - 1; i >= 0; --i) {
+        Node n = _process[i];
+        depth[n] = 0;
+        next[n] = head;
+        if (head != INVALID) prev[head] = n;
+        head = n;
+      }
+
+      std::vector<Node> nextProcess;
+      while (!_process.empty()) {
+        for (int i = 0; i < int(_process.size()); ++i) {
+          Node u = _process[i];
+          _mask->set(u, false);
+          if (depth[u] == -1) continue;
+          for (OutArcIt it(*_gr, u); it != INVALID; ++it) {
+            Node v = _gr->target(it);
+            Value relaxed = OperationTraits::plus((*_dist)[u], (*_length)[it]);
+            if (!OperationTraits::less(relaxed, (*_dist)[v])) continue;
+
+            if (depth[v] != -1) {
+              // Remove the subtree of v from the forest
+              bool cycle = u == v;
+              Node last = next[v];
+              while (!cycle && last != INVALID && depth[last] > depth[v]) {
+                cycle = last == u;
+                depth[last] = -1;
+                last = next[last];
+              }
+              if (cycle) {
+                _pred->set(v, it);
+                _process.clear();
+                _process.push_back(v);
+                return false;
+              }
+              Node p = prev[v];
+              if (p != INVALID) next[p] = last; else head = last;
+              if (last != INVALID) prev[last] = p;
+            }
+
+            _pred->set(v, it);
+            _dist->set(v, relaxed);
+            Node n = next[u];
+            next[u] = v;
+            prev[v] = u;
+            next[v] = n;
+            if (n != INVALID) prev[n] = v;
+            depth[v] = depth[u] + 1;
+            if (!(*_mask)[v]) {
+              _mask->set(v, true);
+              nextProcess.push_back(v);
+            }
+          }
+        }
+        _process.swap(nextProcess);
+        nextProcess.clear();
+      }
+      return true;
+    }
+
     /// \brief Executes the algorithm with arc number limit.
     ///
     /// Executes the algorithm with arc number limit.
@@ -0,0 +1,727 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_BICONNECTIVITY_H
+#define LEMON_BICONNECTIVITY_H
+
+///\ingroup graph_properties
+///\file
+///\brief Blocks, cut nodes and bridges of undirected graphs.
+
+#include <vector>
+
+#include <lemon/core.h>
+#include <lemon/unionfind.h>
+#include <lemon/concepts/graph.h>
+#include <lemon/concept_check.h>
+#include <lemon/bits/parallel.h>
+
+namespace lemon {
+
+  namespace _biconnectivity_bits {
+
+    // The biconnectivity algorithms on the compact representation of
+    // an undirected graph. The nodes and the edges are indexed from 0,
+    // the adjacency lists are stored in CSR format, each entry holding
+    // the opposite node and the edge. The node and edge ranges of the
+    // parallel steps are processed by parallelFor() calling
+    // operator()(first, last) according to the current phase.
+    class BiconnectivityEngine {
+    public:
+
+      BiconnectivityEngine() : _node_num(0), _threads(1) {}
+
+      void init(int node_num) {
+        _node_num = node_num;
+        _eu.clear();
+        _ev.clear();
+      }
+
+      void addEdge(int u, int v) {
+        _eu.push_back(u);
+        _ev.push_back(v);
+      }
+
+      // Hopcroft-Tarjan algorithm with an explicit stack
+      void runSequential() {
+        int n = _node_num, m = _eu.size();
+        _threads = 1;
+        build();
+        initResults();
+
+        std::vector<int> num(n, -1), low(n), pos(n);
+        std::vector<int> stack, edge_stack, node_stack;
+        int time = 0;
+        for (int s = 0; s < n; ++s) {
+          if (num[s] != -1) continue;
+          num[s] = low[s] = time++;
+          _parent[s] = -1;
+          _pred[s] = -1;
+          pos[s] = _first[s];
+          stack.push_back(s);
+          node_stack.push_back(s);
+          int children = 0;
+          while (!stack.empty()) {
+            int v = stack.back();
+            if (pos[v] < _first[v + 1]) {
+              int j = pos[v]++;
+              int w = _adj_node[j], e = _adj_edge[j];
+              if (e == _pred[v]) continue;
+              if (w == v) {
+                loop(e);
+              } else if (num[w] == -1) {
+                _parent[w] = v;
+                _pred[w] = e;
+                num[w] = low[w] = time++;
+                pos[w] = _first[w];
+                stack.push_back(w);
+                node_stack.push_back(w);
+                edge_stack.push_back(e);
+              } else if (num[w] < num[v]) {
+                edge_stack.push_back(e);
+                if (num[w] < low[v]) low[v] = num[w];
+              }
+            } else {
+              stack.pop_back();
+              if (low[v] == num[v]) {
+                int w;
+                do {
+                  w = node_stack.back();
+                  node_stack.pop_back();
+                  _ecomp[w] = _ecomp_num;
+                } while (w != v);
+                ++_ecomp_num;
+              }
+              int u = _parent[v];
+              if (u == -1) continue;
+              if (low[v] < low[u]) low[u] = low[v];
+              if (low[v] >= num[u]) {
+                int e;
+                do {
+                  e = edge_stack.back();
+                  edge_stack.pop_back();
+                  _block[e] = _block_num;
+                } while (e != _pred[v]);
+                ++_block_num;
+                if (_parent[u] != -1 || ++children > 1) _cut[u] = 1;
+              }
+              if (low[v] > num[u]) _bridge[_pred[v]] = 1;
+            }
+          }
+        }
+        countResults(m);
+      }
+
+      // Tarjan-Vishkin algorithm on a breadth-first spanning forest
+      void runParallel(int threads) {
+        int n = _node_num, m = _eu.size();
+        _threads = threads;
+        build();
+        initResults();
+        if (n == 0) return;
+
+        // The roots of the forest are the smallest nodes of the
+        // connected components
+        _uf.init(n);
+        parallelPhase(CONNECT, m);
+        _pre.resize(n);
+        parallelPhase(FIND_ROOTS, n);
+        _order.clear();
+        _level.clear();
+        for (int v = 0; v < n; ++v) {
+          if (_pre[v] == v) {
+            _parent[v] = -1;
+            _pred[v] = -1;
+            _order.push_back(v);
+          } else {
+            _parent[v] = -2;
+          }
+        }
+
+        // Breadth-first search from all roots, the levels are stored
+        // as consecutive ranges of the order array
+        int start = 0, end = _order.size();
+        _order.resize(n);
+        _level.push_back(0);
+        while (start < end) {
+          _level.push_back(end);
+          _next_size = end;
+          _range_first = start;
+          parallelPhase(BFS, end - start);
+          start = end;
+          end = _next_size;
+        }
+
+        // Children lists of the forest
+        _child_first.assign(n + 1, 0);
+        parallelPhase(CHILD_COUNT, n);
+        bits::parallelPrefixSum(_threads, &_child_first[0], n);
+        _cursor = _child_first;
+        _child.resize(n);
+        parallelPhase(CHILD_FILL, n);
+
+        // Subtree sizes (bottom-up) and preorder numbers (top-down)
+        _size.assign(n, 1);
+        bottomUp(SIZE);
+        int k = 0;
+        for (int i = _level[0]; i < _level[1]; ++i) {
+          int r = _order[i];
+          _pre[r] = k;
+          k += _size[r];
+        }
+        for (int l = 0; l + 1 < int(_level.size()); ++l) {
+          _range_first = _level[l];
+          parallelPhase(PREORDER, _level[l + 1] - _level[l]);
+        }
+
+        // The lowest and highest preorder numbers reachable from the
+        // subtrees with a single non-tree edge
+        _low.resize(n);
+        _high.resize(n);
+        parallelPhase(LOW_HIGH, n);
+        bottomUp(LOW_HIGH_UP);
+
+        // Blocks: the tree edges are identified by their child nodes
+        // and joined according to the rules of Tarjan and Vishkin
+        _uf.init(n);
+        parallelPhase(JOIN_NON_TREE, n);
+        parallelPhase(JOIN_TREE, n);
+        _label.resize(n + 1);
+        _tree_block.resize(n);
+        parallelPhase(BLOCK_ROOTS, n);
+        _block_num = bits::parallelPrefixSum(_threads, &_label[0], n);
+        parallelPhase(BLOCK_LABEL, n);
+        parallelPhase(EDGE_BLOCK, m);
+        for (int e = 0; e < m; ++e) {
+          if (_eu[e] == _ev[e]) loop(e);
+        }
+        parallelPhase(CUT_BRIDGE, n);
+
+        // Bi-edge-connected components: the forest without the bridges
+        _uf.init(n);
+        parallelPhase(JOIN_ECOMP, n);
+        parallelPhase(ECOMP_ROOTS, n);
+        _ecomp_num = bits::parallelPrefixSum(_threads, &_label[0], n);
+        parallelPhase(ECOMP_LABEL, n);
+
+        countResults(m);
+      }
+
+      int blockNum() const { return _block_num; }
+      int block(int e) const { return _block[e]; }
+      int cutNodeNum() const { return _cut_num; }
+      bool cutNode(int v) const { return _cut[v] != 0; }
+      int bridgeNum() const { return _bridge_num; }
+      bool bridge(int e) const { return _bridge[e] != 0; }
+      int biEdgeComponentNum() const { return _ecomp_num; }
+      int biEdgeComponent(int v) const { return _ecomp[v]; }
+
+      void operator()(int first, int last) {
+        switch (_phase) {
+        case DEGREE:
+          for (int e = first; e < last; ++e) {
+            bits::atomicFetchAdd(&_first[_eu[e]], 1);
+            if (_ev[e] != _eu[e]) bits::atomicFetchAdd(&_first[_ev[e]], 1);
+          }
+          break;
+        case FILL:
+          for (int e = first; e < last; ++e) {
+            int u = _eu[e], v = _ev[e];
+            int j = bits::atomicFetchAdd(&_cursor[u], 1);
+            _adj_node[j] = v;
+            _adj_edge[j] = e;
+            if (u != v) {
+              j = bits::atomicFetchAdd(&_cursor[v], 1);
+              _adj_node[j] = u;
+              _adj_edge[j] = e;
+            }
+          }
+          break;
+        case CONNECT:
+          for (int e = first; e < last; ++e) {
+            _uf.join(_eu[e], _ev[e]);
+          }
+          break;
+        case FIND_ROOTS:
+          for (int v = first; v < last; ++v) {
+            _pre[v] = _uf.find(v);
+          }
+          break;
+        case BFS:
+          for (int i = _range_first + first; i < _range_first + last; ++i) {
+            int v = _order[i];
+            for (int j = _first[v]; j < _first[v + 1]; ++j) {
+              int w = _adj_node[j];
+              if (bits::atomicCompareAndSwap(&_parent[w], -2, v)) {
+                _pred[w] = _adj_edge[j];
+                _order[bits::atomicFetchAdd(&_next_size, 1)] = w;
+              }
+            }
+          }
+          break;
+        case CHILD_COUNT:
+          for (int v = first; v < last; ++v) {
+            if (_parent[v] != -1) {
+              bits::atomicFetchAdd(&_child_first[_parent[v]], 1);
+            }
+          }
+          break;
+        case CHILD_FILL:
+          for (int v = first; v < last; ++v) {
+            if (_parent[v] != -1) {
+              _child[bits::atomicFetchAdd(&_cursor[_parent[v]], 1)] = v;
+            }
+          }
+          break;
+        case SIZE:
+          for (int i = _range_first + first; i < _range_first + last; ++i) {
+            int v = _order[i];
+            bits::atomicFetchAdd(&_size[_parent[v]], _size[v]);
+          }
+          break;
+        case PREORDER:
+          for (int i = _range_first + first; i < _range_first + last; ++i) {
+            int u = _order[i];
+            int k = _pre[u] + 1;
+            for (int j = _child_first[u]; j < _child_first[u + 1]; ++j) {
+              _pre[_child[j]] = k;
+              k += _size[_child[j]];
+            }
+          }
+          break;
+        case LOW_HIGH:
+          for (int v = first; v < last; ++v) {
+            int low = _pre[v], high = _pre[v];
+            for (int j = _first[v]; j < _first[v + 1]; ++j) {
+              int w = _adj_node[j], e = _adj_edge[j];
+              if (e == _pred[v] || e == _pred[w]) continue;
+              if (_pre[w] < low) low = _pre[w];
+              if (_pre[w] > high) high = _pre[w];
+            }
+            _low[v] = low;
+            // Stored negated to use atomicMin() for the maximum
+            _high[v] = -high;
+          }
+          break;
+        case LOW_HIGH_UP:
+          for (int i = _range_first + first; i < _range_first + last; ++i) {
+            int v = _order[i];
+            bits::atomicMin(&_low[_parent[v]], _low[v]);
+            bits::atomicMin(&_high[_parent[v]], _high[v]);
+          }
+          break;
+        case JOIN_NON_TREE:
+          for (int v = first; v < last; ++v) {
+            for (int j = _first[v]; j < _first[v + 1]; ++j) {
+              int w = _adj_node[j], e = _adj_edge[j];
+              if (e == _pred[v] || e == _pred[w] || _pre[w] >= _pre[v]) {
+                continue;
+              }
+              // Neither end node is an ancestor of the other
+              if (_pre[w] + _size[w] <= _pre[v]) _uf.join(v, w);
+            }
+          }
+          break;
+        case JOIN_TREE:
+          for (int v = first; v < last; ++v) {
+            int u = _parent[v];
+            if (u == -1 || _parent[u] == -1) continue;
+            if (_low[v] < _pre[u] || -_high[v] >= _pre[u] + _size[u]) {
+              _uf.join(v, u);
+            }
+          }
+          break;
+        case BLOCK_ROOTS:
+          for (int v = first; v < last; ++v) {
+            _label[v] = _parent[v] != -1 && _uf.find(v) == v ? 1 : 0;
+          }
+          break;
+        case BLOCK_LABEL:
+          for (int v = first; v < last; ++v) {
+            if (_parent[v] != -1) _tree_block[v] = _label[_uf.find(v)];
+          }
+          break;
+        case EDGE_BLOCK:
+          for (int e = first; e < last; ++e) {
+            int u = _eu[e], v = _ev[e];
+            if (u == v) continue;
+            // A non-tree edge belongs to the block of the tree edge
+            // entering its end node with larger preorder number
+            if (_pred[u] == e || (_pred[v] != e && _pre[u] > _pre[v])) {
+              _block[e] = _tree_block[u];
+            } else {
+              _block[e] = _tree_block[v];
+            }
+          }
+          break;
+        case CUT_BRIDGE:
+          for (int u = first; u < last; ++u) {
+            int a = _child_first[u], b = _child_first[u + 1];
+            if (a < b) {
+              int ref = _parent[u] != -1 ?
+                _tree_block[u] : _tree_block[_child[a]];
+              for (int j = a; j < b; ++j) {
+                if (_tree_block[_child[j]] != ref) {
+                  _cut[u] = 1;
+                  break;
+                }
+              }
+            }
+            if (_parent[u] != -1 && _low[u] >= _pre[u] &&
+                -_high[u] < _pre[u] + _size[u]) {
+              _bridge[_pred[u]] = 1;
+            }
+          }
+          break;
+        case JOIN_ECOMP:
+          for (int v = first; v < last; ++v) {
+            if (_parent[v] != -1 && !_bridge[_pred[v]]) {
+              _uf.join(v, _parent[v]);
+            }
+          }
+          break;
+        case ECOMP_ROOTS:
+          for (int v = first; v < last; ++v) {
+            _label[v] = _uf.find(v) == v ? 1 : 0;
+          }
+          break;
+        case ECOMP_LABEL:
+          for (int v = first; v < last; ++v) {
+            _ecomp[v] = _label[_uf.find(v)];
+          }
+          break;
+        }
+      }
+
+    private:
+
+      enum {
+        DEGREE, FILL, CONNECT, FIND_ROOTS, BFS, CHILD_COUNT, CHILD_FILL,
+        SIZE, PREORDER, LOW_HIGH, LOW_HIGH_UP, JOIN_NON_TREE, JOIN_TREE,
+        BLOCK_ROOTS, BLOCK_LABEL, EDGE_BLOCK, CUT_BRIDGE,
+        JOIN_ECOMP, ECOMP_ROOTS, ECOMP_LABEL
+      };
+
+      void parallelPhase(int phase, int size) {
+        _phase = phase;
+        bits::parallelFor(_threads, 0, size, *this);
+      }
+
+      // Processes the levels of the forest from the deepest one to the
+      // children of the roots
+      void bottomUp(int phase) {
+        for (int l = int(_level.size()) - 2; l > 0; --l) {
+          _range_first = _level[l];
+          parallelPhase(phase, _level[l + 1] - _level[l]);
+        }
+      }
+
+      void build() {
+        int n = _node_num, m = _eu.size();
+        _first.assign(n + 1, 0);
+        parallelPhase(DEGREE, m);
+        int k = n > 0 ? bits::parallelPrefixSum(_threads, &_first[0], n) : 0;
+        _cursor = _first;
+        _adj_node.resize(k);
+        _adj_edge.resize(k);
+        parallelPhase(FILL, m);
+      }
+
+      void initResults() {
+        int n = _node_num, m = _eu.size();
+        _parent.resize(n);
+        _pred.resize(n);
+        _block.assign(m, -1);
+        _bridge.assign(m, 0);
+        _cut.assign(n, 0);
+        _ecomp.assign(n, -1);
+        _block_num = 0;
+        _ecomp_num = 0;
+        _cut_num = 0;
+        _bridge_num = 0;
+      }
+
+      // A loop forms a block on its own, and its node is considered
+      // to be a cut node
+      void loop(int e) {
+        if (_block[e] == -1) {
+          _block[e] = _block_num++;
+          _cut[_eu[e]] = 1;
+        }
+      }
+
+      void countResults(int m) {
+        _cut_num = 0;
+        for (int v = 0; v < _node_num; ++v) {
+          if (_cut[v]) ++_cut_num;
+        }
+        _bridge_num = 0;
+        for (int e = 0; e < m; ++e) {
+          if (_bridge[e]) ++_bridge_num;
+        }
+      }
+
+      int _node_num;
+      int _threads;
+      int _phase;
+
+      // The end nodes of the edges and the adjacency lists
+      std::vector<int> _eu, _ev;
+      std::vector<int> _first, _cursor, _adj_node, _adj_edge;
+
+      // The spanning forest
+      std::vector<int> _parent, _pred;
+      std::vector<int> _order, _level, _child_first, _child;
+      std::vector<int> _size, _pre, _low, _high, _label, _tree_block;
+      int _range_first, _next_size;
+      ConcurrentUnionFind _uf;
+
+      // The results
+      std::vector<int> _block, _bridge, _cut, _ecomp;
+      int _block_num, _cut_num, _bridge_num, _ecomp_num;
+    };
+
+  }
+
+  /// \ingroup graph_properties
+  ///
+  /// \brief Blocks, cut nodes, bridges and bi-edge-connected components
+  /// of an undirected graph.
+  ///
+  /// This class computes the bi-node-connected components (blocks),
+  /// the cut nodes, the bridges (cut edges) and the bi-edge-connected
+  /// components of an undirected graph together, with a single
+  /// traversal of the graph.
+  ///
+  /// Contrary to the functions biNodeConnectedComponents(),
+  /// biNodeConnectedCutNodes(), biEdgeConnectedComponents() and
+  /// biEdgeConnectedCutEdges(), this class does not use recursion
+  /// or graph maps: the graph is copied into compact adjacency arrays
+  /// indexed by the nodes and the edges, and all data of the
+  /// algorithms is stored in a few integer arrays. Therefore it is
+  /// suggested for large and deep (e.g. path-like) graphs.
+  ///
+  /// Two algorithms are available.
+  /// - run() executes the algorithm of Hopcroft and Tarjan, a depth
+  ///   first search with an explicit stack. It runs in
+  ///   \f$O(n+m)\f$ time.
+  /// - runParallel() executes the algorithm of Tarjan and Vishkin on
+  ///   several threads. It builds a breadth-first spanning forest,
+  ///   computes the preorder numbers and the subtree sizes of the
+  ///   forest level by level, then the blocks are found as the
+  ///   connected components of an auxiliary graph on the tree edges
+  ///   using a concurrent union-find structure.
+  ///
+  /// The two algorithms find the same components, but they may
+  /// number them differently.
+  ///
+  /// A loop edge forms a block on its own, and its node is
+  /// considered to be a cut node, like in biNodeConnectedCutNodes().
+  ///
+  /// \tparam GR The type of the undirected graph.
+  template <typename GR>
+  class Biconnectivity {
+  public:
+
+    /// The type of the undirected graph.
+    typedef GR Graph;
+
+  private:
+
+    TEMPLATE_GRAPH_TYPEDEFS(Graph);
+
+    const Graph& _graph;
+    std::vector<int> _node_index, _edge_index;
+    std::vector<Node> _nodes;
+    std::vector<Edge> _edges;
+    _biconnectivity_bits::BiconnectivityEngine _engine;
+
+  public:
+
+    /// \brief Constructor.
+    ///
+    /// Constructor.
+    /// \param graph The undirected graph the algorithm runs on.
+    explicit Biconnectivity(const Graph& graph) : _graph(graph) {
+      checkConcept<concepts::Graph, Graph>();
+    }
+
+    /// \name Execution Control
+
+    ///@{
+
+    /// \brief Runs the sequential algorithm.
+    ///
+    /// This function runs the iterative Hopcroft-Tarjan algorithm.
+    void run() {
+      init();
+      _engine.runSequential();
+    }
+
+    /// \brief Runs the parallel algorithm.
+    ///
+    /// This function runs the Tarjan-Vishkin algorithm on the given
+    /// number of threads. The value 0 (the default) stands for the
+    /// number of hardware threads.
+    void runParallel(int threads = 0) {
+      init();
+      _engine.runParallel(threads);
+    }
+
+    ///@}
+
+    /// \name Query Functions
+    /// The results of the algorithm can be obtained using these
+    /// functions.\n
+    /// Either \ref run() or \ref runParallel() must be called before
+    /// using them.
+
+    ///@{
+
+    /// \brief The number of the blocks.
+    ///
+    /// This function returns the number of the bi-node-connected
+    /// components (blocks).
+    int blockNum() const { return _engine.blockNum(); }
+
+    /// \brief The block of an edge.
+    ///
+    /// This function returns the index of the block containing the
+    /// given edge. It is in the range <tt>[0..blockNum()-1]</tt>.
+    int block(const Edge& e) const {
+      return _engine.block(_edge_index[_graph.id(e)]);
+    }
+
+    /// \brief Writes the blocks into an edge map.
+    ///
+    /// This function sets the value of each edge in the given writable
+    /// \c int edge map to the index of its block. The value of each
+    /// edge is set exactly once.
+    template <typename EdgeMap>
+    void blockMap(EdgeMap& map) const {
+      for (int i = 0; i < int(_edges.size()); ++i) {
+        map.set(_edges[i], _engine.block(i));
+      }
+    }
+
+    /// \brief The number of the cut nodes.
+    ///
+    /// This function returns the number of the cut nodes (articulation
+    /// points).
+    int cutNodeNum() const { return _engine.cutNodeNum(); }
+
+    /// \brief Checks if a node is a cut node.
+    ///
+    /// This function returns \c true if the given node is a cut node,
+    /// i.e. it belongs to more than one block.
+    bool cutNode(const Node& v) const {
+      return _engine.cutNode(_node_index[_graph.id(v)]);
+    }
+
+    /// \brief Writes the cut nodes into a node map.
+    ///
+    /// This function sets the value of each node in the given writable
+    /// \c bool node map to \c true if it is a cut node and to \c false
+    /// otherwise. The value of each node is set exactly once.
+    template <typename NodeMap>
+    void cutNodeMap(NodeMap& map) const {
+      for (int i = 0; i < int(_nodes.size()); ++i) {
+        map.set(_nodes[i], _engine.cutNode(i));
+      }
+    }
+
+    /// \brief The number of the bridges.
+    ///
+    /// This function returns the number of the bridges (cut edges).
+    int bridgeNum() const { return _engine.bridgeNum(); }
+
+    /// \brief Checks if an edge is a bridge.
+    ///
+    /// This function returns \c true if the given edge is a bridge,
+    /// i.e. its removal increases the number of the connected
+    /// components.
+    bool bridge(const Edge& e) const {
+      return _engine.bridge(_edge_index[_graph.id(e)]);
+    }
+
+    /// \brief Writes the bridges into an edge map.
+    ///
+    /// This function sets the value of each edge in the given writable
+    /// \c bool edge map to \c true if it is a bridge and to \c false
+    /// otherwise. The value of each edge is set exactly once.
+    template <typename EdgeMap>
+    void bridgeMap(EdgeMap& map) const {
+      for (int i = 0; i < int(_edges.size()); ++i) {
+        map.set(_edges[i], _engine.bridge(i));
+      }
+    }
+
+    /// \brief The number of the bi-edge-connected components.
+    ///
+    /// This function returns the number of the bi-edge-connected
+    /// components.
+    int biEdgeComponentNum() const { return _engine.biEdgeComponentNum(); }
+
+    /// \brief The bi-edge-connected component of a node.
+    ///
+    /// This function returns the index of the bi-edge-connected
+    /// component containing the given node. It is in the range
+    /// <tt>[0..biEdgeComponentNum()-1]</tt>.
+    int biEdgeComponent(const Node& v) const {
+      return _engine.biEdgeComponent(_node_index[_graph.id(v)]);
+    }
+
+    /// \brief Writes the bi-edge-connected components into a node map.
+    ///
+    /// This function sets the value of each node in the given writable
+    /// \c int node map to the index of its bi-edge-connected component.
+    /// The value of each node is set exactly once.
+    template <typename NodeMap>
+    void biEdgeComponentMap(NodeMap& map) const {
+      for (int i = 0; i < int(_nodes.size()); ++i) {
+        map.set(_nodes[i], _engine.biEdgeComponent(i));
+      }
+    }
+
+    ///@}
+
+  private:
+
+    void init() {
+      _nodes.clear();
+      _edges.clear();
+      _node_index.assign(_graph.maxNodeId() + 1, -1);
+      _edge_index.assign(_graph.maxEdgeId() + 1, -1);
+      for (NodeIt n(_graph); n != INVALID; ++n) {
+        _node_index[_graph.id(n)] = _nodes.size();
+        _nodes.push_back(n);
+      }
+      _engine.init(_nodes.size());
+      for (EdgeIt e(_graph); e != INVALID; ++e) {
+        _edge_index[_graph.id(e)] = _edges.size();
+        _edges.push_back(e);
+        _engine.addEdge(_node_index[_graph.id(_graph.u(e))],
+                        _node_index[_graph.id(_graph.v(e))]);
+      }
+    }
+
+  };
+
+} //namespace lemon
+
+#endif //LEMON_BICONNECTIVITY_H
@@ -0,0 +1,622 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_BIPARTITE_MATCHING_H
+#define LEMON_BIPARTITE_MATCHING_H
+
+#include <vector>
+
+#include <lemon/core.h>
+#include <lemon/maps.h>
+#include <lemon/bits/parallel.h>
+
+///\ingroup matching
+///\file
+///\brief Maximum cardinality matching algorithms in bipartite graphs.
+
+namespace lemon {
+
+  template <typename BGR>
+  class PrBipartiteMatching;
+
+  /// \ingroup matching
+  ///
+  /// \brief Maximum cardinality matching in bipartite graphs
+  ///
+  /// This class implements the Hopcroft-Karp algorithm for finding a
+  /// maximum cardinality matching in a bipartite graph. The algorithm
+  /// works in phases, each phase augments the matching along a maximal
+  /// set of vertex-disjoint shortest augmenting paths, thus the running
+  /// time is \f$O(e\sqrt{n})\f$. The augmenting paths are searched
+  /// without recursion. The algorithm can be started from an arbitrary
+  /// initial matching (the default is the empty one).
+  ///
+  /// The dual solution of the problem is a minimum vertex cover (see
+  /// Konig's theorem), which can be obtained using \ref cover() after
+  /// running the algorithm.
+  ///
+  /// \tparam BGR The bipartite graph type the algorithm runs on.
+  template <typename BGR>
+  class MaxBipartiteMatching {
+  public:
+
+    /// The bipartite graph type of the algorithm
+    typedef BGR BpGraph;
+    /// The type of the matching map
+    typedef typename BpGraph::template NodeMap<typename BpGraph::Arc>
+    MatchingMap;
+
+  private:
+
+    TEMPLATE_BPGRAPH_TYPEDEFS(BpGraph);
+
+    typedef typename BpGraph::template RedNodeMap<OutArcIt> CurrentMap;
+
+    template <typename> friend class PrBipartiteMatching;
+
+    const BpGraph& _graph;
+    MatchingMap* _matching;
+    IntRedNodeMap* _dist;
+    CurrentMap* _current;
+
+    std::vector<RedNode> _queue;
+    std::vector<RedNode> _stack;
+    int _free_num, _limit;
+
+  private:
+
+    void createStructures() {
+      if (!_matching) {
+        _matching = new MatchingMap(_graph);
+      }
+      if (!_dist) {
+        _dist = new IntRedNodeMap(_graph);
+      }
+      if (!_current) {
+        _current = new CurrentMap(_graph);
+      }
+    }
+
+    void destroyStructures() {
+      if (_matching) {
+        delete _matching;
+      }
+      if (_dist) {
+        delete _dist;
+      }
+      if (_current) {
+        delete _current;
+      }
+    }
+
+    // Builds the layers of the alternating paths starting from the
+    // free red nodes. Returns true if a free blue node is reachable.
+    bool bfs() {
+      _queue.clear();
+      for (RedNodeIt n(_graph); n != INVALID; ++n) {
+        if ((*_matching)[n] == INVALID) {
+          (*_dist)[n] = 0;
+          (*_current)[n] = OutArcIt(_graph, n);
+          _queue.push_back(n);
+        } else {
+          (*_dist)[n] = -1;
+        }
+      }
+      _free_num = _queue.size();
+      _limit = -1;
+      for (int i = 0; i < int(_queue.size()); ++i) {
+        RedNode n = _queue[i];
+        int d = (*_dist)[n];
+        if (_limit != -1 && d >= _limit) break;
+        for (OutArcIt a(_graph, n); a != INVALID; ++a) {
+          Arc m = (*_matching)[_graph.target(a)];
+          if (m == INVALID) {
+            _limit = d;
+          } else {
+            RedNode w = _graph.asRedNodeUnsafe(_graph.target(m));
+            if ((*_dist)[w] == -1) {
+              (*_dist)[w] = d + 1;
+              (*_current)[w] = OutArcIt(_graph, w);
+              _queue.push_back(w);
+            }
+          }
+        }
+      }
+      return _limit != -1;
+    }
+
+    // Searches a shortest augmenting path from the given free red node
+    // in the layered graph and augments the matching along it.
+    bool dfs(const RedNode& s) {
+      _stack.clear();
+      _stack.push_back(s);
+      while (!_stack.empty()) {
+        RedNode n = _stack.back();
+        int d = (*_dist)[n];
+        OutArcIt& it = (*_current)[n];
+        bool advanced = false;
+        for (; it != INVALID; ++it) {
+          Arc m = (*_matching)[_graph.target(it)];
+          if (m == INVALID) {
+            if (d == _limit) {
+              augment();
+              return true;
+            }
+          } else if (d < _limit) {
+            RedNode w = _graph.asRedNodeUnsafe(_graph.target(m));
+            if ((*_dist)[w] == d + 1) {
+              _stack.push_back(w);
+              advanced = true;
+              break;
+            }
+          }
+        }
+        if (!advanced) {
+          (*_dist)[n] = -1;
+          _stack.pop_back();
+          if (!_stack.empty()) {
+            ++(*_current)[_stack.back()];
+          }
+        }
+      }
+      return false;
+    }
+
+    void augment() {
+      for (int i = 0; i < int(_stack.size()); ++i) {
+        RedNode n = _stack[i];
+        Arc a = (*_current)[n];
+        (*_matching)[n] = a;
+        (*_matching)[_graph.target(a)] = _graph.oppositeArc(a);
+        (*_dist)[n] = -1;
+      }
+    }
+
+  public:
+
+    /// \brief Constructor
+    ///
+    /// Constructor.
+    MaxBipartiteMatching(const BpGraph& graph)
+      : _graph(graph), _matching(0), _dist(0), _current(0),
+        _free_num(0), _limit(-1) {}
+
+    ~MaxBipartiteMatching() {
+      destroyStructures();
+    }
+
+    /// \name Execution Control
+    /// The simplest way to execute the algorithm is to use the
+    /// \c run() member function.\n
+    /// If you need better control on the execution, you have to call
+    /// one of the functions \ref init(), \ref greedyInit() or
+    /// \ref matchingInit() first, then you can start the algorithm with
+    /// \ref start().
+
+    ///@{
+
+    /// \brief Set the initial matching to the empty matching.
+    ///
+    /// This function sets the initial matching to the empty matching.
+    void init() {
+      createStructures();
+      for (NodeIt n(_graph); n != INVALID; ++n) {
+        (*_matching)[n] = INVALID;
+      }
+    }
+
+    /// \brief Find an initial matching in a greedy way.
+    ///
+    /// This function finds an initial matching in a greedy way.
+    void greedyInit() {
+      init();
+      for (RedNodeIt n(_graph); n != INVALID; ++n) {
+        for (OutArcIt a(_graph, n); a != INVALID; ++a) {
+          Node v = _graph.target(a);
+          if ((*_matching)[v] == INVALID) {
+            (*_matching)[n] = a;
+            (*_matching)[v] = _graph.oppositeArc(a);
+            break;
+          }
+        }
+      }
+    }
+
+    /// \brief Initialize the matching from a map.
+    ///
+    /// This function initializes the matching from a \c bool valued edge
+    /// map. This map should have the property that there are no two incident
+    /// edges with \c true value, i.e. it really contains a matching.
+    /// \return \c true if the map contains a matching.
+    template <typename MatchingMap>
+    bool matchingInit(const MatchingMap& matching) {
+      init();
+      for (EdgeIt e(_graph); e != INVALID; ++e) {
+        if (matching[e]) {
+          Node u = _graph.redNode(e);
+          if ((*_matching)[u] != INVALID) return false;
+          Node v = _graph.blueNode(e);
+          if ((*_matching)[v] != INVALID) return false;
+          (*_matching)[u] = _graph.direct(e, u);
+          (*_matching)[v] = _graph.direct(e, v);
+        }
+      }
+      return true;
+    }
+
+    /// \brief Start the Hopcroft-Karp algorithm
+    ///
+    /// This function runs the phases of the Hopcroft-Karp algorithm
+    /// until no augmenting path remains.
+    ///
+    /// \pre \ref init(), \ref greedyInit() or \ref matchingInit() must be
+    /// called before using this function.
+    void start() {
+      while (bfs()) {
+        for (int i = 0; i < _free_num; ++i) {
+          dfs(_queue[i]);
+        }
+      }
+    }
+
+    /// \brief Run the Hopcroft-Karp algorithm
+    ///
+    /// This function runs the Hopcroft-Karp algorithm starting from a
+    /// greedy initial matching.
+    void run() {
+      greedyInit();
+      start();
+    }
+
+    /// @}
+
+    /// \name Primal Solution
+    /// Functions to get the primal solution, i.e. the maximum matching.
+
+    /// @{
+
+    /// \brief Return the size (cardinality) of the matching.
+    ///
+    /// This function returns the size (cardinality) of the current matching.
+    /// After run() it returns the size of the maximum matching in the graph.
+    int matchingSize() const {
+      int size = 0;
+      for (RedNodeIt n(_graph); n != INVALID; ++n) {
+        if ((*_matching)[n] != INVALID) {
+          ++size;
+        }
+      }
+      return size;
+    }
+
+    /// \brief Return \c true if the given edge is in the matching.
+    ///
+    /// This function returns \c true if the given edge is in the current
+    /// matching.
+    bool matching(const Edge& edge) const {
+      return edge == (*_matching)[_graph.redNode(edge)];
+    }
+
+    /// \brief Return the matching arc (or edge) incident to the given node.
+    ///
+    /// This function returns the matching arc (or edge) incident to the
+    /// given node in the current matching or \c INVALID if the node is
+    /// not covered by the matching.
+    Arc matching(const Node& n) const {
+      return (*_matching)[n];
+    }
+
+    /// \brief Return a const reference to the matching map.
+    ///
+    /// This function returns a const reference to a node map that stores
+    /// the matching arc (or edge) incident to each node.
+    const MatchingMap& matchingMap() const {
+      return *_matching;
+    }
+
+    /// \brief Return the mate of the given node.
+    ///
+    /// This function returns the mate of the given node in the current
+    /// matching or \c INVALID if the node is not covered by the matching.
+    Node mate(const Node& n) const {
+      return (*_matching)[n] != INVALID ?
+        _graph.target((*_matching)[n]) : INVALID;
+    }
+
+    /// @}
+
+    /// \name Dual Solution
+    /// Functions to get the dual solution, i.e. a minimum vertex cover.
+
+    /// @{
+
+    /// \brief Return \c true if the given node is in the vertex cover.
+    ///
+    /// This function returns \c true if the given node is in the
+    /// minimum vertex cover. The cover consists of the red nodes that
+    /// cannot be reached from the free red nodes on alternating paths
+    /// and the blue nodes that can be reached this way. Its size equals
+    /// to the size of the maximum matching.
+    ///
+    /// \pre Either run() or start() must be called before using this
+    /// function.
+    bool cover(const Node& n) const {
+      if (_graph.red(n)) {
+        return (*_dist)[_graph.asRedNodeUnsafe(n)] == -1;
+      } else {
+        Arc m = (*_matching)[n];
+        return m != INVALID &&
+          (*_dist)[_graph.asRedNodeUnsafe(_graph.target(m))] != -1;
+      }
+    }
+
+    /// @}
+
+  };
+
+  namespace _bipartite_matching_bits {
+
+    inline void raiseLabel(int *label, int value) {
+      int old = bits::atomicLoad(label);
+      while (old < value && !bits::atomicCompareAndSwap(label, old, value)) {
+        old = bits::atomicLoad(label);
+      }
+    }
+
+    template <typename BGR>
+    class PushRelabelTask {
+    public:
+      typedef BGR BpGraph;
+      typedef typename BpGraph::RedNode RedNode;
+      typedef typename BpGraph::Arc Arc;
+      typedef typename BpGraph::OutArcIt OutArcIt;
+      typedef typename BpGraph::template BlueNodeMap<int> BlueIndexMap;
+
+      PushRelabelTask(const BpGraph& graph, const std::vector<RedNode>& reds,
+                      const BlueIndexMap& blue_index,
+                      std::vector<Arc>& red_arc, std::vector<int>& label,
+                      std::vector<int>& mate, int limit, int threads)
+        : _graph(graph), _reds(reds), _blue_index(blue_index),
+          _red_arc(red_arc), _label(label), _mate(mate),
+          _limit(limit), _threads(threads) {}
+
+      void operator()(int id) {
+        long long size = _reds.size();
+        int first = static_cast<int>(size * id / _threads);
+        int last = static_cast<int>(size * (id + 1) / _threads);
+        std::vector<int> stack;
+        for (int i = last - 1; i >= first; --i) {
+          stack.push_back(i);
+        }
+        while (!stack.empty()) {
+          int u = stack.back();
+          stack.pop_back();
+          // Double push: find the two lowest labeled neighbours
+          Arc a1 = INVALID;
+          int b1 = -1, min1 = _limit, min2 = _limit;
+          for (OutArcIt a(_graph, _reds[u]); a != INVALID; ++a) {
+            int b = _blue_index[_graph.asBlueNodeUnsafe(_graph.target(a))];
+            int l = bits::atomicLoad(&_label[b]);
+            if (l < min1) {
+              min2 = min1;
+              min1 = l;
+              a1 = a;
+              b1 = b;
+            } else if (l < min2) {
+              min2 = l;
+            }
+          }
+          if (min1 >= _limit) continue;
+          _red_arc[u] = a1;
+          int old = bits::atomicExchange(&_mate[b1], u);
+          raiseLabel(&_label[b1], min2 + 2 < _limit ? min2 + 2 : _limit);
+          if (old != -1) {
+            stack.push_back(old);
+          }
+        }
+      }
+
+    private:
+      const BpGraph& _graph;
+      const std::vector<RedNode>& _reds;
+      const BlueIndexMap& _blue_index;
+      std::vector<Arc>& _red_arc;
+      std::vector<int>& _label;
+      std::vector<int>& _mate;
+      int _limit, _threads;
+    };
+
+  }
+
+  /// \ingroup matching
+  ///
+  /// \brief Maximum cardinality matching in bipartite graphs using
+  /// multi-threaded push-relabel
+  ///
+  /// This class finds a maximum cardinality matching in a bipartite
+  /// graph using the push-relabel approach. The free red nodes are
+  /// distributed among several threads, and each thread repeatedly
+  /// assigns its free red nodes to their lowest labeled blue neighbours
+  /// (double push), displacing the former mates, which become free
+  /// again. The blue nodes are claimed with atomic operations, so the
+  /// threads need no locking. A red node is given up when all of its
+  /// neighbours reach the label limit. The matching obtained this way
+  /// is usually maximum or nearly maximum, and it is completed by
+  /// \ref MaxBipartiteMatching "Hopcroft-Karp" augmentations, so the
+  /// result is always a maximum matching.
+  ///
+  /// The interface of the class is the same as that of
+  /// \ref MaxBipartiteMatching, including the minimum vertex cover
+  /// provided as the dual solution.
+  ///
+  /// \tparam BGR The bipartite graph type the algorithm runs on.
+  template <typename BGR>
+  class PrBipartiteMatching {
+  public:
+
+    /// The bipartite graph type of the algorithm
+    typedef BGR BpGraph;
+    /// The type of the matching map
+    typedef typename BpGraph::template NodeMap<typename BpGraph::Arc>
+    MatchingMap;
+
+  private:
+
+    TEMPLATE_BPGRAPH_TYPEDEFS(BpGraph);
+
+    const BpGraph& _graph;
+    MaxBipartiteMatching<BpGraph> _hk;
+    int _thread_num;
+
+  public:
+
+    /// \brief Constructor
+    ///
+    /// Constructor.
+    PrBipartiteMatching(const BpGraph& graph)
+      : _graph(graph), _hk(graph), _thread_num(0) {}
+
+    /// \brief Set the number of threads.
+    ///
+    /// This function sets the number of threads used by the push-relabel
+    /// phase of the algorithm. The value 0 (the default) stands for the
+    /// number of hardware threads. Fewer threads are used for small
+    /// graphs.
+    /// \return <tt>(*this)</tt>
+    PrBipartiteMatching& threadNum(int num) {
+      _thread_num = num;
+      return *this;
+    }
+
+    /// \name Execution Control
+
+    ///@{
+
+    /// \brief Run the algorithm
+    ///
+    /// This function runs the parallel push-relabel phase, then completes
+    /// the obtained matching to a maximum one.
+    void run() {
+      _hk.init();
+
+      std::vector<RedNode> reds;
+      for (RedNodeIt n(_graph); n != INVALID; ++n) {
+        reds.push_back(n);
+      }
+      IntBlueNodeMap blue_index(_graph);
+      int blue_num = 0;
+      for (BlueNodeIt n(_graph); n != INVALID; ++n) {
+        blue_index[n] = blue_num++;
+      }
+      int red_num = reds.size();
+      if (red_num == 0 || blue_num == 0) {
+        _hk.start();
+        return;
+      }
+
+      std::vector<Arc> red_arc(red_num, INVALID);
+      std::vector<int> label(blue_num, 0);
+      std::vector<int> mate(blue_num, -1);
+      int limit = 2 * (red_num < blue_num ? red_num : blue_num) + 2;
+
+      int threads = bits::parallelThreadNum(_thread_num, red_num, 256);
+      _bipartite_matching_bits::PushRelabelTask<BpGraph>
+        task(_graph, reds, blue_index, red_arc, label, mate, limit, threads);
+      bits::parallelRun(threads, task);
+
+      MatchingMap& matching = *_hk._matching;
+      for (int i = 0; i < blue_num; ++i) {
+        if (mate[i] != -1) {
+          Arc a = red_arc[mate[i]];
+          matching[reds[mate[i]]] = a;
+          matching[_graph.target(a)] = _graph.oppositeArc(a);
+        }
+      }
+      _hk.start();
+    }
+
+    /// @}
+
+    /// \name Primal Solution
+    /// Functions to get the primal solution, i.e. the maximum matching.
+
+    /// @{
+
+    /// \brief Return the size (cardinality) of the matching.
+    ///
+    /// This function returns the size (cardinality) of the maximum
+    /// matching.
+    int matchingSize() const {
+      return _hk.matchingSize();
+    }
+
+    /// \brief Return \c true if the given edge is in the matching.
+    ///
+    /// This function returns \c true if the given edge is in the
+    /// matching.
+    bool matching(const Edge& edge) const {
+      return _hk.matching(edge);
+    }
+
+    /// \brief Return the matching arc (or edge) incident to the given node.
+    ///
+    /// This function returns the matching arc (or edge) incident to the
+    /// given node or \c INVALID if the node is not covered by the matching.
+    Arc matching(const Node& n) const {
+      return _hk.matching(n);
+    }
+
+    /// \brief Return a const reference to the matching map.
+    ///
+    /// This function returns a const reference to a node map that stores
+    /// the matching arc (or edge) incident to each node.
+    const MatchingMap& matchingMap() const {
+      return _hk.matchingMap();
+    }
+
+    /// \brief Return the mate of the given node.
+    ///
+    /// This function returns the mate of the given node or \c INVALID
+    /// if the node is not covered by the matching.
+    Node mate(const Node& n) const {
+      return _hk.mate(n);
+    }
+
+    /// @}
+
+    /// \name Dual Solution
+    /// Functions to get the dual solution, i.e. a minimum vertex cover.
+
+    /// @{
+
+    /// \brief Return \c true if the given node is in the vertex cover.
+    ///
+    /// This function returns \c true if the given node is in the
+    /// minimum vertex cover.
+    /// \see MaxBipartiteMatching::cover()
+    bool cover(const Node& n) const {
+      return _hk.cover(n);
+    }
+
+    /// @}
+
+  };
+
+} //END OF NAMESPACE LEMON
+
+#endif //LEMON_BIPARTITE_MATCHING_H
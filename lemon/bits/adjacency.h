@@ -0,0 +1,163 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_BITS_ADJACENCY_H
+#define LEMON_BITS_ADJACENCY_H
+
+///\file
+///\brief Compact adjacency arrays of graphs.
+///
+///The parallel algorithms and the static graphs work on the compact
+///(CSR) representation of the graphs: the nodes are indexed from 0, and
+///the adjacent nodes of node \c i are stored in
+///<tt>adj[first[i]..first[i+1]-1]</tt>.
+
+#include <vector>
+#include <lemon/core.h>
+#include <lemon/bits/parallel.h>
+
+namespace lemon {
+  namespace bits {
+
+    // Fills the CSR adjacency arrays of a (di)graph. The nodes are
+    // processed by parallelFor(), the first phase counts the arcs, the
+    // second one stores the opposite nodes (and the arcs, if
+    // requested). Each node is processed by a single thread, so the
+    // arrays do not depend on the scheduling.
+    template <typename Digraph, typename ArcIt, bool in, typename IndexMap>
+    class AdjacencyFiller {
+    public:
+      typedef typename Digraph::Node Node;
+      typedef typename Digraph::Arc Arc;
+
+      AdjacencyFiller(const Digraph& digraph, const std::vector<Node>& nodes,
+                      const IndexMap& index, std::vector<int>& first,
+                      std::vector<int>& adj, std::vector<Arc>* arcs)
+        : _digraph(digraph), _nodes(nodes), _index(index),
+          _first(first), _adj(adj), _arcs(arcs), _count(true) {}
+
+      void run(int threads) {
+        int n = _nodes.size();
+        _first.assign(n + 1, 0);
+        _count = true;
+        parallelFor(threads, 0, n, *this);
+        int m = n > 0 ? parallelPrefixSum(threads, &_first[0], n) : 0;
+        _adj.resize(m);
+        if (_arcs) _arcs->resize(m);
+        _count = false;
+        parallelFor(threads, 0, n, *this);
+      }
+
+      void operator()(int first, int last) {
+        for (int i = first; i < last; ++i) {
+          if (_count) {
+            int deg = 0;
+            for (ArcIt a(_digraph, _nodes[i]); a != INVALID; ++a) ++deg;
+            _first[i] = deg;
+          } else {
+            int k = _first[i];
+            for (ArcIt a(_digraph, _nodes[i]); a != INVALID; ++a) {
+              Node w = in ? _digraph.source(a) : _digraph.target(a);
+              _adj[k] = _index[w];
+              if (_arcs) (*_arcs)[k] = a;
+              ++k;
+            }
+          }
+        }
+      }
+
+    private:
+      const Digraph& _digraph;
+      const std::vector<Node>& _nodes;
+      const IndexMap& _index;
+      std::vector<int>& _first;
+      std::vector<int>& _adj;
+      std::vector<Arc>* _arcs;
+      bool _count;
+    };
+
+    /// \brief Builds the incidence arrays of an undirected graph.
+    ///
+    /// This function distributes the arcs of an undirected graph to
+    /// their source nodes by counting sort. The arcs \c 2i and \c 2i+1
+    /// are the two directions of the edge \c i, thus the source of the
+    /// arc \c a is <tt>target[a ^ 1]</tt>. The outgoing arcs of node
+    /// \c i are stored in <tt>out[first[i]..first[i+1]-1]</tt> in
+    /// increasing order, and \c next links them in the same order (the
+    /// last one is followed by \c -1). The arrays \c first, \c out and
+    /// \c next must have \c n+1, \c m and \c m elements, respectively.
+    inline void buildIncidence(int n, int m, const int* target,
+                               int* first, int* out, int* next) {
+      for (int i = 0; i <= n; ++i) {
+        first[i] = 0;
+      }
+      for (int a = 0; a != m; ++a) {
+        ++first[target[a ^ 1] + 1];
+      }
+      for (int i = 0; i != n; ++i) {
+        first[i + 1] += first[i];
+      }
+      std::vector<int> pos(first, first + n);
+      for (int a = 0; a != m; ++a) {
+        out[pos[target[a ^ 1]]++] = a;
+      }
+      for (int i = 0; i != n; ++i) {
+        int b = first[i], e = first[i + 1];
+        for (int k = b; k < e; ++k) {
+          next[out[k]] = k + 1 < e ? out[k + 1] : -1;
+        }
+      }
+    }
+
+    /// \brief Builds the outgoing adjacency arrays of a (di)graph.
+    ///
+    /// This function builds the CSR arrays of the outgoing arcs of
+    /// the given nodes on the given number of threads. \c index maps
+    /// the nodes to their positions in \c nodes. For undirected graphs,
+    /// both directions of the edges are stored. If \c arcs is not
+    /// null, the arcs are also stored in the order of \c adj.
+    template <typename Digraph, typename IndexMap>
+    void buildOutAdjacency(const Digraph& digraph,
+                           const std::vector<typename Digraph::Node>& nodes,
+                           const IndexMap& index, std::vector<int>& first,
+                           std::vector<int>& adj, int threads,
+                           std::vector<typename Digraph::Arc>* arcs = 0) {
+      AdjacencyFiller<Digraph, typename Digraph::OutArcIt, false, IndexMap>
+        filler(digraph, nodes, index, first, adj, arcs);
+      filler.run(threads);
+    }
+
+    /// \brief Builds the incoming adjacency arrays of a digraph.
+    ///
+    /// This function is the counterpart of buildOutAdjacency() for
+    /// the incoming arcs, \c adj contains the source nodes.
+    template <typename Digraph, typename IndexMap>
+    void buildInAdjacency(const Digraph& digraph,
+                          const std::vector<typename Digraph::Node>& nodes,
+                          const IndexMap& index, std::vector<int>& first,
+                          std::vector<int>& adj, int threads,
+                          std::vector<typename Digraph::Arc>* arcs = 0) {
+      AdjacencyFiller<Digraph, typename Digraph::InArcIt, true, IndexMap>
+        filler(digraph, nodes, index, first, adj, arcs);
+      filler.run(threads);
+    }
+
+  }
+}
+
+#endif
@@ -0,0 +1,349 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_BITS_PARALLEL_H
+#define LEMON_BITS_PARALLEL_H
+
+///\file
+///\brief Minimal fork-join threading and atomic primitives.
+///
+///This file provides the small set of tools the parallel algorithms of
+///LEMON are built on: running a functor on a number of threads,
+///splitting an integer range among threads and a few atomic integer
+///operations. The threading library is selected by the \c LEMON_THREADING
+///configuration option. If it is \c None (or the compiler does not
+///provide atomic builtins), the "threads" are simply executed one after
+///the other on the calling thread, thus the algorithms using these tools
+///remain correct, they only lose their parallelism.
+///
+///The functors must not throw exceptions and they must not wait for
+///each other, since their concurrent execution is not guaranteed.
+
+#include <vector>
+#include <lemon/config.h>
+
+#if defined(LEMON_USE_PTHREAD)
+#include <pthread.h>
+#include <unistd.h>
+#elif defined(LEMON_USE_WIN32_THREADS)
+#include <lemon/bits/windows.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if (defined(LEMON_USE_PTHREAD) || defined(LEMON_USE_WIN32_THREADS)) && \
+  (defined(__GNUC__) || defined(_MSC_VER))
+#define LEMON_HAVE_PARALLEL 1
+#endif
+
+namespace lemon {
+  namespace bits {
+
+    /// \brief The number of hardware threads.
+    ///
+    /// This function returns the number of processors available for
+    /// the parallel algorithms. It is 1 if the parallel execution is
+    /// not supported.
+    inline int hardwareThreadNum() {
+#if defined(LEMON_HAVE_PARALLEL) && defined(LEMON_USE_PTHREAD)
+      long num = sysconf(_SC_NPROCESSORS_ONLN);
+      return num > 0 ? static_cast<int>(num) : 1;
+#elif defined(LEMON_HAVE_PARALLEL) && defined(LEMON_USE_WIN32_THREADS)
+      int num = getWinProcessorNum();
+      return num > 0 ? num : 1;
+#else
+      return 1;
+#endif
+    }
+
+    /// \brief The number of threads to be used for a work of the given size.
+    ///
+    /// This function returns the number of threads to be used for
+    /// processing \c size items if at least \c grain items should be
+    /// assigned to each thread. The value 0 for \c threads stands for
+    /// hardwareThreadNum().
+    inline int parallelThreadNum(int threads, long long size,
+                                 long long grain = 4096) {
+      if (threads <= 0) threads = hardwareThreadNum();
+      if (grain < 1) grain = 1;
+      long long limit = (size + grain - 1) / grain;
+      if (limit < threads) threads = static_cast<int>(limit);
+      return threads < 1 ? 1 : threads;
+    }
+
+    template <typename Functor>
+    struct ParallelTask {
+      Functor *functor;
+      int id;
+    };
+
+    template <typename Functor>
+    void parallelTaskEntry(void *arg) {
+      ParallelTask<Functor> *task = static_cast<ParallelTask<Functor>*>(arg);
+      (*task->functor)(task->id);
+    }
+
+#if defined(LEMON_HAVE_PARALLEL) && defined(LEMON_USE_PTHREAD)
+    template <typename Functor>
+    void *parallelPthreadEntry(void *arg) {
+      parallelTaskEntry<Functor>(arg);
+      return 0;
+    }
+#endif
+
+    /// \brief Run a functor on several threads.
+    ///
+    /// This function calls <tt>functor(i)</tt> for each \c i in the
+    /// range <tt>[0..threads-1]</tt>, each call on a separate thread,
+    /// and returns when all of them are finished. The call with
+    /// <tt>i = 0</tt> is executed on the calling thread.
+    template <typename Functor>
+    void parallelRun(int threads, Functor& functor) {
+      if (threads <= 1) {
+        functor(0);
+        return;
+      }
+      std::vector<ParallelTask<Functor> > tasks(threads);
+      for (int i = 0; i < threads; ++i) {
+        tasks[i].functor = &functor;
+        tasks[i].id = i;
+      }
+#if defined(LEMON_HAVE_PARALLEL) && defined(LEMON_USE_PTHREAD)
+      std::vector<pthread_t> handles(threads);
+      std::vector<char> started(threads, 0);
+      for (int i = 1; i < threads; ++i) {
+        started[i] = pthread_create(&handles[i], 0,
+                                    &parallelPthreadEntry<Functor>,
+                                    &tasks[i]) == 0;
+      }
+      functor(0);
+      for (int i = 1; i < threads; ++i) {
+        if (started[i]) {
+          pthread_join(handles[i], 0);
+        } else {
+          functor(i);
+        }
+      }
+#elif defined(LEMON_HAVE_PARALLEL) && defined(LEMON_USE_WIN32_THREADS)
+      std::vector<void*> handles(threads, static_cast<void*>(0));
+      for (int i = 1; i < threads; ++i) {
+        handles[i] = startWinThread(&parallelTaskEntry<Functor>, &tasks[i]);
+      }
+      functor(0);
+      for (int i = 1; i < threads; ++i) {
+        if (handles[i] != 0) {
+          joinWinThread(handles[i]);
+        } else {
+          functor(i);
+        }
+      }
+#else
+      for (int i = 0; i < threads; ++i) {
+        functor(i);
+      }
+#endif
+    }
+
+    template <typename Functor>
+    class ParallelForTask {
+    public:
+      ParallelForTask(Functor& functor, int begin, int end, int threads)
+        : _functor(functor), _begin(begin), _end(end), _threads(threads) {}
+
+      void operator()(int id) {
+        long long size = static_cast<long long>(_end) - _begin;
+        int first = _begin + static_cast<int>(size * id / _threads);
+        int last = _begin + static_cast<int>(size * (id + 1) / _threads);
+        if (first < last) _functor(first, last);
+      }
+
+    private:
+      Functor& _functor;
+      int _begin, _end, _threads;
+    };
+
+    /// \brief Process an integer range on several threads.
+    ///
+    /// This function splits the range <tt>[begin..end-1]</tt> into
+    /// contiguous blocks of nearly equal size and calls
+    /// <tt>functor(first, last)</tt> for each block
+    /// <tt>[first..last-1]</tt> on a separate thread.
+    /// At most parallelThreadNum(threads, end - begin, grain) threads
+    /// are used.
+    /// \return The number of blocks (threads) used.
+    template <typename Functor>
+    int parallelFor(int threads, int begin, int end, Functor& functor,
+                    int grain = 4096) {
+      if (begin >= end) return 0;
+      threads = parallelThreadNum(threads, end - begin, grain);
+      ParallelForTask<Functor> task(functor, begin, end, threads);
+      parallelRun(threads, task);
+      return threads;
+    }
+
+    template <typename Value>
+    class ParallelPrefixSumTask {
+    public:
+      ParallelPrefixSumTask(Value *data, int size, int threads,
+                            std::vector<Value>& sums, bool second)
+        : _data(data), _size(size), _threads(threads),
+          _sums(sums), _second(second) {}
+
+      void operator()(int id) {
+        int first = static_cast<int>(static_cast<long long>(_size) *
+                                     id / _threads);
+        int last = static_cast<int>(static_cast<long long>(_size) *
+                                    (id + 1) / _threads);
+        if (!_second) {
+          Value sum = Value();
+          for (int i = first; i < last; ++i) sum += _data[i];
+          _sums[id] = sum;
+        } else {
+          Value sum = _sums[id];
+          for (int i = first; i < last; ++i) {
+            Value val = _data[i];
+            _data[i] = sum;
+            sum += val;
+          }
+        }
+      }
+
+    private:
+      Value *_data;
+      int _size, _threads;
+      std::vector<Value>& _sums;
+      bool _second;
+    };
+
+    /// \brief Exclusive prefix sum of an array on several threads.
+    ///
+    /// This function replaces the values <tt>data[0..size-1]</tt>
+    /// with their exclusive prefix sums, i.e. <tt>data[i]</tt> becomes
+    /// the sum of the original values <tt>data[0..i-1]</tt>, and
+    /// \c data[size] is set to the total sum. Therefore \c data must
+    /// have at least <tt>size+1</tt> elements.
+    /// \return The total sum.
+    template <typename Value>
+    Value parallelPrefixSum(int threads, Value *data, int size) {
+      threads = parallelThreadNum(threads, size, 1 << 16);
+      std::vector<Value> sums(threads);
+      ParallelPrefixSumTask<Value> count(data, size, threads, sums, false);
+      parallelRun(threads, count);
+      Value total = Value();
+      for (int i = 0; i < threads; ++i) {
+        Value val = sums[i];
+        sums[i] = total;
+        total += val;
+      }
+      ParallelPrefixSumTask<Value> assign(data, size, threads, sums, true);
+      parallelRun(threads, assign);
+      data[size] = total;
+      return total;
+    }
+
+    /// \brief Atomically add a value to an integer.
+    ///
+    /// This function atomically adds \c value to \c *ptr and returns
+    /// the original value.
+    inline int atomicFetchAdd(int *ptr, int value) {
+#if defined(LEMON_HAVE_PARALLEL) && defined(_MSC_VER)
+      return _InterlockedExchangeAdd(reinterpret_cast<volatile long*>(ptr),
+                                     value);
+#elif defined(LEMON_HAVE_PARALLEL)
+      return __sync_fetch_and_add(ptr, value);
+#else
+      int old = *ptr;
+      *ptr += value;
+      return old;
+#endif
+    }
+
+    /// \brief Atomic compare-and-swap on an integer.
+    ///
+    /// This function atomically sets \c *ptr to \c value if it equals
+    /// to \c expected. It returns \c true if the exchange took place.
+    inline bool atomicCompareAndSwap(int *ptr, int expected, int value) {
+#if defined(LEMON_HAVE_PARALLEL) && defined(_MSC_VER)
+      return _InterlockedCompareExchange(reinterpret_cast<volatile long*>(ptr),
+                                         value, expected) == expected;
+#elif defined(LEMON_HAVE_PARALLEL)
+      return __sync_bool_compare_and_swap(ptr, expected, value);
+#else
+      if (*ptr != expected) return false;
+      *ptr = value;
+      return true;
+#endif
+    }
+
+    /// \brief Atomically replace an integer.
+    ///
+    /// This function atomically sets \c *ptr to \c value and returns
+    /// the original value.
+    inline int atomicExchange(int *ptr, int value) {
+#if defined(LEMON_HAVE_PARALLEL) && defined(_MSC_VER)
+      return _InterlockedExchange(reinterpret_cast<volatile long*>(ptr),
+                                  value);
+#elif defined(LEMON_HAVE_PARALLEL)
+      int old = *static_cast<volatile int*>(ptr);
+      while (!__sync_bool_compare_and_swap(ptr, old, value)) {
+        old = *static_cast<volatile int*>(ptr);
+      }
+      return old;
+#else
+      int old = *ptr;
+      *ptr = value;
+      return old;
+#endif
+    }
+
+    /// \brief Atomically read an integer.
+    ///
+    /// This function reads an integer that may be modified concurrently
+    /// by the atomic functions.
+    inline int atomicLoad(const int *ptr) {
+      return *static_cast<const volatile int*>(ptr);
+    }
+
+    /// \brief Atomically write an integer.
+    ///
+    /// This function writes an integer that may be read concurrently
+    /// by atomicLoad().
+    inline void atomicStore(int *ptr, int value) {
+      *static_cast<volatile int*>(ptr) = value;
+    }
+
+    /// \brief Atomically decrease an integer to a given bound.
+    ///
+    /// This function atomically sets \c *ptr to the minimum of its
+    /// current value and \c value. It returns \c true if \c *ptr was
+    /// decreased.
+    inline bool atomicMin(int *ptr, int value) {
+      int old = atomicLoad(ptr);
+      while (value < old) {
+        if (atomicCompareAndSwap(ptr, old, value)) return true;
+        old = atomicLoad(ptr);
+      }
+      return false;
+    }
+
+  }
+}
+
+#endif
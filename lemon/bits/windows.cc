@@ -20,6 +20,7 @@
 ///\brief Some basic non-inline functions and static global data.
 
 #include<lemon/bits/windows.h>
+#include<lemon/concept_check.h>
 
 #if defined(LEMON_WIN32) && defined(__GNUC__)
 #pragma GCC diagnostic ignored "-Wold-style-cast"
@@ -135,6 +136,61 @@ namespace lemon {
 #endif
     }
 
+    int getWinProcessorNum()
+    {
+#ifdef LEMON_WIN32
+      SYSTEM_INFO info;
+      GetSystemInfo(&info);
+      return info.dwNumberOfProcessors;
+#else
+      return 1;
+#endif
+    }
+
+#ifdef LEMON_WIN32
+    namespace {
+      struct WinThreadArg {
+        void (*func)(void*);
+        void *arg;
+      };
+
+      DWORD WINAPI winThreadEntry(LPVOID param) {
+        WinThreadArg *data = static_cast<WinThreadArg*>(param);
+        data->func(data->arg);
+        delete data;
+        return 0;
+      }
+    }
+#endif
+
+    void *startWinThread(void (*func)(void*), void *arg)
+    {
+#ifdef LEMON_WIN32
+      WinThreadArg *data = new WinThreadArg;
+      data->func = func;
+      data->arg = arg;
+      HANDLE handle = CreateThread(0, 0, &winThreadEntry, data, 0, 0);
+      if (handle == 0) {
+        delete data;
+        return 0;
+      }
+      return handle;
+#else
+      ::lemon::ignore_unused_variable_warning(func, arg);
+      return 0;
+#endif
+    }
+
+    void joinWinThread(void *handle)
+    {
+#ifdef LEMON_WIN32
+      WaitForSingleObject(static_cast<HANDLE>(handle), INFINITE);
+      CloseHandle(static_cast<HANDLE>(handle));
+#else
+      ::lemon::ignore_unused_variable_warning(handle);
+#endif
+    }
+
     WinLock::WinLock() {
 #ifdef LEMON_WIN32
       CRITICAL_SECTION *lock = new CRITICAL_SECTION;
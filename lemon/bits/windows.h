@@ -29,6 +29,9 @@ namespace lemon {
                          double &cutime, double &cstime);
     std::string getWinFormattedDate();
     int getWinRndSeed();
+    int getWinProcessorNum();
+    void *startWinThread(void (*func)(void*), void *arg);
+    void joinWinThread(void *handle);
 
     class WinLock {
     public:
@@ -0,0 +1,331 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_BORUVKA_H
+#define LEMON_BORUVKA_H
+
+///\ingroup spantree
+///\file
+///\brief Parallel Boruvka algorithm to compute a minimum cost spanning tree
+
+#include <vector>
+#include <algorithm>
+
+#include <lemon/core.h>
+#include <lemon/kruskal.h>
+#include <lemon/bits/parallel.h>
+
+namespace lemon {
+
+  namespace _boruvka_bits {
+
+    // The contracted graph and the steps of the Boruvka rounds. The
+    // vertex and edge ranges are processed by parallelFor() calling
+    // operator()(first, last) according to the current phase, while
+    // the contraction of the edge list calls operator()(id) on each
+    // thread.
+    template <typename V>
+    class BoruvkaEngine {
+    public:
+
+      BoruvkaEngine(int node_num, int threads)
+        : _node_num(node_num), _threads(threads) {}
+
+      void addEdge(int a, int b, const V& cost) {
+        _u.push_back(a);
+        _v.push_back(b);
+        _id.push_back(_cost.size());
+        _cost.push_back(cost);
+      }
+
+      V run() {
+        _tree.assign(_cost.size(), 0);
+        int n = _node_num;
+        while (!_u.empty()) {
+          int m = _u.size();
+
+          // Build the adjacency lists of the current graph
+          _first.assign(n + 1, 0);
+          parallelPhase(DEGREE, m);
+          bits::parallelPrefixSum(_threads, &_first[0], n);
+          _cursor = _first;
+          _adj.resize(2 * m);
+          parallelPhase(FILL, m);
+
+          // Select the lightest edge of each vertex and hook the
+          // vertices along these edges
+          _best.resize(n);
+          parallelPhase(BEST, n);
+          _parent.resize(n);
+          parallelPhase(HOOK, n);
+
+          // Pointer jumping to make each tree a star
+          _next.resize(n);
+          do {
+            _changed = 0;
+            parallelPhase(JUMP, n);
+            _parent.swap(_next);
+          } while (_changed);
+
+          // Relabel the components
+          _label.resize(n + 1);
+          parallelPhase(ROOTS, n);
+          int k = bits::parallelPrefixSum(_threads, &_label[0], n);
+          parallelPhase(LABEL, n);
+
+          contract();
+          n = k;
+        }
+        V value = 0;
+        for (int i = 0; i < int(_tree.size()); ++i) {
+          if (_tree[i]) value += _cost[i];
+        }
+        return value;
+      }
+
+      bool tree(int i) const {
+        return _tree[i] != 0;
+      }
+
+      void operator()(int first, int last) {
+        switch (_phase) {
+        case DEGREE:
+          for (int i = first; i < last; ++i) {
+            bits::atomicFetchAdd(&_first[_u[i]], 1);
+            bits::atomicFetchAdd(&_first[_v[i]], 1);
+          }
+          break;
+        case FILL:
+          for (int i = first; i < last; ++i) {
+            _adj[bits::atomicFetchAdd(&_cursor[_u[i]], 1)] = i;
+            _adj[bits::atomicFetchAdd(&_cursor[_v[i]], 1)] = i;
+          }
+          break;
+        case BEST:
+          for (int x = first; x < last; ++x) {
+            int best = -1;
+            for (int j = _first[x]; j < _first[x + 1]; ++j) {
+              if (best == -1 || less(_adj[j], best)) best = _adj[j];
+            }
+            _best[x] = best;
+          }
+          break;
+        case HOOK:
+          for (int x = first; x < last; ++x) {
+            int e = _best[x];
+            if (e == -1) {
+              _parent[x] = x;
+              continue;
+            }
+            int y = _u[e] == x ? _v[e] : _u[e];
+            // The common lightest edge of two vertices is selected
+            // only by the vertex with larger index.
+            if (_best[y] == e && x < y) {
+              _parent[x] = x;
+            } else {
+              _parent[x] = y;
+              _tree[_id[e]] = 1;
+            }
+          }
+          break;
+        case JUMP:
+          for (int x = first; x < last; ++x) {
+            _next[x] = _parent[_parent[x]];
+            if (_next[x] != _parent[x]) bits::atomicStore(&_changed, 1);
+          }
+          break;
+        case ROOTS:
+          for (int x = first; x < last; ++x) {
+            _label[x] = _parent[x] == x ? 1 : 0;
+          }
+          break;
+        case LABEL:
+          for (int x = first; x < last; ++x) {
+            _next[x] = _label[_parent[x]];
+          }
+          break;
+        }
+      }
+
+      void operator()(int id) {
+        int m = _u.size();
+        int first = static_cast<int>(
+          static_cast<long long>(m) * id / _contract_threads);
+        int last = static_cast<int>(
+          static_cast<long long>(m) * (id + 1) / _contract_threads);
+        if (_phase == COUNT) {
+          int cnt = 0;
+          for (int i = first; i < last; ++i) {
+            if (_next[_u[i]] != _next[_v[i]]) ++cnt;
+          }
+          _count[id] = cnt;
+        } else {
+          int k = _count[id];
+          for (int i = first; i < last; ++i) {
+            int a = _next[_u[i]], b = _next[_v[i]];
+            if (a != b) {
+              _nu[k] = a;
+              _nv[k] = b;
+              _nid[k] = _id[i];
+              ++k;
+            }
+          }
+        }
+      }
+
+    private:
+
+      enum {
+        DEGREE, FILL, BEST, HOOK, JUMP, ROOTS, LABEL, COUNT, SCATTER
+      };
+
+      // Strict order of the edges of the current graph: by cost, then
+      // by original index
+      bool less(int e, int f) const {
+        int a = _id[e], b = _id[f];
+        return _cost[a] < _cost[b] || (!(_cost[b] < _cost[a]) && a < b);
+      }
+
+      void parallelPhase(int phase, int size) {
+        _phase = phase;
+        bits::parallelFor(_threads, 0, size, *this);
+      }
+
+      // Removes the edges inside the components and maps the end
+      // nodes to the new component labels
+      void contract() {
+        int m = _u.size();
+        _contract_threads = bits::parallelThreadNum(_threads, m, 4096);
+        _count.resize(_contract_threads + 1);
+        _phase = COUNT;
+        bits::parallelRun(_contract_threads, *this);
+        int k = 0;
+        for (int i = 0; i < _contract_threads; ++i) {
+          int c = _count[i];
+          _count[i] = k;
+          k += c;
+        }
+        _nu.resize(k);
+        _nv.resize(k);
+        _nid.resize(k);
+        _phase = SCATTER;
+        bits::parallelRun(_contract_threads, *this);
+        _u.swap(_nu);
+        _v.swap(_nv);
+        _id.swap(_nid);
+      }
+
+      int _node_num;
+      int _threads;
+      int _phase;
+
+      std::vector<V> _cost;
+      std::vector<char> _tree;
+
+      // The current edge list
+      std::vector<int> _u, _v, _id;
+      std::vector<int> _nu, _nv, _nid;
+
+      // Adjacency lists of the current graph
+      std::vector<int> _first, _cursor, _adj;
+
+      std::vector<int> _best, _parent, _next, _label;
+      int _changed;
+
+      std::vector<int> _count;
+      int _contract_threads;
+    };
+
+  }
+
+  /// \ingroup spantree
+  ///
+  /// \brief Parallel Boruvka algorithm for finding a minimum cost
+  /// spanning tree of a graph.
+  ///
+  /// This function finds a minimum cost spanning tree (or forest) of
+  /// a graph using Boruvka's algorithm on several threads.
+  /// In each round, every component selects its lightest incident
+  /// arc/edge, the components are merged along the selected arcs/edges,
+  /// then the graph is contracted: the arcs/edges inside the new
+  /// components are removed and the others are relabeled. The current
+  /// graph is stored in a compact adjacency array (CSR) format, and all
+  /// steps of the rounds run in parallel. The algorithm finishes in
+  /// \f$O(\log n)\f$ rounds and, contrary to \ref kruskal(), it does
+  /// not sort the arcs/edges.
+  ///
+  /// The ties between equal costs are broken by the order of the
+  /// arcs/edges in the graph, so the result does not depend on the
+  /// number of threads.
+  ///
+  /// \param graph The graph the algorithm runs on.
+  /// It can be either \ref concepts::Digraph "directed" or
+  /// \ref concepts::Graph "undirected".
+  /// If the graph is directed, the algorithm consider it to be
+  /// undirected by disregarding the direction of the arcs.
+  /// \param cost A readable arc/edge map that specifies the costs.
+  /// \retval tree A writable arc/edge map with \c bool value type.
+  /// After running the algorithm it will contain the found minimum
+  /// cost spanning tree: the value of an arc/edge will be set to
+  /// \c true if it belongs to the tree, otherwise it will be set to
+  /// \c false. The value of each arc/edge will be set exactly once.
+  /// \param threads The number of threads. The value 0 (the default)
+  /// stands for the number of hardware threads.
+  ///
+  /// \return The total cost of the found spanning tree.
+  ///
+  /// \note If the input graph is not (weakly) connected, a spanning
+  /// forest is calculated instead of a spanning tree.
+  ///
+  /// \sa kruskal(), parallelKruskal(), Prim
+  template <typename Graph, typename CostMap, typename TreeMap>
+  typename CostMap::Value
+  boruvka(const Graph& graph, const CostMap& cost, TreeMap& tree,
+          int threads = 0)
+  {
+    typedef typename CostMap::Key Item;
+    typedef typename CostMap::Value Value;
+    typedef typename ItemSetTraits<Graph, Item>::ItemIt ItemIt;
+    typedef _kruskal_bits::KruskalEnds<Graph> Ends;
+
+    typename Graph::template NodeMap<int> index(graph);
+    int node_num = 0;
+    for (typename Graph::NodeIt n(graph); n != INVALID; ++n) {
+      index[n] = node_num++;
+    }
+
+    _boruvka_bits::BoruvkaEngine<Value> engine(node_num, threads);
+    std::vector<char> loop;
+    for (ItemIt it(graph); it != INVALID; ++it) {
+      int a = index[Ends::first(graph, it)];
+      int b = index[Ends::second(graph, it)];
+      loop.push_back(a == b);
+      if (a != b) engine.addEdge(a, b, cost[it]);
+    }
+    Value value = engine.run();
+
+    int k = 0, l = 0;
+    for (ItemIt it(graph); it != INVALID; ++it) {
+      tree.set(it, !loop[k++] && engine.tree(l++));
+    }
+    return value;
+  }
+
+} //namespace lemon
+
+#endif //LEMON_BORUVKA_H
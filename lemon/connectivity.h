@@ -24,12 +24,17 @@
 #include <lemon/core.h>
 #include <lemon/maps.h>
 #include <lemon/adaptors.h>
+#include <lemon/unionfind.h>
+#include <lemon/bits/parallel.h>
+#include <lemon/bits/adjacency.h>
 
 #include <lemon/concepts/digraph.h>
 #include <lemon/concepts/graph.h>
 #include <lemon/concept_check.h>
 
 #include <stack>
+#include <vector>
+#include <algorithm>
 #include <functional>
 
 /// \ingroup graph_properties
@@ -175,6 +180,183 @@ namespace lemon {
     return compNum;
   }
 
+  namespace _connectivity_bits {
+
+    // Parallel connected components on the CSR representation of an
+    // undirected graph using the Afforest algorithm. The components
+    // are built in a concurrent union-find structure, in which the
+    // representative of each set is its smallest element. The nodes
+    // are processed by parallelFor() calling operator()(first, last)
+    // according to the current phase.
+    class ParallelCcEngine {
+    public:
+
+      ParallelCcEngine(int node_num, int threads)
+        : _node_num(node_num), _threads(threads) {}
+
+      std::vector<int>& first() { return _first; }
+      std::vector<int>& adj() { return _adj; }
+
+      int run() {
+        int n = _node_num;
+        if (n == 0) return 0;
+        _uf.init(n);
+        _comp.resize(n);
+
+        // Sampling: each node is linked to its first few neighbors,
+        // which usually reveals the giant component
+        for (_round = 0; _round < SAMPLE_ROUNDS; ++_round) {
+          parallelPhase(SAMPLE, n);
+        }
+        parallelPhase(COMPRESS, n);
+        _giant = giantComponent();
+
+        // The remaining arcs are processed only from the nodes out of
+        // the giant component. The arcs leaving the giant component
+        // are processed from their other ends.
+        parallelPhase(FINISH, n);
+        parallelPhase(COMPRESS, n);
+
+        _label.resize(n + 1);
+        parallelPhase(ROOTS, n);
+        return bits::parallelPrefixSum(_threads, &_label[0], n);
+      }
+
+      int component(int i) const { return _label[_comp[i]]; }
+
+      void operator()(int first, int last) {
+        switch (_phase) {
+        case SAMPLE:
+          for (int v = first; v < last; ++v) {
+            int j = _first[v] + _round;
+            if (j < _first[v + 1]) _uf.join(v, _adj[j]);
+          }
+          break;
+        case COMPRESS:
+          for (int v = first; v < last; ++v) {
+            _comp[v] = _uf.find(v);
+          }
+          break;
+        case FINISH:
+          for (int v = first; v < last; ++v) {
+            if (_comp[v] == _giant) continue;
+            for (int j = _first[v] + SAMPLE_ROUNDS; j < _first[v + 1]; ++j) {
+              _uf.join(v, _adj[j]);
+            }
+          }
+          break;
+        case ROOTS:
+          for (int v = first; v < last; ++v) {
+            _label[v] = _comp[v] == v ? 1 : 0;
+          }
+          break;
+        }
+      }
+
+    private:
+
+      enum {
+        SAMPLE, COMPRESS, FINISH, ROOTS
+      };
+
+      static const int SAMPLE_ROUNDS = 2;
+      static const int SAMPLE_SIZE = 1024;
+
+      void parallelPhase(int phase, int size) {
+        _phase = phase;
+        bits::parallelFor(_threads, 0, size, *this);
+      }
+
+      // The most frequent component among evenly spaced sample nodes
+      int giantComponent() const {
+        int n = _node_num;
+        int step = n > SAMPLE_SIZE ? n / SAMPLE_SIZE : 1;
+        std::vector<int> sample;
+        for (int v = 0; v < n; v += step) sample.push_back(_comp[v]);
+        std::sort(sample.begin(), sample.end());
+        int giant = sample[0], best = 0;
+        for (int i = 0, j = 0; i < int(sample.size()); i = j) {
+          while (j < int(sample.size()) && sample[j] == sample[i]) ++j;
+          if (j - i > best) {
+            best = j - i;
+            giant = sample[i];
+          }
+        }
+        return giant;
+      }
+
+      int _node_num;
+      int _threads;
+      int _phase;
+      int _round;
+      int _giant;
+
+      std::vector<int> _first, _adj;
+      ConcurrentUnionFind _uf;
+      std::vector<int> _comp, _label;
+    };
+
+  }
+
+  /// \ingroup graph_properties
+  ///
+  /// \brief Find the connected components of an undirected graph
+  /// in parallel.
+  ///
+  /// This function finds the connected components of the given undirected
+  /// graph using several threads. It is the parallel counterpart of
+  /// connectedComponents(), and it numbers the components exactly the
+  /// same way.
+  ///
+  /// The graph is copied into compact adjacency arrays first, then the
+  /// Afforest algorithm is applied: the components are built in a
+  /// concurrent union-find structure (with Shiloach-Vishkin style
+  /// hooking and path compression). In the sampling phase, each node
+  /// is joined with its first two neighbors only, then the remaining
+  /// edges are processed skipping the nodes of the largest component
+  /// found so far. Thus the edges of the giant component of a
+  /// real-life graph are mostly not touched at all.
+  ///
+  /// \param graph The undirected graph.
+  /// \retval compMap A writable node map. The values will be set from 0 to
+  /// the number of the connected components minus one. Each value of the map
+  /// will be set exactly once.
+  /// \param threads The number of threads. The value 0 (the default)
+  /// stands for the number of hardware threads.
+  /// \return The number of connected components.
+  /// \note By definition, the empty graph consists
+  /// of zero connected components.
+  ///
+  /// \see connectedComponents()
+  template <class Graph, class NodeMap>
+  int parallelConnectedComponents(const Graph &graph, NodeMap &compMap,
+                                  int threads = 0) {
+    checkConcept<concepts::Graph, Graph>();
+    typedef typename Graph::Node Node;
+    typedef typename Graph::NodeIt NodeIt;
+    checkConcept<concepts::WriteMap<Node, int>, NodeMap>();
+
+    typedef typename Graph::template NodeMap<int> IndexMap;
+
+    std::vector<Node> nodes;
+    IndexMap index(graph);
+    for (NodeIt n(graph); n != INVALID; ++n) {
+      index[n] = nodes.size();
+      nodes.push_back(n);
+    }
+    int n = nodes.size();
+
+    _connectivity_bits::ParallelCcEngine engine(n, threads);
+    bits::buildOutAdjacency(graph, nodes, index,
+                            engine.first(), engine.adj(), threads);
+
+    int compNum = engine.run();
+    for (int i = 0; i < n; ++i) {
+      compMap.set(nodes[i], engine.component(i));
+    }
+    return compNum;
+  }
+
   namespace _connectivity_bits {
 
     template <typename Digraph, typename Iterator >
@@ -451,6 +633,399 @@ namespace lemon {
     return compNum;
   }
 
+  namespace _connectivity_bits {
+
+    // Parallel strongly connected components on the CSR representation
+    // of a digraph. The component of a node is identified by one of its
+    // nodes (the representative) during the computation, -1 stands for
+    // the nodes whose component is not known yet (the active nodes).
+    // The node and frontier ranges are processed by parallelFor()
+    // calling operator()(first, last) according to the current phase.
+    class ParallelSccEngine {
+    public:
+
+      ParallelSccEngine(int node_num, int threads)
+        : _node_num(node_num), _threads(threads), _stamp(0) {}
+
+      std::vector<int>& outFirst() { return _out_first; }
+      std::vector<int>& outAdj() { return _out_adj; }
+
+      int run() {
+        int n = _node_num;
+        buildInArcs();
+
+        _comp.assign(n, -1);
+        _active.resize(n);
+        for (int i = 0; i < n; ++i) _active[i] = i;
+        _cur.resize(n);
+        _next.resize(n);
+        _mark.assign(n, -1);
+        _color.resize(n);
+
+        // The largest component is usually found by a single
+        // forward-backward search from a high degree node, the rest is
+        // left to the trimming and the coloring steps.
+        trim();
+        if (!_active.empty()) forwardBackward();
+        while (!_active.empty()) {
+          trim();
+          if (!_active.empty()) coloring();
+        }
+        return renumber();
+      }
+
+      int component(int i) const { return _order[_comp[i]]; }
+
+      void operator()(int first, int last) {
+        switch (_phase) {
+        case IN_DEGREE:
+          for (int v = first; v < last; ++v) {
+            for (int j = _out_first[v]; j < _out_first[v + 1]; ++j) {
+              bits::atomicFetchAdd(&_in_first[_out_adj[j]], 1);
+            }
+          }
+          break;
+        case IN_FILL:
+          for (int v = first; v < last; ++v) {
+            for (int j = _out_first[v]; j < _out_first[v + 1]; ++j) {
+              int w = _out_adj[j];
+              _in_adj[bits::atomicFetchAdd(&_cursor[w], 1)] = v;
+            }
+          }
+          break;
+        case TRIM:
+          for (int i = first; i < last; ++i) {
+            int v = _active[i];
+            if (!activeNeighbor(v, _in_first, _in_adj) ||
+                !activeNeighbor(v, _out_first, _out_adj)) {
+              bits::atomicStore(&_comp[v], v);
+              bits::atomicStore(&_changed, 1);
+            }
+          }
+          break;
+        case FORWARD:
+          for (int i = first; i < last; ++i) {
+            int v = _cur[i];
+            for (int j = _out_first[v]; j < _out_first[v + 1]; ++j) {
+              int w = _out_adj[j];
+              if (_comp[w] == -1 &&
+                  bits::atomicLoad(&_mark[w]) != _stamp &&
+                  bits::atomicExchange(&_mark[w], _stamp) != _stamp) {
+                push(w);
+              }
+            }
+          }
+          break;
+        case BACKWARD:
+          for (int i = first; i < last; ++i) {
+            int v = _cur[i];
+            for (int j = _in_first[v]; j < _in_first[v + 1]; ++j) {
+              int w = _in_adj[j];
+              if (_mark[w] == _stamp &&
+                  bits::atomicCompareAndSwap(&_comp[w], -1, _pivot)) {
+                push(w);
+              }
+            }
+          }
+          break;
+        case COLOR_INIT:
+          for (int i = first; i < last; ++i) {
+            int v = _active[i];
+            _color[v] = v;
+            _cur[i] = v;
+          }
+          break;
+        case COLOR:
+          for (int i = first; i < last; ++i) {
+            int v = _cur[i];
+            int c = bits::atomicLoad(&_color[v]);
+            for (int j = _out_first[v]; j < _out_first[v + 1]; ++j) {
+              int w = _out_adj[j];
+              if (_comp[w] == -1 && bits::atomicMin(&_color[w], c) &&
+                  bits::atomicExchange(&_mark[w], _stamp) != _stamp) {
+                push(w);
+              }
+            }
+          }
+          break;
+        case ROOTS:
+          for (int i = first; i < last; ++i) {
+            int v = _active[i];
+            if (_color[v] == v) {
+              _comp[v] = v;
+              push(v);
+            }
+          }
+          break;
+        case COLOR_BACK:
+          for (int i = first; i < last; ++i) {
+            int v = _cur[i];
+            int c = _color[v];
+            for (int j = _in_first[v]; j < _in_first[v + 1]; ++j) {
+              int w = _in_adj[j];
+              if (_color[w] == c &&
+                  bits::atomicCompareAndSwap(&_comp[w], -1, c)) {
+                push(w);
+              }
+            }
+          }
+          break;
+        }
+      }
+
+    private:
+
+      enum {
+        IN_DEGREE, IN_FILL, TRIM, FORWARD, BACKWARD,
+        COLOR_INIT, COLOR, ROOTS, COLOR_BACK
+      };
+
+      void parallelPhase(int phase, int size) {
+        _phase = phase;
+        bits::parallelFor(_threads, 0, size, *this);
+      }
+
+      void push(int v) {
+        _next[bits::atomicFetchAdd(&_next_size, 1)] = v;
+      }
+
+      // Runs the current phase on the frontier, and makes the
+      // collected nodes the next frontier
+      void expand(int phase) {
+        _next_size = 0;
+        ++_stamp;
+        parallelPhase(phase, _cur_size);
+        _cur.swap(_next);
+        _cur_size = _next_size;
+      }
+
+      bool activeNeighbor(int v, const std::vector<int>& first,
+                          const std::vector<int>& adj) const {
+        for (int j = first[v]; j < first[v + 1]; ++j) {
+          int w = adj[j];
+          if (w != v && bits::atomicLoad(&_comp[w]) == -1) return true;
+        }
+        return false;
+      }
+
+      void buildInArcs() {
+        int n = _node_num;
+        _in_first.assign(n + 1, 0);
+        parallelPhase(IN_DEGREE, n);
+        if (n > 0) bits::parallelPrefixSum(_threads, &_in_first[0], n);
+        _cursor = _in_first;
+        _in_adj.resize(_out_adj.size());
+        parallelPhase(IN_FILL, n);
+        std::vector<int>().swap(_cursor);
+      }
+
+      // Removes the active nodes that are not known to be finished
+      void compact() {
+        int k = 0;
+        for (int i = 0; i < int(_active.size()); ++i) {
+          if (_comp[_active[i]] == -1) _active[k++] = _active[i];
+        }
+        _active.resize(k);
+      }
+
+      // Nodes without active in- or out-neighbors form singleton
+      // components
+      void trim() {
+        do {
+          _changed = 0;
+          parallelPhase(TRIM, _active.size());
+          compact();
+        } while (_changed && !_active.empty());
+      }
+
+      // The component of the pivot is the intersection of the nodes
+      // reachable from it and the nodes it is reachable from
+      void forwardBackward() {
+        long long best = -1;
+        _pivot = _active[0];
+        for (int i = 0; i < int(_active.size()); ++i) {
+          int v = _active[i];
+          long long d = static_cast<long long>
+            (_out_first[v + 1] - _out_first[v] + 1) *
+            (_in_first[v + 1] - _in_first[v] + 1);
+          if (d > best) {
+            best = d;
+            _pivot = v;
+          }
+        }
+
+        ++_stamp;
+        _mark[_pivot] = _stamp;
+        _cur[0] = _pivot;
+        _cur_size = 1;
+        while (_cur_size > 0) {
+          _next_size = 0;
+          parallelPhase(FORWARD, _cur_size);
+          _cur.swap(_next);
+          _cur_size = _next_size;
+        }
+
+        _comp[_pivot] = _pivot;
+        _cur[0] = _pivot;
+        _cur_size = 1;
+        while (_cur_size > 0) {
+          _next_size = 0;
+          parallelPhase(BACKWARD, _cur_size);
+          _cur.swap(_next);
+          _cur_size = _next_size;
+        }
+        compact();
+      }
+
+      // The smallest index reaching each node is propagated along the
+      // arcs. The nodes keeping their own index are the roots, and the
+      // component of a root consists of the nodes of the same color
+      // from which it is reachable.
+      void coloring() {
+        _cur_size = _active.size();
+        parallelPhase(COLOR_INIT, _cur_size);
+        while (_cur_size > 0) expand(COLOR);
+
+        _cur_size = _active.size();
+        _next_size = 0;
+        parallelPhase(ROOTS, _cur_size);
+        _cur.swap(_next);
+        _cur_size = _next_size;
+        while (_cur_size > 0) expand(COLOR_BACK);
+        compact();
+      }
+
+      // Numbers the components in a topological order of the
+      // condensed digraph. The components are processed in the order
+      // of their representatives in the case of ties.
+      int renumber() {
+        int n = _node_num;
+        std::vector<int>& deg = _color;
+        std::vector<int>& first = _mark;
+        std::vector<int>& members = _cur;
+        deg.assign(n, 0);
+        first.assign(n + 1, 0);
+        for (int v = 0; v < n; ++v) {
+          ++first[_comp[v]];
+          for (int j = _out_first[v]; j < _out_first[v + 1]; ++j) {
+            int c = _comp[_out_adj[j]];
+            if (c != _comp[v]) ++deg[c];
+          }
+        }
+        for (int v = 0, k = 0; v <= n; ++v) {
+          int c = first[v];
+          first[v] = k;
+          k += c;
+        }
+        _cursor = first;
+        for (int v = 0; v < n; ++v) members[_cursor[_comp[v]]++] = v;
+
+        _order.assign(n, -1);
+        std::vector<int>& queue = _next;
+        int head = 0, tail = 0;
+        for (int v = 0; v < n; ++v) {
+          if (_comp[v] == v && deg[v] == 0) queue[tail++] = v;
+        }
+        while (head < tail) {
+          int r = queue[head];
+          _order[r] = head++;
+          for (int i = first[r]; i < first[r + 1]; ++i) {
+            int v = members[i];
+            for (int j = _out_first[v]; j < _out_first[v + 1]; ++j) {
+              int c = _comp[_out_adj[j]];
+              if (c != r && --deg[c] == 0) queue[tail++] = c;
+            }
+          }
+        }
+        return tail;
+      }
+
+      int _node_num;
+      int _threads;
+      int _phase;
+
+      std::vector<int> _out_first, _out_adj;
+      std::vector<int> _in_first, _in_adj, _cursor;
+
+      std::vector<int> _comp, _active, _color, _mark, _order;
+      std::vector<int> _cur, _next;
+      int _cur_size, _next_size;
+      int _stamp, _pivot, _changed;
+    };
+
+  }
+
+  /// \ingroup graph_properties
+  ///
+  /// \brief Find the strongly connected components of a directed graph
+  /// in parallel.
+  ///
+  /// This function finds the strongly connected components of the given
+  /// directed graph using several threads. It is the parallel
+  /// counterpart of stronglyConnectedComponents(), and it numbers the
+  /// components the same way: there is no arc going from a higher
+  /// numbered component to a lower one.
+  ///
+  /// The digraph is copied into compact adjacency arrays first, then
+  /// the components are found by the following steps, which are all
+  /// executed in parallel and do not use recursion.
+  /// - \e Trimming: the nodes that have no incoming or no outgoing
+  ///   arcs from the unprocessed nodes form singleton components.
+  /// - \e Forward-backward \e search: the component of a node of high
+  ///   degree is the intersection of the nodes reachable from it and
+  ///   the nodes from which it is reachable. This step usually finds
+  ///   the giant component of the real-life digraphs.
+  /// - \e Coloring: the smallest node index is propagated along the
+  ///   arcs, then each node that keeps its own index collects its
+  ///   component with a backward search restricted to its color.
+  ///   This step is repeated (together with trimming) until all
+  ///   components are found.
+  ///
+  /// The algorithm is the most efficient on \ref StaticDigraph, but it
+  /// works on any digraph type. The result does not depend on the
+  /// number of threads.
+  ///
+  /// \param digraph The digraph.
+  /// \retval compMap A writable node map. The values will be set from 0 to
+  /// the number of the strongly connected components minus one. Each value
+  /// of the map will be set exactly once.
+  /// \param threads The number of threads. The value 0 (the default)
+  /// stands for the number of hardware threads.
+  /// \return The number of strongly connected components.
+  /// \note By definition, the empty digraph has zero
+  /// strongly connected components.
+  ///
+  /// \see stronglyConnectedComponents()
+  template <typename Digraph, typename NodeMap>
+  int parallelStronglyConnectedComponents(const Digraph& digraph,
+                                          NodeMap& compMap,
+                                          int threads = 0) {
+    checkConcept<concepts::Digraph, Digraph>();
+    typedef typename Digraph::Node Node;
+    typedef typename Digraph::NodeIt NodeIt;
+    checkConcept<concepts::WriteMap<Node, int>, NodeMap>();
+
+    typedef typename Digraph::template NodeMap<int> IndexMap;
+
+    std::vector<Node> nodes;
+    IndexMap index(digraph);
+    for (NodeIt n(digraph); n != INVALID; ++n) {
+      index[n] = nodes.size();
+      nodes.push_back(n);
+    }
+    int n = nodes.size();
+
+    _connectivity_bits::ParallelSccEngine engine(n, threads);
+    bits::buildOutAdjacency(digraph, nodes, index,
+                            engine.outFirst(), engine.outAdj(), threads);
+
+    int compNum = engine.run();
+    for (int i = 0; i < n; ++i) {
+      compMap.set(nodes[i], engine.component(i));
+    }
+    return compNum;
+  }
+
   /// \ingroup graph_properties
   ///
   /// \brief Find the cut arcs of the strongly connected components.
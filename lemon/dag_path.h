@@ -0,0 +1,663 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_DAG_PATH_H
+#define LEMON_DAG_PATH_H
+
+///\ingroup graph_properties
+///\file
+///\brief Parallel topological layering and shortest/longest paths in DAGs.
+
+#include <vector>
+
+#include <lemon/core.h>
+#include <lemon/path.h>
+#include <lemon/concepts/digraph.h>
+#include <lemon/concept_check.h>
+#include <lemon/bits/parallel.h>
+#include <lemon/bits/adjacency.h>
+
+namespace lemon {
+
+  namespace _dag_path_bits {
+
+    // The indices of the nodes stored in a vector by their ids
+    template <typename Digraph>
+    class IdIndexMap {
+    public:
+      typedef typename Digraph::Node Key;
+      typedef int Value;
+
+      IdIndexMap(const Digraph& digraph, const std::vector<int>& index)
+        : _digraph(digraph), _index(index) {}
+
+      Value operator[](const Key& node) const {
+        return _index[_digraph.id(node)];
+      }
+
+    private:
+      const Digraph& _digraph;
+      const std::vector<int>& _index;
+    };
+
+    // Kahn's algorithm processing the nodes level by level. The
+    // current level is processed by parallelFor(), each node of the
+    // next level is pushed by the thread decreasing its in-degree to
+    // zero.
+    class KahnEngine {
+    public:
+
+      KahnEngine(const std::vector<int>& first, const std::vector<int>& adj,
+                 int threads)
+        : _out_first(first), _out_adj(adj), _threads(threads) {}
+
+      bool run(std::vector<int>& order, std::vector<int>& level_first,
+               std::vector<int>& level) {
+        int n = int(_out_first.size()) - 1;
+        _deg.assign(n, 0);
+        _order = &order;
+        _level = &level;
+        _phase = DEGREE;
+        bits::parallelFor(_threads, 0, n, *this);
+
+        order.resize(n);
+        level.assign(n, -1);
+        level_first.clear();
+        int end = 0;
+        for (int v = 0; v < n; ++v) {
+          if (_deg[v] == 0) {
+            order[end++] = v;
+            level[v] = 0;
+          }
+        }
+        int start = 0;
+        _phase = LEVEL;
+        while (start < end) {
+          level_first.push_back(start);
+          _range_first = start;
+          _next_size = end;
+          _current = level_first.size();
+          bits::parallelFor(_threads, 0, end - start, *this);
+          start = end;
+          end = _next_size;
+        }
+        level_first.push_back(end);
+        order.resize(end);
+        return end == n;
+      }
+
+      void operator()(int first, int last) {
+        if (_phase == DEGREE) {
+          for (int v = first; v < last; ++v) {
+            for (int j = _out_first[v]; j < _out_first[v + 1]; ++j) {
+              bits::atomicFetchAdd(&_deg[_out_adj[j]], 1);
+            }
+          }
+        } else {
+          for (int i = _range_first + first; i < _range_first + last; ++i) {
+            int v = (*_order)[i];
+            for (int j = _out_first[v]; j < _out_first[v + 1]; ++j) {
+              int w = _out_adj[j];
+              if (bits::atomicFetchAdd(&_deg[w], -1) == 1) {
+                (*_level)[w] = _current;
+                (*_order)[bits::atomicFetchAdd(&_next_size, 1)] = w;
+              }
+            }
+          }
+        }
+      }
+
+    private:
+
+      enum { DEGREE, LEVEL };
+
+      const std::vector<int>& _out_first;
+      const std::vector<int>& _out_adj;
+      int _threads;
+      int _phase;
+
+      std::vector<int> _deg;
+      std::vector<int>* _order;
+      std::vector<int>* _level;
+      int _range_first, _next_size, _current;
+    };
+
+  }
+
+  template <typename GR, typename LEN>
+  class DagPath;
+
+  /// \ingroup graph_properties
+  ///
+  /// \brief Parallel topological layering of a digraph.
+  ///
+  /// This class computes a topological order of an acyclic digraph
+  /// using Kahn's algorithm on several threads. The nodes are
+  /// partitioned into \e levels: level 0 consists of the nodes without
+  /// incoming arcs, and level \c k consists of the nodes whose
+  /// predecessors are all in the levels <tt>0..k-1</tt>, thus the
+  /// level of a node is the number of arcs on the longest path ending
+  /// at it. The nodes of a level do not depend on each other, so the
+  /// levels can be processed one after the other, and the nodes of
+  /// each level in parallel. The topological order lists the levels
+  /// in increasing order.
+  ///
+  /// The digraph is copied into compact adjacency arrays first, which
+  /// is the cheapest for \ref StaticDigraph, but the class works on
+  /// any digraph type.
+  ///
+  /// \tparam GR The type of the digraph.
+  ///
+  /// \see topologicalSort(), checkedTopologicalSort(),
+  /// parallelTopologicalSort(), DagPath
+  template <typename GR>
+  class TopologicalLevels {
+  public:
+
+    /// The type of the digraph.
+    typedef GR Digraph;
+
+  private:
+
+    TEMPLATE_DIGRAPH_TYPEDEFS(Digraph);
+
+    const Digraph& _digraph;
+    std::vector<Node> _nodes;
+    std::vector<int> _index;
+    std::vector<int> _out_first, _out_adj;
+    std::vector<int> _order, _level_first, _level;
+    bool _dag;
+
+  public:
+
+    /// \brief Constructor.
+    ///
+    /// Constructor.
+    /// \param digraph The digraph the algorithm runs on.
+    explicit TopologicalLevels(const Digraph& digraph)
+      : _digraph(digraph), _dag(true) {
+      checkConcept<concepts::Digraph, Digraph>();
+    }
+
+    /// \brief Runs the algorithm.
+    ///
+    /// This function runs the algorithm on the given number of
+    /// threads. The value 0 (the default) stands for the number of
+    /// hardware threads.
+    ///
+    /// \return \c false if the digraph is not acyclic. In this case,
+    /// the levels contain only the nodes that are not reachable from
+    /// any directed cycle.
+    bool run(int threads = 0) {
+      _nodes.clear();
+      _index.assign(_digraph.maxNodeId() + 1, -1);
+      for (NodeIt n(_digraph); n != INVALID; ++n) {
+        _index[_digraph.id(n)] = _nodes.size();
+        _nodes.push_back(n);
+      }
+      bits::buildOutAdjacency(_digraph, _nodes,
+        _dag_path_bits::IdIndexMap<Digraph>(_digraph, _index),
+        _out_first, _out_adj, threads);
+      _dag_path_bits::KahnEngine engine(_out_first, _out_adj, threads);
+      _dag = engine.run(_order, _level_first, _level);
+      return _dag;
+    }
+
+    /// \name Query Functions
+    /// The results of the algorithm can be obtained using these
+    /// functions.\n
+    /// run() must be called before using them.
+
+    ///@{
+
+    /// \brief Checks if the digraph is acyclic.
+    ///
+    /// This function returns \c true if the digraph is acyclic.
+    bool dag() const { return _dag; }
+
+    /// \brief The number of the levels.
+    ///
+    /// This function returns the number of the levels.
+    int levelNum() const { return int(_level_first.size()) - 1; }
+
+    /// \brief The number of the nodes in a level.
+    ///
+    /// This function returns the number of the nodes in the given level.
+    int levelNodeNum(int k) const {
+      return _level_first[k + 1] - _level_first[k];
+    }
+
+    /// \brief A node of a level.
+    ///
+    /// This function returns the <tt>i</tt>th node of the <tt>k</tt>th
+    /// level, where <tt>0 <= i < levelNodeNum(k)</tt>. The order of the
+    /// nodes within a level is not specified.
+    Node levelNode(int k, int i) const {
+      return _nodes[_order[_level_first[k] + i]];
+    }
+
+    /// \brief The level of a node.
+    ///
+    /// This function returns the level of the given node, or -1 if it
+    /// is reachable from a directed cycle.
+    int level(const Node& v) const {
+      return _level[_index[_digraph.id(v)]];
+    }
+
+    /// \brief The number of the ordered nodes.
+    ///
+    /// This function returns the number of the nodes in the
+    /// topological order, which is the number of the nodes if the
+    /// digraph is acyclic.
+    int orderNodeNum() const { return _order.size(); }
+
+    /// \brief A node of the topological order.
+    ///
+    /// This function returns the <tt>i</tt>th node of the topological
+    /// order, where <tt>0 <= i < orderNodeNum()</tt>.
+    Node orderNode(int i) const { return _nodes[_order[i]]; }
+
+    /// \brief Writes the topological order into a node map.
+    ///
+    /// This function sets the value of each ordered node in the given
+    /// writable \c int node map to its position in the topological
+    /// order. The value of each ordered node is set exactly once,
+    /// the other nodes are not changed.
+    template <typename NodeMap>
+    void orderMap(NodeMap& map) const {
+      for (int i = 0; i < int(_order.size()); ++i) {
+        map.set(_nodes[_order[i]], i);
+      }
+    }
+
+    /// \brief Writes the levels into a node map.
+    ///
+    /// This function sets the value of each node in the given writable
+    /// \c int node map to its level (-1 for the nodes that are
+    /// reachable from a directed cycle). The value of each node is set
+    /// exactly once.
+    template <typename NodeMap>
+    void levelMap(NodeMap& map) const {
+      for (int i = 0; i < int(_nodes.size()); ++i) {
+        map.set(_nodes[i], _level[i]);
+      }
+    }
+
+    ///@}
+
+  private:
+
+    // The internal representation used by DagPath
+
+    template <typename, typename> friend class DagPath;
+
+    const std::vector<Node>& indexNodes() const { return _nodes; }
+    const std::vector<int>& nodeIndex() const { return _index; }
+    const std::vector<int>& indexOrder() const { return _order; }
+    const std::vector<int>& levelFirst() const { return _level_first; }
+  };
+
+  /// \ingroup graph_properties
+  ///
+  /// \brief Sort the nodes of a DAG into topological order in parallel.
+  ///
+  /// This function sorts the nodes of the given acyclic digraph (DAG)
+  /// into topological order using Kahn's algorithm on several threads,
+  /// and it also checks whether the digraph is acyclic. The nodes of
+  /// the same level of \ref TopologicalLevels get consecutive
+  /// positions, and their order is not specified.
+  ///
+  /// \param digraph The digraph.
+  /// \retval order A writable node map. The values will be set from 0 to
+  /// the number of the nodes in the digraph minus one. Each value of the
+  /// map will be set exactly once.
+  /// \param threads The number of threads. The value 0 (the default)
+  /// stands for the number of hardware threads.
+  /// \return \c false if the digraph is not acyclic. In this case, the
+  /// map is set only for the nodes that are not reachable from any
+  /// directed cycle.
+  ///
+  /// \see checkedTopologicalSort(), TopologicalLevels
+  template <typename Digraph, typename NodeMap>
+  bool parallelTopologicalSort(const Digraph& digraph, NodeMap& order,
+                               int threads = 0) {
+    checkConcept<concepts::WriteMap<typename Digraph::Node, int>,
+      NodeMap>();
+    TopologicalLevels<Digraph> levels(digraph);
+    bool dag = levels.run(threads);
+    levels.orderMap(order);
+    return dag;
+  }
+
+  /// \ingroup shortest_path
+  ///
+  /// \brief Shortest and longest paths in acyclic digraphs.
+  ///
+  /// This class computes shortest or longest paths from a set of
+  /// source nodes in an acyclic digraph (DAG) with arbitrary arc
+  /// lengths. The nodes are processed along the levels of the
+  /// digraph computed by \ref TopologicalLevels: the distance of each
+  /// node is computed from the distances of its in-neighbors, which
+  /// are on lower levels, so the nodes of a level are processed in
+  /// parallel. The algorithm runs in \f$O(n+m)\f$ time, and it does
+  /// not use heaps or atomic operations on the distances.
+  ///
+  /// The longest paths from all nodes (see \ref run()) give the
+  /// critical path values of a project scheduling network, i.e.
+  /// the earliest start times of the tasks.
+  ///
+  /// The level sets are available via \ref levels(), so later
+  /// per-level computations can be parallelized the same way.
+  ///
+  /// \tparam GR The type of the digraph.
+  /// \tparam LEN A \ref concepts::ReadMap "readable" arc map that
+  /// specifies the lengths of the arcs. The default map type is
+  /// \ref concepts::Digraph::ArcMap "GR::ArcMap<int>".
+#ifdef DOXYGEN
+  template <typename GR, typename LEN>
+#else
+  template <typename GR,
+            typename LEN = typename GR::template ArcMap<int> >
+#endif
+  class DagPath {
+  public:
+
+    /// The type of the digraph.
+    typedef GR Digraph;
+    /// The type of the arc length map.
+    typedef LEN LengthMap;
+    /// The type of the arc lengths.
+    typedef typename LengthMap::Value Value;
+    /// The type of the paths.
+    typedef lemon::Path<Digraph> Path;
+
+  private:
+
+    TEMPLATE_DIGRAPH_TYPEDEFS(Digraph);
+
+    const Digraph& _digraph;
+    const LengthMap& _length;
+    int _threads;
+    bool _longest;
+
+    TopologicalLevels<Digraph> _levels;
+    std::vector<int> _in_first, _in_adj;
+    std::vector<Arc> _in_arc;
+
+    std::vector<Value> _dist;
+    std::vector<Arc> _pred;
+    std::vector<char> _reached, _source;
+
+  public:
+
+    /// \brief Constructor.
+    ///
+    /// Constructor.
+    /// \param digraph The digraph the algorithm runs on.
+    /// \param length The length map of the arcs.
+    DagPath(const Digraph& digraph, const LengthMap& length)
+      : _digraph(digraph), _length(length), _threads(0),
+        _longest(false), _levels(digraph) {}
+
+    /// \brief Sets the number of threads.
+    ///
+    /// This function sets the number of threads. The value 0 (the
+    /// default) stands for the number of hardware threads.
+    /// \return <tt>(*this)</tt>
+    DagPath& threads(int num) {
+      _threads = num;
+      return *this;
+    }
+
+    /// \brief Sets the objective.
+    ///
+    /// This function sets whether shortest (the default) or longest
+    /// paths are searched.
+    /// \return <tt>(*this)</tt>
+    DagPath& longest(bool b = true) {
+      _longest = b;
+      return *this;
+    }
+
+    /// \name Execution Control
+    /// The simplest way to execute the algorithm is to use one of the
+    /// member functions called \ref run(Node) "run()".\n
+    /// If you need better control on the execution, you have to call
+    /// \ref init() first, then you can add source nodes with
+    /// \ref addSource(). Finally the actual path computation can be
+    /// performed with \ref start().
+
+    ///@{
+
+    /// \brief Initializes the internal data structures.
+    ///
+    /// Initializes the internal data structures and computes the
+    /// topological levels of the digraph.
+    /// \return \c false if the digraph is not acyclic.
+    bool init() {
+      bool dag = _levels.run(_threads);
+      const std::vector<Node>& nodes = _levels.indexNodes();
+      int n = nodes.size();
+      bits::buildInAdjacency(_digraph, nodes,
+        _dag_path_bits::IdIndexMap<Digraph>(_digraph, _levels.nodeIndex()),
+        _in_first, _in_adj, _threads, &_in_arc);
+      _dist.assign(n, Value(0));
+      _pred.assign(n, INVALID);
+      _reached.assign(n, 0);
+      _source.assign(n, 0);
+      return dag;
+    }
+
+    /// \brief Adds a new source node.
+    ///
+    /// This function adds a new source node with the given initial
+    /// distance.
+    void addSource(const Node& s, const Value& dst = Value(0)) {
+      int i = index(s);
+      if (!_source[i] ||
+          (_longest ? _dist[i] < dst : dst < _dist[i])) {
+        _dist[i] = dst;
+      }
+      _source[i] = 1;
+      _reached[i] = 1;
+    }
+
+    /// \brief Executes the algorithm.
+    ///
+    /// Executes the algorithm: the nodes are processed level by level,
+    /// the nodes of each level in parallel.
+    ///
+    /// \pre init() must be called and at least one source node should
+    /// be added with addSource() before using this function.
+    /// \return \c false if the digraph is not acyclic. In this case,
+    /// only the nodes that are not reachable from any directed cycle
+    /// are processed.
+    bool start() {
+      const std::vector<int>& level_first = _levels.levelFirst();
+      for (int k = 0; k + 1 < int(level_first.size()); ++k) {
+        RelaxTask task(*this, level_first[k]);
+        bits::parallelFor(_threads, 0, level_first[k + 1] - level_first[k],
+                          task, 1024);
+      }
+      return _levels.dag();
+    }
+
+    /// \brief Runs the algorithm from the given source node.
+    ///
+    /// This function runs the algorithm from the given source node.
+    ///
+    /// \note <tt>p.run(s)</tt> is just a shortcut of the following code.
+    /// \code
+    ///   p.init();
+    ///   p.addSource(s);
+    ///   p.start();
+    /// \endcode
+    /// \return \c false if the digraph is not acyclic.
+    bool run(const Node& s) {
+      init();
+      addSource(s);
+      return start();
+    }
+
+    /// \brief Runs the algorithm from all nodes.
+    ///
+    /// This function runs the algorithm considering all nodes as
+    /// source nodes with zero distance. In longest path mode, this
+    /// gives the length of the longest path ending at each node,
+    /// i.e. the critical path values.
+    /// \return \c false if the digraph is not acyclic.
+    bool run() {
+      init();
+      for (NodeIt n(_digraph); n != INVALID; ++n) addSource(n);
+      return start();
+    }
+
+    ///@}
+
+    /// \name Query Functions
+    /// The results of the algorithm can be obtained using these
+    /// functions.\n
+    /// The algorithm should be executed before using them.
+
+    ///@{
+
+    /// \brief The topological levels of the digraph.
+    ///
+    /// This function returns a const reference to the
+    /// \ref TopologicalLevels "topological levels" of the digraph.
+    const TopologicalLevels<Digraph>& levels() const { return _levels; }
+
+    /// \brief The distance of a node from the sources.
+    ///
+    /// This function returns the length of the shortest (or longest)
+    /// path from the sources to the given node.
+    /// \pre The node must be reached.
+    Value dist(const Node& v) const { return _dist[index(v)]; }
+
+    /// \brief Checks if a node is reached from the sources.
+    ///
+    /// This function returns \c true if the given node is reachable
+    /// from the sources.
+    bool reached(const Node& v) const { return _reached[index(v)] != 0; }
+
+    /// \brief The last arc of the path to a node.
+    ///
+    /// This function returns the last arc of the found path to the
+    /// given node, or \c INVALID if it is not reached or the path
+    /// consists of the node only. The latter holds for the source
+    /// nodes whose initial distance is not improved by a path from
+    /// another source node.
+    Arc predArc(const Node& v) const { return _pred[index(v)]; }
+
+    /// \brief The previous node on the path to a node.
+    ///
+    /// This function returns the previous node on the found path to
+    /// the given node, or \c INVALID if \ref predArc() is \c INVALID.
+    Node predNode(const Node& v) const {
+      Arc a = _pred[index(v)];
+      return a == INVALID ? INVALID : _digraph.source(a);
+    }
+
+    /// \brief The path to a node.
+    ///
+    /// This function returns the found path to the given node.
+    /// \pre The node must be reached.
+    Path path(const Node& t) const {
+      Path p;
+      for (Arc a = predArc(t); a != INVALID; a = predArc(_digraph.source(a))) {
+        p.addFront(a);
+      }
+      return p;
+    }
+
+    /// \brief Writes the distances into a node map.
+    ///
+    /// This function sets the value of each reached node in the given
+    /// writable node map to its distance. The other nodes are not
+    /// changed.
+    template <typename NodeMap>
+    void distMap(NodeMap& map) const {
+      const std::vector<Node>& nodes = _levels.indexNodes();
+      for (int i = 0; i < int(nodes.size()); ++i) {
+        if (_reached[i]) map.set(nodes[i], _dist[i]);
+      }
+    }
+
+    /// \brief Writes the predecessor arcs into a node map.
+    ///
+    /// This function sets the value of each node in the given writable
+    /// node map to its predecessor arc (see \ref predArc()).
+    template <typename NodeMap>
+    void predMap(NodeMap& map) const {
+      const std::vector<Node>& nodes = _levels.indexNodes();
+      for (int i = 0; i < int(nodes.size()); ++i) {
+        map.set(nodes[i], _pred[i]);
+      }
+    }
+
+    ///@}
+
+  private:
+
+    // Processes the nodes of the current level
+    class RelaxTask {
+    public:
+      RelaxTask(DagPath& alg, int first) : _alg(alg), _first(first) {}
+
+      void operator()(int first, int last) {
+        const std::vector<int>& order = _alg._levels.indexOrder();
+        for (int i = _first + first; i < _first + last; ++i) {
+          _alg.relax(order[i]);
+        }
+      }
+
+    private:
+      DagPath& _alg;
+      int _first;
+    };
+
+    friend class RelaxTask;
+
+    void relax(int v) {
+      bool reached = _source[v] != 0;
+      Value dist = _dist[v];
+      Arc pred = INVALID;
+      for (int j = _in_first[v]; j < _in_first[v + 1]; ++j) {
+        int u = _in_adj[j];
+        if (!_reached[u]) continue;
+        Value d = _dist[u] + _length[_in_arc[j]];
+        if (!reached || (_longest ? dist < d : d < dist)) {
+          dist = d;
+          pred = _in_arc[j];
+          reached = true;
+        }
+      }
+      _dist[v] = dist;
+      _pred[v] = pred;
+      _reached[v] = reached ? 1 : 0;
+    }
+
+    int index(const Node& v) const {
+      return _levels.nodeIndex()[_digraph.id(v)];
+    }
+
+  };
+
+} //namespace lemon
+
+#endif //LEMON_DAG_PATH_H
@@ -26,6 +26,7 @@
 #include <limits>
 #include <lemon/list_graph.h>
 #include <lemon/bin_heap.h>
+#include <lemon/monotone_bucket_heap.h>
 #include <lemon/bits/path_dump.h>
 #include <lemon/core.h>
 #include <lemon/error.h>
@@ -56,6 +57,26 @@ namespace lemon {
     }
   };
 
+  namespace _dijkstra_bits {
+
+    // Selects the default heap type: MonotoneBucketHeap for integer
+    // lengths of at most 64 bits and BinHeap otherwise.
+    template <typename V, typename CR,
+              bool integer = std::numeric_limits<V>::is_integer &&
+                             (std::numeric_limits<V>::digits > 1) &&
+                             (std::numeric_limits<V>::digits +
+                              std::numeric_limits<V>::is_signed <= 64)>
+    struct DefaultHeapSelector {
+      typedef BinHeap<V, CR, std::less<V> > Heap;
+    };
+
+    template <typename V, typename CR>
+    struct DefaultHeapSelector<V, CR, true> {
+      typedef MonotoneBucketHeap<V, CR> Heap;
+    };
+
+  }
+
   ///Default traits class of Dijkstra class.
 
   ///Default traits class of Dijkstra class.
@@ -98,11 +119,15 @@ namespace lemon {
 
     ///The heap type used by the %Dijkstra algorithm.
 
-    ///The heap type used by the Dijkstra algorithm.
+    ///The heap type used by the Dijkstra algorithm. It is
+    ///\ref MonotoneBucketHeap if the arc lengths are of integer type
+    ///and \ref BinHeap otherwise.
     ///
     ///\sa BinHeap
+    ///\sa MonotoneBucketHeap
     ///\sa Dijkstra
-    typedef BinHeap<typename LEN::Value, HeapCrossRef, std::less<Value> > Heap;
+    typedef typename _dijkstra_bits::
+      DefaultHeapSelector<Value, HeapCrossRef>::Heap Heap;
     ///Instantiates a \c Heap.
 
     ///This function instantiates a \ref Heap.
@@ -964,12 +989,15 @@ namespace lemon {
 
     ///The heap type used by the Dijkstra algorithm.
 
-    ///The heap type used by the Dijkstra algorithm.
+    ///The heap type used by the Dijkstra algorithm. It is
+    ///\ref MonotoneBucketHeap if the arc lengths are of integer type
+    ///and \ref BinHeap otherwise.
     ///
     ///\sa BinHeap
+    ///\sa MonotoneBucketHeap
     ///\sa Dijkstra
-    typedef BinHeap<Value, typename Digraph::template NodeMap<int>,
-                    std::less<Value> > Heap;
+    typedef typename _dijkstra_bits::
+      DefaultHeapSelector<Value, HeapCrossRef>::Heap Heap;
 
     ///Instantiates a \ref Heap.
 
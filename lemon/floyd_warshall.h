@@ -0,0 +1,290 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_FLOYD_WARSHALL_H
+#define LEMON_FLOYD_WARSHALL_H
+
+/// \ingroup shortest_path
+/// \file
+/// \brief Floyd-Warshall algorithm for the all-pairs shortest path problem.
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include <lemon/core.h>
+#include <lemon/maps.h>
+#include <lemon/bits/parallel.h>
+
+namespace lemon {
+
+  namespace _floyd_warshall_bits {
+
+    // The sentinel of the unreachable pairs. For integer types half of
+    // the maximum value is used, so adding a finite distance to it does
+    // not overflow.
+    template <typename V, bool has_inf = std::numeric_limits<V>::has_infinity>
+    struct Infinity {
+      static V value() { return std::numeric_limits<V>::infinity(); }
+    };
+
+    template <typename V>
+    struct Infinity<V, false> {
+      static V value() { return std::numeric_limits<V>::max() / 2; }
+    };
+
+    // Min-plus update of the block [i0..i1) x [j0..j1) through the
+    // nodes [k0..k1). The inner loop runs on contiguous memory without
+    // branches, so it can be vectorized by the compiler.
+    template <typename V>
+    void minPlus(V* d, int n, int i0, int i1, int j0, int j1,
+                 int k0, int k1, V inf) {
+      for (int k = k0; k < k1; ++k) {
+        const V* dk = d + static_cast<long long>(k) * n;
+        for (int i = i0; i < i1; ++i) {
+          V* di = d + static_cast<long long>(i) * n;
+          V dik = di[k];
+          if (dik == inf) continue;
+          for (int j = j0; j < j1; ++j) {
+            V dkj = dk[j];
+            V val = dik + dkj;
+            di[j] = (dkj != inf && val < di[j]) ? val : di[j];
+          }
+        }
+      }
+    }
+
+    // Updates the blocks of the given block rows that are independent
+    // of the current pivot block.
+    template <typename V>
+    class BlockRowTask {
+    public:
+      BlockRowTask(V* d, int n, int block, int kb, V inf)
+        : _d(d), _n(n), _block(block), _kb(kb), _inf(inf) {}
+
+      void operator()(int first, int last) {
+        int k0 = _kb * _block, k1 = std::min(k0 + _block, _n);
+        for (int ib = first; ib < last; ++ib) {
+          if (ib == _kb) continue;
+          int i0 = ib * _block, i1 = std::min(i0 + _block, _n);
+          for (int j0 = 0; j0 < _n; j0 += _block) {
+            if (j0 == k0) continue;
+            minPlus(_d, _n, i0, i1, j0, std::min(j0 + _block, _n),
+                    k0, k1, _inf);
+          }
+        }
+      }
+
+    private:
+      V* _d;
+      int _n, _block, _kb;
+      V _inf;
+    };
+
+  }
+
+  /// \ingroup shortest_path
+  ///
+  /// \brief Floyd-Warshall algorithm for the all-pairs shortest path
+  /// problem.
+  ///
+  /// This class implements the Floyd-Warshall algorithm for finding the
+  /// shortest paths between all pairs of nodes. The arc lengths can be
+  /// either positive or negative, but the digraph should not contain
+  /// directed cycles with negative total length.
+  ///
+  /// The distances are stored in a dense row-major matrix, which is
+  /// processed in square blocks (tiles) to use the cache efficiently.
+  /// The blocks independent of the current pivot block are updated on
+  /// several threads, and the innermost min-plus loop is written so that
+  /// the compiler can vectorize it. The running time is \f$O(n^3)\f$ and
+  /// the memory usage is \f$O(n^2)\f$, so this algorithm is suggested
+  /// for small dense digraphs. For sparse digraphs, consider to use
+  /// \ref Johnson instead.
+  ///
+  /// For integer length types the distances must be less than half of
+  /// the maximum value of the type in absolute value.
+  ///
+  /// \tparam GR The type of the digraph the algorithm runs on.
+  /// \tparam LEN A \ref concepts::ReadMap "readable" arc map that specifies
+  /// the lengths of the arcs. The default map type is
+  /// \ref concepts::Digraph::ArcMap "GR::ArcMap<int>".
+#ifdef DOXYGEN
+  template <typename GR, typename LEN>
+#else
+  template <typename GR,
+            typename LEN = typename GR::template ArcMap<int> >
+#endif
+  class FloydWarshall {
+  public:
+
+    /// The type of the digraph.
+    typedef GR Digraph;
+    /// The type of the map that stores the arc lengths.
+    typedef LEN LengthMap;
+    /// The type of the arc lengths.
+    typedef typename LengthMap::Value Value;
+
+  private:
+
+    TEMPLATE_DIGRAPH_TYPEDEFS(Digraph);
+
+    const Digraph& _graph;
+    const LengthMap& _length;
+
+    IntNodeMap _index;
+    int _node_num;
+    std::vector<Value> _matrix;
+    int _thread_num;
+    int _block;
+
+    static Value inf() {
+      return _floyd_warshall_bits::Infinity<Value>::value();
+    }
+
+  public:
+
+    /// \brief Constructor.
+    ///
+    /// Constructor.
+    /// \param graph The digraph the algorithm runs on.
+    /// \param length The length map used by the algorithm.
+    FloydWarshall(const Digraph& graph, const LengthMap& length)
+      : _graph(graph), _length(length), _index(graph), _node_num(0),
+        _thread_num(0), _block(64) {}
+
+    /// \brief Sets the number of threads.
+    ///
+    /// Sets the number of threads. The value 0 (the default) stands for
+    /// the number of hardware threads.
+    /// \return <tt>(*this)</tt>
+    FloydWarshall& threadNum(int num) {
+      _thread_num = num;
+      return *this;
+    }
+
+    /// \brief Sets the block size.
+    ///
+    /// Sets the size of the square blocks of the matrix processed
+    /// together. The default value is 64.
+    /// \return <tt>(*this)</tt>
+    FloydWarshall& blockSize(int size) {
+      _block = size > 0 ? size : 1;
+      return *this;
+    }
+
+    /// \name Execution Control
+
+    ///@{
+
+    /// \brief Runs the algorithm.
+    ///
+    /// This function runs the algorithm.
+    ///
+    /// \return \c false if the digraph contains a directed cycle with
+    /// negative total length. In this case the computation is stopped
+    /// and the distances are undefined.
+    bool run() {
+      using _floyd_warshall_bits::minPlus;
+      const int n = countNodes(_graph);
+      _node_num = n;
+      int i = 0;
+      for (NodeIt v(_graph); v != INVALID; ++v) {
+        _index[v] = i++;
+      }
+      const Value infinity = inf();
+      _matrix.assign(static_cast<long long>(n) * n, infinity);
+      if (n == 0) return true;
+      Value* d = &_matrix[0];
+      for (int k = 0; k < n; ++k) {
+        d[static_cast<long long>(k) * n + k] = 0;
+      }
+      for (ArcIt a(_graph); a != INVALID; ++a) {
+        Value& val = d[static_cast<long long>(_index[_graph.source(a)]) * n +
+                       _index[_graph.target(a)]];
+        if (_length[a] < val) val = _length[a];
+      }
+
+      const int block = _block;
+      const int blocks = (n + block - 1) / block;
+      for (int kb = 0; kb < blocks; ++kb) {
+        int k0 = kb * block, k1 = std::min(k0 + block, n);
+        // Pivot block
+        minPlus(d, n, k0, k1, k0, k1, k0, k1, infinity);
+        for (int k = k0; k < k1; ++k) {
+          if (d[static_cast<long long>(k) * n + k] < 0) return false;
+        }
+        // Pivot row and pivot column
+        for (int b0 = 0; b0 < n; b0 += block) {
+          if (b0 == k0) continue;
+          int b1 = std::min(b0 + block, n);
+          minPlus(d, n, k0, k1, b0, b1, k0, k1, infinity);
+          minPlus(d, n, b0, b1, k0, k1, k0, k1, infinity);
+        }
+        // Remaining blocks
+        _floyd_warshall_bits::BlockRowTask<Value>
+          task(d, n, block, kb, infinity);
+        bits::parallelFor(_thread_num, 0, blocks, task, 1);
+      }
+      for (int k = 0; k < n; ++k) {
+        if (d[static_cast<long long>(k) * n + k] < 0) return false;
+      }
+      return true;
+    }
+
+    ///@}
+
+    /// \name Query Functions
+    /// The results of the algorithm can be obtained using these
+    /// functions.\n
+    /// \ref run() must be called before using them.
+
+    ///@{
+
+    /// \brief The index of the given node.
+    ///
+    /// This function returns the index of the given node in the
+    /// distance matrix, which is in the range <tt>[0..n-1]</tt>.
+    int index(const Node& node) const {
+      return _index[node];
+    }
+
+    /// \brief The distance between two nodes.
+    ///
+    /// This function returns the distance from \c s to \c t.
+    ///
+    /// \pre \c t must be reachable from \c s.
+    Value dist(const Node& s, const Node& t) const {
+      return _matrix[static_cast<long long>(_index[s]) * _node_num +
+                     _index[t]];
+    }
+
+    /// \brief Checks if a node is reachable from another node.
+    ///
+    /// This function returns \c true if \c t is reachable from \c s.
+    bool reached(const Node& s, const Node& t) const {
+      return dist(s, t) != inf();
+    }
+
+    ///@}
+
+  };
+
+} //END OF NAMESPACE LEMON
+
+#endif //LEMON_FLOYD_WARSHALL_H
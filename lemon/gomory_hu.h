@@ -20,9 +20,16 @@
 #define LEMON_GOMORY_HU_TREE_H
 
 #include <limits>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <algorithm>
 
 #include <lemon/core.h>
+#include <lemon/error.h>
 #include <lemon/preflow.h>
+#include <lemon/tolerance.h>
+#include <lemon/bits/parallel.h>
 #include <lemon/concept_check.h>
 #include <lemon/concepts/maps.h>
 
@@ -32,6 +39,152 @@
 
 namespace lemon {
 
+  namespace _gomory_hu_bits {
+
+    // The undirected graph in CSR format: each edge is represented by
+    // two opposite arcs, both having the capacity of the edge.
+    template <typename V>
+    struct CutNetwork {
+      std::vector<int> first, target, rev;
+      std::vector<V> cap;
+    };
+
+    // A minimum cut computation with its own working arrays (Dinic's
+    // algorithm). The arrays are allocated at the first use and reused
+    // by the subsequent cuts, only the residual capacities are reset.
+    // A workspace does not use graph maps, so the workspaces of
+    // different threads can run concurrently on the same network.
+    template <typename V>
+    class CutWorkspace {
+    public:
+
+      CutWorkspace() : _net(0) {}
+
+      void network(const CutNetwork<V>& net) { _net = &net; }
+
+      // Computes a minimum s-t cut, its value is returned and the nodes
+      // of the source side are stored in the given vector
+      V minCut(int s, int t, std::vector<int>& side) {
+        const CutNetwork<V>& net = *_net;
+        int n = int(net.first.size()) - 1;
+        _res = net.cap;
+        _level.resize(n);
+        _it.resize(n);
+        V flow = 0;
+        while (bfs(s, t)) {
+          for (int v = 0; v < n; ++v) _it[v] = net.first[v];
+          flow += augment(s, t);
+        }
+        side.clear();
+        for (int i = 0; i < int(_queue.size()); ++i) {
+          side.push_back(_queue[i]);
+        }
+        return flow;
+      }
+
+    private:
+
+      // Builds the level graph, returns false if t is not reachable.
+      // The last search (which does not reach t) leaves the source side
+      // of the minimum cut in the queue.
+      bool bfs(int s, int t) {
+        const CutNetwork<V>& net = *_net;
+        std::fill(_level.begin(), _level.end(), -1);
+        _queue.clear();
+        _level[s] = 0;
+        _queue.push_back(s);
+        for (int i = 0; i < int(_queue.size()); ++i) {
+          int v = _queue[i];
+          for (int j = net.first[v]; j < net.first[v + 1]; ++j) {
+            int w = net.target[j];
+            if (_level[w] == -1 && _tolerance.positive(_res[j])) {
+              _level[w] = _level[v] + 1;
+              _queue.push_back(w);
+            }
+          }
+        }
+        return _level[t] != -1;
+      }
+
+      // Finds a blocking flow in the level graph with an iterative
+      // depth-first search
+      V augment(int s, int t) {
+        const CutNetwork<V>& net = *_net;
+        V flow = 0;
+        int v = s;
+        _path.clear();
+        while (true) {
+          if (v == t) {
+            V delta = _res[_path[0]];
+            for (int i = 1; i < int(_path.size()); ++i) {
+              if (_res[_path[i]] < delta) delta = _res[_path[i]];
+            }
+            for (int i = 0; i < int(_path.size()); ++i) {
+              _res[_path[i]] -= delta;
+              _res[net.rev[_path[i]]] += delta;
+            }
+            flow += delta;
+            _path.clear();
+            v = s;
+            continue;
+          }
+          int &j = _it[v];
+          while (j < net.first[v + 1] &&
+                 !(_tolerance.positive(_res[j]) &&
+                   _level[net.target[j]] == _level[v] + 1)) ++j;
+          if (j < net.first[v + 1]) {
+            _path.push_back(j);
+            v = net.target[j];
+          } else {
+            _level[v] = -1;
+            if (_path.empty()) break;
+            v = net.target[net.rev[_path.back()]];
+            _path.pop_back();
+            ++_it[v];
+          }
+        }
+        return flow;
+      }
+
+      const CutNetwork<V>* _net;
+      Tolerance<V> _tolerance;
+      std::vector<V> _res;
+      std::vector<int> _level, _it, _queue, _path;
+    };
+
+    // Computes a batch of independent cuts, each thread takes the next
+    // cut of the batch using an atomic counter
+    template <typename V>
+    class CutBatchTask {
+    public:
+
+      CutBatchTask(std::vector<CutWorkspace<V> >& workspaces,
+                   const std::vector<int>& source,
+                   const std::vector<int>& target,
+                   std::vector<V>& value,
+                   std::vector<std::vector<int> >& side)
+        : _workspaces(workspaces), _source(source), _target(target),
+          _value(value), _side(side), _next(0) {}
+
+      void operator()(int id) {
+        int k;
+        while ((k = bits::atomicFetchAdd(&_next, 1)) < int(_source.size())) {
+          _value[k] = _workspaces[id].minCut(_source[k], _target[k],
+                                             _side[k]);
+        }
+      }
+
+    private:
+      std::vector<CutWorkspace<V> >& _workspaces;
+      const std::vector<int>& _source;
+      const std::vector<int>& _target;
+      std::vector<V>& _value;
+      std::vector<std::vector<int> >& _side;
+      int _next;
+    };
+
+  }
+
   /// \ingroup min_cut
   ///
   /// \brief Gomory-Hu cut tree algorithm
@@ -54,6 +207,9 @@ namespace lemon {
   /// the minimum cut and the minimum cut value between any two nodes
   /// in the graph. You can also list (iterate on) the nodes and the
   /// edges of the cuts using \c MinCutNodeIt and \c MinCutEdgeIt.
+  /// The tree can be saved with \c writeTree() and loaded with
+  /// \c readTree(), and \ref GomoryHuIndex answers the minimum cut
+  /// value queries in constant time.
   ///
   /// \tparam GR The type of the undirected graph the algorithm runs on.
   /// \tparam CAP The type of the edge map containing the capacities.
@@ -177,6 +333,11 @@ namespace lemon {
         }
       }
 
+      computeOrder();
+    }
+
+    // Compute the depth of the nodes in the tree
+    void computeOrder() {
       (*_order)[_root] = 0;
       int index = 1;
 
@@ -208,6 +369,201 @@ namespace lemon {
       start();
     }
 
+    /// \brief Run the Gomory-Hu algorithm on several threads.
+    ///
+    /// This function runs the Gomory-Hu algorithm (Gusfield's variant)
+    /// on the given number of threads. The value 0 (the default)
+    /// stands for the number of hardware threads.
+    ///
+    /// The graph is copied into a compact adjacency array format, and
+    /// each thread computes minimum cuts in its own workspace with
+    /// Dinic's algorithm, reusing its working arrays for the
+    /// subsequent cuts. The cuts of the next few nodes are computed
+    /// concurrently with respect to the current tree, then they are
+    /// applied to the tree in the original order. If the tree
+    /// neighbor of a node has been changed by an earlier cut of the
+    /// same batch, its cut is recomputed in the next batch, thus the
+    /// result is a valid Gomory-Hu tree, but it may differ from the
+    /// one found by \ref run().
+    void runParallel(int threads = 0) {
+      init();
+
+      std::vector<Node> nodes;
+      std::vector<int> index(_graph.maxNodeId() + 1, -1);
+      for (NodeIt n(_graph); n != INVALID; ++n) {
+        index[_graph.id(n)] = nodes.size();
+        nodes.push_back(n);
+      }
+      int n = nodes.size();
+      if (n == 0) return;
+
+      // Build the network
+      _gomory_hu_bits::CutNetwork<Value> net;
+      net.first.assign(n + 1, 0);
+      for (EdgeIt e(_graph); e != INVALID; ++e) {
+        int u = index[_graph.id(_graph.u(e))];
+        int v = index[_graph.id(_graph.v(e))];
+        if (u == v) continue;
+        ++net.first[u];
+        ++net.first[v];
+      }
+      for (int i = 0, k = 0; i <= n; ++i) {
+        int d = net.first[i];
+        net.first[i] = k;
+        k += d;
+      }
+      std::vector<int> pos(net.first.begin(), net.first.end() - 1);
+      net.target.resize(net.first[n]);
+      net.rev.resize(net.first[n]);
+      net.cap.resize(net.first[n]);
+      for (EdgeIt e(_graph); e != INVALID; ++e) {
+        int u = index[_graph.id(_graph.u(e))];
+        int v = index[_graph.id(_graph.v(e))];
+        if (u == v) continue;
+        int a = pos[u]++, b = pos[v]++;
+        net.target[a] = v;
+        net.target[b] = u;
+        net.rev[a] = b;
+        net.rev[b] = a;
+        net.cap[a] = net.cap[b] = _capacity[e];
+      }
+
+      // The tree is stored in index based arrays, the root is node 0
+      std::vector<int> pred(n, 0);
+      std::vector<Value> weight(n);
+      pred[0] = -1;
+
+      threads = bits::parallelThreadNum(threads, n, 1);
+      std::vector<_gomory_hu_bits::CutWorkspace<Value> > workspaces(threads);
+      for (int i = 0; i < threads; ++i) workspaces[i].network(net);
+
+      std::vector<int> pending, batch, target;
+      for (int i = n - 1; i > 0; --i) pending.push_back(i);
+      std::vector<Value> value;
+      std::vector<std::vector<int> > side;
+      std::vector<int> mark(n, -1);
+
+      while (!pending.empty()) {
+        int size = std::min(int(pending.size()),
+                            threads == 1 ? 1 : 2 * threads);
+        batch.clear();
+        target.clear();
+        for (int i = 0; i < size; ++i) {
+          batch.push_back(pending.back());
+          target.push_back(pred[pending.back()]);
+          pending.pop_back();
+        }
+        value.resize(size);
+        side.resize(size);
+        _gomory_hu_bits::CutBatchTask<Value>
+          task(workspaces, batch, target, value, side);
+        bits::parallelRun(std::min(threads, size), task);
+
+        std::vector<int> retry;
+        for (int k = 0; k < size; ++k) {
+          int s = batch[k], t = target[k];
+          if (pred[s] != t) {
+            retry.push_back(s);
+            continue;
+          }
+          for (int i = 0; i < int(side[k].size()); ++i) mark[side[k][i]] = k;
+          weight[s] = value[k];
+          for (int i = 0; i < int(side[k].size()); ++i) {
+            int v = side[k][i];
+            if (v != s && pred[v] == t) pred[v] = s;
+          }
+          if (pred[t] != -1 && mark[pred[t]] == k) {
+            pred[s] = pred[t];
+            pred[t] = s;
+            weight[s] = weight[t];
+            weight[t] = value[k];
+          }
+          for (int i = 0; i < int(side[k].size()); ++i) mark[side[k][i]] = -1;
+        }
+        while (!retry.empty()) {
+          pending.push_back(retry.back());
+          retry.pop_back();
+        }
+      }
+
+      for (int i = 0; i < n; ++i) {
+        (*_pred)[nodes[i]] = pred[i] == -1 ? INVALID : nodes[pred[i]];
+        if (i != 0) (*_weight)[nodes[i]] = weight[i];
+      }
+      computeOrder();
+    }
+
+    /// \brief Read a Gomory-Hu tree from a stream.
+    ///
+    /// This function restores a Gomory-Hu tree that was saved by
+    /// \ref writeTree(), so the query functions can be used without
+    /// running the algorithm again. The graph must have the same
+    /// nodes (in the same order of \c NodeIt) as the graph for which
+    /// the tree was written. The capacities are not read and not used.
+    ///
+    /// \exception FormatError If the input is not a valid tree of
+    /// the nodes of the graph.
+    void readTree(std::istream& is) {
+      std::string header;
+      int n;
+      if (!(is >> header) || header != "@gomory_hu") {
+        throw FormatError("Missing @gomory_hu section");
+      }
+      if (!(is >> n) || n != countNodes(_graph)) {
+        throw FormatError("Wrong number of nodes");
+      }
+
+      std::vector<int> pred(n);
+      std::vector<Value> weight(n);
+      int root = -1;
+      for (int i = 0; i < n; ++i) {
+        if (!(is >> pred[i]) || pred[i] < -1 || pred[i] >= n ||
+            pred[i] == i) {
+          throw FormatError("Invalid predecessor");
+        }
+        if (pred[i] == -1) {
+          if (root != -1) throw FormatError("Multiple roots");
+          root = i;
+        } else if (!(is >> weight[i])) {
+          throw FormatError("Invalid weight");
+        }
+      }
+      if (n > 0 && root == -1) throw FormatError("Missing root");
+
+      // Check that the predecessor links do not form a cycle
+      std::vector<char> state(n, 0);
+      std::vector<int> st;
+      for (int i = 0; i < n; ++i) {
+        int v = i;
+        while (state[v] == 0) {
+          state[v] = 1;
+          st.push_back(v);
+          if (pred[v] == -1) break;
+          v = pred[v];
+        }
+        if (state[v] == 1 && pred[v] != -1) {
+          throw FormatError("Cycle in the tree");
+        }
+        while (!st.empty()) {
+          state[st.back()] = 2;
+          st.pop_back();
+        }
+      }
+
+      createStructures();
+      std::vector<Node> nodes;
+      for (NodeIt v(_graph); v != INVALID; ++v) nodes.push_back(v);
+      for (int i = 0; i < n; ++i) {
+        (*_pred)[nodes[i]] = pred[i] == -1 ? INVALID : nodes[pred[i]];
+        (*_weight)[nodes[i]] = pred[i] == -1 ?
+          std::numeric_limits<Value>::max() : weight[i];
+        (*_order)[nodes[i]] = -1;
+      }
+      if (n == 0) return;
+      _root = nodes[root];
+      computeOrder();
+    }
+
     /// @}
 
     ///\name Query Functions
@@ -344,6 +700,37 @@ namespace lemon {
       return value;
     }
 
+    /// \brief Write the Gomory-Hu tree to a stream.
+    ///
+    /// This function writes the Gomory-Hu tree to the given stream in
+    /// a compact text format, which can be loaded by \ref readTree().
+    /// It consists of a \c \@gomory_hu header, the number of the nodes,
+    /// then a line for each node in the order of \c NodeIt: the index
+    /// of its predecessor and the weight of the predecessor edge, or
+    /// \c -1 for the root. Floating-point weights are written with
+    /// full precision.
+    ///
+    /// \pre \ref run() must be called before using this function.
+    void writeTree(std::ostream& os) const {
+      std::vector<int> index(_graph.maxNodeId() + 1, -1);
+      int n = 0;
+      for (NodeIt v(_graph); v != INVALID; ++v) {
+        index[_graph.id(v)] = n++;
+      }
+      std::streamsize prec =
+        os.precision(std::numeric_limits<Value>::digits10 + 2);
+      os << "@gomory_hu\n" << n << '\n';
+      for (NodeIt v(_graph); v != INVALID; ++v) {
+        Node p = (*_pred)[v];
+        if (p == INVALID) {
+          os << -1 << '\n';
+        } else {
+          os << index[_graph.id(p)] << ' ' << (*_weight)[v] << '\n';
+        }
+      }
+      os.precision(prec);
+    }
+
     ///@}
 
     friend class MinCutNodeIt;
@@ -563,6 +950,178 @@ namespace lemon {
 
   };
 
+  /// \ingroup min_cut
+  ///
+  /// \brief Constant time minimum cut queries on a Gomory-Hu tree.
+  ///
+  /// This class preprocesses a Gomory-Hu tree to answer minimum cut
+  /// value queries between any two nodes in constant time, while
+  /// \ref GomoryHu::minCutValue() "GomoryHu::minCutValue()" walks
+  /// along the tree path.
+  ///
+  /// The tree edges are merged in decreasing order of their weights
+  /// (like in Kruskal's algorithm), and the node lists of the merged
+  /// components are concatenated. The weight of the merging edge is
+  /// stored between the last node of the first list and the first
+  /// node of the second one. In the resulting node sequence, the
+  /// minimum cut value between two nodes is the minimum of the values
+  /// stored between them (i.e. this is a Cartesian tree of the tree
+  /// edges), which is obtained with a sparse table in \f$O(1)\f$ time.
+  /// The preprocessing takes \f$O(n\log n)\f$ time and space.
+  ///
+  /// The index can be built from any object providing the
+  /// \c predNode() and \c predValue() functions of \ref GomoryHu,
+  /// for example, from a tree loaded with
+  /// \ref GomoryHu::readTree() "GomoryHu::readTree()".
+  ///
+  /// \tparam GR The type of the undirected graph.
+  /// \tparam V The value type of the cuts. The default type is \c int.
+  template <typename GR, typename V = int>
+  class GomoryHuIndex {
+  public:
+
+    /// The graph type of the algorithm
+    typedef GR Graph;
+    /// The value type of the cuts
+    typedef V Value;
+
+  private:
+
+    TEMPLATE_GRAPH_TYPEDEFS(Graph);
+
+    const Graph& _graph;
+
+    // The position of each node (by its id) in the node sequence
+    std::vector<int> _pos;
+    // The sparse table: level k contains the minimum of the values
+    // in the ranges of length 2^k
+    std::vector<std::vector<Value> > _table;
+    std::vector<int> _log;
+
+    int find(std::vector<int>& parent, int i) const {
+      while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+      }
+      return i;
+    }
+
+    class WeightLess {
+    public:
+      WeightLess(const std::vector<Value>& weight) : _weight(weight) {}
+      bool operator()(int a, int b) const {
+        return _weight[b] < _weight[a] ||
+          (!(_weight[a] < _weight[b]) && a < b);
+      }
+    private:
+      const std::vector<Value>& _weight;
+    };
+
+  public:
+
+    /// \brief Constructor
+    ///
+    /// Constructor.
+    /// \param graph The undirected graph of the Gomory-Hu tree.
+    GomoryHuIndex(const Graph& graph) : _graph(graph) {}
+
+    /// \brief Build the index.
+    ///
+    /// This function builds the index for the given Gomory-Hu tree.
+    /// It has to be called again if the tree is changed.
+    ///
+    /// \param gh A \ref GomoryHu instance (or any class with the same
+    /// \c predNode() and \c predValue() functions) on the graph,
+    /// for which \c run() or \c readTree() has been called.
+    template <typename GH>
+    void build(const GH& gh) {
+      std::vector<Node> nodes;
+      _pos.assign(_graph.maxNodeId() + 1, -1);
+      for (NodeIt n(_graph); n != INVALID; ++n) {
+        _pos[_graph.id(n)] = nodes.size();
+        nodes.push_back(n);
+      }
+      int n = nodes.size();
+
+      std::vector<int> pred(n), edges;
+      std::vector<Value> weight(n);
+      for (int i = 0; i < n; ++i) {
+        Node p = gh.predNode(nodes[i]);
+        if (p == INVALID) {
+          pred[i] = -1;
+        } else {
+          pred[i] = _pos[_graph.id(p)];
+          weight[i] = gh.predValue(nodes[i]);
+          edges.push_back(i);
+        }
+      }
+      std::sort(edges.begin(), edges.end(), WeightLess(weight));
+
+      // Merge the components along the edges, concatenating their
+      // node lists (union by size with path halving)
+      std::vector<int> parent(n), size(n, 1), head(n), tail(n);
+      std::vector<int> next(n, -1);
+      std::vector<Value> gap(n);
+      for (int i = 0; i < n; ++i) {
+        parent[i] = head[i] = tail[i] = i;
+      }
+      for (int k = 0; k < int(edges.size()); ++k) {
+        int a = find(parent, edges[k]), b = find(parent, pred[edges[k]]);
+        next[tail[a]] = head[b];
+        gap[tail[a]] = weight[edges[k]];
+        int h = head[a], t = tail[b];
+        if (size[a] < size[b]) std::swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+        head[a] = h;
+        tail[a] = t;
+      }
+
+      // Lay out the node sequence
+      _table.assign(1, std::vector<Value>());
+      if (n == 0) return;
+      int v = head[find(parent, 0)];
+      for (int i = 0; i < n; ++i) {
+        _pos[_graph.id(nodes[v])] = i;
+        if (i + 1 < n) _table[0].push_back(gap[v]);
+        v = next[v];
+      }
+
+      _log.assign(n + 1, 0);
+      for (int i = 2; i <= n; ++i) _log[i] = _log[i / 2] + 1;
+      _table.resize(_log[n - 1] + 1);
+      for (int k = 1; k < int(_table.size()); ++k) {
+        const std::vector<Value>& prev = _table[k - 1];
+        int len = n - (1 << k);
+        _table[k].resize(len);
+        for (int i = 0; i < len; ++i) {
+          const Value& x = prev[i];
+          const Value& y = prev[i + (1 << (k - 1))];
+          _table[k][i] = y < x ? y : x;
+        }
+      }
+    }
+
+    /// \brief Return the minimum cut value between two nodes
+    ///
+    /// This function returns the minimum cut value between the nodes
+    /// \c s and \c t in constant time. If the two nodes are the same,
+    /// it returns the largest value of the value type, like
+    /// \ref GomoryHu::minCutValue() "GomoryHu::minCutValue()".
+    ///
+    /// \pre \ref build() must be called before using this function.
+    Value minCutValue(const Node& s, const Node& t) const {
+      int i = _pos[_graph.id(s)], j = _pos[_graph.id(t)];
+      if (i == j) return std::numeric_limits<Value>::max();
+      if (j < i) std::swap(i, j);
+      int k = _log[j - i];
+      const Value& x = _table[k][i];
+      const Value& y = _table[k][j - (1 << k)];
+      return y < x ? y : x;
+    }
+
+  };
+
 }
 
 #endif
@@ -30,6 +30,7 @@
 #include <lemon/path.h>
 #include <lemon/tolerance.h>
 #include <lemon/connectivity.h>
+#include <lemon/bits/parallel.h>
 
 namespace lemon {
 
@@ -90,6 +91,329 @@ namespace lemon {
   };
 
 
+  namespace _howard_bits {
+
+    // Finds the strongly connected components of the digraph, and
+    // collects the nodes and the incoming arcs inside each component.
+    // It is shared by HowardMmc and HowardMrc.
+    template <typename GR, typename CompMap, typename ArcListMap>
+    int findComponents(const GR& gr, CompMap& comp,
+                       std::vector<std::vector<typename GR::Node> >& nodes,
+                       ArcListMap& in_arcs) {
+      typedef typename GR::NodeIt NodeIt;
+      typedef typename GR::InArcIt InArcIt;
+      int comp_num = stronglyConnectedComponents(gr, comp);
+      nodes.resize(comp_num);
+      if (comp_num == 1) {
+        nodes[0].clear();
+        for (NodeIt n(gr); n != INVALID; ++n) {
+          nodes[0].push_back(n);
+          in_arcs[n].clear();
+          for (InArcIt a(gr, n); a != INVALID; ++a) {
+            in_arcs[n].push_back(a);
+          }
+        }
+      } else {
+        for (int i = 0; i < comp_num; ++i)
+          nodes[i].clear();
+        for (NodeIt n(gr); n != INVALID; ++n) {
+          int k = comp[n];
+          nodes[k].push_back(n);
+          in_arcs[n].clear();
+          for (InArcIt a(gr, n); a != INVALID; ++a) {
+            if (comp[gr.source(a)] == k) in_arcs[n].push_back(a);
+          }
+        }
+      }
+      return comp_num;
+    }
+
+    // The strongly connected components in compact adjacency array
+    // (CSR) format for the parallel variant of the algorithm. The
+    // nodes are indexed by components, and the arcs (inside the
+    // components) are stored by their targets. The working arrays of
+    // the components are disjoint, so different components can be
+    // processed concurrently.
+    template <typename LC, typename TOL>
+    struct HowardData {
+      std::vector<int> comp_first;
+      std::vector<int> in_first, in_source, in_target;
+      std::vector<LC> in_cost;
+      std::vector<int> out_first, out_arc;
+
+      std::vector<int> policy, next_policy, mark, parent;
+      std::vector<LC> dist, next_dist;
+
+      const TOL* tolerance;
+    };
+
+    // Policy iteration in one component. The policy evaluation (two
+    // reverse BFS searches) and the policy improvement sweep run on the
+    // given number of threads by parallelFor() calling
+    // operator()(first, last) according to the current phase. The
+    // searches process the levels synchronously, and a node attached
+    // to the policy graph by several arcs selects the first one, so
+    // the result does not depend on the number of threads.
+    template <typename LC, typename TOL>
+    class HowardSolver {
+    public:
+
+      HowardSolver(HowardData<LC, TOL>& data, int threads)
+        : _data(data), _threads(threads) {}
+
+      // Solves the component [first, last) and returns the number of
+      // iterations
+      int solve(int first, int last, int limit) {
+        _first = first;
+        _last = last;
+        found = false;
+        limited = false;
+        int n = last - first;
+        if (n == 0 || _data.in_first[last] == _data.in_first[first]) {
+          return 0;
+        }
+        _queue.resize(n);
+
+        runPhase(INIT, _first, _last);
+        int iter = 0;
+        while (true) {
+          ++iter;
+          findPolicyCycle();
+          evaluate();
+          _improved = 0;
+          runPhase(IMPROVE, _first, _last);
+          if (!_improved) break;
+          if (iter >= limit) {
+            limited = true;
+            break;
+          }
+          runPhase(UPDATE, _first, _last);
+        }
+        return iter;
+      }
+
+      void operator()(int first, int last) {
+        HowardData<LC, TOL>& d = _data;
+        switch (_phase) {
+        case INIT:
+          for (int u = first; u < last; ++u) {
+            int best = -1;
+            for (int k = d.out_first[u]; k < d.out_first[u + 1]; ++k) {
+              int p = d.out_arc[k];
+              if (best == -1 || d.in_cost[p] < d.in_cost[best]) best = p;
+            }
+            d.policy[u] = best;
+            d.mark[u] = -1;
+            d.parent[u] = std::numeric_limits<int>::max();
+          }
+          break;
+        case CLEAR:
+          for (int u = first; u < last; ++u) d.mark[u] = -1;
+          break;
+        case TREE:
+          for (int i = first; i < last; ++i) {
+            int v = _queue[i];
+            for (int p = d.in_first[v]; p < d.in_first[v + 1]; ++p) {
+              int u = d.in_source[p];
+              if (d.policy[u] == p && d.mark[u] == -1) {
+                d.mark[u] = _level;
+                d.dist[u] = d.dist[v] + d.in_cost[p] * _size - _cost;
+                _queue[bits::atomicFetchAdd(&_qback, 1)] = u;
+              }
+            }
+          }
+          break;
+        case ATTACH:
+          for (int i = first; i < last; ++i) {
+            int v = _queue[i];
+            for (int p = d.in_first[v]; p < d.in_first[v + 1]; ++p) {
+              int u = d.in_source[p];
+              if (bits::atomicLoad(&d.mark[u]) >= 0) continue;
+              bits::atomicMin(&d.parent[u], p);
+              if (bits::atomicCompareAndSwap(&d.mark[u], -1, -2)) {
+                _queue[bits::atomicFetchAdd(&_qback, 1)] = u;
+              }
+            }
+          }
+          break;
+        case ATTACH_SET:
+          for (int i = first; i < last; ++i) {
+            int u = _queue[i];
+            int p = d.parent[u];
+            d.parent[u] = std::numeric_limits<int>::max();
+            d.policy[u] = p;
+            d.mark[u] = _level;
+            d.dist[u] = d.dist[d.in_target[p]] + d.in_cost[p] * _size - _cost;
+          }
+          break;
+        case IMPROVE:
+          {
+            bool improved = false;
+            for (int u = first; u < last; ++u) {
+              LC best = d.dist[u];
+              int pol = d.policy[u];
+              for (int k = d.out_first[u]; k < d.out_first[u + 1]; ++k) {
+                int p = d.out_arc[k];
+                LC delta = d.dist[d.in_target[p]] +
+                  d.in_cost[p] * _size - _cost;
+                if (d.tolerance->less(delta, best)) {
+                  best = delta;
+                  pol = p;
+                  improved = true;
+                }
+              }
+              d.next_dist[u] = best;
+              d.next_policy[u] = pol;
+            }
+            if (improved) bits::atomicStore(&_improved, 1);
+          }
+          break;
+        case UPDATE:
+          for (int u = first; u < last; ++u) {
+            d.dist[u] = d.next_dist[u];
+            d.policy[u] = d.next_policy[u];
+          }
+          break;
+        }
+      }
+
+      // The minimum mean cycle of the policy graph found in the
+      // last iteration
+      bool found, limited;
+      LC cost;
+      int size, node;
+
+    private:
+
+      enum { INIT, CLEAR, TREE, ATTACH, ATTACH_SET, IMPROVE, UPDATE };
+
+      void runPhase(int phase, int first, int last) {
+        _phase = phase;
+        bits::parallelFor(_threads, first, last, *this);
+      }
+
+      // Finds the cycles of the policy graph (sequentially, it takes
+      // linear time)
+      void findPolicyCycle() {
+        HowardData<LC, TOL>& d = _data;
+        for (int u = _first; u < _last; ++u) d.mark[u] = -1;
+        found = false;
+        for (int i = _first; i < _last; ++i) {
+          int u = i;
+          if (d.mark[u] >= 0) continue;
+          for (; d.mark[u] < 0; u = d.in_target[d.policy[u]]) {
+            d.mark[u] = i;
+          }
+          if (d.mark[u] == i) {
+            LC ccost = d.in_cost[d.policy[u]];
+            int csize = 1;
+            for (int v = d.in_target[d.policy[u]]; v != u;
+                 v = d.in_target[d.policy[v]]) {
+              ccost += d.in_cost[d.policy[v]];
+              ++csize;
+            }
+            if (!found || ccost * size < cost * csize) {
+              found = true;
+              cost = ccost;
+              size = csize;
+              node = u;
+            }
+          }
+        }
+      }
+
+      // Computes the node distances with respect to the minimum mean
+      // cycle using two reverse BFS searches like the sequential
+      // algorithm, but processing each level on several threads. The
+      // second search attaches the nodes not reaching the cycle to the
+      // policy graph.
+      void evaluate() {
+        HowardData<LC, TOL>& d = _data;
+        _cost = cost;
+        _size = size;
+        runPhase(CLEAR, _first, _last);
+        d.mark[node] = 0;
+        d.dist[node] = 0;
+        _queue[0] = node;
+        _qback = 1;
+        _level = 0;
+        int qfront = 0;
+        while (qfront < _qback) {
+          int qlast = _qback;
+          ++_level;
+          runPhase(TREE, qfront, qlast);
+          qfront = qlast;
+        }
+        qfront = 0;
+        while (qfront < _qback && _qback < _last - _first) {
+          int qlast = _qback;
+          ++_level;
+          runPhase(ATTACH, qfront, qlast);
+          runPhase(ATTACH_SET, qlast, _qback);
+          qfront = qlast;
+        }
+      }
+
+      HowardData<LC, TOL>& _data;
+      int _threads;
+      int _phase;
+      int _first, _last;
+
+      LC _cost;
+      int _size;
+      int _level;
+      std::vector<int> _queue;
+      int _qback;
+      int _improved;
+    };
+
+    // Processes the small components on several threads, each
+    // component on a single thread
+    template <typename LC, typename TOL>
+    class HowardDispatcher {
+    public:
+
+      HowardDispatcher(HowardData<LC, TOL>& data,
+                       const std::vector<int>& comps, int limit,
+                       std::vector<int>& iter, std::vector<char>& found,
+                       std::vector<char>& limited, std::vector<LC>& cost,
+                       std::vector<int>& size, std::vector<int>& node)
+        : _data(data), _comps(comps), _limit(limit), _iter(iter),
+          _found(found), _limited(limited), _cost(cost), _size(size),
+          _node(node), _next(0) {}
+
+      void operator()(int) {
+        HowardSolver<LC, TOL> solver(_data, 1);
+        int i;
+        while ((i = bits::atomicFetchAdd(&_next, 1)) < int(_comps.size())) {
+          int k = _comps[i];
+          _iter[k] = solver.solve(_data.comp_first[k],
+                                  _data.comp_first[k + 1], _limit);
+          _found[k] = solver.found;
+          _limited[k] = solver.limited;
+          if (solver.found) {
+            _cost[k] = solver.cost;
+            _size[k] = solver.size;
+            _node[k] = solver.node;
+          }
+        }
+      }
+
+    private:
+      HowardData<LC, TOL>& _data;
+      const std::vector<int>& _comps;
+      int _limit;
+      std::vector<int>& _iter;
+      std::vector<char>& _found;
+      std::vector<char>& _limited;
+      std::vector<LC>& _cost;
+      std::vector<int>& _size;
+      std::vector<int>& _node;
+      int _next;
+    };
+
+  }
+
   /// \addtogroup min_mean_cycle
   /// @{
 
@@ -103,6 +427,13 @@ namespace lemon {
   /// minimum mean cycle problem, though the best known theoretical
   /// bound on its running time is exponential.
   ///
+  /// The algorithm can also run on several threads (see \ref threads()).
+  /// In this case, the strongly connected components are processed
+  /// concurrently, and the policy evaluation and improvement steps
+  /// are also parallelized within the large components.
+  /// The number of iterations performed in each component can be
+  /// obtained using \ref iterationNum().
+  ///
   /// \tparam GR The type of the digraph the algorithm runs on.
   /// \tparam CM The type of the cost map. The default
   /// map type is \ref concepts::Digraph::ArcMap "GR::ArcMap<int>".
@@ -201,6 +532,10 @@ namespace lemon {
     std::vector<Node> _queue;
     int _qfront, _qback;
 
+    // The number of iterations performed in the components
+    std::vector<int> _comp_iter;
+    int _threads;
+
     Tolerance _tolerance;
 
     // Infinite constant
@@ -265,7 +600,7 @@ namespace lemon {
       _gr(digraph), _cost(cost), _best_found(false),
       _best_cost(0), _best_size(1), _cycle_path(NULL), _local_path(false),
       _policy(digraph), _reached(digraph), _level(digraph), _dist(digraph),
-      _comp(digraph), _in_arcs(digraph),
+      _comp(digraph), _in_arcs(digraph), _threads(1),
       INF(std::numeric_limits<LargeCost>::has_infinity ?
           std::numeric_limits<LargeCost>::infinity() :
           std::numeric_limits<LargeCost>::max())
@@ -317,6 +652,25 @@ namespace lemon {
       return _tolerance;
     }
 
+    /// \brief Set the number of threads.
+    ///
+    /// This function sets the number of threads used by the algorithm.
+    /// The value 0 stands for the number of hardware threads.
+    /// By default, the algorithm runs on a single thread.
+    ///
+    /// If more threads are used, the small strongly connected
+    /// components are processed concurrently (each of them on a single
+    /// thread), while the policy evaluation and improvement steps
+    /// are parallelized within the components having more than 4096
+    /// nodes. The found minimum cycle mean does not depend on the
+    /// number of threads.
+    ///
+    /// \return <tt>(*this)</tt>
+    HowardMmc& threads(int num) {
+      _threads = num;
+      return *this;
+    }
+
     /// \name Execution control
     /// The simplest way to execute the algorithm is to call the \ref run()
     /// function.\n
@@ -358,14 +712,20 @@ namespace lemon {
     /// \param limit  The maximum allowed number of iterations during
     /// the search process. Its default value implies that the algorithm
     /// runs until it finds the exact optimal solution.
+    /// If more than one thread is used (see \ref threads()), the
+    /// components are processed independently, so this limit is
+    /// applied to each component separately.
     ///
     /// \return The termination cause of the search process.
     /// For more information, see \ref TerminationCause.
     TerminationCause findCycleMean(int limit =
                                    std::numeric_limits<int>::max()) {
+      if (_threads != 1) return findCycleMeanParallel(limit);
+
       // Initialize and find strongly connected components
       init();
       findComponents();
+      _comp_iter.assign(_comp_num, 0);
 
       // Find the minimum cycle mean in the components
       int iter_count = 0;
@@ -378,6 +738,7 @@ namespace lemon {
             iter_limit_reached = true;
             break;
           }
+          ++_comp_iter[comp];
           findPolicyCycle();
           if (!computeNodeDistances()) break;
         }
@@ -475,6 +836,42 @@ namespace lemon {
       return *_cycle_path;
     }
 
+    /// \brief Return the number of strongly connected components.
+    ///
+    /// This function returns the number of strongly connected components
+    /// of the digraph.
+    ///
+    /// \pre \ref run() or \ref findCycleMean() must be called before
+    /// using this function.
+    int componentNum() const {
+      return _comp_num;
+    }
+
+    /// \brief Return the strongly connected component of a node.
+    ///
+    /// This function returns the index of the strongly connected
+    /// component containing the given node. The components are
+    /// indexed from 0 to <tt>componentNum()-1</tt>.
+    ///
+    /// \pre \ref run() or \ref findCycleMean() must be called before
+    /// using this function.
+    int component(const Node& node) const {
+      return _comp[node];
+    }
+
+    /// \brief Return the number of iterations in a component.
+    ///
+    /// This function returns the number of policy iterations performed
+    /// in the given strongly connected component. It is 0 for the
+    /// components without arcs (and for the components that were not
+    /// processed due to the iteration limit).
+    ///
+    /// \pre \ref run() or \ref findCycleMean() must be called before
+    /// using this function.
+    int iterationNum(int comp) const {
+      return _comp_iter[comp];
+    }
+
     ///@}
 
   private:
@@ -495,29 +892,131 @@ namespace lemon {
     // Find strongly connected components and initialize _comp_nodes
     // and _in_arcs
     void findComponents() {
-      _comp_num = stronglyConnectedComponents(_gr, _comp);
-      _comp_nodes.resize(_comp_num);
-      if (_comp_num == 1) {
-        _comp_nodes[0].clear();
-        for (NodeIt n(_gr); n != INVALID; ++n) {
-          _comp_nodes[0].push_back(n);
-          _in_arcs[n].clear();
-          for (InArcIt a(_gr, n); a != INVALID; ++a) {
-            _in_arcs[n].push_back(a);
-          }
+      _comp_num = _howard_bits::findComponents(_gr, _comp, _comp_nodes,
+                                               _in_arcs);
+    }
+
+    // Find the minimum cycle mean on several threads
+    TerminationCause findCycleMeanParallel(int limit) {
+      typedef _howard_bits::HowardData<LargeCost, Tolerance> Data;
+      typedef _howard_bits::HowardSolver<LargeCost, Tolerance> Solver;
+      typedef _howard_bits::HowardDispatcher<LargeCost, Tolerance>
+        Dispatcher;
+      const int GRAIN = 4096;
+
+      init();
+      _comp_num = parallelStronglyConnectedComponents(_gr, _comp, _threads);
+
+      // Index the nodes by components (_level is used as the index map)
+      Data data;
+      data.tolerance = &_tolerance;
+      std::vector<int>& comp_first = data.comp_first;
+      comp_first.assign(_comp_num + 1, 0);
+      for (NodeIt n(_gr); n != INVALID; ++n) {
+        ++comp_first[_comp[n] + 1];
+      }
+      for (int k = 0; k < _comp_num; ++k) {
+        comp_first[k + 1] += comp_first[k];
+      }
+      int node_num = comp_first[_comp_num];
+      std::vector<int> pos(comp_first.begin(), comp_first.end() - 1);
+      std::vector<Node> nodes(node_num);
+      for (NodeIt n(_gr); n != INVALID; ++n) {
+        int i = pos[_comp[n]]++;
+        _level[n] = i;
+        nodes[i] = n;
+      }
+
+      // Build the arc lists of the components
+      std::vector<Arc> arcs;
+      data.in_first.resize(node_num + 1);
+      data.in_first[0] = 0;
+      for (int i = 0; i < node_num; ++i) {
+        Node v = nodes[i];
+        for (InArcIt a(_gr, v); a != INVALID; ++a) {
+          Node u = _gr.source(a);
+          if (_comp[u] != _comp[v]) continue;
+          data.in_source.push_back(_level[u]);
+          data.in_target.push_back(i);
+          data.in_cost.push_back(_cost[a]);
+          arcs.push_back(a);
         }
-      } else {
-        for (int i = 0; i < _comp_num; ++i)
-          _comp_nodes[i].clear();
-        for (NodeIt n(_gr); n != INVALID; ++n) {
-          int k = _comp[n];
-          _comp_nodes[k].push_back(n);
-          _in_arcs[n].clear();
-          for (InArcIt a(_gr, n); a != INVALID; ++a) {
-            if (_comp[_gr.source(a)] == k) _in_arcs[n].push_back(a);
-          }
+        data.in_first[i + 1] = arcs.size();
+      }
+      int arc_num = arcs.size();
+      data.out_first.assign(node_num + 1, 0);
+      for (int p = 0; p < arc_num; ++p) {
+        ++data.out_first[data.in_source[p] + 1];
+      }
+      for (int i = 0; i < node_num; ++i) {
+        data.out_first[i + 1] += data.out_first[i];
+      }
+      data.out_arc.resize(arc_num);
+      pos.assign(data.out_first.begin(), data.out_first.end() - 1);
+      for (int p = 0; p < arc_num; ++p) {
+        data.out_arc[pos[data.in_source[p]]++] = p;
+      }
+
+      data.policy.resize(node_num);
+      data.next_policy.resize(node_num);
+      data.mark.resize(node_num);
+      data.parent.resize(node_num);
+      data.dist.resize(node_num);
+      data.next_dist.resize(node_num);
+
+      // Process the large components one by one using all threads,
+      // and the small components concurrently
+      _comp_iter.assign(_comp_num, 0);
+      std::vector<char> found(_comp_num, false), limited(_comp_num, false);
+      std::vector<LargeCost> cost(_comp_num);
+      std::vector<int> size(_comp_num), node(_comp_num);
+      std::vector<int> small;
+      Solver solver(data, _threads);
+      for (int k = 0; k < _comp_num; ++k) {
+        if (comp_first[k + 1] - comp_first[k] <= GRAIN) {
+          small.push_back(k);
+          continue;
+        }
+        _comp_iter[k] = solver.solve(comp_first[k], comp_first[k + 1], limit);
+        found[k] = solver.found;
+        limited[k] = solver.limited;
+        if (solver.found) {
+          cost[k] = solver.cost;
+          size[k] = solver.size;
+          node[k] = solver.node;
         }
       }
+      Dispatcher dispatcher(data, small, limit, _comp_iter,
+                            found, limited, cost, size, node);
+      bits::parallelRun(bits::parallelThreadNum(_threads, small.size(), 1),
+                        dispatcher);
+
+      // Select the best cycle
+      bool iter_limit_reached = false;
+      int best_comp = -1;
+      for (int k = 0; k < _comp_num; ++k) {
+        if (limited[k]) iter_limit_reached = true;
+        if ( found[k] && (!_best_found ||
+             cost[k] * _best_size < _best_cost * size[k]) ) {
+          _best_found = true;
+          _best_cost = cost[k];
+          _best_size = size[k];
+          _best_node = nodes[node[k]];
+          best_comp = k;
+        }
+      }
+      if (_best_found) {
+        for (int i = comp_first[best_comp];
+             i < comp_first[best_comp + 1]; ++i) {
+          _policy[nodes[i]] = arcs[data.policy[i]];
+        }
+      }
+
+      if (iter_limit_reached) {
+        return ITERATION_LIMIT;
+      } else {
+        return _best_found ? OPTIMAL : NO_CYCLE;
+      }
     }
 
     // Build the policy graph in the given strongly connected component
@@ -0,0 +1,696 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_HOWARD_MRC_H
+#define LEMON_HOWARD_MRC_H
+
+/// \ingroup min_mean_cycle
+///
+/// \file
+/// \brief Howard's algorithm for finding a minimum ratio cycle.
+
+#include <vector>
+#include <limits>
+#include <lemon/core.h>
+#include <lemon/path.h>
+#include <lemon/tolerance.h>
+#include <lemon/connectivity.h>
+#include <lemon/howard_mmc.h>
+
+namespace lemon {
+
+  /// \brief Default traits class of HowardMrc class.
+  ///
+  /// Default traits class of HowardMrc class.
+  /// \tparam GR The type of the digraph.
+  /// \tparam CM The type of the cost map.
+  /// It must conform to the \ref concepts::ReadMap "ReadMap" concept.
+  /// \tparam TM The type of the transit time map.
+  /// It must conform to the \ref concepts::ReadMap "ReadMap" concept.
+#ifdef DOXYGEN
+  template <typename GR, typename CM, typename TM>
+#else
+  template <typename GR, typename CM, typename TM,
+    bool integer = std::numeric_limits<typename CM::Value>::is_integer &&
+                   std::numeric_limits<typename TM::Value>::is_integer>
+#endif
+  struct HowardMrcDefaultTraits
+  {
+    /// The type of the digraph
+    typedef GR Digraph;
+    /// The type of the cost map
+    typedef CM CostMap;
+    /// The type of the arc costs
+    typedef typename CostMap::Value Cost;
+    /// The type of the transit time map
+    typedef TM TimeMap;
+    /// The type of the transit times
+    typedef typename TimeMap::Value Time;
+
+    /// \brief The large cost type used for internal computations
+    ///
+    /// The large cost type used for internal computations.
+    /// It is \c long \c long if both the \c Cost and the \c Time types
+    /// are integer, otherwise it is \c double.
+    /// \c Cost and \c Time must be convertible to \c LargeCost.
+    typedef double LargeCost;
+
+    /// The tolerance type used for internal computations
+    typedef lemon::Tolerance<LargeCost> Tolerance;
+
+    /// \brief The path type of the found cycles
+    ///
+    /// The path type of the found cycles.
+    /// It must conform to the \ref lemon::concepts::Path "Path" concept
+    /// and it must have an \c addBack() function.
+    typedef lemon::Path<Digraph> Path;
+  };
+
+  // Default traits class for integer cost and time types
+  template <typename GR, typename CM, typename TM>
+  struct HowardMrcDefaultTraits<GR, CM, TM, true>
+  {
+    typedef GR Digraph;
+    typedef CM CostMap;
+    typedef typename CostMap::Value Cost;
+    typedef TM TimeMap;
+    typedef typename TimeMap::Value Time;
+#ifdef LEMON_HAVE_LONG_LONG
+    typedef long long LargeCost;
+#else
+    typedef long LargeCost;
+#endif
+    typedef lemon::Tolerance<LargeCost> Tolerance;
+    typedef lemon::Path<Digraph> Path;
+  };
+
+
+  /// \addtogroup min_mean_cycle
+  /// @{
+
+  /// \brief Implementation of Howard's algorithm for finding a minimum
+  /// ratio cycle.
+  ///
+  /// This class implements Howard's policy iteration algorithm for finding
+  /// a directed cycle of minimum cost-to-time ratio in a digraph
+  /// \cite dasdan04experimental.
+  /// The ratio of a cycle is its total cost divided by its total transit
+  /// time, so the minimum mean cycle problem is the special case of unit
+  /// transit times. In the throughput analysis of dataflow graphs, for
+  /// example, the costs are the execution times and the transit times
+  /// are the numbers of initial tokens on the arcs.
+  ///
+  /// The interface of this class is the same as that of \ref HowardMmc,
+  /// except that the functions are named after the ratio instead of the
+  /// mean (e.g. \ref findCycleRatio(), \ref cycleRatio()) and
+  /// \ref cycleTime() replaces \c cycleSize().
+  ///
+  /// \tparam GR The type of the digraph the algorithm runs on.
+  /// \tparam CM The type of the cost map. The default
+  /// map type is \ref concepts::Digraph::ArcMap "GR::ArcMap<int>".
+  /// \tparam TM The type of the transit time map. The default
+  /// map type is \ref concepts::Digraph::ArcMap "GR::ArcMap<int>".
+  /// \tparam TR The traits class that defines various types used by the
+  /// algorithm. By default, it is \ref HowardMrcDefaultTraits
+  /// "HowardMrcDefaultTraits<GR, CM, TM>".
+  /// In most cases, this parameter should not be set directly,
+  /// consider to use the named template parameters instead.
+  ///
+  /// \warning The transit times must be non-negative, and the total
+  /// transit time of each directed cycle must be positive.
+#ifdef DOXYGEN
+  template <typename GR, typename CM, typename TM, typename TR>
+#else
+  template < typename GR,
+             typename CM = typename GR::template ArcMap<int>,
+             typename TM = typename GR::template ArcMap<int>,
+             typename TR = HowardMrcDefaultTraits<GR, CM, TM> >
+#endif
+  class HowardMrc
+  {
+  public:
+
+    /// The type of the digraph
+    typedef typename TR::Digraph Digraph;
+    /// The type of the cost map
+    typedef typename TR::CostMap CostMap;
+    /// The type of the arc costs
+    typedef typename TR::Cost Cost;
+    /// The type of the transit time map
+    typedef typename TR::TimeMap TimeMap;
+    /// The type of the transit times
+    typedef typename TR::Time Time;
+
+    /// \brief The large cost type
+    ///
+    /// The large cost type used for internal computations.
+    /// By default, it is \c long \c long if both the \c Cost and the
+    /// \c Time types are integer, otherwise it is \c double.
+    typedef typename TR::LargeCost LargeCost;
+
+    /// The tolerance type
+    typedef typename TR::Tolerance Tolerance;
+
+    /// \brief The path type of the found cycles
+    ///
+    /// The path type of the found cycles.
+    /// Using the \ref lemon::HowardMrcDefaultTraits "default traits class",
+    /// it is \ref lemon::Path "Path<Digraph>".
+    typedef typename TR::Path Path;
+
+    /// The \ref lemon::HowardMrcDefaultTraits "traits class" of the algorithm
+    typedef TR Traits;
+
+    /// \brief Constants for the causes of search termination.
+    ///
+    /// Enum type containing constants for the different causes of search
+    /// termination. The \ref findCycleRatio() function returns one of
+    /// these values.
+    enum TerminationCause {
+
+      /// No directed cycle can be found in the digraph.
+      NO_CYCLE = 0,
+
+      /// Optimal solution (minimum cycle ratio) is found.
+      OPTIMAL = 1,
+
+      /// The iteration count limit is reached.
+      ITERATION_LIMIT
+    };
+
+  private:
+
+    TEMPLATE_DIGRAPH_TYPEDEFS(Digraph);
+
+    // The digraph the algorithm runs on
+    const Digraph &_gr;
+    // The cost of the arcs
+    const CostMap &_cost;
+    // The transit time of the arcs
+    const TimeMap &_time;
+
+    // Data for the found cycles
+    bool _curr_found, _best_found;
+    LargeCost _curr_cost, _best_cost;
+    LargeCost _curr_time, _best_time;
+    Node _curr_node, _best_node;
+
+    Path *_cycle_path;
+    bool _local_path;
+
+    // Internal data used by the algorithm
+    typename Digraph::template NodeMap<Arc> _policy;
+    typename Digraph::template NodeMap<bool> _reached;
+    typename Digraph::template NodeMap<int> _level;
+    typename Digraph::template NodeMap<LargeCost> _dist;
+
+    // Data for storing the strongly connected components
+    int _comp_num;
+    typename Digraph::template NodeMap<int> _comp;
+    std::vector<std::vector<Node> > _comp_nodes;
+    std::vector<Node>* _nodes;
+    typename Digraph::template NodeMap<std::vector<Arc> > _in_arcs;
+
+    // Queue used for BFS search
+    std::vector<Node> _queue;
+    int _qfront, _qback;
+
+    // The number of iterations performed
+    int _iter_num;
+
+    Tolerance _tolerance;
+
+    // Infinite constant
+    const LargeCost INF;
+
+  public:
+
+    /// \name Named Template Parameters
+    /// @{
+
+    template <typename T>
+    struct SetLargeCostTraits : public Traits {
+      typedef T LargeCost;
+      typedef lemon::Tolerance<T> Tolerance;
+    };
+
+    /// \brief \ref named-templ-param "Named parameter" for setting
+    /// \c LargeCost type.
+    ///
+    /// \ref named-templ-param "Named parameter" for setting \c LargeCost
+    /// type. It is used for internal computations in the algorithm.
+    template <typename T>
+    struct SetLargeCost
+      : public HowardMrc<GR, CM, TM, SetLargeCostTraits<T> > {
+      typedef HowardMrc<GR, CM, TM, SetLargeCostTraits<T> > Create;
+    };
+
+    template <typename T>
+    struct SetPathTraits : public Traits {
+      typedef T Path;
+    };
+
+    /// \brief \ref named-templ-param "Named parameter" for setting
+    /// \c %Path type.
+    ///
+    /// \ref named-templ-param "Named parameter" for setting the \c %Path
+    /// type of the found cycles.
+    /// It must conform to the \ref lemon::concepts::Path "Path" concept
+    /// and it must have an \c addBack() function.
+    template <typename T>
+    struct SetPath
+      : public HowardMrc<GR, CM, TM, SetPathTraits<T> > {
+      typedef HowardMrc<GR, CM, TM, SetPathTraits<T> > Create;
+    };
+
+    /// @}
+
+  protected:
+
+    HowardMrc() {}
+
+  public:
+
+    /// \brief Constructor.
+    ///
+    /// The constructor of the class.
+    ///
+    /// \param digraph The digraph the algorithm runs on.
+    /// \param cost The costs of the arcs.
+    /// \param time The transit times of the arcs.
+    HowardMrc( const Digraph &digraph,
+               const CostMap &cost,
+               const TimeMap &time ) :
+      _gr(digraph), _cost(cost), _time(time), _best_found(false),
+      _best_cost(0), _best_time(1), _cycle_path(NULL), _local_path(false),
+      _policy(digraph), _reached(digraph), _level(digraph), _dist(digraph),
+      _comp(digraph), _in_arcs(digraph), _iter_num(0),
+      INF(std::numeric_limits<LargeCost>::has_infinity ?
+          std::numeric_limits<LargeCost>::infinity() :
+          std::numeric_limits<LargeCost>::max())
+    {}
+
+    /// Destructor.
+    ~HowardMrc() {
+      if (_local_path) delete _cycle_path;
+    }
+
+    /// \brief Set the path structure for storing the found cycle.
+    ///
+    /// This function sets an external path structure for storing the
+    /// found cycle.
+    ///
+    /// If you don't call this function before calling \ref run() or
+    /// \ref findCycleRatio(), a local \ref Path "path" structure
+    /// will be allocated. The destuctor deallocates this automatically
+    /// allocated object, of course.
+    ///
+    /// \note The algorithm calls only the \ref lemon::Path::addBack()
+    /// "addBack()" function of the given path structure.
+    ///
+    /// \return <tt>(*this)</tt>
+    HowardMrc& cycle(Path &path) {
+      if (_local_path) {
+        delete _cycle_path;
+        _local_path = false;
+      }
+      _cycle_path = &path;
+      return *this;
+    }
+
+    /// \brief Set the tolerance used by the algorithm.
+    ///
+    /// This function sets the tolerance object used by the algorithm.
+    ///
+    /// \return <tt>(*this)</tt>
+    HowardMrc& tolerance(const Tolerance& tolerance) {
+      _tolerance = tolerance;
+      return *this;
+    }
+
+    /// \brief Return a const reference to the tolerance.
+    ///
+    /// This function returns a const reference to the tolerance object
+    /// used by the algorithm.
+    const Tolerance& tolerance() const {
+      return _tolerance;
+    }
+
+    /// \name Execution control
+    /// The simplest way to execute the algorithm is to call the \ref run()
+    /// function.\n
+    /// If you only need the minimum cycle ratio, you may call
+    /// \ref findCycleRatio().
+
+    /// @{
+
+    /// \brief Run the algorithm.
+    ///
+    /// This function runs the algorithm.
+    /// It can be called more than once (e.g. if the underlying digraph
+    /// and/or the arc costs have been modified).
+    ///
+    /// \return \c true if a directed cycle exists in the digraph.
+    ///
+    /// \note <tt>mrc.run()</tt> is just a shortcut of the following code.
+    /// \code
+    ///   return mrc.findCycleRatio() && mrc.findCycle();
+    /// \endcode
+    bool run() {
+      return findCycleRatio() && findCycle();
+    }
+
+    /// \brief Find the minimum cycle ratio (or an upper bound).
+    ///
+    /// This function finds the minimum cost-to-time ratio of the
+    /// directed cycles in the digraph (or an upper bound for it).
+    ///
+    /// By default, the function finds the exact minimum cycle ratio,
+    /// but an optional limit can also be specified for the number of
+    /// iterations performed during the search process.
+    /// The return value indicates if the optimal solution is found
+    /// or the iteration limit is reached. In the latter case, an
+    /// approximate solution is provided, which corresponds to a directed
+    /// cycle whose ratio is relatively small, but not necessarily
+    /// minimal.
+    ///
+    /// \param limit  The maximum allowed number of iterations during
+    /// the search process. Its default value implies that the algorithm
+    /// runs until it finds the exact optimal solution.
+    ///
+    /// \return The termination cause of the search process.
+    /// For more information, see \ref TerminationCause.
+    TerminationCause findCycleRatio(int limit =
+                                    std::numeric_limits<int>::max()) {
+      // Initialize and find strongly connected components
+      init();
+      findComponents();
+
+      // Find the minimum cycle ratio in the components
+      bool iter_limit_reached = false;
+      for (int comp = 0; comp < _comp_num; ++comp) {
+        // Find the minimum ratio cycle in the current component
+        if (!buildPolicyGraph(comp)) continue;
+        while (true) {
+          if (++_iter_num > limit) {
+            --_iter_num;
+            iter_limit_reached = true;
+            break;
+          }
+          findPolicyCycle();
+          if (!computeNodeDistances()) break;
+        }
+
+        // Update the best cycle (global minimum ratio cycle)
+        if ( _curr_found && (!_best_found ||
+             _curr_cost * _best_time < _best_cost * _curr_time) ) {
+          _best_found = true;
+          _best_cost = _curr_cost;
+          _best_time = _curr_time;
+          _best_node = _curr_node;
+        }
+
+        if (iter_limit_reached) break;
+      }
+
+      if (iter_limit_reached) {
+        return ITERATION_LIMIT;
+      } else {
+        return _best_found ? OPTIMAL : NO_CYCLE;
+      }
+    }
+
+    /// \brief Find a minimum ratio directed cycle.
+    ///
+    /// This function finds a directed cycle of minimum cost-to-time
+    /// ratio in the digraph using the data computed by findCycleRatio().
+    ///
+    /// \return \c true if a directed cycle exists in the digraph.
+    ///
+    /// \pre \ref findCycleRatio() must be called before using this
+    /// function.
+    bool findCycle() {
+      if (!_best_found) return false;
+      _cycle_path->addBack(_policy[_best_node]);
+      for ( Node v = _best_node;
+            (v = _gr.target(_policy[v])) != _best_node; ) {
+        _cycle_path->addBack(_policy[v]);
+      }
+      return true;
+    }
+
+    /// @}
+
+    /// \name Query Functions
+    /// The results of the algorithm can be obtained using these
+    /// functions.\n
+    /// The algorithm should be executed before using them.
+
+    /// @{
+
+    /// \brief Return the total cost of the found cycle.
+    ///
+    /// This function returns the total cost of the found cycle.
+    ///
+    /// \pre \ref run() or \ref findCycleRatio() must be called before
+    /// using this function.
+    Cost cycleCost() const {
+      return static_cast<Cost>(_best_cost);
+    }
+
+    /// \brief Return the total transit time of the found cycle.
+    ///
+    /// This function returns the total transit time of the found cycle.
+    ///
+    /// \pre \ref run() or \ref findCycleRatio() must be called before
+    /// using this function.
+    Time cycleTime() const {
+      return static_cast<Time>(_best_time);
+    }
+
+    /// \brief Return the cost-to-time ratio of the found cycle.
+    ///
+    /// This function returns the cost-to-time ratio of the found cycle.
+    ///
+    /// \note <tt>alg.cycleRatio()</tt> is just a shortcut of the
+    /// following code.
+    /// \code
+    ///   return static_cast<double>(alg.cycleCost()) / alg.cycleTime();
+    /// \endcode
+    ///
+    /// \pre \ref run() or \ref findCycleRatio() must be called before
+    /// using this function.
+    double cycleRatio() const {
+      return static_cast<double>(_best_cost) / _best_time;
+    }
+
+    /// \brief Return the found cycle.
+    ///
+    /// This function returns a const reference to the path structure
+    /// storing the found cycle.
+    ///
+    /// \pre \ref run() or \ref findCycle() must be called before using
+    /// this function.
+    const Path& cycle() const {
+      return *_cycle_path;
+    }
+
+    /// \brief Return the number of iterations.
+    ///
+    /// This function returns the total number of policy iterations
+    /// performed in the strongly connected components.
+    ///
+    /// \pre \ref run() or \ref findCycleRatio() must be called before
+    /// using this function.
+    int iterationNum() const {
+      return _iter_num;
+    }
+
+    ///@}
+
+  private:
+
+    // Initialize
+    void init() {
+      if (!_cycle_path) {
+        _local_path = true;
+        _cycle_path = new Path;
+      }
+      _queue.resize(countNodes(_gr));
+      _best_found = false;
+      _best_cost = 0;
+      _best_time = 1;
+      _iter_num = 0;
+      _cycle_path->clear();
+    }
+
+    // Find strongly connected components and initialize _comp_nodes
+    // and _in_arcs
+    void findComponents() {
+      _comp_num = _howard_bits::findComponents(_gr, _comp, _comp_nodes,
+                                               _in_arcs);
+    }
+
+    // Build the policy graph in the given strongly connected component
+    // (the out-degree of every node is 1). The initial policy arcs are
+    // the arcs of minimum cost-to-time ratio, the zero time arcs are
+    // preferred.
+    bool buildPolicyGraph(int comp) {
+      _nodes = &(_comp_nodes[comp]);
+      if (_nodes->size() < 1 ||
+          (_nodes->size() == 1 && _in_arcs[(*_nodes)[0]].size() == 0)) {
+        return false;
+      }
+      for (int i = 0; i < int(_nodes->size()); ++i) {
+        _policy[(*_nodes)[i]] = INVALID;
+      }
+      Node u, v;
+      Arc e;
+      for (int i = 0; i < int(_nodes->size()); ++i) {
+        v = (*_nodes)[i];
+        for (int j = 0; j < int(_in_arcs[v].size()); ++j) {
+          e = _in_arcs[v][j];
+          u = _gr.source(e);
+          if (_policy[u] == INVALID || ratioLess(e, _policy[u])) {
+            _policy[u] = e;
+          }
+        }
+      }
+      return true;
+    }
+
+    // Compare the cost-to-time ratio of two arcs (a zero time arc is
+    // less than the positive time arcs)
+    bool ratioLess(const Arc& a, const Arc& b) const {
+      LargeCost ta = _time[a], tb = _time[b];
+      if (ta == 0 || tb == 0) {
+        return tb != 0 || (ta == 0 &&
+          static_cast<LargeCost>(_cost[a]) < static_cast<LargeCost>(_cost[b]));
+      }
+      return static_cast<LargeCost>(_cost[a]) * tb <
+             static_cast<LargeCost>(_cost[b]) * ta;
+    }
+
+    // Find the minimum ratio cycle in the policy graph
+    void findPolicyCycle() {
+      for (int i = 0; i < int(_nodes->size()); ++i) {
+        _level[(*_nodes)[i]] = -1;
+      }
+      LargeCost ccost, ctime;
+      Node u, v;
+      _curr_found = false;
+      for (int i = 0; i < int(_nodes->size()); ++i) {
+        u = (*_nodes)[i];
+        if (_level[u] >= 0) continue;
+        for (; _level[u] < 0; u = _gr.target(_policy[u])) {
+          _level[u] = i;
+        }
+        if (_level[u] == i) {
+          // A cycle is found
+          ccost = _cost[_policy[u]];
+          ctime = _time[_policy[u]];
+          for (v = u; (v = _gr.target(_policy[v])) != u; ) {
+            ccost += _cost[_policy[v]];
+            ctime += _time[_policy[v]];
+          }
+          if ( !_curr_found ||
+               (ccost * _curr_time < _curr_cost * ctime) ) {
+            _curr_found = true;
+            _curr_cost = ccost;
+            _curr_time = ctime;
+            _curr_node = u;
+          }
+        }
+      }
+    }
+
+    // Contract the policy graph and compute node distances
+    bool computeNodeDistances() {
+      // Find the component of the main cycle and compute node distances
+      // using reverse BFS
+      for (int i = 0; i < int(_nodes->size()); ++i) {
+        _reached[(*_nodes)[i]] = false;
+      }
+      _qfront = _qback = 0;
+      _queue[0] = _curr_node;
+      _reached[_curr_node] = true;
+      _dist[_curr_node] = 0;
+      Node u, v;
+      Arc e;
+      while (_qfront <= _qback) {
+        v = _queue[_qfront++];
+        for (int j = 0; j < int(_in_arcs[v].size()); ++j) {
+          e = _in_arcs[v][j];
+          u = _gr.source(e);
+          if (_policy[u] == e && !_reached[u]) {
+            _reached[u] = true;
+            _dist[u] = _dist[v] + reducedCost(e);
+            _queue[++_qback] = u;
+          }
+        }
+      }
+
+      // Connect all other nodes to this component and compute node
+      // distances using reverse BFS
+      _qfront = 0;
+      while (_qback < int(_nodes->size())-1) {
+        v = _queue[_qfront++];
+        for (int j = 0; j < int(_in_arcs[v].size()); ++j) {
+          e = _in_arcs[v][j];
+          u = _gr.source(e);
+          if (!_reached[u]) {
+            _reached[u] = true;
+            _policy[u] = e;
+            _dist[u] = _dist[v] + reducedCost(e);
+            _queue[++_qback] = u;
+          }
+        }
+      }
+
+      // Improve node distances
+      bool improved = false;
+      for (int i = 0; i < int(_nodes->size()); ++i) {
+        v = (*_nodes)[i];
+        for (int j = 0; j < int(_in_arcs[v].size()); ++j) {
+          e = _in_arcs[v][j];
+          u = _gr.source(e);
+          LargeCost delta = _dist[v] + reducedCost(e);
+          if (_tolerance.less(delta, _dist[u])) {
+            _dist[u] = delta;
+            _policy[u] = e;
+            improved = true;
+          }
+        }
+      }
+      return improved;
+    }
+
+    // The cost of an arc with respect to the current cycle ratio
+    // (multiplied by the transit time of the cycle)
+    LargeCost reducedCost(const Arc& e) const {
+      return static_cast<LargeCost>(_cost[e]) * _curr_time -
+             static_cast<LargeCost>(_time[e]) * _curr_cost;
+    }
+
+  }; //class HowardMrc
+
+  ///@}
+
+} //namespace lemon
+
+#endif //LEMON_HOWARD_MRC_H
@@ -0,0 +1,422 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_JOHNSON_H
+#define LEMON_JOHNSON_H
+
+/// \ingroup shortest_path
+/// \file
+/// \brief Johnson algorithm for the all-pairs shortest path problem.
+
+#include <vector>
+
+#include <lemon/core.h>
+#include <lemon/maps.h>
+#include <lemon/path.h>
+#include <lemon/bellman_ford.h>
+#include <lemon/dijkstra.h>
+#include <lemon/bits/parallel.h>
+
+namespace lemon {
+
+  namespace _johnson_bits {
+
+    // The arc lengths reduced by the node potentials
+    template <typename GR, typename LEN, typename PM>
+    class ReducedLengthMap {
+    public:
+      typedef typename GR::Arc Key;
+      typedef typename LEN::Value Value;
+
+      ReducedLengthMap(const GR& graph, const LEN& length, const PM& pot)
+        : _graph(graph), _length(length), _pot(pot) {}
+
+      Value operator[](const Key& arc) const {
+        return _length[arc] + _pot[_graph.source(arc)] -
+          _pot[_graph.target(arc)];
+      }
+
+    private:
+      const GR& _graph;
+      const LEN& _length;
+      const PM& _pot;
+    };
+
+    template <typename It, typename V>
+    class MatrixOutput {
+    public:
+      MatrixOutput(It matrix, int n) : _matrix(matrix), _n(n) {}
+
+      template <typename Node>
+      void operator()(int s, const Node&, int t, const Node&, bool reached,
+                      const V& dist) {
+        _matrix[static_cast<long long>(s) * _n + t] = reached ?
+          dist : BellmanFordDefaultOperationTraits<V>::infinity();
+      }
+
+    private:
+      It _matrix;
+      int _n;
+    };
+
+    template <typename F, typename V>
+    class VisitOutput {
+    public:
+      VisitOutput(F& visitor) : _visitor(visitor) {}
+
+      template <typename Node>
+      void operator()(int, const Node& s, int, const Node& t, bool reached,
+                      const V& dist) {
+        if (reached) _visitor(s, t, dist);
+      }
+
+    private:
+      F& _visitor;
+    };
+
+    // Runs Dijkstra from the sources taken one by one from a shared
+    // counter, each thread uses its own Dijkstra instance.
+    template <typename GR, typename PM, typename DIJ, typename OUT>
+    class SourceTask {
+    public:
+      typedef typename GR::Node Node;
+      typedef typename PM::Value Value;
+
+      SourceTask(const GR& graph, const std::vector<Node>& nodes,
+                 const PM& pot, std::vector<DIJ*>& dijkstra, OUT& output)
+        : _graph(graph), _nodes(nodes), _pot(pot), _dijkstra(dijkstra),
+          _output(output), _next(0) {}
+
+      void operator()(int id) {
+        DIJ& dijkstra = *_dijkstra[id];
+        int n = _nodes.size();
+        while (true) {
+          int i = bits::atomicFetchAdd(&_next, 1);
+          if (i >= n) break;
+          Node s = _nodes[i];
+          dijkstra.run(s);
+          for (int j = 0; j < n; ++j) {
+            Node t = _nodes[j];
+            bool reached = dijkstra.reached(t);
+            Value dist = reached ?
+              dijkstra.dist(t) - _pot[s] + _pot[t] : Value();
+            _output(i, s, j, t, reached, dist);
+          }
+        }
+      }
+
+    private:
+      const GR& _graph;
+      const std::vector<Node>& _nodes;
+      const PM& _pot;
+      std::vector<DIJ*>& _dijkstra;
+      OUT& _output;
+      int _next;
+    };
+
+  }
+
+  /// \ingroup shortest_path
+  ///
+  /// \brief Johnson algorithm for the all-pairs shortest path problem.
+  ///
+  /// This class implements Johnson's algorithm for finding the
+  /// shortest paths between all pairs of nodes. The arc lengths can be
+  /// either positive or negative, but the digraph should not contain
+  /// directed cycles with negative total length.
+  ///
+  /// First, node potentials are computed by the \ref BellmanFord
+  /// algorithm (started from all nodes with zero distance), which make
+  /// all reduced arc lengths non-negative. Then the \ref Dijkstra
+  /// algorithm is run from each node using the reduced lengths. These
+  /// runs are executed on several threads, each thread having its own
+  /// Dijkstra instance (with its own maps and heap), and the sources are
+  /// distributed among the threads dynamically. The running time is
+  /// \f$O(nm\log n)\f$, so this algorithm is suggested for sparse
+  /// digraphs. For small dense digraphs, consider to use
+  /// \ref FloydWarshall instead.
+  ///
+  /// The distances can be stored in an internal matrix (\ref start()),
+  /// written to a dense matrix provided by the caller
+  /// (\ref start(It)), or passed to a callback function
+  /// (\ref startVisit()), which needs no \f$O(n^2)\f$ memory.
+  /// In the dense matrices the nodes are identified by the indices
+  /// returned by \ref index().
+  ///
+  /// \tparam GR The type of the digraph the algorithm runs on.
+  /// \tparam LEN A \ref concepts::ReadMap "readable" arc map that specifies
+  /// the lengths of the arcs. The default map type is
+  /// \ref concepts::Digraph::ArcMap "GR::ArcMap<int>".
+#ifdef DOXYGEN
+  template <typename GR, typename LEN>
+#else
+  template <typename GR,
+            typename LEN = typename GR::template ArcMap<int> >
+#endif
+  class Johnson {
+  public:
+
+    /// The type of the digraph.
+    typedef GR Digraph;
+    /// The type of the map that stores the arc lengths.
+    typedef LEN LengthMap;
+    /// The type of the arc lengths.
+    typedef typename LengthMap::Value Value;
+    /// The type of the map that stores the node potentials.
+    typedef typename Digraph::template NodeMap<Value> PotentialMap;
+
+  private:
+
+    TEMPLATE_DIGRAPH_TYPEDEFS(Digraph);
+
+    typedef _johnson_bits::ReducedLengthMap<Digraph, LengthMap, PotentialMap>
+    ReducedLengthMap;
+    typedef Dijkstra<Digraph, ReducedLengthMap> DijkstraAlg;
+
+    const Digraph& _graph;
+    const LengthMap& _length;
+
+    PotentialMap _potential;
+    BellmanFord<Digraph, LengthMap> _bf;
+    IntNodeMap _index;
+    std::vector<Node> _nodes;
+    std::vector<Value> _matrix;
+    int _thread_num;
+
+    template <typename Output>
+    void solve(Output& output) {
+      ReducedLengthMap reduced(_graph, _length, _potential);
+      int threads = bits::parallelThreadNum(_thread_num, _nodes.size(), 16);
+      // The maps of the Dijkstra instances are allocated by this thread
+      std::vector<DijkstraAlg*> dijkstra(threads);
+      for (int i = 0; i < threads; ++i) {
+        dijkstra[i] = new DijkstraAlg(_graph, reduced);
+        dijkstra[i]->init();
+      }
+      _johnson_bits::SourceTask<Digraph, PotentialMap, DijkstraAlg, Output>
+        task(_graph, _nodes, _potential, dijkstra, output);
+      bits::parallelRun(threads, task);
+      for (int i = 0; i < threads; ++i) {
+        delete dijkstra[i];
+      }
+    }
+
+  public:
+
+    /// \brief Constructor.
+    ///
+    /// Constructor.
+    /// \param graph The digraph the algorithm runs on.
+    /// \param length The length map used by the algorithm.
+    Johnson(const Digraph& graph, const LengthMap& length)
+      : _graph(graph), _length(length), _potential(graph),
+        _bf(graph, length), _index(graph), _thread_num(0) {}
+
+    /// \brief Sets the number of threads.
+    ///
+    /// Sets the number of threads running the Dijkstra searches.
+    /// The value 0 (the default) stands for the number of hardware
+    /// threads.
+    /// \return <tt>(*this)</tt>
+    Johnson& threadNum(int num) {
+      _thread_num = num;
+      return *this;
+    }
+
+    /// \name Execution Control
+    /// The simplest way to execute the algorithm is to use \ref run().\n
+    /// If you need better control on the execution, you have to call
+    /// \ref init() first, then the distances can be computed with one
+    /// of the \c start() functions.
+
+    ///@{
+
+    /// \brief Initializes the algorithm.
+    ///
+    /// This function computes the node potentials using the
+    /// \ref BellmanFord::spfaStart() "Bellman-Ford" algorithm.
+    ///
+    /// \return \c false if the digraph contains a directed cycle with
+    /// negative total length, which can be obtained using
+    /// \ref negativeCycle().
+    bool init() {
+      _nodes.clear();
+      for (NodeIt n(_graph); n != INVALID; ++n) {
+        _index[n] = _nodes.size();
+        _nodes.push_back(n);
+      }
+      _matrix.clear();
+      _bf.distMap(_potential);
+      _bf.init(0);
+      return _bf.spfaStart();
+    }
+
+    /// \brief Computes the distances into the internal matrix.
+    ///
+    /// This function computes the distances between all pairs of nodes
+    /// and stores them in an internal matrix. Then they can be queried
+    /// using \ref dist() and \ref reached().
+    ///
+    /// \pre \ref init() must be called and it must return \c true
+    /// before using this function.
+    void start() {
+      int n = _nodes.size();
+      _matrix.resize(static_cast<long long>(n) * n);
+      if (n == 0) return;
+      _johnson_bits::MatrixOutput<Value*, Value> output(&_matrix[0], n);
+      solve(output);
+    }
+
+    /// \brief Computes the distances into the given dense matrix.
+    ///
+    /// This function computes the distances between all pairs of nodes
+    /// and writes them to the given row-major matrix, i.e. the distance
+    /// from node \c s to node \c t is written to
+    /// <tt>matrix[index(s) * n + index(t)]</tt>, where \c n is the
+    /// number of nodes. For the unreachable pairs the maximum value
+    /// (or the infinity) of the \c Value type is written. The rows of
+    /// the matrix are written concurrently by several threads.
+    ///
+    /// \param matrix A random access iterator (e.g. a pointer) to a
+    /// matrix having at least \f$n^2\f$ elements.
+    ///
+    /// \pre \ref init() must be called and it must return \c true
+    /// before using this function.
+    template <typename It>
+    void start(It matrix) {
+      _johnson_bits::MatrixOutput<It, Value> output(matrix, _nodes.size());
+      solve(output);
+    }
+
+    /// \brief Computes the distances and passes them to a callback.
+    ///
+    /// This function computes the distances between all pairs of nodes
+    /// and calls <tt>visitor(s, t, dist)</tt> for each pair of nodes
+    /// \c s and \c t such that \c t is reachable from \c s.
+    ///
+    /// \warning The visitor is called concurrently by several threads
+    /// (for different source nodes), so it has to be thread-safe.
+    /// The calls for the same source node are made by the same thread.
+    ///
+    /// \pre \ref init() must be called and it must return \c true
+    /// before using this function.
+    template <typename Visitor>
+    void startVisit(Visitor& visitor) {
+      _johnson_bits::VisitOutput<Visitor, Value> output(visitor);
+      solve(output);
+    }
+
+    /// \brief Runs the algorithm.
+    ///
+    /// This function runs the algorithm and stores the distances in an
+    /// internal matrix.
+    ///
+    /// \return \c false if the digraph contains a directed cycle with
+    /// negative total length.
+    ///
+    /// \note <tt>j.run()</tt> is just a shortcut of the following code.
+    /// \code
+    ///   if (!j.init()) return false;
+    ///   j.start();
+    ///   return true;
+    /// \endcode
+    bool run() {
+      if (!init()) return false;
+      start();
+      return true;
+    }
+
+    ///@}
+
+    /// \name Query Functions
+    /// The results of the algorithm can be obtained using these
+    /// functions.
+
+    ///@{
+
+    /// \brief The index of the given node.
+    ///
+    /// This function returns the index of the given node in the dense
+    /// matrices, which is in the range <tt>[0..n-1]</tt>.
+    ///
+    /// \pre \ref init() must be called before using this function.
+    int index(const Node& node) const {
+      return _index[node];
+    }
+
+    /// \brief The distance between two nodes.
+    ///
+    /// This function returns the distance from \c s to \c t.
+    ///
+    /// \pre \ref run() or \ref start() must be called before using this
+    /// function, and \c t must be reachable from \c s.
+    Value dist(const Node& s, const Node& t) const {
+      return _matrix[static_cast<long long>(_index[s]) * _nodes.size() +
+                     _index[t]];
+    }
+
+    /// \brief Checks if a node is reachable from another node.
+    ///
+    /// This function returns \c true if \c t is reachable from \c s.
+    ///
+    /// \pre \ref run() or \ref start() must be called before using this
+    /// function.
+    bool reached(const Node& s, const Node& t) const {
+      return dist(s, t) != BellmanFordDefaultOperationTraits<Value>::
+        infinity();
+    }
+
+    /// \brief The potential of the given node.
+    ///
+    /// This function returns the potential of the given node computed
+    /// by \ref init(). The reduced length
+    /// <tt>length[a] + potential(source(a)) - potential(target(a))</tt>
+    /// of each arc is non-negative.
+    ///
+    /// \pre \ref init() must be called and it must return \c true
+    /// before using this function.
+    Value potential(const Node& node) const {
+      return _potential[node];
+    }
+
+    /// \brief Returns a const reference to the potential map.
+    ///
+    /// Returns a const reference to the node map storing the potentials.
+    ///
+    /// \pre \ref init() must be called and it must return \c true
+    /// before using this function.
+    const PotentialMap& potentialMap() const {
+      return _potential;
+    }
+
+    /// \brief Gives back a negative cycle.
+    ///
+    /// This function gives back a directed cycle with negative total
+    /// length if \ref init() has found one.
+    /// Otherwise it gives back an empty path.
+    lemon::Path<Digraph> negativeCycle() const {
+      return _bf.negativeCycle();
+    }
+
+    ///@}
+
+  };
+
+} //END OF NAMESPACE LEMON
+
+#endif //LEMON_JOHNSON_H
@@ -0,0 +1,574 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_K_SHORTEST_PATHS_H
+#define LEMON_K_SHORTEST_PATHS_H
+
+///\ingroup shortest_path
+///\file
+///\brief Yen's algorithm for finding the k shortest simple paths.
+
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <queue>
+#include <functional>
+#include <lemon/core.h>
+#include <lemon/bin_heap.h>
+#include <lemon/maps.h>
+#include <lemon/path.h>
+#include <lemon/adaptors.h>
+#include <lemon/dijkstra.h>
+#include <lemon/bits/parallel.h>
+
+namespace lemon {
+
+  namespace _k_shortest_paths_bits {
+
+    // Static adjacency arrays of the digraph and the shortest path tree
+    // towards the target node, shared by the threads. The arcs are
+    // indexed in the order of their source nodes.
+    template <typename V>
+    struct KspData {
+      std::vector<int> out_first, source, target;
+      std::vector<V> length;
+      std::vector<V> dist;
+      std::vector<int> next;
+      std::vector<char> reach;
+      int t;
+    };
+
+    // A spur path search: its parameters and its result
+    template <typename V>
+    struct KspSpur {
+      int index;
+      std::vector<int> banned;
+      bool found;
+      V length;
+      std::vector<int> arcs;
+    };
+
+    // The work arrays of one thread. The spur paths are searched by
+    // A* using the distances to the target node as potentials, so the
+    // reduced lengths of the tree arcs are zero. If the best arc
+    // leaving the spur node is followed by a tree path avoiding the
+    // root nodes, the spur path is obtained without any search.
+    template <typename V>
+    class KspWorkspace {
+    public:
+
+      typedef BinHeap<V, RangeMap<int> > Heap;
+
+      KspWorkspace(const KspData<V>& data)
+        : _data(data), _cross(data.dist.size(), Heap::PRE_HEAP),
+          _heap(_cross), _dist(data.dist.size()),
+          _pred(data.dist.size(), -1), _mark(data.dist.size(), 0),
+          _stamp(0) {}
+
+      // Finds a shortest path from nodes[i] to the target avoiding
+      // nodes[0..i] and the banned arcs leaving nodes[i]
+      void spur(const std::vector<int>& nodes, KspSpur<V>& spur) {
+        const KspData<V>& d = _data;
+        int i = spur.index, v = nodes[i];
+        spur.found = false;
+        spur.arcs.clear();
+        ++_stamp;
+        for (int j = 0; j <= i; ++j) _mark[nodes[j]] = _stamp;
+
+        // Try the tree path after the best arc
+        int best = -1;
+        V best_len = V();
+        for (int a = d.out_first[v]; a < d.out_first[v + 1]; ++a) {
+          int w = d.target[a];
+          if (!allowed(a, w, spur.banned)) continue;
+          V len = d.length[a] + d.dist[w];
+          if (best == -1 || len < best_len) {
+            best = a;
+            best_len = len;
+          }
+        }
+        if (best == -1) return;
+        bool free = true;
+        for (int w = d.target[best]; w != d.t; w = d.target[d.next[w]]) {
+          if (_mark[w] == _stamp) {
+            free = false;
+            break;
+          }
+        }
+        if (free) {
+          spur.found = true;
+          spur.length = best_len;
+          spur.arcs.push_back(best);
+          for (int w = d.target[best]; w != d.t; w = d.target[d.next[w]]) {
+            spur.arcs.push_back(d.next[w]);
+          }
+          return;
+        }
+
+        // A* search
+        _touched.clear();
+        _heap.push(v, d.dist[v]);
+        _dist[v] = 0;
+        _pred[v] = -1;
+        _touched.push_back(v);
+        while (!_heap.empty() && _heap.top() != d.t) {
+          int u = _heap.top();
+          _heap.pop();
+          for (int a = d.out_first[u]; a < d.out_first[u + 1]; ++a) {
+            int w = d.target[a];
+            if (u == v ? !allowed(a, w, spur.banned) :
+                (!d.reach[w] || _mark[w] == _stamp)) continue;
+            V dn = _dist[u] + d.length[a];
+            switch (_heap.state(w)) {
+            case Heap::PRE_HEAP:
+              _heap.push(w, dn + d.dist[w]);
+              _dist[w] = dn;
+              _pred[w] = a;
+              _touched.push_back(w);
+              break;
+            case Heap::IN_HEAP:
+              if (dn + d.dist[w] < _heap[w]) {
+                _heap.decrease(w, dn + d.dist[w]);
+                _dist[w] = dn;
+                _pred[w] = a;
+              }
+              break;
+            case Heap::POST_HEAP:
+              break;
+            }
+          }
+        }
+        if (!_heap.empty()) {
+          spur.found = true;
+          spur.length = _dist[d.t];
+          for (int w = d.t; w != v; ) {
+            int a = _pred[w];
+            spur.arcs.push_back(a);
+            w = d.source[a];
+          }
+          std::reverse(spur.arcs.begin(), spur.arcs.end());
+        }
+        _heap.clear();
+        for (int j = 0; j < int(_touched.size()); ++j) {
+          _cross[_touched[j]] = Heap::PRE_HEAP;
+        }
+      }
+
+    private:
+
+      bool allowed(int a, int w, const std::vector<int>& banned) const {
+        if (!_data.reach[w] || _mark[w] == _stamp) return false;
+        for (int j = 0; j < int(banned.size()); ++j) {
+          if (banned[j] == a) return false;
+        }
+        return true;
+      }
+
+      const KspData<V>& _data;
+      RangeMap<int> _cross;
+      Heap _heap;
+      std::vector<V> _dist;
+      std::vector<int> _pred;
+      std::vector<int> _mark;
+      int _stamp;
+      std::vector<int> _touched;
+    };
+
+    // Performs the spur searches of a path on several threads
+    template <typename V>
+    class KspDispatcher {
+    public:
+
+      KspDispatcher(std::vector<KspWorkspace<V>*>& workspaces,
+                    const std::vector<int>& nodes,
+                    std::vector<KspSpur<V> >& spurs)
+        : _workspaces(workspaces), _nodes(nodes), _spurs(spurs),
+          _next(0) {}
+
+      void operator()(int id) {
+        int i;
+        while ((i = bits::atomicFetchAdd(&_next, 1)) < int(_spurs.size())) {
+          _workspaces[id]->spur(_nodes, _spurs[i]);
+        }
+      }
+
+    private:
+      std::vector<KspWorkspace<V>*>& _workspaces;
+      const std::vector<int>& _nodes;
+      std::vector<KspSpur<V> >& _spurs;
+      int _next;
+    };
+
+  }
+
+  /// \addtogroup shortest_path
+  /// @{
+
+  /// \brief Yen's algorithm for finding the k shortest simple paths.
+  ///
+  /// \ref lemon::KShortestPaths "KShortestPaths" implements Yen's
+  /// algorithm for finding the \e k shortest simple (loopless) paths
+  /// between two nodes of a digraph in increasing order of length.
+  ///
+  /// The paths are found lazily: \ref findNext() finds the next
+  /// shortest path, so the search can be stopped at any time.
+  /// Each new path is derived from an earlier one by replacing its
+  /// suffix after a \e spur \e node with a shortest path avoiding the
+  /// earlier part of the path (and the arcs used by the already found
+  /// paths with the same prefix). The following improvements are
+  /// used.
+  /// - The spur nodes of a path are taken only from the node where it
+  ///   deviates from its parent path (Lawler's modification).
+  /// - The shortest path tree towards the target node is computed once
+  ///   by \ref Dijkstra on the reversed digraph. Its distances are
+  ///   used as potentials in the spur searches (A* search), and a spur
+  ///   path is taken directly from the tree without any search if the
+  ///   tree path does not touch the earlier part of the path.
+  /// - The spur searches of a path are independent, so they can be
+  ///   performed on several threads (see \ref threads()). The result
+  ///   does not depend on the number of threads.
+  ///
+  /// The running time is \f$O(kn(m+n\log n))\f$ in the worst case,
+  /// but it is usually much faster due to the tree reuse.
+  ///
+  /// \tparam GR The digraph type the algorithm runs on.
+  /// \tparam LEN The type of the length map.
+  /// The default value is <tt>GR::ArcMap<int></tt>.
+  ///
+  /// \warning Length values should be \e non-negative.
+  ///
+  /// \note Only simple paths are found. The paths that may contain
+  /// repeated nodes (the problem solved by Eppstein's algorithm) are
+  /// not supported.
+#ifdef DOXYGEN
+  template <typename GR, typename LEN>
+#else
+  template < typename GR,
+             typename LEN = typename GR::template ArcMap<int> >
+#endif
+  class KShortestPaths
+  {
+    TEMPLATE_DIGRAPH_TYPEDEFS(GR);
+
+  public:
+
+    /// The type of the digraph.
+    typedef GR Digraph;
+    /// The type of the length map.
+    typedef LEN LengthMap;
+    /// The type of the lengths.
+    typedef typename LengthMap::Value Length;
+    /// The type of the found paths.
+    typedef lemon::Path<Digraph> Path;
+
+  private:
+
+    typedef _k_shortest_paths_bits::KspData<Length> Data;
+    typedef _k_shortest_paths_bits::KspSpur<Length> Spur;
+    typedef _k_shortest_paths_bits::KspWorkspace<Length> Workspace;
+    typedef _k_shortest_paths_bits::KspDispatcher<Length> Dispatcher;
+
+    // A path found or to be found (candidate)
+    struct PathData {
+      std::vector<int> arcs;
+      Length length;
+      int dev;
+    };
+
+    typedef std::pair<Length, int> CandKey;
+    typedef std::priority_queue<CandKey, std::vector<CandKey>,
+                                std::greater<CandKey> > CandQueue;
+
+    const Digraph &_graph;
+    const LengthMap &_length;
+    int _threads;
+
+    Data _data;
+    std::vector<Arc> _arcs;
+    int _s;
+
+    // The found paths
+    std::vector<PathData> _found;
+    std::vector<Path> _paths;
+    int _expanded;
+
+    // The candidates
+    std::vector<PathData> _cands;
+    CandQueue _queue;
+    std::set<std::vector<int> > _cand_set;
+
+    std::vector<Workspace*> _workspaces;
+
+  public:
+
+    /// \brief Constructor.
+    ///
+    /// Constructor.
+    ///
+    /// \param graph The digraph the algorithm runs on.
+    /// \param length The length (cost) values of the arcs.
+    KShortestPaths(const Digraph &graph, const LengthMap &length)
+      : _graph(graph), _length(length), _threads(1), _s(-1),
+        _expanded(0) {}
+
+    /// Destructor.
+    ~KShortestPaths() {
+      clearWorkspaces();
+    }
+
+    /// \brief Set the number of threads.
+    ///
+    /// This function sets the number of threads used for the spur
+    /// searches. The value 0 stands for the number of hardware threads.
+    /// By default, the algorithm runs on a single thread.
+    ///
+    /// \return <tt>(*this)</tt>
+    KShortestPaths& threads(int num) {
+      _threads = num;
+      return *this;
+    }
+
+    /// \name Execution Control
+    /// The simplest way to execute the algorithm is to call \ref run().
+    /// \n If the number of the required paths is not known in advance,
+    /// call \ref init() first, then \ref findNext() for each new path.
+
+    /// @{
+
+    /// \brief Initialize the algorithm.
+    ///
+    /// This function initializes the algorithm for finding paths from
+    /// \c s to \c t. It computes the shortest path tree towards \c t.
+    void init(const Node& s, const Node& t) {
+      // Build the adjacency arrays
+      IntNodeMap index(_graph);
+      IntArcMap arc_index(_graph);
+      int n = 0;
+      for (NodeIt u(_graph); u != INVALID; ++u) {
+        index[u] = n++;
+      }
+      _arcs.clear();
+      _data.out_first.resize(n + 1);
+      _data.source.clear();
+      _data.target.clear();
+      _data.length.clear();
+      int i = 0;
+      for (NodeIt u(_graph); u != INVALID; ++u, ++i) {
+        _data.out_first[i] = _arcs.size();
+        for (OutArcIt a(_graph, u); a != INVALID; ++a) {
+          arc_index[a] = _arcs.size();
+          _arcs.push_back(a);
+          _data.source.push_back(i);
+          _data.target.push_back(index[_graph.target(a)]);
+          _data.length.push_back(_length[a]);
+        }
+      }
+      _data.out_first[n] = _arcs.size();
+
+      // Compute the shortest path tree towards the target node
+      typedef ReverseDigraph<const Digraph> RevDigraph;
+      RevDigraph rev(_graph);
+      Dijkstra<RevDigraph, LengthMap> dijk(rev, _length);
+      dijk.run(t);
+      _data.dist.assign(n, Length());
+      _data.next.assign(n, -1);
+      _data.reach.assign(n, 0);
+      i = 0;
+      for (NodeIt u(_graph); u != INVALID; ++u, ++i) {
+        if (!dijk.reached(u)) continue;
+        _data.reach[i] = 1;
+        _data.dist[i] = dijk.dist(u);
+        Arc a = dijk.predArc(u);
+        if (a != INVALID) _data.next[i] = arc_index[a];
+      }
+      _data.t = index[t];
+      _s = index[s];
+
+      // The first candidate is the tree path
+      _found.clear();
+      _paths.clear();
+      _expanded = 0;
+      _cands.clear();
+      _queue = CandQueue();
+      _cand_set.clear();
+      if (_data.reach[_s]) {
+        PathData p;
+        for (int u = _s; u != _data.t; u = _data.target[_data.next[u]]) {
+          p.arcs.push_back(_data.next[u]);
+        }
+        p.length = _data.dist[_s];
+        p.dev = 0;
+        addCandidate(p);
+      }
+
+      clearWorkspaces();
+    }
+
+    /// \brief Find the next shortest path.
+    ///
+    /// This function finds the next shortest simple path. It can be
+    /// obtained using \ref path() "path(pathNum()-1)".
+    ///
+    /// \return \c false if there are no more paths.
+    ///
+    /// \pre \ref init() must be called before using this function.
+    bool findNext() {
+      if (_expanded < int(_found.size())) {
+        expand(_expanded++);
+      }
+      if (_queue.empty()) return false;
+      int c = _queue.top().second;
+      _queue.pop();
+      _found.push_back(PathData());
+      std::swap(_found.back(), _cands[c]);
+      Path p;
+      const std::vector<int>& arcs = _found.back().arcs;
+      for (int j = 0; j < int(arcs.size()); ++j) {
+        p.addBack(_arcs[arcs[j]]);
+      }
+      _paths.push_back(p);
+      return true;
+    }
+
+    /// \brief Run the algorithm.
+    ///
+    /// This function finds the \c k shortest simple paths from \c s to
+    /// \c t.
+    ///
+    /// \return The number of the found paths, which is less than \c k
+    /// if there are less than \c k simple paths from \c s to \c t.
+    ///
+    /// \note <tt>ksp.run(s, t, k)</tt> is just a shortcut of the
+    /// following code.
+    /// \code
+    ///   ksp.init(s, t);
+    ///   while (ksp.pathNum() < k && ksp.findNext()) {}
+    ///   return ksp.pathNum();
+    /// \endcode
+    int run(const Node& s, const Node& t, int k) {
+      init(s, t);
+      while (pathNum() < k && findNext()) {}
+      return pathNum();
+    }
+
+    /// @}
+
+    /// \name Query Functions
+    /// The results of the algorithm can be obtained using these
+    /// functions.
+
+    /// @{
+
+    /// \brief Return the number of the found paths.
+    ///
+    /// This function returns the number of the paths found so far.
+    int pathNum() const {
+      return _found.size();
+    }
+
+    /// \brief Return a found path.
+    ///
+    /// This function returns the <tt>i</tt>-th shortest path.
+    /// \c i must be between \c 0 and <tt>%pathNum()-1</tt>.
+    const Path& path(int i) const {
+      return _paths[i];
+    }
+
+    /// \brief Return the length of a found path.
+    ///
+    /// This function returns the length of the <tt>i</tt>-th shortest
+    /// path. \c i must be between \c 0 and <tt>%pathNum()-1</tt>.
+    Length length(int i) const {
+      return _found[i].length;
+    }
+
+    /// @}
+
+  private:
+
+    void addCandidate(PathData& p) {
+      if (!_cand_set.insert(p.arcs).second) return;
+      _cands.push_back(PathData());
+      std::swap(_cands.back(), p);
+      _queue.push(CandKey(_cands.back().length, _cands.size() - 1));
+    }
+
+    void clearWorkspaces() {
+      for (int i = 0; i < int(_workspaces.size()); ++i) {
+        delete _workspaces[i];
+      }
+      _workspaces.clear();
+    }
+
+    // Generate the candidates derived from the given found path
+    void expand(int k) {
+      const PathData& p = _found[k];
+      int len = p.arcs.size();
+      if (p.dev >= len) return;
+
+      std::vector<int> nodes(len + 1);
+      nodes[0] = _s;
+      for (int i = 0; i < len; ++i) {
+        nodes[i + 1] = _data.target[p.arcs[i]];
+      }
+
+      // The spur searches; the arcs leaving the spur node on the found
+      // paths with the same prefix are banned
+      std::vector<Spur> spurs(len - p.dev);
+      for (int i = p.dev; i < len; ++i) {
+        Spur& spur = spurs[i - p.dev];
+        spur.index = i;
+        for (int j = 0; j < int(_found.size()); ++j) {
+          const std::vector<int>& q = _found[j].arcs;
+          if (int(q.size()) > i &&
+              std::equal(q.begin(), q.begin() + i, p.arcs.begin())) {
+            spur.banned.push_back(q[i]);
+          }
+        }
+      }
+      int threads = bits::parallelThreadNum(_threads, spurs.size(), 1);
+      while (int(_workspaces.size()) < threads) {
+        _workspaces.push_back(new Workspace(_data));
+      }
+      Dispatcher dispatcher(_workspaces, nodes, spurs);
+      bits::parallelRun(threads, dispatcher);
+
+      // Add the candidates in the order of the spur nodes
+      Length prefix = Length();
+      for (int i = 0; i < p.dev; ++i) prefix += _data.length[p.arcs[i]];
+      for (int i = p.dev; i < len; ++i) {
+        Spur& spur = spurs[i - p.dev];
+        if (spur.found) {
+          PathData c;
+          c.arcs.assign(p.arcs.begin(), p.arcs.begin() + i);
+          c.arcs.insert(c.arcs.end(), spur.arcs.begin(), spur.arcs.end());
+          c.length = prefix + spur.length;
+          c.dev = i;
+          addCandidate(c);
+        }
+        prefix += _data.length[p.arcs[i]];
+      }
+    }
+
+  }; //class KShortestPaths
+
+  ///@}
+
+} //namespace lemon
+
+#endif //LEMON_K_SHORTEST_PATHS_H
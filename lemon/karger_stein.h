@@ -0,0 +1,557 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_KARGER_STEIN_H
+#define LEMON_KARGER_STEIN_H
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+#include <lemon/core.h>
+#include <lemon/random.h>
+#include <lemon/concept_check.h>
+#include <lemon/concepts/maps.h>
+#include <lemon/bits/parallel.h>
+
+/// \file
+/// \ingroup min_cut
+/// \brief Karger-Stein randomized minimum cut algorithm.
+
+namespace lemon {
+
+  namespace _karger_stein_bits {
+
+    // A multigraph given by the list of its edges
+    template <typename V>
+    struct EdgeList {
+      int node_num;
+      std::vector<int> u, v;
+      std::vector<V> w;
+    };
+
+    class KeyLess {
+    public:
+      KeyLess(const std::vector<double>& key) : _key(key) {}
+      bool operator()(int a, int b) const {
+        return _key[a] < _key[b];
+      }
+    private:
+      const std::vector<double>& _key;
+    };
+
+    // The working arrays of the trials running on one thread. A trial
+    // is a run of the recursive contraction algorithm, which uses its
+    // own random generator seeded by the index of the trial, so its
+    // result does not depend on the thread running it.
+    template <typename V>
+    class TrialWorkspace {
+    public:
+
+      TrialWorkspace() : _input(0) {}
+
+      void input(const EdgeList<V>& graph) { _input = &graph; }
+
+      void run(int seed) {
+        _rnd.seed(seed);
+        _value = std::numeric_limits<V>::max();
+        recurse(0);
+      }
+
+      const V& value() const { return _value; }
+      const std::vector<char>& side() const { return _side; }
+
+    private:
+
+      // The number of nodes below which the minimum cut is computed by
+      // enumerating the cuts
+      static const int LEAF_SIZE = 6;
+
+      const EdgeList<V>& graph(int level) const {
+        return level == 0 ? *_input : _levels[level];
+      }
+
+      void recurse(int level) {
+        int n = graph(level).node_num;
+        if (n <= LEAF_SIZE) {
+          leafCut(level);
+          return;
+        }
+        // With probability at least 1/2, a fixed minimum cut survives
+        // the contraction to this size
+        int t = static_cast<int>(std::ceil(1.0 + n / std::sqrt(2.0)));
+        for (int rep = 0; rep < 2; ++rep) {
+          contract(level, t);
+          recurse(level + 1);
+        }
+      }
+
+      // Contracts random edges of the graph on the given level chosen
+      // with probabilities proportional to their weights until it has
+      // t nodes. The edges are processed in the order of exponentially
+      // distributed keys, the end nodes are united with a union-find
+      // structure, then the parallel edges are merged.
+      void contract(int level, int t) {
+        if (int(_levels.size()) <= level + 1) {
+          _levels.resize(level + 2);
+          _maps.resize(level + 2);
+        }
+        const EdgeList<V>& g = graph(level);
+        int n = g.node_num, m = g.u.size();
+
+        _key.resize(m);
+        _order.resize(m);
+        for (int e = 0; e < m; ++e) {
+          _key[e] = _rnd.exponential(static_cast<double>(g.w[e]));
+          _order[e] = e;
+        }
+        std::sort(_order.begin(), _order.end(), KeyLess(_key));
+
+        _parent.resize(n);
+        for (int x = 0; x < n; ++x) _parent[x] = x;
+        int comp_num = n;
+        for (int k = 0; k < m && comp_num > t; ++k) {
+          int a = find(g.u[_order[k]]), b = find(g.v[_order[k]]);
+          if (a != b) {
+            _parent[a] = b;
+            --comp_num;
+          }
+        }
+
+        std::vector<int>& map = _maps[level + 1];
+        map.assign(n, -1);
+        int k = 0;
+        for (int x = 0; x < n; ++x) {
+          if (find(x) == x) map[x] = k++;
+        }
+        for (int x = 0; x < n; ++x) map[x] = map[find(x)];
+
+        // Merge the parallel edges bucketed by their smaller end node
+        EdgeList<V>& h = _levels[level + 1];
+        h.node_num = k;
+        h.u.clear();
+        h.v.clear();
+        h.w.clear();
+        _start.assign(k + 1, 0);
+        for (int e = 0; e < m; ++e) {
+          int a = map[g.u[e]], b = map[g.v[e]];
+          if (a != b) ++_start[std::min(a, b) + 1];
+        }
+        for (int x = 0; x < k; ++x) _start[x + 1] += _start[x];
+        _bucket.resize(_start[k]);
+        for (int e = 0; e < m; ++e) {
+          int a = map[g.u[e]], b = map[g.v[e]];
+          if (a != b) _bucket[_start[std::min(a, b)]++] = e;
+        }
+        _mark.assign(k, -1);
+        _pos.resize(k);
+        for (int a = 0, j = 0; a < k; ++a) {
+          for (; j < _start[a]; ++j) {
+            int e = _bucket[j];
+            int b = map[g.u[e]] == a ? map[g.v[e]] : map[g.u[e]];
+            if (_mark[b] == a) {
+              h.w[_pos[b]] += g.w[e];
+            } else {
+              _mark[b] = a;
+              _pos[b] = h.u.size();
+              h.u.push_back(a);
+              h.v.push_back(b);
+              h.w.push_back(g.w[e]);
+            }
+          }
+        }
+      }
+
+      // Finds a minimum cut of a small graph by enumerating the cuts
+      void leafCut(int level) {
+        const EdgeList<V>& g = graph(level);
+        int n = g.node_num, m = g.u.size();
+        int best = -1;
+        V best_value = _value;
+        for (int mask = 2; mask < (1 << n); mask += 2) {
+          V value = 0;
+          for (int e = 0; e < m; ++e) {
+            if (((mask >> g.u[e]) ^ (mask >> g.v[e])) & 1) value += g.w[e];
+          }
+          if (value < best_value) {
+            best_value = value;
+            best = mask;
+          }
+        }
+        if (best == -1) return;
+
+        // Map the cut back to the original nodes
+        _value = best_value;
+        _inside.resize(n);
+        for (int x = 0; x < n; ++x) _inside[x] = (best >> x) & 1;
+        for (int l = level; l > 0; --l) {
+          const std::vector<int>& map = _maps[l];
+          _outside.resize(map.size());
+          for (int x = 0; x < int(map.size()); ++x) {
+            _outside[x] = _inside[map[x]];
+          }
+          _inside.swap(_outside);
+        }
+        _side = _inside;
+      }
+
+      int find(int x) {
+        while (_parent[x] != x) {
+          _parent[x] = _parent[_parent[x]];
+          x = _parent[x];
+        }
+        return x;
+      }
+
+      const EdgeList<V>* _input;
+      Random _rnd;
+
+      // The contracted graphs of the recursion levels and the maps
+      // from the nodes of the previous levels
+      std::vector<EdgeList<V> > _levels;
+      std::vector<std::vector<int> > _maps;
+
+      std::vector<double> _key;
+      std::vector<int> _order, _parent;
+      std::vector<int> _start, _bucket, _mark, _pos;
+      std::vector<char> _inside, _outside;
+
+      V _value;
+      std::vector<char> _side;
+    };
+
+    // Runs a batch of trials, one on each thread
+    template <typename V>
+    class TrialBatch {
+    public:
+
+      TrialBatch(std::vector<TrialWorkspace<V> >& workspaces)
+        : _workspaces(workspaces) {}
+
+      void start(int first) { _first = first; }
+
+      void operator()(int id) {
+        _workspaces[id].run(_first + id);
+      }
+
+    private:
+      std::vector<TrialWorkspace<V> >& _workspaces;
+      int _first;
+    };
+
+  }
+
+  /// \ingroup min_cut
+  ///
+  /// \brief Karger-Stein randomized minimum cut algorithm.
+  ///
+  /// This class estimates the minimum cut of an undirected graph with
+  /// non-negative edge capacities using the recursive contraction
+  /// algorithm of Karger and Stein. A trial of the algorithm contracts
+  /// randomly chosen edges (with probabilities proportional to their
+  /// capacities) until about \f$n/\sqrt{2}\f$ nodes remain, then it
+  /// recurses twice on the contracted graph. Small graphs are solved
+  /// by enumerating their cuts. The contractions sort the edges by
+  /// random exponential keys generated by \ref Random and unite their
+  /// end nodes with a union-find structure.
+  ///
+  /// A trial finds a fixed minimum cut with probability at least
+  /// \f$1/(d+1)\f$, where \f$d\approx 2\log_2 n\f$ is the depth of the
+  /// recursion. Independent trials are run in parallel, one on each
+  /// thread, until the cut found by the first trial with the best
+  /// value has not been improved by so many further trials that the
+  /// probability of missing a smaller cut is below <tt>1 -
+  /// confidence</tt>, or the maximum number of trials is reached.
+  /// Decreasing the confidence makes the algorithm faster, but the
+  /// result may be larger than the minimum cut value.
+  ///
+  /// The trials are seeded by their indices (offset by the
+  /// \ref seed() "seed"), and the trials after the stopping point are
+  /// discarded, so the result does not depend on the number of threads.
+  ///
+  /// For exact computations see \ref NagamochiIbaraki and \ref HaoOrlin.
+  ///
+  /// \tparam GR The type of the undirected graph the algorithm runs on.
+  /// \tparam CM The type of the edge map containing the capacities.
+  /// The default map type is \ref concepts::Graph::EdgeMap
+  /// "GR::EdgeMap<int>".
+#ifdef DOXYGEN
+  template <typename GR, typename CM>
+#else
+  template <typename GR,
+            typename CM = typename GR::template EdgeMap<int> >
+#endif
+  class KargerStein {
+  public:
+
+    /// The graph type of the algorithm
+    typedef GR Graph;
+    /// The capacity map type of the algorithm
+    typedef CM CapacityMap;
+    /// The value type of capacities
+    typedef typename CapacityMap::Value Value;
+
+  private:
+
+    TEMPLATE_GRAPH_TYPEDEFS(Graph);
+
+    const Graph& _graph;
+    const CapacityMap& _capacity;
+
+    int _threads;
+    double _confidence;
+    int _max_trials;
+    int _seed;
+
+    Value _min_cut;
+    typename Graph::template NodeMap<bool> _cut_map;
+    int _trial_num;
+    double _probability;
+
+  public:
+
+    /// \brief Constructor.
+    ///
+    /// Constructor.
+    /// \param graph The undirected graph the algorithm runs on.
+    /// \param capacity The edge capacity map.
+    KargerStein(const Graph& graph, const CapacityMap& capacity)
+      : _graph(graph), _capacity(capacity), _threads(0),
+        _confidence(0.99), _max_trials(0), _seed(0),
+        _min_cut(), _cut_map(graph), _trial_num(0), _probability(0)
+    {
+      checkConcept<concepts::ReadMap<Edge, Value>, CapacityMap>();
+    }
+
+    /// \brief Sets the number of threads.
+    ///
+    /// This function sets the number of threads. The value 0 (the
+    /// default) stands for the number of hardware threads.
+    /// \return <tt>(*this)</tt>
+    KargerStein& threads(int num) {
+      _threads = num;
+      return *this;
+    }
+
+    /// \brief Sets the required confidence.
+    ///
+    /// This function sets the required probability of finding a
+    /// minimum cut (0.99 by default). If it is at least 1, the trials
+    /// are run up to the \ref maxTrials() "maximum number", or if it
+    /// is not set, the largest confidence below 1 is used.
+    /// \return <tt>(*this)</tt>
+    KargerStein& confidence(double p) {
+      _confidence = p;
+      return *this;
+    }
+
+    /// \brief Sets the maximum number of trials.
+    ///
+    /// This function sets the maximum number of trials. The value 0
+    /// (the default) means that the trials are run until the required
+    /// \ref confidence() "confidence" is reached.
+    /// \return <tt>(*this)</tt>
+    KargerStein& maxTrials(int num) {
+      _max_trials = num;
+      return *this;
+    }
+
+    /// \brief Sets the seed of the random generators.
+    ///
+    /// This function sets the seed of the random generators of the
+    /// trials (0 by default).
+    /// \return <tt>(*this)</tt>
+    KargerStein& seed(int value) {
+      _seed = value;
+      return *this;
+    }
+
+    /// \name Execution Control
+
+    ///@{
+
+    /// \brief Runs the algorithm.
+    ///
+    /// This function runs the trials of the algorithm.
+    void run() {
+      typedef _karger_stein_bits::EdgeList<Value> EdgeList;
+      typedef _karger_stein_bits::TrialWorkspace<Value> Workspace;
+
+      std::vector<Node> nodes;
+      IntNodeMap index(_graph);
+      for (NodeIt n(_graph); n != INVALID; ++n) {
+        index[n] = nodes.size();
+        nodes.push_back(n);
+      }
+      int n = nodes.size();
+
+      EdgeList input;
+      input.node_num = n;
+      std::vector<int> parent(n);
+      for (int x = 0; x < n; ++x) parent[x] = x;
+      int comp_num = n;
+      for (EdgeIt e(_graph); e != INVALID; ++e) {
+        int a = index[_graph.u(e)], b = index[_graph.v(e)];
+        if (a == b || !(Value(0) < _capacity[e])) continue;
+        input.u.push_back(a);
+        input.v.push_back(b);
+        input.w.push_back(_capacity[e]);
+        a = find(parent, a);
+        b = find(parent, b);
+        if (a != b) {
+          parent[a] = b;
+          --comp_num;
+        }
+      }
+
+      _trial_num = 0;
+      _probability = 1.0;
+      for (NodeIt v(_graph); v != INVALID; ++v) _cut_map[v] = false;
+      if (n < 2) {
+        _min_cut = std::numeric_limits<Value>::max();
+        return;
+      }
+      if (comp_num > 1) {
+        int r = find(parent, 0);
+        for (int x = 0; x < n; ++x) {
+          _cut_map[nodes[x]] = find(parent, x) == r;
+        }
+        _min_cut = 0;
+        return;
+      }
+
+      // The number of trials without improvement that ensures the
+      // required confidence. The confidence 1 could never be reached
+      // without a limit on the trials.
+      double q = 1.0 / (2.0 * std::log(double(n)) / std::log(2.0) + 2.0);
+      double conf = _confidence;
+      if (conf >= 1.0 && _max_trials <= 0) {
+        conf = 1.0 - std::numeric_limits<double>::epsilon();
+      }
+      int needed = conf <= 0.0 ? 1 : conf >= 1.0 ?
+        std::numeric_limits<int>::max() :
+        static_cast<int>(std::ceil(std::log(1.0 - conf) /
+                                   std::log(1.0 - q)));
+      if (needed < 1) needed = 1;
+
+      int threads = bits::parallelThreadNum(_threads, n, 1);
+      std::vector<Workspace> workspaces(threads);
+      for (int i = 0; i < threads; ++i) workspaces[i].input(input);
+      _karger_stein_bits::TrialBatch<Value> batch(workspaces);
+
+      int last = 0;
+      bool found = false;
+      std::vector<char> best;
+      while (true) {
+        int num = threads;
+        if (_max_trials > 0 && _trial_num + num > _max_trials) {
+          num = _max_trials - _trial_num;
+        }
+        batch.start(_seed + _trial_num);
+        bits::parallelRun(num, batch);
+
+        bool finished = false;
+        for (int i = 0; i < num && !finished; ++i) {
+          if (!found || workspaces[i].value() < _min_cut) {
+            found = true;
+            _min_cut = workspaces[i].value();
+            best = workspaces[i].side();
+            last = _trial_num;
+          }
+          ++_trial_num;
+          finished = _trial_num - last - 1 >= needed ||
+            _trial_num == _max_trials;
+        }
+        if (finished) break;
+      }
+
+      _probability = 1.0 - std::pow(1.0 - q, double(_trial_num - last - 1));
+      for (int x = 0; x < n; ++x) _cut_map[nodes[x]] = best[x] != 0;
+    }
+
+    ///@}
+
+    /// \name Query Functions
+    /// The results of the algorithm can be obtained using these
+    /// functions.\n
+    /// \ref run() must be called before using them.
+
+    ///@{
+
+    /// \brief Returns the value of the found cut.
+    ///
+    /// This function returns the value of the smallest cut found by
+    /// the trials, or the largest value of the value type if the graph
+    /// has less than two nodes.
+    Value minCutValue() const {
+      return _min_cut;
+    }
+
+    /// \brief Returns the found cut in a node map.
+    ///
+    /// This function sets the nodes of one side of the smallest cut
+    /// found by the trials to \c true and the other nodes to \c false
+    /// in the given map.
+    /// \param cutMap A \ref concepts::WriteMap "writable" node map with
+    /// \c bool (or convertible) value type.
+    /// \return The value of the found cut.
+    template <typename CutMap>
+    Value minCutMap(CutMap& cutMap) const {
+      for (NodeIt n(_graph); n != INVALID; ++n) {
+        cutMap.set(n, _cut_map[n]);
+      }
+      return _min_cut;
+    }
+
+    /// \brief Returns the number of trials.
+    ///
+    /// This function returns the number of trials that were taken
+    /// into account.
+    int trialNum() const {
+      return _trial_num;
+    }
+
+    /// \brief Returns the estimated probability of the result.
+    ///
+    /// This function returns a lower bound on the probability that
+    /// a smaller cut would have been found by the trials after the
+    /// first one finding the reported cut, if such a cut existed.
+    /// It is 1 if the result is certainly a minimum cut (i.e. the
+    /// graph is not connected).
+    double successProbability() const {
+      return _probability;
+    }
+
+    ///@}
+
+  private:
+
+    static int find(std::vector<int>& parent, int x) {
+      while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+      }
+      return x;
+    }
+
+  };
+
+} //namespace lemon
+
+#endif //LEMON_KARGER_STEIN_H
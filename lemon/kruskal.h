@@ -26,6 +26,7 @@
 
 #include <lemon/core.h>
 #include <lemon/bits/traits.h>
+#include <lemon/bits/parallel.h>
 
 ///\ingroup spantree
 ///\file
@@ -94,6 +95,246 @@ namespace lemon {
     }
 
 
+    // The end nodes of the arcs of digraphs and the edges of graphs.
+
+    template <typename Graph, typename Enable = void>
+    struct KruskalEnds {
+      template <typename Item>
+      static typename Graph::Node first(const Graph& g, const Item& i) {
+        return g.source(i);
+      }
+      template <typename Item>
+      static typename Graph::Node second(const Graph& g, const Item& i) {
+        return g.target(i);
+      }
+    };
+
+    template <typename Graph>
+    struct KruskalEnds<Graph,
+      typename enable_if<UndirectedTagIndicator<Graph>, void>::type> {
+      template <typename Item>
+      static typename Graph::Node first(const Graph& g, const Item& i) {
+        return g.u(i);
+      }
+      template <typename Item>
+      static typename Graph::Node second(const Graph& g, const Item& i) {
+        return g.v(i);
+      }
+    };
+
+    template <typename V>
+    struct FilterEdge {
+      V cost;
+      int u, v;
+      int id;
+    };
+
+    template <typename V>
+    struct FilterEdgeComp {
+      bool operator()(const FilterEdge<V>& left,
+                      const FilterEdge<V>& right) const {
+        return left.cost < right.cost;
+      }
+    };
+
+    template <typename V>
+    class LessPred {
+    public:
+      LessPred(const V& pivot) : _pivot(pivot) {}
+      bool operator()(const FilterEdge<V>& e) const {
+        return e.cost < _pivot;
+      }
+    private:
+      V _pivot;
+    };
+
+    template <typename V>
+    class LessEqualPred {
+    public:
+      LessEqualPred(const V& pivot) : _pivot(pivot) {}
+      bool operator()(const FilterEdge<V>& e) const {
+        return !(_pivot < e.cost);
+      }
+    private:
+      V _pivot;
+    };
+
+    // Keeps the edges connecting different components
+    template <typename V>
+    class ComponentPred {
+    public:
+      ComponentPred(ConcurrentUnionFind& uf) : _uf(uf) {}
+      bool operator()(const FilterEdge<V>& e) const {
+        return _uf.find(e.u) != _uf.find(e.v);
+      }
+    private:
+      ConcurrentUnionFind& _uf;
+    };
+
+    // Stable parallel partition of a range into a buffer. In the first
+    // phase each thread counts the elements of its block satisfying the
+    // predicate, in the second phase the elements are copied to their
+    // final position.
+    template <typename V, typename Pred>
+    class SplitTask {
+    public:
+      typedef FilterEdge<V> Edge;
+
+      SplitTask(const Edge* from, Edge* to, int size, int threads,
+                const Pred& pred)
+        : _from(from), _to(to), _size(size), _threads(threads),
+          _pred(pred), _count(threads), _left(threads), _right(threads),
+          _phase(0) {}
+
+      void operator()(int id) {
+        int first = static_cast<int>(
+          static_cast<long long>(_size) * id / _threads);
+        int last = static_cast<int>(
+          static_cast<long long>(_size) * (id + 1) / _threads);
+        if (_phase == 0) {
+          int cnt = 0;
+          for (int i = first; i < last; ++i) {
+            if (_pred(_from[i])) ++cnt;
+          }
+          _count[id] = cnt;
+        } else {
+          int l = _left[id], r = _right[id];
+          for (int i = first; i < last; ++i) {
+            if (_pred(_from[i])) {
+              _to[l++] = _from[i];
+            } else {
+              _to[r++] = _from[i];
+            }
+          }
+        }
+      }
+
+      int run() {
+        _phase = 0;
+        bits::parallelRun(_threads, *this);
+        int total = 0;
+        for (int i = 0; i < _threads; ++i) total += _count[i];
+        int l = 0, r = total;
+        for (int i = 0; i < _threads; ++i) {
+          int first = static_cast<int>(
+            static_cast<long long>(_size) * i / _threads);
+          int last = static_cast<int>(
+            static_cast<long long>(_size) * (i + 1) / _threads);
+          _left[i] = l;
+          _right[i] = r;
+          l += _count[i];
+          r += last - first - _count[i];
+        }
+        _phase = 1;
+        bits::parallelRun(_threads, *this);
+        return total;
+      }
+
+    private:
+      const Edge* _from;
+      Edge* _to;
+      int _size, _threads;
+      Pred _pred;
+      std::vector<int> _count, _left, _right;
+      int _phase;
+    };
+
+    template <typename V>
+    class CopyTask {
+    public:
+      CopyTask(const FilterEdge<V>* from, FilterEdge<V>* to)
+        : _from(from), _to(to) {}
+      void operator()(int first, int last) {
+        std::copy(_from + first, _from + last, _to + first);
+      }
+    private:
+      const FilterEdge<V>* _from;
+      FilterEdge<V>* _to;
+    };
+
+    // Filter-Kruskal algorithm: the edges are partitioned around a
+    // pivot cost, the lighter part is processed recursively, then the
+    // edges of the heavier part that connect already connected nodes
+    // are filtered out before its recursive processing.
+    template <typename V>
+    class FilterKruskal {
+    public:
+      typedef FilterEdge<V> Edge;
+
+      FilterKruskal(int node_num, std::vector<Edge>& edges,
+                    std::vector<char>& tree, int threads)
+        : _edges(edges), _buffer(edges.size()), _uf(node_num),
+          _tree(tree), _threads(threads),
+          _threshold(std::max(1024, node_num)), _value(0) {}
+
+      V run() {
+        if (!_edges.empty()) process(0, _edges.size());
+        return _value;
+      }
+
+    private:
+
+      template <typename Pred>
+      int split(int first, int last, const Pred& pred) {
+        int size = last - first;
+        int threads = bits::parallelThreadNum(_threads, size, 16384);
+        if (threads <= 1) {
+          return std::stable_partition(_edges.begin() + first,
+                                       _edges.begin() + last, pred) -
+            _edges.begin();
+        }
+        SplitTask<V, Pred> task(&_edges[first], &_buffer[first],
+                                size, threads, pred);
+        int mid = task.run();
+        CopyTask<V> copy(&_buffer[0], &_edges[0]);
+        bits::parallelFor(threads, first, last, copy, 16384);
+        return first + mid;
+      }
+
+      void base(int first, int last) {
+        std::sort(_edges.begin() + first, _edges.begin() + last,
+                  FilterEdgeComp<V>());
+        for (int i = first; i < last; ++i) {
+          const Edge& e = _edges[i];
+          if (_uf.join(e.u, e.v)) {
+            _tree[e.id] = 1;
+            _value += e.cost;
+          }
+        }
+      }
+
+      void process(int first, int last) {
+        if (last - first <= _threshold) {
+          base(first, last);
+          return;
+        }
+        V a = _edges[first].cost;
+        V b = _edges[first + (last - first) / 2].cost;
+        V c = _edges[last - 1].cost;
+        V pivot = a < b ? (b < c ? b : (a < c ? c : a)) :
+                          (a < c ? a : (b < c ? c : b));
+        int mid = split(first, last, LessPred<V>(pivot));
+        if (mid == first) {
+          mid = split(first, last, LessEqualPred<V>(pivot));
+          if (mid == last) {
+            base(first, last);
+            return;
+          }
+        }
+        process(first, mid);
+        int end = split(mid, last, ComponentPred<V>(_uf));
+        if (end > mid) process(mid, end);
+      }
+
+      std::vector<Edge>& _edges;
+      std::vector<Edge> _buffer;
+      ConcurrentUnionFind _uf;
+      std::vector<char>& _tree;
+      int _threads;
+      int _threshold;
+      V _value;
+    };
+
     template <typename Sequence>
     struct PairComp {
       typedef typename Sequence::value_type Value;
@@ -319,6 +560,82 @@ namespace lemon {
       kruskal(graph, in, out);
   }
 
+  /// \ingroup spantree
+  ///
+  /// \brief Parallel Kruskal algorithm for finding a minimum cost
+  /// spanning tree of a graph.
+  ///
+  /// This function finds a minimum cost spanning tree (or forest) of a
+  /// graph using the \e filter-Kruskal algorithm on several threads.
+  /// The arcs/edges are partitioned around a pivot cost, the lighter
+  /// part is processed recursively, then the arcs/edges of the heavier
+  /// part connecting nodes of the same component are filtered out
+  /// before it is processed. Small parts are sorted and processed by
+  /// the original Kruskal algorithm. The partitioning and filtering
+  /// steps run in parallel, the components are maintained by a
+  /// \ref ConcurrentUnionFind structure.
+  ///
+  /// Since the heavy arcs/edges are usually filtered out without
+  /// sorting them, this algorithm is faster than \ref kruskal() even
+  /// on one thread, if the graph is dense.
+  ///
+  /// \param graph The graph the algorithm runs on.
+  /// It can be either \ref concepts::Digraph "directed" or
+  /// \ref concepts::Graph "undirected".
+  /// If the graph is directed, the algorithm consider it to be
+  /// undirected by disregarding the direction of the arcs.
+  /// \param cost A readable arc/edge map that specifies the costs.
+  /// \retval tree A writable arc/edge map with \c bool value type.
+  /// After running the algorithm it will contain the found minimum
+  /// cost spanning tree: the value of an arc/edge will be set to
+  /// \c true if it belongs to the tree, otherwise it will be set to
+  /// \c false. The value of each arc/edge will be set exactly once.
+  /// \param threads The number of threads. The value 0 (the default)
+  /// stands for the number of hardware threads.
+  ///
+  /// \return The total cost of the found spanning tree.
+  ///
+  /// \note If the input graph is not (weakly) connected, a spanning
+  /// forest is calculated instead of a spanning tree.
+  template <typename Graph, typename CostMap, typename TreeMap>
+  typename CostMap::Value
+  parallelKruskal(const Graph& graph, const CostMap& cost, TreeMap& tree,
+                  int threads = 0)
+  {
+    typedef typename CostMap::Key Item;
+    typedef typename CostMap::Value Value;
+    typedef typename ItemSetTraits<Graph, Item>::ItemIt ItemIt;
+    typedef _kruskal_bits::KruskalEnds<Graph> Ends;
+    typedef _kruskal_bits::FilterEdge<Value> Edge;
+
+    typename Graph::template NodeMap<int> index(graph);
+    int node_num = 0;
+    for (typename Graph::NodeIt n(graph); n != INVALID; ++n) {
+      index[n] = node_num++;
+    }
+
+    std::vector<Edge> edges;
+    for (ItemIt it(graph); it != INVALID; ++it) {
+      Edge e;
+      e.cost = cost[it];
+      e.u = index[Ends::first(graph, it)];
+      e.v = index[Ends::second(graph, it)];
+      e.id = edges.size();
+      edges.push_back(e);
+    }
+
+    std::vector<char> in_tree(edges.size(), 0);
+    _kruskal_bits::FilterKruskal<Value>
+      alg(node_num, edges, in_tree, threads);
+    Value value = alg.run();
+
+    int k = 0;
+    for (ItemIt it(graph); it != INVALID; ++it) {
+      tree.set(it, in_tree[k++] != 0);
+    }
+    return value;
+  }
+
 } //namespace lemon
 
 #endif //LEMON_KRUSKAL_H
@@ -0,0 +1,567 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_LAWLER_MRC_H
+#define LEMON_LAWLER_MRC_H
+
+/// \ingroup min_mean_cycle
+///
+/// \file
+/// \brief Lawler's algorithm for finding a minimum ratio cycle.
+
+#include <vector>
+#include <limits>
+#include <lemon/core.h>
+#include <lemon/path.h>
+#include <lemon/tolerance.h>
+#include <lemon/bellman_ford.h>
+
+namespace lemon {
+
+  /// \brief Default traits class of LawlerMrc class.
+  ///
+  /// Default traits class of LawlerMrc class.
+  /// \tparam GR The type of the digraph.
+  /// \tparam CM The type of the cost map.
+  /// It must conform to the \ref concepts::ReadMap "ReadMap" concept.
+  /// \tparam TM The type of the transit time map.
+  /// It must conform to the \ref concepts::ReadMap "ReadMap" concept.
+#ifdef DOXYGEN
+  template <typename GR, typename CM, typename TM>
+#else
+  template <typename GR, typename CM, typename TM,
+    bool integer = std::numeric_limits<typename CM::Value>::is_integer &&
+                   std::numeric_limits<typename TM::Value>::is_integer>
+#endif
+  struct LawlerMrcDefaultTraits
+  {
+    /// The type of the digraph
+    typedef GR Digraph;
+    /// The type of the cost map
+    typedef CM CostMap;
+    /// The type of the arc costs
+    typedef typename CostMap::Value Cost;
+    /// The type of the transit time map
+    typedef TM TimeMap;
+    /// The type of the transit times
+    typedef typename TimeMap::Value Time;
+
+    /// \brief The large cost type used for internal computations
+    ///
+    /// The large cost type used for internal computations.
+    /// It is \c long \c long if both the \c Cost and the \c Time types
+    /// are integer, otherwise it is \c double.
+    /// \c Cost and \c Time must be convertible to \c LargeCost.
+    typedef double LargeCost;
+
+    /// \brief The path type of the found cycles
+    ///
+    /// The path type of the found cycles.
+    /// It must conform to the \ref lemon::concepts::Path "Path" concept
+    /// and it must have an \c addBack() function.
+    typedef lemon::Path<Digraph> Path;
+  };
+
+  // Default traits class for integer cost and time types
+  template <typename GR, typename CM, typename TM>
+  struct LawlerMrcDefaultTraits<GR, CM, TM, true>
+  {
+    typedef GR Digraph;
+    typedef CM CostMap;
+    typedef typename CostMap::Value Cost;
+    typedef TM TimeMap;
+    typedef typename TimeMap::Value Time;
+#ifdef LEMON_HAVE_LONG_LONG
+    typedef long long LargeCost;
+#else
+    typedef long LargeCost;
+#endif
+    typedef lemon::Path<Digraph> Path;
+  };
+
+
+  /// \addtogroup min_mean_cycle
+  /// @{
+
+  /// \brief Implementation of Lawler's algorithm for finding a minimum
+  /// ratio cycle.
+  ///
+  /// This class implements Lawler's binary search algorithm for finding
+  /// a directed cycle of minimum cost-to-time ratio in a digraph
+  /// \cite amo93networkflows.
+  /// A cycle of ratio less than \f$\lambda\f$ exists if and only if the
+  /// arc lengths \f$c(a) - \lambda t(a)\f$ admit a negative cycle, which
+  /// is checked by the \ref BellmanFord::spfaStart() "queue-based"
+  /// Bellman-Ford algorithm. Each negative cycle found in this way
+  /// improves the upper bound to its own ratio, and the search stops
+  /// when the bounds prove the optimality of the best cycle.
+  ///
+  /// For integer costs and transit times, the result is exact (up to
+  /// the precision of \c double), and the number of iterations is
+  /// \f$O(\log(nCT))\f$, where \f$C\f$ and \f$T\f$ are the largest
+  /// absolute cost and transit time. For real data, the ratio is found
+  /// up to the epsilon of \ref Tolerance "Tolerance<double>".
+  /// In practice, \ref HowardMrc is usually much faster, but the
+  /// running time of this algorithm is polynomial.
+  ///
+  /// The interface of this class is the same as that of \ref HowardMrc.
+  ///
+  /// \tparam GR The type of the digraph the algorithm runs on.
+  /// \tparam CM The type of the cost map. The default
+  /// map type is \ref concepts::Digraph::ArcMap "GR::ArcMap<int>".
+  /// \tparam TM The type of the transit time map. The default
+  /// map type is \ref concepts::Digraph::ArcMap "GR::ArcMap<int>".
+  /// \tparam TR The traits class that defines various types used by the
+  /// algorithm. By default, it is \ref LawlerMrcDefaultTraits
+  /// "LawlerMrcDefaultTraits<GR, CM, TM>".
+  /// In most cases, this parameter should not be set directly,
+  /// consider to use the named template parameters instead.
+  ///
+  /// \warning The transit times must be non-negative, and the total
+  /// transit time of each directed cycle must be positive.
+#ifdef DOXYGEN
+  template <typename GR, typename CM, typename TM, typename TR>
+#else
+  template < typename GR,
+             typename CM = typename GR::template ArcMap<int>,
+             typename TM = typename GR::template ArcMap<int>,
+             typename TR = LawlerMrcDefaultTraits<GR, CM, TM> >
+#endif
+  class LawlerMrc
+  {
+  public:
+
+    /// The type of the digraph
+    typedef typename TR::Digraph Digraph;
+    /// The type of the cost map
+    typedef typename TR::CostMap CostMap;
+    /// The type of the arc costs
+    typedef typename TR::Cost Cost;
+    /// The type of the transit time map
+    typedef typename TR::TimeMap TimeMap;
+    /// The type of the transit times
+    typedef typename TR::Time Time;
+
+    /// \brief The large cost type
+    ///
+    /// The large cost type used for internal computations.
+    /// By default, it is \c long \c long if both the \c Cost and the
+    /// \c Time types are integer, otherwise it is \c double.
+    typedef typename TR::LargeCost LargeCost;
+
+    /// The tolerance type used for the binary search
+    typedef lemon::Tolerance<double> Tolerance;
+
+    /// \brief The path type of the found cycles
+    ///
+    /// The path type of the found cycles.
+    /// Using the \ref lemon::LawlerMrcDefaultTraits "default traits class",
+    /// it is \ref lemon::Path "Path<Digraph>".
+    typedef typename TR::Path Path;
+
+    /// The \ref lemon::LawlerMrcDefaultTraits "traits class" of the algorithm
+    typedef TR Traits;
+
+    /// \brief Constants for the causes of search termination.
+    ///
+    /// Enum type containing constants for the different causes of search
+    /// termination. The \ref findCycleRatio() function returns one of
+    /// these values.
+    enum TerminationCause {
+
+      /// No directed cycle can be found in the digraph.
+      NO_CYCLE = 0,
+
+      /// Optimal solution (minimum cycle ratio) is found.
+      OPTIMAL = 1,
+
+      /// The iteration count limit is reached.
+      ITERATION_LIMIT
+    };
+
+  private:
+
+    TEMPLATE_DIGRAPH_TYPEDEFS(Digraph);
+
+    typedef typename Digraph::template ArcMap<double> LengthMap;
+    typedef BellmanFord<Digraph, LengthMap> NegCycleAlg;
+
+    // The digraph the algorithm runs on
+    const Digraph &_gr;
+    // The cost of the arcs
+    const CostMap &_cost;
+    // The transit time of the arcs
+    const TimeMap &_time;
+
+    // Data for the found cycle
+    bool _best_found;
+    LargeCost _best_cost, _best_time;
+    std::vector<Arc> _best_arcs;
+
+    Path *_cycle_path;
+    bool _local_path;
+
+    // The number of negative cycle searches
+    int _iter_num;
+
+    Tolerance _tolerance;
+
+  public:
+
+    /// \name Named Template Parameters
+    /// @{
+
+    template <typename T>
+    struct SetLargeCostTraits : public Traits {
+      typedef T LargeCost;
+    };
+
+    /// \brief \ref named-templ-param "Named parameter" for setting
+    /// \c LargeCost type.
+    ///
+    /// \ref named-templ-param "Named parameter" for setting \c LargeCost
+    /// type. It is used for internal computations in the algorithm.
+    template <typename T>
+    struct SetLargeCost
+      : public LawlerMrc<GR, CM, TM, SetLargeCostTraits<T> > {
+      typedef LawlerMrc<GR, CM, TM, SetLargeCostTraits<T> > Create;
+    };
+
+    template <typename T>
+    struct SetPathTraits : public Traits {
+      typedef T Path;
+    };
+
+    /// \brief \ref named-templ-param "Named parameter" for setting
+    /// \c %Path type.
+    ///
+    /// \ref named-templ-param "Named parameter" for setting the \c %Path
+    /// type of the found cycles.
+    /// It must conform to the \ref lemon::concepts::Path "Path" concept
+    /// and it must have an \c addBack() function.
+    template <typename T>
+    struct SetPath
+      : public LawlerMrc<GR, CM, TM, SetPathTraits<T> > {
+      typedef LawlerMrc<GR, CM, TM, SetPathTraits<T> > Create;
+    };
+
+    /// @}
+
+  protected:
+
+    LawlerMrc() {}
+
+  public:
+
+    /// \brief Constructor.
+    ///
+    /// The constructor of the class.
+    ///
+    /// \param digraph The digraph the algorithm runs on.
+    /// \param cost The costs of the arcs.
+    /// \param time The transit times of the arcs.
+    LawlerMrc( const Digraph &digraph,
+               const CostMap &cost,
+               const TimeMap &time ) :
+      _gr(digraph), _cost(cost), _time(time), _best_found(false),
+      _best_cost(0), _best_time(1), _cycle_path(NULL), _local_path(false),
+      _iter_num(0)
+    {}
+
+    /// Destructor.
+    ~LawlerMrc() {
+      if (_local_path) delete _cycle_path;
+    }
+
+    /// \brief Set the path structure for storing the found cycle.
+    ///
+    /// This function sets an external path structure for storing the
+    /// found cycle.
+    ///
+    /// If you don't call this function before calling \ref run() or
+    /// \ref findCycleRatio(), a local \ref Path "path" structure
+    /// will be allocated. The destuctor deallocates this automatically
+    /// allocated object, of course.
+    ///
+    /// \note The algorithm calls only the \ref lemon::Path::addBack()
+    /// "addBack()" function of the given path structure.
+    ///
+    /// \return <tt>(*this)</tt>
+    LawlerMrc& cycle(Path &path) {
+      if (_local_path) {
+        delete _cycle_path;
+        _local_path = false;
+      }
+      _cycle_path = &path;
+      return *this;
+    }
+
+    /// \brief Set the tolerance used by the algorithm.
+    ///
+    /// This function sets the tolerance object used by the algorithm.
+    /// It determines the precision of the binary search for real
+    /// costs or transit times.
+    ///
+    /// \return <tt>(*this)</tt>
+    LawlerMrc& tolerance(const Tolerance& tolerance) {
+      _tolerance = tolerance;
+      return *this;
+    }
+
+    /// \brief Return a const reference to the tolerance.
+    ///
+    /// This function returns a const reference to the tolerance object
+    /// used by the algorithm.
+    const Tolerance& tolerance() const {
+      return _tolerance;
+    }
+
+    /// \name Execution control
+    /// The simplest way to execute the algorithm is to call the \ref run()
+    /// function.\n
+    /// If you only need the minimum cycle ratio, you may call
+    /// \ref findCycleRatio().
+
+    /// @{
+
+    /// \brief Run the algorithm.
+    ///
+    /// This function runs the algorithm.
+    /// It can be called more than once (e.g. if the underlying digraph
+    /// and/or the arc costs have been modified).
+    ///
+    /// \return \c true if a directed cycle exists in the digraph.
+    ///
+    /// \note <tt>mrc.run()</tt> is just a shortcut of the following code.
+    /// \code
+    ///   return mrc.findCycleRatio() && mrc.findCycle();
+    /// \endcode
+    bool run() {
+      return findCycleRatio() && findCycle();
+    }
+
+    /// \brief Find the minimum cycle ratio (or an upper bound).
+    ///
+    /// This function finds the minimum cost-to-time ratio of the
+    /// directed cycles in the digraph (or an upper bound for it).
+    ///
+    /// By default, the function finds the minimum cycle ratio,
+    /// but an optional limit can also be specified for the number of
+    /// iterations (negative cycle searches) of the binary search.
+    /// The return value indicates if the optimal solution is found
+    /// or the iteration limit is reached. In the latter case, the
+    /// best cycle found so far is provided.
+    ///
+    /// \param limit  The maximum allowed number of iterations during
+    /// the search process. Its default value implies that the algorithm
+    /// runs until it finds the optimal solution.
+    ///
+    /// \return The termination cause of the search process.
+    /// For more information, see \ref TerminationCause.
+    TerminationCause findCycleRatio(int limit =
+                                    std::numeric_limits<int>::max()) {
+      init();
+
+      // Every cycle ratio is in [-bound, bound]
+      double cost_sum = 0, time_sum = 0, time_min = 0;
+      for (ArcIt a(_gr); a != INVALID; ++a) {
+        double c = static_cast<double>(_cost[a]);
+        double t = static_cast<double>(_time[a]);
+        cost_sum += c < 0 ? -c : c;
+        time_sum += t;
+        if (t > 0 && (time_min == 0 || t < time_min)) time_min = t;
+      }
+      if (time_min == 0) return NO_CYCLE;
+      double bound = cost_sum / time_min + 1;
+
+      // The distinct cycle ratios differ by at least 'gap' for integer
+      // data, otherwise the tolerance determines the precision
+      bool integer = std::numeric_limits<LargeCost>::is_integer;
+      double gap = 1 / (time_sum * time_sum);
+
+      LengthMap length(_gr);
+      NegCycleAlg bf(_gr, length);
+
+      // Find an initial cycle
+      if (limit < 1) return ITERATION_LIMIT;
+      if (!findNegativeCycle(bf, length, bound)) return NO_CYCLE;
+
+      double lo = -bound, hi = bestRatio();
+      while (integer ? hi - lo >= gap : _tolerance.less(lo, hi)) {
+        if (_iter_num >= limit) return ITERATION_LIMIT;
+        double mid = lo + (hi - lo) / 2;
+        if (!(lo < mid && mid < hi)) break;
+        if (findNegativeCycle(bf, length, mid)) {
+          hi = bestRatio();
+        } else {
+          lo = mid;
+        }
+      }
+      return OPTIMAL;
+    }
+
+    /// \brief Find a minimum ratio directed cycle.
+    ///
+    /// This function finds a directed cycle of minimum cost-to-time
+    /// ratio in the digraph using the data computed by findCycleRatio().
+    ///
+    /// \return \c true if a directed cycle exists in the digraph.
+    ///
+    /// \pre \ref findCycleRatio() must be called before using this
+    /// function.
+    bool findCycle() {
+      if (!_best_found) return false;
+      for (int i = 0; i < int(_best_arcs.size()); ++i) {
+        _cycle_path->addBack(_best_arcs[i]);
+      }
+      return true;
+    }
+
+    /// @}
+
+    /// \name Query Functions
+    /// The results of the algorithm can be obtained using these
+    /// functions.\n
+    /// The algorithm should be executed before using them.
+
+    /// @{
+
+    /// \brief Return the total cost of the found cycle.
+    ///
+    /// This function returns the total cost of the found cycle.
+    ///
+    /// \pre \ref run() or \ref findCycleRatio() must be called before
+    /// using this function.
+    Cost cycleCost() const {
+      return static_cast<Cost>(_best_cost);
+    }
+
+    /// \brief Return the total transit time of the found cycle.
+    ///
+    /// This function returns the total transit time of the found cycle.
+    ///
+    /// \pre \ref run() or \ref findCycleRatio() must be called before
+    /// using this function.
+    Time cycleTime() const {
+      return static_cast<Time>(_best_time);
+    }
+
+    /// \brief Return the cost-to-time ratio of the found cycle.
+    ///
+    /// This function returns the cost-to-time ratio of the found cycle.
+    ///
+    /// \note <tt>alg.cycleRatio()</tt> is just a shortcut of the
+    /// following code.
+    /// \code
+    ///   return static_cast<double>(alg.cycleCost()) / alg.cycleTime();
+    /// \endcode
+    ///
+    /// \pre \ref run() or \ref findCycleRatio() must be called before
+    /// using this function.
+    double cycleRatio() const {
+      return static_cast<double>(_best_cost) / _best_time;
+    }
+
+    /// \brief Return the found cycle.
+    ///
+    /// This function returns a const reference to the path structure
+    /// storing the found cycle.
+    ///
+    /// \pre \ref run() or \ref findCycle() must be called before using
+    /// this function.
+    const Path& cycle() const {
+      return *_cycle_path;
+    }
+
+    /// \brief Return the number of iterations.
+    ///
+    /// This function returns the number of negative cycle searches
+    /// performed by the algorithm.
+    ///
+    /// \pre \ref run() or \ref findCycleRatio() must be called before
+    /// using this function.
+    int iterationNum() const {
+      return _iter_num;
+    }
+
+    ///@}
+
+  private:
+
+    // Initialize
+    void init() {
+      if (!_cycle_path) {
+        _local_path = true;
+        _cycle_path = new Path;
+      }
+      _best_found = false;
+      _best_cost = 0;
+      _best_time = 1;
+      _best_arcs.clear();
+      _iter_num = 0;
+      _cycle_path->clear();
+    }
+
+    double bestRatio() const {
+      return static_cast<double>(_best_cost) / _best_time;
+    }
+
+    // Search for a cycle of ratio less than the given value and update
+    // the best cycle if it is found
+    bool findNegativeCycle(NegCycleAlg& bf, LengthMap& length,
+                           double ratio) {
+      ++_iter_num;
+      for (ArcIt a(_gr); a != INVALID; ++a) {
+        length[a] = static_cast<double>(_cost[a]) -
+                    ratio * static_cast<double>(_time[a]);
+      }
+      bf.init(0);
+      if (bf.spfaStart()) return false;
+
+      lemon::Path<Digraph> cycle = bf.negativeCycle();
+      LargeCost ccost = 0, ctime = 0;
+      for (typename lemon::Path<Digraph>::ArcIt a(cycle);
+           a != INVALID; ++a) {
+        ccost += _cost[a];
+        ctime += _time[a];
+      }
+      // Check the exact ratio of the cycle (the search may report
+      // cycles of nearly zero length due to rounding errors)
+      if (cycle.empty() || ctime <= 0 ||
+          !(static_cast<double>(ccost) <
+            ratio * static_cast<double>(ctime))) return false;
+      if (!_best_found || ccost * _best_time < _best_cost * ctime) {
+        _best_found = true;
+        _best_cost = ccost;
+        _best_time = ctime;
+        _best_arcs.clear();
+        for (typename lemon::Path<Digraph>::ArcIt a(cycle);
+             a != INVALID; ++a) {
+          _best_arcs.push_back(a);
+        }
+      }
+      return true;
+    }
+
+  }; //class LawlerMrc
+
+  ///@}
+
+} //namespace lemon
+
+#endif //LEMON_LAWLER_MRC_H
@@ -0,0 +1,392 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_LAZY_HEAP_H
+#define LEMON_LAZY_HEAP_H
+
+///\ingroup heaps
+///\file
+///\brief Lazy deletion heap implementation.
+
+#include <vector>
+#include <utility>
+#include <functional>
+#include <algorithm>
+
+namespace lemon {
+
+  /// \ingroup heaps
+  ///
+  ///\brief Lazy deletion heap data structure.
+  ///
+  /// This class implements a binary heap with \e lazy \e deletion.
+  /// It fully conforms to the \ref concepts::Heap "heap concept".
+  ///
+  /// Instead of moving an element inside the heap when its priority
+  /// is changed, a new entry is pushed with the new priority and the
+  /// old entry is left in the heap as a stale duplicate. Erasing an
+  /// item also just invalidates its entries. The stale entries are
+  /// discarded when they get to the top of the heap, and the whole
+  /// heap is compacted when the majority of its entries are stale.
+  ///
+  /// The heap entries are plain (priority, slot, stamp) triples and
+  /// the cross reference map is not updated while the entries are
+  /// moved, so the sifting operations are cheap and cache-friendly.
+  /// This makes this heap a good choice for algorithms like Dijkstra,
+  /// which perform a lot of \ref decrease() operations, but usually
+  /// only a few of them for each item.
+  ///
+  /// \tparam PR Type of the priorities of the items.
+  /// \tparam IM A read-writable item map with \c int values, used
+  /// internally to handle the cross references.
+  /// \tparam CMP A functor class for comparing the priorities.
+  /// The default is \c std::less<PR>.
+  ///
+  ///\sa BinHeap
+#ifdef DOXYGEN
+  template <typename PR, typename IM, typename CMP>
+#else
+  template <typename PR, typename IM, typename CMP = std::less<PR> >
+#endif
+  class LazyHeap {
+  public:
+    /// Type of the item-int map.
+    typedef IM ItemIntMap;
+    /// Type of the priorities.
+    typedef PR Prio;
+    /// Type of the items stored in the heap.
+    typedef typename ItemIntMap::Key Item;
+    /// Type of the item-priority pairs.
+    typedef std::pair<Item,Prio> Pair;
+    /// Functor type for comparing the priorities.
+    typedef CMP Compare;
+
+    /// \brief Type to represent the states of the items.
+    ///
+    /// Each item has a state associated to it. It can be "in heap",
+    /// "pre-heap" or "post-heap". The latter two are indifferent from the
+    /// heap's point of view, but may be useful to the user.
+    ///
+    /// The item-int map must be initialized in such way that it assigns
+    /// \c PRE_HEAP (<tt>-1</tt>) to any element to be put in the heap.
+    enum State {
+      IN_HEAP = 0,    ///< = 0.
+      PRE_HEAP = -1,  ///< = -1.
+      POST_HEAP = -2  ///< = -2.
+    };
+
+  private:
+
+    // The data of an item stored in the heap. The stamp is increased
+    // each time the priority of the slot changes or the slot is freed.
+    struct Slot {
+      Item item;
+      Prio prio;
+      unsigned int stamp;
+      Slot(const Item &i, const Prio &p) : item(i), prio(p), stamp(0) {}
+    };
+
+    // An entry is valid if its stamp equals to the stamp of its slot.
+    struct Entry {
+      Prio prio;
+      int slot;
+      unsigned int stamp;
+      Entry(const Prio &p, int s, unsigned int t)
+        : prio(p), slot(s), stamp(t) {}
+    };
+
+    // Reversed comparison for the std heap functions, which maintain
+    // a max-heap.
+    class EntryComp {
+    public:
+      EntryComp(const Compare &comp) : _comp(comp) {}
+      bool operator()(const Entry &a, const Entry &b) const {
+        return _comp(b.prio, a.prio);
+      }
+    private:
+      Compare _comp;
+    };
+
+    std::vector<Entry> _entries;
+    std::vector<Slot> _slots;
+    std::vector<int> _free;
+    int _num;
+    ItemIntMap &_iim;
+    Compare _comp;
+
+  public:
+    /// \brief Constructor.
+    ///
+    /// Constructor.
+    /// \param map A map that assigns \c int values to the items.
+    /// It is used internally to handle the cross references.
+    /// The assigned value must be \c PRE_HEAP (<tt>-1</tt>) for each item.
+    explicit LazyHeap(ItemIntMap &map) : _num(0), _iim(map) {}
+
+    /// \brief Constructor.
+    ///
+    /// Constructor.
+    /// \param map A map that assigns \c int values to the items.
+    /// It is used internally to handle the cross references.
+    /// The assigned value must be \c PRE_HEAP (<tt>-1</tt>) for each item.
+    /// \param comp The function object used for comparing the priorities.
+    LazyHeap(ItemIntMap &map, const Compare &comp)
+      : _num(0), _iim(map), _comp(comp) {}
+
+    /// \brief The number of items stored in the heap.
+    ///
+    /// This function returns the number of items stored in the heap.
+    int size() const { return _num; }
+
+    /// \brief Check if the heap is empty.
+    ///
+    /// This function returns \c true if the heap is empty.
+    bool empty() const { return _num == 0; }
+
+    /// \brief Make the heap empty.
+    ///
+    /// This functon makes the heap empty.
+    /// It does not change the cross reference map. If you want to reuse
+    /// a heap that is not surely empty, you should first clear it and
+    /// then you should set the cross reference map to \c PRE_HEAP
+    /// for each item.
+    void clear() {
+      _entries.clear();
+      _slots.clear();
+      _free.clear();
+      _num = 0;
+    }
+
+  private:
+
+    bool valid(const Entry &e) const {
+      return _slots[e.slot].stamp == e.stamp;
+    }
+
+    void pushEntry(int s) {
+      const Slot &slot = _slots[s];
+      _entries.push_back(Entry(slot.prio, s, slot.stamp));
+      std::push_heap(_entries.begin(), _entries.end(), EntryComp(_comp));
+    }
+
+    int allocSlot(const Item &i, const Prio &p) {
+      int s;
+      if (_free.empty()) {
+        s = _slots.size();
+        _slots.push_back(Slot(i, p));
+      } else {
+        s = _free.back();
+        _free.pop_back();
+        _slots[s].item = i;
+        _slots[s].prio = p;
+      }
+      return s;
+    }
+
+    void freeSlot(int s) {
+      _iim.set(_slots[s].item, POST_HEAP);
+      ++_slots[s].stamp;
+      _free.push_back(s);
+      --_num;
+    }
+
+    // Restores the invariant that the top entry is valid and drops
+    // the stale entries if they dominate the heap.
+    void cleanup() {
+      if (_num == 0) {
+        clear();
+        return;
+      }
+      if (static_cast<int>(_entries.size()) > 2 * _num + 16) {
+        int k = 0;
+        for (int j = 0; j < static_cast<int>(_entries.size()); ++j) {
+          if (valid(_entries[j])) _entries[k++] = _entries[j];
+        }
+        _entries.erase(_entries.begin() + k, _entries.end());
+        std::make_heap(_entries.begin(), _entries.end(), EntryComp(_comp));
+        return;
+      }
+      while (!valid(_entries.front())) {
+        std::pop_heap(_entries.begin(), _entries.end(), EntryComp(_comp));
+        _entries.pop_back();
+      }
+    }
+
+    void change(int s, const Prio &p) {
+      _slots[s].prio = p;
+      ++_slots[s].stamp;
+      pushEntry(s);
+      cleanup();
+    }
+
+  public:
+    /// \brief Insert a pair of item and priority into the heap.
+    ///
+    /// This function inserts \c p.first to the heap with priority
+    /// \c p.second.
+    /// \param p The pair to insert.
+    /// \pre \c p.first must not be stored in the heap.
+    void push(const Pair &p) {
+      push(p.first, p.second);
+    }
+
+    /// \brief Insert an item into the heap with the given priority.
+    ///
+    /// This function inserts the given item into the heap with the
+    /// given priority.
+    /// \param i The item to insert.
+    /// \param p The priority of the item.
+    /// \pre \e i must not be stored in the heap.
+    void push(const Item &i, const Prio &p) {
+      int s = allocSlot(i, p);
+      _iim.set(i, s);
+      ++_num;
+      pushEntry(s);
+    }
+
+    /// \brief Return the item having minimum priority.
+    ///
+    /// This function returns the item having minimum priority.
+    /// \pre The heap must be non-empty.
+    Item top() const { return _slots[_entries.front().slot].item; }
+
+    /// \brief The minimum priority.
+    ///
+    /// This function returns the minimum priority.
+    /// \pre The heap must be non-empty.
+    Prio prio() const { return _entries.front().prio; }
+
+    /// \brief Remove the item having minimum priority.
+    ///
+    /// This function removes the item having minimum priority.
+    /// \pre The heap must be non-empty.
+    void pop() {
+      freeSlot(_entries.front().slot);
+      std::pop_heap(_entries.begin(), _entries.end(), EntryComp(_comp));
+      _entries.pop_back();
+      cleanup();
+    }
+
+    /// \brief Remove the given item from the heap.
+    ///
+    /// This function removes the given item from the heap if it is
+    /// already stored.
+    /// \param i The item to delete.
+    /// \pre \e i must be in the heap.
+    void erase(const Item &i) {
+      freeSlot(_iim[i]);
+      cleanup();
+    }
+
+    /// \brief The priority of the given item.
+    ///
+    /// This function returns the priority of the given item.
+    /// \param i The item.
+    /// \pre \e i must be in the heap.
+    Prio operator[](const Item &i) const {
+      return _slots[_iim[i]].prio;
+    }
+
+    /// \brief Set the priority of an item or insert it, if it is
+    /// not stored in the heap.
+    ///
+    /// This method sets the priority of the given item if it is
+    /// already stored in the heap. Otherwise it inserts the given
+    /// item into the heap with the given priority.
+    /// \param i The item.
+    /// \param p The priority.
+    void set(const Item &i, const Prio &p) {
+      int s = _iim[i];
+      if( s<0 )
+        push(i,p);
+      else
+        change(s, p);
+    }
+
+    /// \brief Decrease the priority of an item to the given value.
+    ///
+    /// This function decreases the priority of an item to the given value.
+    /// \param i The item.
+    /// \param p The priority.
+    /// \pre \e i must be stored in the heap with priority at least \e p.
+    void decrease(const Item &i, const Prio &p) {
+      change(_iim[i], p);
+    }
+
+    /// \brief Increase the priority of an item to the given value.
+    ///
+    /// This function increases the priority of an item to the given value.
+    /// \param i The item.
+    /// \param p The priority.
+    /// \pre \e i must be stored in the heap with priority at most \e p.
+    void increase(const Item &i, const Prio &p) {
+      change(_iim[i], p);
+    }
+
+    /// \brief Return the state of an item.
+    ///
+    /// This method returns \c PRE_HEAP if the given item has never
+    /// been in the heap, \c IN_HEAP if it is in the heap at the moment,
+    /// and \c POST_HEAP otherwise.
+    /// In the latter case it is possible that the item will get back
+    /// to the heap again.
+    /// \param i The item.
+    State state(const Item &i) const {
+      int s = _iim[i];
+      if (s>=0) s=0;
+      return State(s);
+    }
+
+    /// \brief Set the state of an item in the heap.
+    ///
+    /// This function sets the state of the given item in the heap.
+    /// It can be used to manually clear the heap when it is important
+    /// to achive better time complexity.
+    /// \param i The item.
+    /// \param st The state. It should not be \c IN_HEAP.
+    void state(const Item& i, State st) {
+      switch (st) {
+        case POST_HEAP:
+        case PRE_HEAP:
+          if (state(i) == IN_HEAP) erase(i);
+          _iim[i] = st;
+          break;
+        case IN_HEAP:
+          break;
+      }
+    }
+
+    /// \brief Replace an item in the heap.
+    ///
+    /// This function replaces item \c i with item \c j.
+    /// Item \c i must be in the heap, while \c j must be out of the
+    /// heap. After calling this method, item \c i will be out of the
+    /// heap and \c j will be in the heap with the same prioriority
+    /// as item \c i had before.
+    void replace(const Item& i, const Item& j) {
+      int s = _iim[i];
+      _iim.set(i, _iim[j]);
+      _iim.set(j, s);
+      _slots[s].item = j;
+    }
+
+  }; // class LazyHeap
+
+} // namespace lemon
+
+#endif // LEMON_LAZY_HEAP_H
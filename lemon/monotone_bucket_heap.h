@@ -0,0 +1,486 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_MONOTONE_BUCKET_HEAP_H
+#define LEMON_MONOTONE_BUCKET_HEAP_H
+
+///\ingroup heaps
+///\file
+///\brief Multi-level bucket heap for monotone integer priorities.
+
+#include <vector>
+#include <utility>
+#include <limits>
+#include <algorithm>
+
+namespace lemon {
+
+  /// \ingroup heaps
+  ///
+  /// \brief Multi-level bucket heap for monotone integer priorities.
+  ///
+  /// This class implements a multi-level bucket queue (a variant of
+  /// Dial's algorithm and the radix heaps), which is designed for
+  /// \e monotone usage, i.e. when the priorities of the inserted items
+  /// are not less than the priority of the last removed item. This is
+  /// the case, for example, in the Dijkstra algorithm with
+  /// non-negative integer arc lengths.
+  /// It fully conforms to the \ref concepts::Heap "heap concept",
+  /// but the non-monotone operations require the rebuild of the heap
+  /// in linear time.
+  ///
+  /// The priorities are considered as numbers of \e L digits in base
+  /// \f$2^b\f$ (\e b=8, and \e L is at most 8 for 64-bit integers).
+  /// The heap has \e L levels of \f$2^b\f$ buckets. An item is stored
+  /// on the level of the highest digit in which its priority differs
+  /// from the last removed priority, in the bucket of this digit.
+  /// When the lowest level becomes empty, the first non-empty bucket
+  /// of the next non-empty level is distributed to the lower levels.
+  /// Therefore, each item is moved at most \e L-1 times, independently
+  /// of the range of the priorities, and the buckets are simple linked
+  /// lists, so the heap operations are considerably faster than those
+  /// of the comparison-based heaps. This heap is the default heap of
+  /// \ref Dijkstra for integer arc lengths.
+  ///
+  /// \tparam PR Type of the priorities of the items. It must be an
+  /// integer type of at most 64 bits.
+  /// \tparam IM A read-writable item map with \c int values, used
+  /// internally to handle the cross references.
+  ///
+  ///\sa BucketHeap
+  ///\sa RadixHeap
+  template <typename PR, typename IM>
+  class MonotoneBucketHeap {
+
+  public:
+
+    /// Type of the item-int map.
+    typedef IM ItemIntMap;
+    /// Type of the priorities.
+    typedef PR Prio;
+    /// Type of the items stored in the heap.
+    typedef typename ItemIntMap::Key Item;
+    /// Type of the item-priority pairs.
+    typedef std::pair<Item,Prio> Pair;
+
+    /// \brief Type to represent the states of the items.
+    ///
+    /// Each item has a state associated to it. It can be "in heap",
+    /// "pre-heap" or "post-heap". The latter two are indifferent from the
+    /// heap's point of view, but may be useful to the user.
+    ///
+    /// The item-int map must be initialized in such way that it assigns
+    /// \c PRE_HEAP (<tt>-1</tt>) to any element to be put in the heap.
+    enum State {
+      IN_HEAP = 0,    ///< = 0.
+      PRE_HEAP = -1,  ///< = -1.
+      POST_HEAP = -2  ///< = -2.
+    };
+
+  private:
+
+    // The number of bits of a digit and the number of buckets per level
+    enum {
+      DIGIT_BITS = 8,
+      BUCKET_NUM = 1 << DIGIT_BITS
+    };
+
+    typedef unsigned long long Code;
+
+    struct BucketItem {
+      BucketItem(const Item& _item, const Prio& _prio)
+        : item(_item), prio(_prio), code(encode(_prio)),
+          prev(-1), next(-1), bucket(0) {}
+
+      Item item;
+      Prio prio;
+      Code code;
+      int prev, next;
+      int bucket;
+    };
+
+    // Maps the priorities to unsigned codes in an order preserving way
+    static Code encode(const Prio& p) {
+      typedef std::numeric_limits<Prio> Limits;
+      return Limits::is_signed ?
+        static_cast<Code>(static_cast<long long>(p)) -
+        static_cast<Code>(static_cast<long long>(Limits::min())) :
+        static_cast<Code>(p);
+    }
+
+    static int levelNum() {
+      typedef std::numeric_limits<Prio> Limits;
+      int bits = Limits::digits + (Limits::is_signed ? 1 : 0);
+      return (bits + DIGIT_BITS - 1) / DIGIT_BITS;
+    }
+
+    static int digit(Code c, int level) {
+      return static_cast<int>((c >> (DIGIT_BITS * level)) & (BUCKET_NUM - 1));
+    }
+
+    ItemIntMap& _iim;
+    std::vector<BucketItem> _data;
+
+    // The first items of the buckets, level by level, and the number
+    // of the items on each level
+    std::vector<int> _first;
+    std::vector<int> _level_size;
+    int _level_num;
+
+    // The code of the last removed priority (or a lower bound of the
+    // stored codes after a rebuild)
+    Code _last;
+    // The first possibly non-empty bucket of the lowest level
+    int _lower_min;
+
+  public:
+
+    /// \brief Constructor.
+    ///
+    /// Constructor.
+    /// \param map A map that assigns \c int values to the items.
+    /// It is used internally to handle the cross references.
+    /// The assigned value must be \c PRE_HEAP (<tt>-1</tt>) for each item.
+    explicit MonotoneBucketHeap(ItemIntMap &map)
+      : _iim(map), _level_num(levelNum()), _last(0), _lower_min(0)
+    {
+      _first.resize(_level_num * BUCKET_NUM, -1);
+      _level_size.resize(_level_num, 0);
+    }
+
+    /// \brief The number of items stored in the heap.
+    ///
+    /// This function returns the number of items stored in the heap.
+    int size() const { return _data.size(); }
+
+    /// \brief Check if the heap is empty.
+    ///
+    /// This function returns \c true if the heap is empty.
+    bool empty() const { return _data.empty(); }
+
+    /// \brief Make the heap empty.
+    ///
+    /// This functon makes the heap empty.
+    /// It does not change the cross reference map. If you want to reuse
+    /// a heap that is not surely empty, you should first clear it and
+    /// then you should set the cross reference map to \c PRE_HEAP
+    /// for each item.
+    void clear() {
+      _data.clear();
+      std::fill(_first.begin(), _first.end(), -1);
+      std::fill(_level_size.begin(), _level_size.end(), 0);
+    }
+
+  private:
+
+    void link(int idx, int bucket) {
+      int& first = _first[bucket];
+      _data[idx].bucket = bucket;
+      _data[idx].prev = -1;
+      _data[idx].next = first;
+      if (first != -1) {
+        _data[first].prev = idx;
+      }
+      first = idx;
+      ++_level_size[bucket / BUCKET_NUM];
+      if (bucket < _lower_min) _lower_min = bucket;
+    }
+
+    void unlink(int idx) {
+      const BucketItem& bi = _data[idx];
+      if (bi.prev != -1) {
+        _data[bi.prev].next = bi.next;
+      } else {
+        _first[bi.bucket] = bi.next;
+      }
+      if (bi.next != -1) {
+        _data[bi.next].prev = bi.prev;
+      }
+      --_level_size[bi.bucket / BUCKET_NUM];
+    }
+
+    // Puts an item into the bucket of the highest digit in which its
+    // code differs from _last, assuming that it is not less than _last.
+    void place(int idx) {
+      const Code c = _data[idx].code;
+      const Code x = c ^ _last;
+      int level = 0;
+      while (level + 1 < _level_num &&
+             (x >> (DIGIT_BITS * (level + 1))) != 0) {
+        ++level;
+      }
+      link(idx, level * BUCKET_NUM + digit(c, level));
+    }
+
+    // Redistributes all items with respect to the minimum priority
+    void rebuild() {
+      std::fill(_first.begin(), _first.end(), -1);
+      std::fill(_level_size.begin(), _level_size.end(), 0);
+      _last = _data[0].code;
+      for (int k = 1; k < int(_data.size()); ++k) {
+        if (_data[k].code < _last) _last = _data[k].code;
+      }
+      _lower_min = digit(_last, 0);
+      for (int k = 0; k < int(_data.size()); ++k) {
+        place(k);
+      }
+    }
+
+    void insert(int idx) {
+      if (_data[idx].code < _last) {
+        rebuild();
+      } else {
+        place(idx);
+      }
+    }
+
+    // Makes the first non-empty bucket of the lowest level available,
+    // so that the minimum item is _first[_lower_min]. It is called at
+    // the end of each modifying operation, thus the const queries need
+    // not change the heap.
+    void moveDown() {
+      if (_data.empty()) return;
+      if (_level_size[0] == 0) {
+        int level = 1;
+        while (_level_size[level] == 0) ++level;
+        // The buckets up to the digit of _last are empty on this level
+        int bucket = level * BUCKET_NUM + digit(_last, level) + 1;
+        while (_first[bucket] == -1) ++bucket;
+        int idx = _first[bucket];
+        Code min = _data[idx].code;
+        for (int i = _data[idx].next; i != -1; i = _data[i].next) {
+          if (_data[i].code < min) min = _data[i].code;
+        }
+        _first[bucket] = -1;
+        _last = min;
+        _lower_min = digit(_last, 0);
+        while (idx != -1) {
+          int next = _data[idx].next;
+          --_level_size[level];
+          place(idx);
+          idx = next;
+        }
+      }
+      while (_first[_lower_min] == -1) ++_lower_min;
+    }
+
+    void relocateLast(int idx) {
+      if (idx != int(_data.size()) - 1) {
+        _data[idx] = _data.back();
+        if (_data[idx].prev != -1) {
+          _data[_data[idx].prev].next = idx;
+        } else {
+          _first[_data[idx].bucket] = idx;
+        }
+        if (_data[idx].next != -1) {
+          _data[_data[idx].next].prev = idx;
+        }
+        _iim[_data[idx].item] = idx;
+      }
+      _data.pop_back();
+    }
+
+  public:
+
+    /// \brief Insert a pair of item and priority into the heap.
+    ///
+    /// This function inserts \c p.first to the heap with priority
+    /// \c p.second.
+    /// \param p The pair to insert.
+    /// \pre \c p.first must not be stored in the heap.
+    void push(const Pair& p) {
+      push(p.first, p.second);
+    }
+
+    /// \brief Insert an item into the heap with the given priority.
+    ///
+    /// This function inserts the given item into the heap with the
+    /// given priority.
+    /// \param i The item to insert.
+    /// \param p The priority of the item.
+    /// \pre \e i must not be stored in the heap.
+    void push(const Item &i, const Prio &p) {
+      int idx = _data.size();
+      _iim[i] = idx;
+      _data.push_back(BucketItem(i, p));
+      if (idx == 0) {
+        _last = _data[idx].code;
+        _lower_min = digit(_last, 0);
+      }
+      insert(idx);
+      moveDown();
+    }
+
+    /// \brief Return the item having minimum priority.
+    ///
+    /// This function returns the item having minimum priority.
+    /// \pre The heap must be non-empty.
+    Item top() const {
+      return _data[_first[_lower_min]].item;
+    }
+
+    /// \brief The minimum priority.
+    ///
+    /// This function returns the minimum priority.
+    /// \pre The heap must be non-empty.
+    Prio prio() const {
+      return _data[_first[_lower_min]].prio;
+    }
+
+    /// \brief Remove the item having minimum priority.
+    ///
+    /// This function removes the item having minimum priority.
+    /// \pre The heap must be non-empty.
+    void pop() {
+      int idx = _first[_lower_min];
+      _last = _data[idx].code;
+      _iim[_data[idx].item] = POST_HEAP;
+      unlink(idx);
+      relocateLast(idx);
+      moveDown();
+    }
+
+    /// \brief Remove the given item from the heap.
+    ///
+    /// This function removes the given item from the heap if it is
+    /// already stored.
+    /// \param i The item to delete.
+    /// \pre \e i must be in the heap.
+    void erase(const Item &i) {
+      int idx = _iim[i];
+      _iim[_data[idx].item] = POST_HEAP;
+      unlink(idx);
+      relocateLast(idx);
+      moveDown();
+    }
+
+    /// \brief The priority of the given item.
+    ///
+    /// This function returns the priority of the given item.
+    /// \param i The item.
+    /// \pre \e i must be in the heap.
+    Prio operator[](const Item &i) const {
+      int idx = _iim[i];
+      return _data[idx].prio;
+    }
+
+    /// \brief Set the priority of an item or insert it, if it is
+    /// not stored in the heap.
+    ///
+    /// This method sets the priority of the given item if it is
+    /// already stored in the heap. Otherwise it inserts the given
+    /// item into the heap with the given priority.
+    /// \param i The item.
+    /// \param p The priority.
+    void set(const Item &i, const Prio &p) {
+      int idx = _iim[i];
+      if (idx < 0) {
+        push(i, p);
+      } else {
+        unlink(idx);
+        _data[idx].prio = p;
+        _data[idx].code = encode(p);
+        insert(idx);
+        moveDown();
+      }
+    }
+
+    /// \brief Decrease the priority of an item to the given value.
+    ///
+    /// This function decreases the priority of an item to the given value.
+    /// \param i The item.
+    /// \param p The priority.
+    /// \pre \e i must be stored in the heap with priority at least \e p.
+    void decrease(const Item &i, const Prio &p) {
+      int idx = _iim[i];
+      unlink(idx);
+      _data[idx].prio = p;
+      _data[idx].code = encode(p);
+      insert(idx);
+      moveDown();
+    }
+
+    /// \brief Increase the priority of an item to the given value.
+    ///
+    /// This function increases the priority of an item to the given value.
+    /// \param i The item.
+    /// \param p The priority.
+    /// \pre \e i must be stored in the heap with priority at most \e p.
+    void increase(const Item &i, const Prio &p) {
+      int idx = _iim[i];
+      unlink(idx);
+      _data[idx].prio = p;
+      _data[idx].code = encode(p);
+      insert(idx);
+      moveDown();
+    }
+
+    /// \brief Return the state of an item.
+    ///
+    /// This method returns \c PRE_HEAP if the given item has never
+    /// been in the heap, \c IN_HEAP if it is in the heap at the moment,
+    /// and \c POST_HEAP otherwise.
+    /// In the latter case it is possible that the item will get back
+    /// to the heap again.
+    /// \param i The item.
+    State state(const Item &i) const {
+      int idx = _iim[i];
+      if (idx >= 0) idx = 0;
+      return State(idx);
+    }
+
+    /// \brief Set the state of an item in the heap.
+    ///
+    /// This function sets the state of the given item in the heap.
+    /// It can be used to manually clear the heap when it is important
+    /// to achive better time complexity.
+    /// \param i The item.
+    /// \param st The state. It should not be \c IN_HEAP.
+    void state(const Item& i, State st) {
+      switch (st) {
+      case POST_HEAP:
+      case PRE_HEAP:
+        if (state(i) == IN_HEAP) {
+          erase(i);
+        }
+        _iim[i] = st;
+        break;
+      case IN_HEAP:
+        break;
+      }
+    }
+
+    /// \brief Replace an item in the heap.
+    ///
+    /// This function replaces item \c i with item \c j.
+    /// Item \c i must be in the heap, while \c j must be out of the
+    /// heap. After calling this method, item \c i will be out of the
+    /// heap and \c j will be in the heap with the same prioriority
+    /// as item \c i had before.
+    void replace(const Item& i, const Item& j) {
+      int idx = _iim[i];
+      _iim[i] = _iim[j];
+      _iim[j] = idx;
+      _data[idx].item = j;
+    }
+
+  }; // class MonotoneBucketHeap
+
+} // namespace lemon
+
+#endif // LEMON_MONOTONE_BUCKET_HEAP_H
@@ -0,0 +1,310 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_PRIM_H
+#define LEMON_PRIM_H
+
+///\ingroup spantree
+///\file
+///\brief Prim's algorithm to compute a minimum cost spanning tree
+
+#include <lemon/core.h>
+#include <lemon/bin_heap.h>
+#include <lemon/maps.h>
+
+namespace lemon {
+
+  /// \ingroup spantree
+  ///
+  /// \brief Prim's algorithm for finding a minimum cost spanning tree
+  /// of a graph.
+  ///
+  /// This class implements Prim's algorithm for finding a minimum cost
+  /// spanning tree (or forest) of an undirected graph. The tree is
+  /// grown from a root node like in the Dijkstra algorithm: in each
+  /// step the node that can be connected to the tree with the lightest
+  /// edge is added to it. The candidate nodes are stored in a heap,
+  /// so the running time is \f$O(m\log n)\f$ using \ref BinHeap, and
+  /// \f$O(m+n\log n)\f$ using \ref FibHeap or \ref PairingHeap.
+  ///
+  /// This algorithm does not sort the edges, therefore it is suggested
+  /// for dense graphs, while \ref kruskal() and \ref boruvka() are
+  /// usually faster on sparse graphs.
+  ///
+  /// \tparam GR The type of the undirected graph the algorithm runs on.
+  /// \tparam CM A \ref concepts::ReadMap "readable" edge map that
+  /// specifies the costs of the edges. The default map type is
+  /// \ref concepts::Graph::EdgeMap "GR::EdgeMap<int>".
+  /// \tparam H The heap type used by the algorithm. It must conform to
+  /// the \ref concepts::Heap "heap concept" and its cross reference
+  /// map must be constructible from the graph, for example a node map
+  /// with \c int values. The default is \ref BinHeap.
+#ifdef DOXYGEN
+  template <typename GR, typename CM, typename H>
+#else
+  template <typename GR,
+            typename CM = typename GR::template EdgeMap<int>,
+            typename H = BinHeap<typename CM::Value,
+                                 typename GR::template NodeMap<int> > >
+#endif
+  class Prim {
+  public:
+
+    /// The type of the graph the algorithm runs on.
+    typedef GR Graph;
+    /// The type of the cost map.
+    typedef CM CostMap;
+    /// The type of the costs.
+    typedef typename CostMap::Value Value;
+    /// The type of the heap used by the algorithm.
+    typedef H Heap;
+    /// The cross reference type used by the heap.
+    typedef typename Heap::ItemIntMap HeapCrossRef;
+    /// The type of the map that stores the predecessor edges.
+    typedef typename Graph::template NodeMap<typename Graph::Edge> PredMap;
+
+  private:
+
+    TEMPLATE_GRAPH_TYPEDEFS(Graph);
+
+    const Graph& _graph;
+    const CostMap& _cost;
+
+    PredMap _pred;
+    HeapCrossRef _heap_cross_ref;
+    Heap _heap;
+    Value _value;
+
+  public:
+
+    /// \brief Constructor.
+    ///
+    /// Constructor.
+    /// \param graph The undirected graph the algorithm runs on.
+    /// \param cost The cost map of the edges.
+    Prim(const Graph& graph, const CostMap& cost)
+      : _graph(graph), _cost(cost), _pred(graph),
+        _heap_cross_ref(graph), _heap(_heap_cross_ref), _value(0) {}
+
+    /// \name Execution Control
+    /// The simplest way to execute the algorithm is to use
+    /// \ref run() or \ref run(Node).\n
+    /// If you need better control on the execution, you have to call
+    /// \ref init() first, then you can add root nodes with
+    /// \ref addSource(). Finally the actual algorithm can be performed
+    /// with \ref start() or using \ref processNextNode().
+
+    ///@{
+
+    /// \brief Initializes the internal data structures.
+    ///
+    /// Initializes the internal data structures.
+    void init() {
+      _heap.clear();
+      for (NodeIt n(_graph); n != INVALID; ++n) {
+        _pred.set(n, INVALID);
+        _heap_cross_ref.set(n, Heap::PRE_HEAP);
+      }
+      _value = 0;
+    }
+
+    /// \brief Adds a new root node.
+    ///
+    /// Adds a new root node to the priority heap, from which a new
+    /// tree is grown. It is ignored if the node has already been
+    /// reached.
+    void addSource(const Node& s) {
+      if (_heap.state(s) == Heap::PRE_HEAP) {
+        _heap.push(s, Value(0));
+      }
+    }
+
+    /// \brief Processes the next node in the priority heap.
+    ///
+    /// Processes the next node in the priority heap, i.e. adds it to
+    /// the tree with its lightest connecting edge.
+    /// \return The processed node.
+    /// \warning The priority heap must not be empty.
+    Node processNextNode() {
+      Node v = _heap.top();
+      if (_pred[v] != INVALID) _value += _heap.prio();
+      _heap.pop();
+      for (IncEdgeIt e(_graph, v); e != INVALID; ++e) {
+        Node w = _graph.oppositeNode(v, e);
+        switch (_heap.state(w)) {
+        case Heap::PRE_HEAP:
+          _heap.push(w, _cost[e]);
+          _pred.set(w, e);
+          break;
+        case Heap::IN_HEAP:
+          if (_cost[e] < _heap[w]) {
+            _heap.decrease(w, _cost[e]);
+            _pred.set(w, e);
+          }
+          break;
+        case Heap::POST_HEAP:
+          break;
+        }
+      }
+      return v;
+    }
+
+    /// \brief Returns \c false if there are nodes to be processed.
+    ///
+    /// Returns \c false if there are nodes to be processed
+    /// in the priority heap.
+    bool emptyQueue() const { return _heap.empty(); }
+
+    /// \brief Executes the algorithm.
+    ///
+    /// Executes the algorithm: the trees are grown from the root nodes
+    /// until the priority heap becomes empty.
+    ///
+    /// \pre init() must be called and at least one root node should be
+    /// added with addSource() before using this function.
+    void start() {
+      while (!_heap.empty()) processNextNode();
+    }
+
+    /// \brief Runs the algorithm from the given root node.
+    ///
+    /// This method runs the algorithm to find a minimum cost spanning
+    /// tree of the component of node \c s.
+    ///
+    /// \note <tt>p.run(s)</tt> is just a shortcut of the following code.
+    /// \code
+    ///   p.init();
+    ///   p.addSource(s);
+    ///   p.start();
+    /// \endcode
+    void run(const Node& s) {
+      init();
+      addSource(s);
+      start();
+    }
+
+    /// \brief Runs the algorithm.
+    ///
+    /// This method runs the algorithm to find a minimum cost spanning
+    /// forest of the whole graph.
+    void run() {
+      init();
+      for (NodeIt n(_graph); n != INVALID; ++n) {
+        if (_heap.state(n) == Heap::PRE_HEAP) {
+          addSource(n);
+          start();
+        }
+      }
+    }
+
+    ///@}
+
+    /// \name Query Functions
+    /// The results of the algorithm can be obtained using these
+    /// functions.\n
+    /// The algorithm should be executed before using them.
+
+    ///@{
+
+    /// \brief Returns the total cost of the found tree.
+    ///
+    /// Returns the total cost of the found spanning tree (or forest).
+    Value treeValue() const { return _value; }
+
+    /// \brief Returns the tree edge connecting a node to its parent.
+    ///
+    /// Returns the tree edge connecting the given node to its parent,
+    /// or \c INVALID if the node is a root or it is not reached.
+    Edge predEdge(const Node& v) const { return _pred[v]; }
+
+    /// \brief Returns a const reference to the predecessor map.
+    ///
+    /// Returns a const reference to the node map that stores the tree
+    /// edges connecting the nodes to their parents.
+    const PredMap& predMap() const { return _pred; }
+
+    /// \brief Checks if an edge is in the tree.
+    ///
+    /// Returns \c true if the given edge is in the found tree.
+    bool tree(const Edge& e) const {
+      return (_pred[_graph.u(e)] == e &&
+              _heap.state(_graph.u(e)) == Heap::POST_HEAP) ||
+             (_pred[_graph.v(e)] == e &&
+              _heap.state(_graph.v(e)) == Heap::POST_HEAP);
+    }
+
+    /// \brief Writes the tree into a bool edge map.
+    ///
+    /// This function sets the value of each edge in the given
+    /// writable \c bool edge map to \c true if it is in the tree and
+    /// to \c false otherwise. The value of each edge is set exactly
+    /// once.
+    template <typename TreeMap>
+    void treeMap(TreeMap& map) const {
+      for (EdgeIt e(_graph); e != INVALID; ++e) {
+        map.set(e, tree(e));
+      }
+    }
+
+    /// \brief Checks if a node is reached.
+    ///
+    /// Returns \c true if the given node is reached, i.e. it has been
+    /// added to the heap.
+    bool reached(const Node& v) const {
+      return _heap.state(v) != Heap::PRE_HEAP;
+    }
+
+    /// \brief Checks if a node is processed.
+    ///
+    /// Returns \c true if the given node is processed, i.e. it is
+    /// already in the tree.
+    bool processed(const Node& v) const {
+      return _heap.state(v) == Heap::POST_HEAP;
+    }
+
+    ///@}
+  };
+
+  /// \ingroup spantree
+  ///
+  /// \brief Prim's algorithm for finding a minimum cost spanning tree
+  /// of a graph.
+  ///
+  /// This function runs Prim's algorithm to find a minimum cost
+  /// spanning tree (or forest) of an undirected graph. For more
+  /// control on the execution, use the \ref Prim class.
+  ///
+  /// \param graph The undirected graph the algorithm runs on.
+  /// \param cost A readable edge map that specifies the costs.
+  /// \retval tree A writable edge map with \c bool value type. Its
+  /// value is set to \c true for the tree edges and to \c false for
+  /// the other edges. The value of each edge is set exactly once.
+  ///
+  /// \return The total cost of the found spanning tree.
+  template <typename Graph, typename CostMap, typename TreeMap>
+  typename CostMap::Value
+  prim(const Graph& graph, const CostMap& cost, TreeMap& tree) {
+    Prim<Graph, CostMap> alg(graph, cost);
+    alg.run();
+    alg.treeMap(tree);
+    return alg.treeValue();
+  }
+
+} //namespace lemon
+
+#endif //LEMON_PRIM_H
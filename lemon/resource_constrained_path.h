@@ -0,0 +1,572 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_RESOURCE_CONSTRAINED_PATH_H
+#define LEMON_RESOURCE_CONSTRAINED_PATH_H
+
+///\ingroup shortest_path
+///\file
+///\brief Bicriteria and resource constrained shortest paths.
+
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <lemon/core.h>
+#include <lemon/path.h>
+#include <lemon/adaptors.h>
+#include <lemon/dijkstra.h>
+
+namespace lemon {
+
+  namespace _resource_constrained_path_bits {
+
+    // Pooled storage of the labels. The slots of the discarded labels
+    // are reused, so the storage is proportional to the maximum number
+    // of the labels alive at the same time.
+    template <typename C, typename R>
+    class LabelPool {
+    public:
+
+      std::vector<C> cost;
+      std::vector<R> res;
+      std::vector<int> node;
+      std::vector<int> pred;
+      std::vector<int> arc;
+
+      int add(int v, const C& c, const R& r, int p, int a) {
+        int l;
+        if (_free.empty()) {
+          l = node.size();
+          cost.push_back(c);
+          res.push_back(r);
+          node.push_back(v);
+          pred.push_back(p);
+          arc.push_back(a);
+        } else {
+          l = _free.back();
+          _free.pop_back();
+          cost[l] = c;
+          res[l] = r;
+          node[l] = v;
+          pred[l] = p;
+          arc[l] = a;
+        }
+        return l;
+      }
+
+      void release(int l) {
+        _free.push_back(l);
+      }
+
+      void clear() {
+        cost.clear();
+        res.clear();
+        node.clear();
+        pred.clear();
+        arc.clear();
+        _free.clear();
+      }
+
+      int size() const {
+        return node.size();
+      }
+
+    private:
+      std::vector<int> _free;
+    };
+
+    // Binary heap of the labels ordered by (key, resource)
+    template <typename C, typename R>
+    class LabelHeap {
+    public:
+
+      LabelHeap() {}
+
+      void push(const C& key, const R& res, int l) {
+        _heap.push(Item(Key(key, res), l));
+      }
+
+      bool empty() const {
+        return _heap.empty();
+      }
+
+      int pop() {
+        int l = _heap.top().second;
+        _heap.pop();
+        return l;
+      }
+
+    private:
+      typedef std::pair<C, R> Key;
+      typedef std::pair<Key, int> Item;
+      std::priority_queue<Item, std::vector<Item>,
+                          std::greater<Item> > _heap;
+    };
+
+    // Cyclic bucket queue of the labels for integer keys (Dial's
+    // method). The keys are monotone and the keys of the labels in the
+    // queue are in the range [current key, current key + width), so
+    // each bucket holds labels of equal keys. The current bucket is
+    // kept as a heap ordered by the resource values, the other ones
+    // are unordered.
+    template <typename C, typename R>
+    class LabelBucketQueue {
+    public:
+
+      LabelBucketQueue(int width, const C& key)
+        : _buckets(width), _cur(0), _key(key), _size(0) {
+        _cur = bucket(key);
+      }
+
+      void push(const C& key, const R& res, int l) {
+        std::vector<Item>& b = _buckets[bucket(key)];
+        b.push_back(Item(res, l));
+        if (key == _key) {
+          std::push_heap(b.begin(), b.end(), std::greater<Item>());
+        }
+        ++_size;
+      }
+
+      bool empty() const {
+        return _size == 0;
+      }
+
+      int pop() {
+        while (_buckets[_cur].empty()) {
+          ++_key;
+          if (++_cur == int(_buckets.size())) _cur = 0;
+          std::make_heap(_buckets[_cur].begin(), _buckets[_cur].end(),
+                         std::greater<Item>());
+        }
+        std::vector<Item>& b = _buckets[_cur];
+        std::pop_heap(b.begin(), b.end(), std::greater<Item>());
+        int l = b.back().second;
+        b.pop_back();
+        --_size;
+        return l;
+      }
+
+    private:
+      typedef std::pair<R, int> Item;
+
+      int bucket(const C& key) const {
+        return static_cast<int>(static_cast<long long>(key) %
+                                static_cast<long long>(_buckets.size()));
+      }
+
+      std::vector<std::vector<Item> > _buckets;
+      int _cur;
+      C _key;
+      int _size;
+    };
+
+  }
+
+  /// \addtogroup shortest_path
+  /// @{
+
+  /// \brief Bicriteria and resource constrained shortest paths.
+  ///
+  /// \ref ResourceConstrainedPath implements a label setting algorithm
+  /// for finding the Pareto-optimal paths of a digraph with respect to
+  /// two arc weights: a cost (e.g. travel time) and a resource
+  /// consumption (e.g. toll). A path is Pareto-optimal if no other path
+  /// between the same nodes is at most as expensive and consumes at
+  /// most as much resource, and better in at least one of them.
+  /// The resource can also be limited, then only the paths whose
+  /// total resource consumption is at most the given limit are
+  /// considered, and the cheapest one of them is the solution of the
+  /// \e resource \e constrained \e shortest \e path \e problem.
+  ///
+  /// Each label represents a path from the source node: its cost, its
+  /// resource consumption and the label it was extended from. The labels
+  /// are processed in the order of their costs (and resource consumption
+  /// for equal costs), so a label that is not dominated by the labels
+  /// processed before at the same node is Pareto-optimal. The labels are
+  /// kept in a pooled storage and their queue is a bucket queue if the
+  /// costs are integers and the arc costs are not too large, otherwise
+  /// it is a binary heap.
+  ///
+  /// If a target node is given, the search is guided towards it. The
+  /// minimum cost and the minimum resource consumption of the paths to
+  /// the target node are computed first for each node. The former one is
+  /// used as a potential to direct the search (like in the A* algorithm),
+  /// and a label is pruned if the lower bounds show that it cannot be
+  /// extended to a new Pareto-optimal path to the target node or that
+  /// the resource limit would be exceeded.
+  ///
+  /// The number of Pareto-optimal paths can be exponential in the
+  /// worst case, but it is typically small in practice.
+  ///
+  /// \tparam GR The digraph type the algorithm runs on.
+  /// \tparam CM The type of the cost map.
+  /// The default value is <tt>GR::ArcMap<int></tt>.
+  /// \tparam RM The type of the resource map.
+  /// The default value is \c CM.
+  ///
+  /// \warning Both the costs and the resource values should be
+  /// \e non-negative.
+#ifdef DOXYGEN
+  template <typename GR, typename CM, typename RM>
+#else
+  template < typename GR,
+             typename CM = typename GR::template ArcMap<int>,
+             typename RM = CM >
+#endif
+  class ResourceConstrainedPath
+  {
+    TEMPLATE_DIGRAPH_TYPEDEFS(GR);
+
+  public:
+
+    /// The type of the digraph.
+    typedef GR Digraph;
+    /// The type of the cost map.
+    typedef CM CostMap;
+    /// The type of the resource map.
+    typedef RM ResourceMap;
+    /// The type of the costs.
+    typedef typename CostMap::Value Cost;
+    /// The type of the resource values.
+    typedef typename ResourceMap::Value Resource;
+    /// The type of the found paths.
+    typedef lemon::Path<Digraph> Path;
+
+  private:
+
+    typedef _resource_constrained_path_bits::LabelPool<Cost, Resource>
+      Pool;
+    typedef _resource_constrained_path_bits::LabelHeap<Cost, Resource>
+      Heap;
+    typedef _resource_constrained_path_bits::LabelBucketQueue<Cost,
+      Resource> BucketQueue;
+
+    // The maximum number of buckets used by the bucket queue
+    static const int MAX_BUCKET_NUM = 1 << 16;
+
+    const Digraph &_graph;
+    const CostMap &_cost;
+    const ResourceMap &_resource;
+
+    bool _limited;
+    Resource _limit;
+
+    // Adjacency arrays of the digraph
+    IntNodeMap _index;
+    std::vector<int> _out_first, _target;
+    std::vector<Cost> _arc_cost;
+    std::vector<Resource> _arc_res;
+    std::vector<Arc> _arcs;
+
+    // Potentials and lower bounds on the resource consumption towards
+    // the target node
+    std::vector<Cost> _pot;
+    std::vector<Resource> _lower;
+    std::vector<char> _reach;
+    int _t;
+
+    // The labels and the minimum resource value of the permanent labels
+    // at each node
+    Pool _pool;
+    std::vector<Resource> _min_res;
+    std::vector<char> _has_label;
+    std::vector<int> _perm;
+
+    // The permanent labels sorted by their nodes
+    std::vector<int> _label_first;
+    std::vector<int> _labels;
+
+    bool _buckets;
+
+  public:
+
+    /// \brief Constructor.
+    ///
+    /// Constructor.
+    ///
+    /// \param graph The digraph the algorithm runs on.
+    /// \param cost The cost values of the arcs.
+    /// \param resource The resource consumption of the arcs.
+    ResourceConstrainedPath(const Digraph &graph, const CostMap &cost,
+                            const ResourceMap &resource)
+      : _graph(graph), _cost(cost), _resource(resource),
+        _limited(false), _limit(), _index(graph), _t(-1),
+        _buckets(false) {}
+
+    /// \brief Set the resource limit.
+    ///
+    /// This function sets an upper bound on the total resource
+    /// consumption of the paths. By default, there is no limit.
+    ///
+    /// \return <tt>(*this)</tt>
+    ResourceConstrainedPath& resourceLimit(const Resource& limit) {
+      _limited = true;
+      _limit = limit;
+      return *this;
+    }
+
+    /// \brief Remove the resource limit.
+    ///
+    /// This function removes the upper bound on the total resource
+    /// consumption of the paths.
+    ///
+    /// \return <tt>(*this)</tt>
+    ResourceConstrainedPath& noResourceLimit() {
+      _limited = false;
+      return *this;
+    }
+
+    /// \name Execution Control
+
+    /// @{
+
+    /// \brief Run the algorithm from a source node.
+    ///
+    /// This function finds the Pareto-optimal paths from \c s to all
+    /// the other nodes (that satisfy the resource limit, if it is set).
+    void run(const Node& s) {
+      build();
+      int n = _out_first.size() - 1;
+      _t = -1;
+      _pot.assign(n, Cost());
+      _lower.assign(n, Resource());
+      _reach.assign(n, 1);
+      search(_index[s]);
+    }
+
+    /// \brief Run the algorithm from a source node to a target node.
+    ///
+    /// This function finds the Pareto-optimal paths from \c s to \c t
+    /// (that satisfy the resource limit, if it is set).
+    ///
+    /// \note The labels of the other nodes are not complete, since the
+    /// search is pruned using the lower bounds towards \c t.
+    void run(const Node& s, const Node& t) {
+      build();
+      int n = _out_first.size() - 1;
+      _t = _index[t];
+
+      typedef ReverseDigraph<const Digraph> RevDigraph;
+      RevDigraph rev(_graph);
+      Dijkstra<RevDigraph, CostMap> cost_dijk(rev, _cost);
+      Dijkstra<RevDigraph, ResourceMap> res_dijk(rev, _resource);
+      cost_dijk.run(t);
+      res_dijk.run(t);
+      _pot.assign(n, Cost());
+      _lower.assign(n, Resource());
+      _reach.assign(n, 0);
+      for (NodeIt u(_graph); u != INVALID; ++u) {
+        if (!cost_dijk.reached(u)) continue;
+        int i = _index[u];
+        _pot[i] = cost_dijk.dist(u);
+        _lower[i] = res_dijk.dist(u);
+        _reach[i] = !_limited || !(_limit < _lower[i]);
+      }
+      search(_index[s]);
+    }
+
+    /// @}
+
+    /// \name Query Functions
+    /// The results of the algorithm can be obtained using these
+    /// functions.\n
+    /// \ref run() must be called before using them.
+
+    /// @{
+
+    /// \brief Return the number of the Pareto-optimal paths to a node.
+    ///
+    /// This function returns the number of the Pareto-optimal paths
+    /// found from the source node to the given node.
+    int pathNum(const Node& v) const {
+      int i = _index[v];
+      return _label_first[i + 1] - _label_first[i];
+    }
+
+    /// \brief Return the cost of a Pareto-optimal path.
+    ///
+    /// This function returns the cost of the <tt>i</tt>-th
+    /// Pareto-optimal path to the given node.
+    /// The paths are ordered by increasing cost and decreasing
+    /// resource consumption, so if a resource limit is set, the
+    /// path with index \c 0 is the resource constrained shortest path.
+    /// \c i must be between \c 0 and <tt>%pathNum(v)-1</tt>.
+    Cost cost(const Node& v, int i) const {
+      return _pool.cost[_labels[_label_first[_index[v]] + i]];
+    }
+
+    /// \brief Return the resource consumption of a Pareto-optimal path.
+    ///
+    /// This function returns the resource consumption of the
+    /// <tt>i</tt>-th Pareto-optimal path to the given node.
+    /// \c i must be between \c 0 and <tt>%pathNum(v)-1</tt>.
+    Resource resource(const Node& v, int i) const {
+      return _pool.res[_labels[_label_first[_index[v]] + i]];
+    }
+
+    /// \brief Return a Pareto-optimal path.
+    ///
+    /// This function returns the <tt>i</tt>-th Pareto-optimal path to
+    /// the given node.
+    /// \c i must be between \c 0 and <tt>%pathNum(v)-1</tt>.
+    Path path(const Node& v, int i) const {
+      Path p;
+      for (int l = _labels[_label_first[_index[v]] + i];
+           _pool.pred[l] != -1; l = _pool.pred[l]) {
+        p.addFront(_arcs[_pool.arc[l]]);
+      }
+      return p;
+    }
+
+    /// \brief Check if a node is reached.
+    ///
+    /// This function returns \c true if a path to the given node is
+    /// found.
+    bool reached(const Node& v) const {
+      return pathNum(v) > 0;
+    }
+
+    /// \brief Return the number of the created labels.
+    ///
+    /// This function returns the size of the label pool, i.e. the
+    /// maximum number of labels stored at the same time.
+    int labelNum() const {
+      return _pool.size();
+    }
+
+    /// @}
+
+  private:
+
+    // Build the adjacency arrays
+    void build() {
+      int n = 0;
+      for (NodeIt u(_graph); u != INVALID; ++u) {
+        _index[u] = n++;
+      }
+      _out_first.resize(n + 1);
+      _target.clear();
+      _arc_cost.clear();
+      _arc_res.clear();
+      _arcs.clear();
+      int i = 0;
+      for (NodeIt u(_graph); u != INVALID; ++u, ++i) {
+        _out_first[i] = _arcs.size();
+        for (OutArcIt a(_graph, u); a != INVALID; ++a) {
+          _arcs.push_back(a);
+          _target.push_back(_index[_graph.target(a)]);
+          _arc_cost.push_back(_cost[a]);
+          _arc_res.push_back(_resource[a]);
+        }
+      }
+      _out_first[n] = _arcs.size();
+    }
+
+    void search(int s) {
+      int n = _out_first.size() - 1;
+      _pool.clear();
+      _min_res.assign(n, Resource());
+      _has_label.assign(n, 0);
+      _perm.clear();
+
+      if (_reach[s]) {
+        // Use a bucket queue if the costs are integers and the reduced
+        // arc costs are small enough
+        _buckets = std::numeric_limits<Cost>::is_integer;
+        Cost width = Cost();
+        for (int u = 0; _buckets && u < n; ++u) {
+          if (!_reach[u]) continue;
+          for (int a = _out_first[u]; a != _out_first[u + 1]; ++a) {
+            int v = _target[a];
+            if (!_reach[v]) continue;
+            Cost c = _arc_cost[a] + _pot[v] - _pot[u];
+            if (width < c) width = c;
+            if (!(width < Cost(MAX_BUCKET_NUM - 1))) _buckets = false;
+          }
+        }
+        if (_buckets) {
+          BucketQueue queue(static_cast<int>(width) + 1, _pot[s]);
+          process(s, queue);
+        } else {
+          Heap queue;
+          process(s, queue);
+        }
+      }
+
+      // Sort the permanent labels by their nodes
+      _label_first.assign(n + 1, 0);
+      for (int i = 0; i < int(_perm.size()); ++i) {
+        ++_label_first[_pool.node[_perm[i]] + 1];
+      }
+      for (int u = 0; u < n; ++u) {
+        _label_first[u + 1] += _label_first[u];
+      }
+      _labels.resize(_perm.size());
+      std::vector<int> pos(_label_first.begin(), _label_first.end() - 1);
+      for (int i = 0; i < int(_perm.size()); ++i) {
+        _labels[pos[_pool.node[_perm[i]]]++] = _perm[i];
+      }
+    }
+
+    template <typename Queue>
+    void process(int s, Queue& queue) {
+      int l = _pool.add(s, Cost(), Resource(), -1, -1);
+      queue.push(_pot[s], Resource(), l);
+      while (!queue.empty()) {
+        l = queue.pop();
+        int u = _pool.node[l];
+        Resource r = _pool.res[l];
+
+        // Discard the label if it is dominated by a permanent label
+        // at the same node or at the target node
+        if ((_has_label[u] && !(r < _min_res[u])) ||
+            (_t >= 0 && u != _t && _has_label[_t] &&
+             !(r + _lower[u] < _min_res[_t]))) {
+          _pool.release(l);
+          continue;
+        }
+        _has_label[u] = 1;
+        _min_res[u] = r;
+        _perm.push_back(l);
+        if (u == _t) continue;
+
+        // Extend the label
+        Cost c = _pool.cost[l];
+        for (int a = _out_first[u]; a != _out_first[u + 1]; ++a) {
+          int v = _target[a];
+          if (!_reach[v]) continue;
+          Resource nr = r + _arc_res[a];
+          if (_has_label[v] && !(nr < _min_res[v])) continue;
+          if (_limited && _limit < nr + _lower[v]) continue;
+          if (_t >= 0 && _has_label[_t] &&
+              !(nr + _lower[v] < _min_res[_t])) continue;
+          Cost nc = c + _arc_cost[a];
+          queue.push(nc + _pot[v], nr, _pool.add(v, nc, nr, l, a));
+        }
+      }
+    }
+
+  }; //class ResourceConstrainedPath
+
+  ///@}
+
+} //namespace lemon
+
+#endif //LEMON_RESOURCE_CONSTRAINED_PATH_H
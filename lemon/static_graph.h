@@ -21,13 +21,160 @@
 
 ///\ingroup graphs
 ///\file
-///\brief StaticDigraph class.
+///\brief StaticDigraph, StaticGraph and StaticBpGraph classes.
+
+#include <vector>
+#include <algorithm>
+#include <functional>
 
 #include <lemon/core.h>
+#include <lemon/maps.h>
 #include <lemon/bits/graph_extender.h>
+#include <lemon/bits/adjacency.h>
+#include <lemon/bits/parallel.h>
 
 namespace lemon {
 
+  namespace _static_graph_bits {
+
+    template <typename ArcListIterator>
+    class CountArcsTask {
+    public:
+      CountArcsTask(ArcListIterator begin, int node_num,
+                    int *out_count, int *in_count)
+        : _begin(begin), _node_num(node_num),
+          _out_count(out_count), _in_count(in_count) {}
+
+      void operator()(int first, int last) {
+        for (int k = first; k < last; ++k) {
+          int i = _begin[k].first, j = _begin[k].second;
+          LEMON_ASSERT(i >= 0 && i < _node_num && j >= 0 && j < _node_num,
+                       "Wrong arc list for StaticDigraph::parallelBuild()");
+          bits::atomicFetchAdd(_out_count + i, 1);
+          bits::atomicFetchAdd(_in_count + j, 1);
+        }
+      }
+
+    private:
+      ArcListIterator _begin;
+      int _node_num;
+      int *_out_count, *_in_count;
+    };
+
+    template <typename ArcListIterator>
+    class PlaceArcsTask {
+    public:
+      PlaceArcsTask(ArcListIterator begin, int *out_pos, int *in_pos,
+                    int *out_perm, int *in_perm)
+        : _begin(begin), _out_pos(out_pos), _in_pos(in_pos),
+          _out_perm(out_perm), _in_perm(in_perm) {}
+
+      void operator()(int first, int last) {
+        for (int k = first; k < last; ++k) {
+          _out_perm[bits::atomicFetchAdd(_out_pos + _begin[k].first, 1)] = k;
+          _in_perm[bits::atomicFetchAdd(_in_pos + _begin[k].second, 1)] = k;
+        }
+      }
+
+    private:
+      ArcListIterator _begin;
+      int *_out_pos, *_in_pos;
+      int *_out_perm, *_in_perm;
+    };
+
+    template <typename ArcListIterator>
+    class OutListTask {
+    public:
+      OutListTask(ArcListIterator begin, const int *node_first_out,
+                  int *out_perm, int *arc_source, int *arc_target,
+                  int *arc_next_out, int *arc_index)
+        : _begin(begin), _node_first_out(node_first_out),
+          _out_perm(out_perm), _arc_source(arc_source),
+          _arc_target(arc_target), _arc_next_out(arc_next_out),
+          _arc_index(arc_index) {}
+
+      void operator()(int first, int last) {
+        for (int i = first; i < last; ++i) {
+          int b = _node_first_out[i], e = _node_first_out[i + 1];
+          std::sort(_out_perm + b, _out_perm + e);
+          for (int a = b; a < e; ++a) {
+            int k = _out_perm[a];
+            _arc_source[a] = i;
+            _arc_target[a] = _begin[k].second;
+            _arc_next_out[a] = a + 1 < e ? a + 1 : -1;
+            _arc_index[k] = a;
+          }
+        }
+      }
+
+    private:
+      ArcListIterator _begin;
+      const int *_node_first_out;
+      int *_out_perm;
+      int *_arc_source, *_arc_target, *_arc_next_out;
+      int *_arc_index;
+    };
+
+    class InListTask {
+    public:
+      InListTask(const int *in_first, int *in_perm, const int *arc_index,
+                 int *node_first_in, int *arc_next_in)
+        : _in_first(in_first), _in_perm(in_perm), _arc_index(arc_index),
+          _node_first_in(node_first_in), _arc_next_in(arc_next_in) {}
+
+      void operator()(int first, int last) {
+        for (int j = first; j < last; ++j) {
+          int b = _in_first[j], e = _in_first[j + 1];
+          for (int a = b; a < e; ++a) {
+            _in_perm[a] = _arc_index[_in_perm[a]];
+          }
+          std::sort(_in_perm + b, _in_perm + e, std::greater<int>());
+          _node_first_in[j] = b < e ? _in_perm[b] : -1;
+          for (int a = b; a < e; ++a) {
+            _arc_next_in[_in_perm[a]] = a + 1 < e ? _in_perm[a + 1] : -1;
+          }
+        }
+      }
+
+    private:
+      const int *_in_first;
+      int *_in_perm;
+      const int *_arc_index;
+      int *_node_first_in, *_arc_next_in;
+    };
+
+    template <typename Digraph, typename ArcRefMap>
+    class ArcRefTask {
+    public:
+      ArcRefTask(const int *arc_index, ArcRefMap& arc_ref)
+        : _arc_index(arc_index), _arc_ref(arc_ref) {}
+
+      void operator()(int first, int last) {
+        for (int k = first; k < last; ++k) {
+          _arc_ref[k] = Digraph::arcFromId(_arc_index[k]);
+        }
+      }
+
+    private:
+      const int *_arc_index;
+      ArcRefMap& _arc_ref;
+    };
+
+    class FillTask {
+    public:
+      FillTask(int *data, int value) : _data(data), _value(value) {}
+
+      void operator()(int first, int last) {
+        std::fill(_data + first, _data + last, _value);
+      }
+
+    private:
+      int *_data;
+      int _value;
+    };
+
+  }
+
   class StaticDigraphBase {
 
   public:
@@ -240,6 +387,61 @@ namespace lemon {
       node_first_out[node_num] = arc_num;
     }
 
+    template <typename ArcListIterator, typename ArcRefMap>
+    void parallelBuild(int n, ArcListIterator first, ArcListIterator last,
+                       ArcRefMap& arcRef, int threads) {
+      using namespace _static_graph_bits;
+
+      built = true;
+
+      node_num = n;
+      arc_num = static_cast<int>(last - first);
+
+      node_first_out = new int[node_num + 1];
+      node_first_in = new int[node_num];
+
+      arc_source = new int[arc_num];
+      arc_target = new int[arc_num];
+      arc_next_out = new int[arc_num];
+      arc_next_in = new int[arc_num];
+
+      threads = bits::parallelThreadNum(threads, arc_num);
+
+      std::vector<int> in_first(node_num + 1);
+      FillTask fill(node_first_out, 0);
+      bits::parallelFor(threads, 0, node_num, fill);
+
+      CountArcsTask<ArcListIterator>
+        count(first, node_num, node_first_out, &in_first[0]);
+      bits::parallelFor(threads, 0, arc_num, count);
+      bits::parallelPrefixSum(threads, node_first_out, node_num);
+      bits::parallelPrefixSum(threads, &in_first[0], node_num);
+
+      // Stable ordering is restored by sorting the segments afterwards
+      std::vector<int> out_pos(node_first_out, node_first_out + node_num + 1);
+      std::vector<int> in_pos(in_first);
+      std::vector<int> in_perm(arc_num + 1);
+      std::vector<int> arc_index(arc_num + 1);
+      int *out_perm = arc_next_out;
+      PlaceArcsTask<ArcListIterator>
+        place(first, &out_pos[0], &in_pos[0], out_perm, &in_perm[0]);
+      bits::parallelFor(threads, 0, arc_num, place);
+      std::vector<int>().swap(out_pos);
+      std::vector<int>().swap(in_pos);
+
+      OutListTask<ArcListIterator>
+        out_list(first, node_first_out, out_perm, arc_source, arc_target,
+                 arc_next_out, &arc_index[0]);
+      bits::parallelFor(threads, 0, node_num, out_list, 1024);
+
+      InListTask in_list(&in_first[0], &in_perm[0], &arc_index[0],
+                         node_first_in, arc_next_in);
+      bits::parallelFor(threads, 0, node_num, in_list, 1024);
+
+      ArcRefTask<StaticDigraphBase, ArcRefMap> arc_ref(&arc_index[0], arcRef);
+      bits::parallelFor(threads, 0, arc_num, arc_ref);
+    }
+
   protected:
 
     void fastFirstOut(Arc& e, const Node& n) const {
@@ -418,6 +620,69 @@ namespace lemon {
       notifier(Arc()).build();
     }
 
+    /// \brief Build the digraph from an unsorted arc list in parallel.
+    ///
+    /// This function builds the digraph from the given arc list using
+    /// several threads. In contrast to build(), the arcs can be given in
+    /// arbitrary order. The arcs are distributed to their source and
+    /// target nodes by a parallel counting sort, which constructs the
+    /// outgoing and incoming arc lists at the same time.
+    /// It can be called more than once, but in such case, the whole
+    /// structure and all maps will be cleared and rebuilt.
+    ///
+    /// The list of the arcs must be given in the range <tt>[begin, end)</tt>
+    /// specified by STL compatible random access iterators whose
+    /// \c value_type must be <tt>std::pair<int,int></tt>.
+    /// Each arc must be specified by a pair of integer indices
+    /// from the range <tt>[0..n-1]</tt>.
+    /// The outgoing arcs of each node are indexed in the same order
+    /// as they appear in the list, thus if the list is sorted
+    /// with respect to the first values of the pairs, the result is
+    /// the same as that of build().
+    ///
+    /// \param n The number of nodes.
+    /// \param begin An iterator pointing to the beginning of the arc list.
+    /// \param end An iterator pointing to the end of the arc list.
+    /// \param arcRef The arc references will be copied into this map.
+    /// Its key type must be \c int, the position of the pair in the
+    /// list, and its value type must be \c StaticDigraph::Arc
+    /// (e.g. an <tt>std::vector<StaticDigraph::Arc></tt> of sufficient
+    /// size). It is written concurrently by the threads.
+    /// \param threads The number of threads to be used. The value 0
+    /// stands for the number of the available processors.
+    ///
+    /// For example, a digraph can be built from a shuffled arc list
+    /// like this.
+    /// \code
+    ///   std::vector<std::pair<int,int> > arcs;
+    ///   arcs.push_back(std::make_pair(3,0));
+    ///   arcs.push_back(std::make_pair(0,1));
+    ///   arcs.push_back(std::make_pair(1,2));
+    ///   std::vector<StaticDigraph::Arc> arc_ref(arcs.size());
+    ///   StaticDigraph gr;
+    ///   gr.parallelBuild(4, arcs.begin(), arcs.end(), arc_ref);
+    /// \endcode
+    template <typename ArcListIterator, typename ArcRefMap>
+    void parallelBuild(int n, ArcListIterator begin, ArcListIterator end,
+                       ArcRefMap& arcRef, int threads = 0) {
+      if (built) Parent::clear();
+      StaticDigraphBase::parallelBuild(n, begin, end, arcRef, threads);
+      notifier(Node()).build();
+      notifier(Arc()).build();
+    }
+
+    /// \brief Build the digraph from an unsorted arc list in parallel.
+    ///
+    /// This function builds the digraph from the given arc list using
+    /// several threads. It is the same as the other version of
+    /// parallelBuild(), but the arc references are not stored.
+    template <typename ArcListIterator>
+    void parallelBuild(int n, ArcListIterator begin, ArcListIterator end,
+                       int threads = 0) {
+      NullMap<int, Arc> arcRef;
+      parallelBuild(n, begin, end, arcRef, threads);
+    }
+
     /// \brief Clear the digraph.
     ///
     /// This function erases all nodes and arcs from the digraph.
@@ -480,6 +745,1047 @@ namespace lemon {
 
   };
 
+
+  namespace _static_graph_bits {
+
+    // Incidence iterators of the CSR based undirected graphs. The
+    // outgoing arcs of each node are stored contiguously in the
+    // out_arcs array of the base class, so OutArcIt and IncEdgeIt
+    // simply walk this range.
+    template <typename Base>
+    class IncidenceExtender : public Base {
+      typedef Base Parent;
+
+    public:
+
+      typedef typename Parent::Node Node;
+      typedef typename Parent::Arc Arc;
+      typedef typename Parent::Edge Edge;
+      typedef typename Parent::InArcIt InArcIt;
+
+      class OutArcIt : public Arc {
+      public:
+
+        OutArcIt() { }
+
+        OutArcIt(Invalid i) : Arc(i) { }
+
+        OutArcIt(const IncidenceExtender& graph, const Node& node)
+          : _graph(&graph) {
+          graph.fastFirstOut(_pos, node);
+          graph.fastLastOut(_last, node);
+          Arc::operator=(_pos != _last ?
+                         Parent::arcFromId(graph.fastOutArc(_pos)) :
+                         Arc(INVALID));
+        }
+
+        OutArcIt(const IncidenceExtender& graph, const Arc& arc)
+          : Arc(arc), _graph(&graph) {
+          if (arc != INVALID) {
+            Node n = graph.source(arc);
+            graph.fastFirstOut(_pos, n);
+            graph.fastLastOut(_last, n);
+            while (graph.fastOutArc(_pos) != graph.id(arc)) ++_pos;
+          }
+        }
+
+        OutArcIt& operator++() {
+          ++_pos;
+          Arc::operator=(_pos != _last ?
+                         Parent::arcFromId(_graph->fastOutArc(_pos)) :
+                         Arc(INVALID));
+          return *this;
+        }
+
+      private:
+        const IncidenceExtender* _graph;
+        int _pos, _last;
+      };
+
+      class IncEdgeIt : public Edge {
+        friend class IncidenceExtender;
+      public:
+
+        IncEdgeIt() { }
+
+        IncEdgeIt(Invalid i) : Edge(i), _direction(false) { }
+
+        IncEdgeIt(const IncidenceExtender& graph, const Node& node)
+          : _graph(&graph) {
+          graph.fastFirstOut(_pos, node);
+          graph.fastLastOut(_last, node);
+          set();
+        }
+
+        IncEdgeIt(const IncidenceExtender& graph, const Edge& edge,
+                  const Node& node)
+          : Edge(edge), _graph(&graph) {
+          if (edge != INVALID) {
+            Arc arc = graph.direct(edge, node);
+            graph.fastFirstOut(_pos, node);
+            graph.fastLastOut(_last, node);
+            while (graph.fastOutArc(_pos) != graph.id(arc)) ++_pos;
+            _direction = graph.direction(arc);
+          }
+        }
+
+        IncEdgeIt& operator++() {
+          ++_pos;
+          set();
+          return *this;
+        }
+
+      private:
+        void set() {
+          if (_pos != _last) {
+            int a = _graph->fastOutArc(_pos);
+            Edge::operator=(Parent::edgeFromId(a / 2));
+            _direction = (a & 1) == 1;
+          } else {
+            Edge::operator=(INVALID);
+            _direction = false;
+          }
+        }
+
+        const IncidenceExtender* _graph;
+        int _pos, _last;
+        bool _direction;
+      };
+
+      Node baseNode(const OutArcIt &arc) const {
+        return Parent::source(static_cast<const Arc&>(arc));
+      }
+
+      Node runningNode(const OutArcIt &arc) const {
+        return Parent::target(static_cast<const Arc&>(arc));
+      }
+
+      Node baseNode(const InArcIt &arc) const {
+        return Parent::target(static_cast<const Arc&>(arc));
+      }
+
+      Node runningNode(const InArcIt &arc) const {
+        return Parent::source(static_cast<const Arc&>(arc));
+      }
+
+      Node baseNode(const IncEdgeIt &edge) const {
+        return edge._direction ? this->u(edge) : this->v(edge);
+      }
+
+      Node runningNode(const IncEdgeIt &edge) const {
+        return edge._direction ? this->v(edge) : this->u(edge);
+      }
+
+    };
+
+  }
+
+  class StaticGraphBase {
+
+  public:
+
+    StaticGraphBase()
+      : built(false), node_num(0), edge_num(0),
+        node_first_out(NULL), out_arcs(NULL),
+        arc_target(NULL), arc_next_out(NULL) {}
+
+    ~StaticGraphBase() {
+      if (built) {
+        delete[] node_first_out;
+        delete[] out_arcs;
+        delete[] arc_target;
+        delete[] arc_next_out;
+      }
+    }
+
+    class Node {
+      friend class StaticGraphBase;
+    protected:
+      int id;
+      Node(int _id) : id(_id) {}
+    public:
+      Node() {}
+      Node (Invalid) : id(-1) {}
+      bool operator==(const Node& node) const { return id == node.id; }
+      bool operator!=(const Node& node) const { return id != node.id; }
+      bool operator<(const Node& node) const { return id < node.id; }
+    };
+
+    class Edge {
+      friend class StaticGraphBase;
+    protected:
+      int id;
+      Edge(int _id) : id(_id) {}
+    public:
+      Edge() {}
+      Edge (Invalid) : id(-1) {}
+      bool operator==(const Edge& edge) const { return id == edge.id; }
+      bool operator!=(const Edge& edge) const { return id != edge.id; }
+      bool operator<(const Edge& edge) const { return id < edge.id; }
+    };
+
+    class Arc {
+      friend class StaticGraphBase;
+    protected:
+      int id;
+      Arc(int _id) : id(_id) {}
+    public:
+      operator Edge() const {
+        return id != -1 ? edgeFromId(id / 2) : INVALID;
+      }
+
+      Arc() {}
+      Arc (Invalid) : id(-1) {}
+      bool operator==(const Arc& arc) const { return id == arc.id; }
+      bool operator!=(const Arc& arc) const { return id != arc.id; }
+      bool operator<(const Arc& arc) const { return id < arc.id; }
+    };
+
+    Node source(const Arc& e) const { return Node(arc_target[e.id ^ 1]); }
+    Node target(const Arc& e) const { return Node(arc_target[e.id]); }
+
+    Node u(const Edge& e) const { return Node(arc_target[2 * e.id]); }
+    Node v(const Edge& e) const { return Node(arc_target[2 * e.id + 1]); }
+
+    static bool direction(const Arc& e) { return (e.id & 1) == 1; }
+    static Arc direct(const Edge& e, bool d) {
+      return Arc(e.id * 2 + (d ? 1 : 0));
+    }
+
+    void first(Node& n) const { n.id = node_num - 1; }
+    static void next(Node& n) { --n.id; }
+
+    void first(Arc& e) const { e.id = 2 * edge_num - 1; }
+    static void next(Arc& e) { --e.id; }
+
+    void first(Edge& e) const { e.id = edge_num - 1; }
+    static void next(Edge& e) { --e.id; }
+
+    void firstOut(Arc& e, const Node& n) const {
+      e.id = node_first_out[n.id] != node_first_out[n.id + 1] ?
+        out_arcs[node_first_out[n.id]] : -1;
+    }
+    void nextOut(Arc& e) const { e.id = arc_next_out[e.id]; }
+
+    void firstIn(Arc& e, const Node& n) const {
+      firstOut(e, n);
+      if (e.id != -1) e.id ^= 1;
+    }
+    void nextIn(Arc& e) const {
+      e.id = arc_next_out[e.id ^ 1];
+      if (e.id != -1) e.id ^= 1;
+    }
+
+    void firstInc(Edge& e, bool& d, const Node& n) const {
+      Arc a;
+      firstOut(a, n);
+      e.id = a.id != -1 ? a.id / 2 : -1;
+      d = a.id != -1 ? (a.id & 1) == 1 : true;
+    }
+    void nextInc(Edge& e, bool& d) const {
+      int a = arc_next_out[2 * e.id + (d ? 1 : 0)];
+      e.id = a != -1 ? a / 2 : -1;
+      d = a != -1 ? (a & 1) == 1 : true;
+    }
+
+    static int id(const Node& n) { return n.id; }
+    static Node nodeFromId(int id) { return Node(id); }
+    int maxNodeId() const { return node_num - 1; }
+
+    static int id(const Edge& e) { return e.id; }
+    static Edge edgeFromId(int id) { return Edge(id); }
+    int maxEdgeId() const { return edge_num - 1; }
+
+    static int id(const Arc& e) { return e.id; }
+    static Arc arcFromId(int id) { return Arc(id); }
+    int maxArcId() const { return 2 * edge_num - 1; }
+
+    typedef True NodeNumTag;
+    typedef True EdgeNumTag;
+    typedef True ArcNumTag;
+
+    int nodeNum() const { return node_num; }
+    int edgeNum() const { return edge_num; }
+    int arcNum() const { return 2 * edge_num; }
+
+    typedef True BuildTag;
+
+    void clear() {
+      if (built) {
+        delete[] node_first_out;
+        delete[] out_arcs;
+        delete[] arc_target;
+        delete[] arc_next_out;
+      }
+      built = false;
+      node_num = 0;
+      edge_num = 0;
+    }
+
+    template <typename Graph, typename NodeRefMap, typename EdgeRefMap>
+    void build(const Graph& graph, NodeRefMap& nodeRef, EdgeRefMap& edgeRef) {
+      allocate(countNodes(graph), countEdges(graph));
+
+      int node_index = 0;
+      for (typename Graph::NodeIt n(graph); n != INVALID; ++n) {
+        nodeRef[n] = Node(node_index);
+        ++node_index;
+      }
+
+      int edge_index = 0;
+      for (typename Graph::EdgeIt e(graph); e != INVALID; ++e) {
+        edgeRef[e] = Edge(edge_index);
+        arc_target[2 * edge_index] = nodeRef[graph.u(e)].id;
+        arc_target[2 * edge_index + 1] = nodeRef[graph.v(e)].id;
+        ++edge_index;
+      }
+      buildAdjacency();
+    }
+
+    template <typename EdgeListIterator>
+    void build(int n, EdgeListIterator first, EdgeListIterator last) {
+      allocate(n, static_cast<int>(std::distance(first, last)));
+
+      int edge_index = 0;
+      for ( ; first != last; ++first) {
+        int i = (*first).first, j = (*first).second;
+        LEMON_ASSERT(i >= 0 && i < node_num && j >= 0 && j < node_num,
+          "Wrong edge list for StaticGraph::build()");
+        arc_target[2 * edge_index] = i;
+        arc_target[2 * edge_index + 1] = j;
+        ++edge_index;
+      }
+      buildAdjacency();
+    }
+
+  private:
+
+    void allocate(int n, int m) {
+      built = true;
+
+      node_num = n;
+      edge_num = m;
+
+      node_first_out = new int[node_num + 1];
+      out_arcs = new int[2 * edge_num];
+      arc_target = new int[2 * edge_num];
+      arc_next_out = new int[2 * edge_num];
+    }
+
+    void buildAdjacency() {
+      bits::buildIncidence(node_num, 2 * edge_num, arc_target,
+                           node_first_out, out_arcs, arc_next_out);
+    }
+
+  protected:
+
+    void fastFirstOut(int& pos, const Node& n) const {
+      pos = node_first_out[n.id];
+    }
+    void fastLastOut(int& pos, const Node& n) const {
+      pos = node_first_out[n.id + 1];
+    }
+    int fastOutArc(int pos) const {
+      return out_arcs[pos];
+    }
+
+  protected:
+    bool built;
+    int node_num;
+    int edge_num;
+    int *node_first_out;
+    int *out_arcs;
+    int *arc_target;
+    int *arc_next_out;
+  };
+
+  typedef _static_graph_bits::IncidenceExtender<
+    GraphExtender<StaticGraphBase> > ExtendedStaticGraphBase;
+
+
+  /// \ingroup graphs
+  ///
+  /// \brief A static undirected graph class.
+  ///
+  /// \ref StaticGraph is a highly efficient undirected graph
+  /// implementation, but it is fully static.
+  /// The incident arcs of the nodes are stored in compact arrays
+  /// (in compressed sparse row format), thus it provides faster
+  /// iteration of the incident edges and arcs than \ref ListGraph and
+  /// \ref SmartGraph, especially using \c OutArcIt and \c IncEdgeIt
+  /// iterators. It stores only one \c int value for each node and
+  /// three \c int values for each arc.
+  /// However it only provides build() and clear() functions and does not
+  /// support any other modification of the graph.
+  ///
+  /// The two arcs of an edge are paired as in \ref SmartGraph, i.e. the
+  /// edge with index \c i has the arcs with indices <tt>2*i</tt> and
+  /// <tt>2*i+1</tt>, the latter one is directed from \c u(e) to \c v(e).
+  /// Since this graph structure is completely static, its nodes, edges
+  /// and arcs can be indexed with integers from the ranges
+  /// <tt>[0..nodeNum()-1]</tt>, <tt>[0..edgeNum()-1]</tt> and
+  /// <tt>[0..arcNum()-1]</tt>, respectively.
+  /// The index of an item is the same as its ID, it can be obtained
+  /// using the corresponding \ref index() or \ref concepts::Graph::id()
+  /// "id()" function. A node, edge or arc with a certain index can be
+  /// obtained using node(), edge() or arc().
+  ///
+  /// This type fully conforms to the \ref concepts::Graph "Graph concept".
+  /// Most of its member functions and nested classes are documented
+  /// only in the concept class.
+  ///
+  /// This class provides constant time counting for nodes, edges and arcs.
+  ///
+  /// \sa concepts::Graph
+  /// \sa StaticDigraph
+  class StaticGraph : public ExtendedStaticGraphBase {
+
+  private:
+    /// Graphs are \e not copy constructible. Use GraphCopy instead.
+    StaticGraph(const StaticGraph &) : ExtendedStaticGraphBase() {};
+    /// \brief Assignment of a graph to another one is \e not allowed.
+    /// Use GraphCopy instead.
+    void operator=(const StaticGraph&) {}
+
+  public:
+
+    typedef ExtendedStaticGraphBase Parent;
+
+  public:
+
+    /// \brief Constructor
+    ///
+    /// Default constructor.
+    StaticGraph() : Parent() {}
+
+    /// \brief The node with the given index.
+    ///
+    /// This function returns the node with the given index.
+    /// \sa index()
+    static Node node(int ix) { return Parent::nodeFromId(ix); }
+
+    /// \brief The edge with the given index.
+    ///
+    /// This function returns the edge with the given index.
+    /// \sa index()
+    static Edge edge(int ix) { return Parent::edgeFromId(ix); }
+
+    /// \brief The arc with the given index.
+    ///
+    /// This function returns the arc with the given index.
+    /// \sa index()
+    static Arc arc(int ix) { return Parent::arcFromId(ix); }
+
+    /// \brief The index of the given node.
+    ///
+    /// This function returns the index of the the given node.
+    /// \sa node()
+    static int index(Node node) { return Parent::id(node); }
+
+    /// \brief The index of the given edge.
+    ///
+    /// This function returns the index of the the given edge.
+    /// \sa edge()
+    static int index(Edge edge) { return Parent::id(edge); }
+
+    /// \brief The index of the given arc.
+    ///
+    /// This function returns the index of the the given arc.
+    /// \sa arc()
+    static int index(Arc arc) { return Parent::id(arc); }
+
+    /// \brief Number of nodes.
+    ///
+    /// This function returns the number of nodes.
+    int nodeNum() const { return node_num; }
+
+    /// \brief Number of edges.
+    ///
+    /// This function returns the number of edges.
+    int edgeNum() const { return edge_num; }
+
+    /// \brief Number of arcs.
+    ///
+    /// This function returns the number of arcs.
+    int arcNum() const { return 2 * edge_num; }
+
+    /// \brief Build the graph copying another graph.
+    ///
+    /// This function builds the graph copying another graph of any
+    /// kind. It can be called more than once, but in such case, the whole
+    /// structure and all maps will be cleared and rebuilt.
+    ///
+    /// This method also makes possible to copy a graph to a StaticGraph
+    /// structure using \ref GraphCopy.
+    ///
+    /// \param graph An existing graph to be copied.
+    /// \param nodeRef The node references will be copied into this map.
+    /// Its key type must be \c Graph::Node and its value type must be
+    /// \c StaticGraph::Node.
+    /// It must conform to the \ref concepts::ReadWriteMap "ReadWriteMap"
+    /// concept.
+    /// \param edgeRef The edge references will be copied into this map.
+    /// Its key type must be \c Graph::Edge and its value type must be
+    /// \c StaticGraph::Edge.
+    /// It must conform to the \ref concepts::WriteMap "WriteMap" concept.
+    ///
+    /// \note If you do not need the edge references, then you could use
+    /// \ref NullMap for the last parameter. However the node references
+    /// are required by the function itself, thus they must be readable
+    /// from the map.
+    template <typename Graph, typename NodeRefMap, typename EdgeRefMap>
+    void build(const Graph& graph, NodeRefMap& nodeRef, EdgeRefMap& edgeRef) {
+      if (built) Parent::clear();
+      Parent::build(graph, nodeRef, edgeRef);
+    }
+
+    /// \brief Build the graph from an edge list.
+    ///
+    /// This function builds the graph from the given edge list.
+    /// It can be called more than once, but in such case, the whole
+    /// structure and all maps will be cleared and rebuilt.
+    ///
+    /// The list of the edges must be given in the range <tt>[begin, end)</tt>
+    /// specified by STL compatible itartors whose \c value_type must be
+    /// <tt>std::pair<int,int></tt>.
+    /// Each edge must be specified by a pair of integer indices
+    /// from the range <tt>[0..n-1]</tt>. The pairs can be given in
+    /// arbitrary order.
+    /// If the k-th pair in the list is <tt>(i,j)</tt>, then
+    /// <tt>edge(k-1)</tt> will connect <tt>node(i)</tt> and
+    /// <tt>node(j)</tt>, i.e. <tt>u(edge(k-1)) == node(i)</tt> and
+    /// <tt>v(edge(k-1)) == node(j)</tt>.
+    ///
+    /// \param n The number of nodes.
+    /// \param begin An iterator pointing to the beginning of the edge list.
+    /// \param end An iterator pointing to the end of the edge list.
+    ///
+    /// For example, a simple graph can be constructed like this.
+    /// \code
+    ///   std::vector<std::pair<int,int> > edges;
+    ///   edges.push_back(std::make_pair(0,1));
+    ///   edges.push_back(std::make_pair(0,2));
+    ///   edges.push_back(std::make_pair(1,3));
+    ///   edges.push_back(std::make_pair(2,3));
+    ///   StaticGraph gr;
+    ///   gr.build(4, edges.begin(), edges.end());
+    /// \endcode
+    template <typename EdgeListIterator>
+    void build(int n, EdgeListIterator begin, EdgeListIterator end) {
+      if (built) Parent::clear();
+      StaticGraphBase::build(n, begin, end);
+      notifier(Node()).build();
+      notifier(Edge()).build();
+      notifier(Arc()).build();
+    }
+
+    /// \brief Clear the graph.
+    ///
+    /// This function erases all nodes and edges from the graph.
+    void clear() {
+      Parent::clear();
+    }
+
+  };
+
+
+  class StaticBpGraphBase {
+
+  public:
+
+    StaticBpGraphBase()
+      : built(false), red_num(0), node_num(0), edge_num(0),
+        node_first_out(NULL), out_arcs(NULL),
+        arc_target(NULL), arc_next_out(NULL) {}
+
+    ~StaticBpGraphBase() {
+      if (built) {
+        delete[] node_first_out;
+        delete[] out_arcs;
+        delete[] arc_target;
+        delete[] arc_next_out;
+      }
+    }
+
+    class Node {
+      friend class StaticBpGraphBase;
+    protected:
+      int id;
+      Node(int _id) : id(_id) {}
+    public:
+      Node() {}
+      Node (Invalid) : id(-1) {}
+      bool operator==(const Node& node) const { return id == node.id; }
+      bool operator!=(const Node& node) const { return id != node.id; }
+      bool operator<(const Node& node) const { return id < node.id; }
+    };
+
+    class RedNode : public Node {
+      friend class StaticBpGraphBase;
+    protected:
+      explicit RedNode(int pid) : Node(pid) {}
+    public:
+      RedNode() {}
+      RedNode(Invalid) : Node(INVALID){}
+    };
+
+    class BlueNode : public Node {
+      friend class StaticBpGraphBase;
+    protected:
+      explicit BlueNode(int pid) : Node(pid) {}
+    public:
+      BlueNode() {}
+      BlueNode(Invalid) : Node(INVALID){}
+    };
+
+    class Edge {
+      friend class StaticBpGraphBase;
+    protected:
+      int id;
+      Edge(int _id) : id(_id) {}
+    public:
+      Edge() {}
+      Edge (Invalid) : id(-1) {}
+      bool operator==(const Edge& edge) const { return id == edge.id; }
+      bool operator!=(const Edge& edge) const { return id != edge.id; }
+      bool operator<(const Edge& edge) const { return id < edge.id; }
+    };
+
+    class Arc {
+      friend class StaticBpGraphBase;
+    protected:
+      int id;
+      Arc(int _id) : id(_id) {}
+    public:
+      operator Edge() const {
+        return id != -1 ? edgeFromId(id / 2) : INVALID;
+      }
+
+      Arc() {}
+      Arc (Invalid) : id(-1) {}
+      bool operator==(const Arc& arc) const { return id == arc.id; }
+      bool operator!=(const Arc& arc) const { return id != arc.id; }
+      bool operator<(const Arc& arc) const { return id < arc.id; }
+    };
+
+    typedef True NodeNumTag;
+    typedef True EdgeNumTag;
+    typedef True ArcNumTag;
+
+    int nodeNum() const { return node_num; }
+    int redNum() const { return red_num; }
+    int blueNum() const { return node_num - red_num; }
+    int edgeNum() const { return edge_num; }
+    int arcNum() const { return 2 * edge_num; }
+
+    int maxNodeId() const { return node_num - 1; }
+    int maxRedId() const { return red_num - 1; }
+    int maxBlueId() const { return node_num - red_num - 1; }
+    int maxEdgeId() const { return edge_num - 1; }
+    int maxArcId() const { return 2 * edge_num - 1; }
+
+    bool red(const Node& n) const { return n.id < red_num; }
+    bool blue(const Node& n) const { return n.id >= red_num; }
+
+    static RedNode asRedNodeUnsafe(const Node& n) { return RedNode(n.id); }
+    static BlueNode asBlueNodeUnsafe(const Node& n) { return BlueNode(n.id); }
+
+    Node source(const Arc& a) const { return Node(arc_target[a.id ^ 1]); }
+    Node target(const Arc& a) const { return Node(arc_target[a.id]); }
+
+    RedNode redNode(const Edge& e) const {
+      return RedNode(arc_target[2 * e.id]);
+    }
+    BlueNode blueNode(const Edge& e) const {
+      return BlueNode(arc_target[2 * e.id + 1]);
+    }
+
+    static bool direction(const Arc& a) { return (a.id & 1) == 1; }
+    static Arc direct(const Edge& e, bool d) {
+      return Arc(e.id * 2 + (d ? 1 : 0));
+    }
+
+    void first(Node& n) const { n.id = node_num - 1; }
+    static void next(Node& n) { --n.id; }
+
+    void first(RedNode& n) const { n.id = red_num - 1; }
+    static void next(RedNode& n) { --n.id; }
+
+    void first(BlueNode& n) const {
+      n.id = red_num == node_num ? -1 : node_num - 1;
+    }
+    void next(BlueNode& n) const {
+      n.id = n.id == red_num ? -1 : n.id - 1;
+    }
+
+    void first(Arc& a) const { a.id = 2 * edge_num - 1; }
+    static void next(Arc& a) { --a.id; }
+
+    void first(Edge& e) const { e.id = edge_num - 1; }
+    static void next(Edge& e) { --e.id; }
+
+    void firstOut(Arc& e, const Node& n) const {
+      e.id = node_first_out[n.id] != node_first_out[n.id + 1] ?
+        out_arcs[node_first_out[n.id]] : -1;
+    }
+    void nextOut(Arc& e) const { e.id = arc_next_out[e.id]; }
+
+    void firstIn(Arc& e, const Node& n) const {
+      firstOut(e, n);
+      if (e.id != -1) e.id ^= 1;
+    }
+    void nextIn(Arc& e) const {
+      e.id = arc_next_out[e.id ^ 1];
+      if (e.id != -1) e.id ^= 1;
+    }
+
+    void firstInc(Edge& e, bool& d, const Node& n) const {
+      Arc a;
+      firstOut(a, n);
+      e.id = a.id != -1 ? a.id / 2 : -1;
+      d = a.id != -1 ? (a.id & 1) == 1 : true;
+    }
+    void nextInc(Edge& e, bool& d) const {
+      int a = arc_next_out[2 * e.id + (d ? 1 : 0)];
+      e.id = a != -1 ? a / 2 : -1;
+      d = a != -1 ? (a & 1) == 1 : true;
+    }
+
+    static int id(const Node& n) { return n.id; }
+    static int id(const RedNode& n) { return n.id; }
+    int id(const BlueNode& n) const { return n.id - red_num; }
+    static int id(const Arc& e) { return e.id; }
+    static int id(const Edge& e) { return e.id; }
+
+    static Node nodeFromId(int id) { return Node(id); }
+    static Arc arcFromId(int id) { return Arc(id); }
+    static Edge edgeFromId(int id) { return Edge(id); }
+
+    static RedNode redNode(int index) { return RedNode(index); }
+    static int index(const RedNode& n) { return n.id; }
+
+    BlueNode blueNode(int index) const { return BlueNode(index + red_num); }
+    int index(const BlueNode& n) const { return n.id - red_num; }
+
+    typedef True BuildTag;
+
+    void clear() {
+      if (built) {
+        delete[] node_first_out;
+        delete[] out_arcs;
+        delete[] arc_target;
+        delete[] arc_next_out;
+      }
+      built = false;
+      red_num = 0;
+      node_num = 0;
+      edge_num = 0;
+    }
+
+    template <typename BpGraph, typename RedNodeRefMap,
+              typename BlueNodeRefMap, typename EdgeRefMap>
+    void build(const BpGraph& graph, RedNodeRefMap& redRef,
+               BlueNodeRefMap& blueRef, EdgeRefMap& edgeRef) {
+      allocate(countRedNodes(graph), countBlueNodes(graph),
+               countEdges(graph));
+
+      int red_index = 0;
+      for (typename BpGraph::RedNodeIt n(graph); n != INVALID; ++n) {
+        redRef[n] = RedNode(red_index);
+        ++red_index;
+      }
+      int blue_index = red_num;
+      for (typename BpGraph::BlueNodeIt n(graph); n != INVALID; ++n) {
+        blueRef[n] = BlueNode(blue_index);
+        ++blue_index;
+      }
+
+      int edge_index = 0;
+      for (typename BpGraph::EdgeIt e(graph); e != INVALID; ++e) {
+        edgeRef[e] = Edge(edge_index);
+        arc_target[2 * edge_index] = redRef[graph.redNode(e)].id;
+        arc_target[2 * edge_index + 1] = blueRef[graph.blueNode(e)].id;
+        ++edge_index;
+      }
+      buildAdjacency();
+    }
+
+    template <typename EdgeListIterator>
+    void build(int redNum, int blueNum,
+               EdgeListIterator first, EdgeListIterator last) {
+      allocate(redNum, blueNum, static_cast<int>(std::distance(first, last)));
+
+      int edge_index = 0;
+      for ( ; first != last; ++first) {
+        int i = (*first).first, j = (*first).second;
+        LEMON_ASSERT(i >= 0 && i < redNum && j >= 0 && j < blueNum,
+          "Wrong edge list for StaticBpGraph::build()");
+        arc_target[2 * edge_index] = i;
+        arc_target[2 * edge_index + 1] = red_num + j;
+        ++edge_index;
+      }
+      buildAdjacency();
+    }
+
+  private:
+
+    void allocate(int r, int b, int m) {
+      built = true;
+
+      red_num = r;
+      node_num = r + b;
+      edge_num = m;
+
+      node_first_out = new int[node_num + 1];
+      out_arcs = new int[2 * edge_num];
+      arc_target = new int[2 * edge_num];
+      arc_next_out = new int[2 * edge_num];
+    }
+
+    void buildAdjacency() {
+      bits::buildIncidence(node_num, 2 * edge_num, arc_target,
+                           node_first_out, out_arcs, arc_next_out);
+    }
+
+  protected:
+
+    void fastFirstOut(int& pos, const Node& n) const {
+      pos = node_first_out[n.id];
+    }
+    void fastLastOut(int& pos, const Node& n) const {
+      pos = node_first_out[n.id + 1];
+    }
+    int fastOutArc(int pos) const {
+      return out_arcs[pos];
+    }
+
+  protected:
+    bool built;
+    int red_num;
+    int node_num;
+    int edge_num;
+    int *node_first_out;
+    int *out_arcs;
+    int *arc_target;
+    int *arc_next_out;
+  };
+
+  typedef _static_graph_bits::IncidenceExtender<
+    BpGraphExtender<StaticBpGraphBase> > ExtendedStaticBpGraphBase;
+
+
+  /// \ingroup graphs
+  ///
+  /// \brief A static undirected bipartite graph class.
+  ///
+  /// \ref StaticBpGraph is a highly efficient bipartite graph
+  /// implementation, but it is fully static.
+  /// Similarly to \ref StaticGraph, the incident arcs of the nodes are
+  /// stored in compact arrays (in compressed sparse row format), thus
+  /// it provides fast iteration of the incident edges and arcs,
+  /// especially using \c OutArcIt and \c IncEdgeIt iterators.
+  /// It stores only one \c int value for each node and three \c int
+  /// values for each arc.
+  /// However it only provides build() and clear() functions and does not
+  /// support any other modification of the graph.
+  ///
+  /// The red nodes precede the blue nodes in the node numbering, thus
+  /// the red and blue indices of the nodes are computed arithmetically,
+  /// no separate index arrays are stored. Since this graph structure is
+  /// completely static, its red nodes, blue nodes, edges and arcs can
+  /// be indexed with integers from the ranges <tt>[0..redNum()-1]</tt>,
+  /// <tt>[0..blueNum()-1]</tt>, <tt>[0..edgeNum()-1]</tt> and
+  /// <tt>[0..arcNum()-1]</tt>, respectively (see redNode(), blueNode(),
+  /// edge(), arc() and index()). The arcs of an edge are paired as in
+  /// \ref StaticGraph.
+  ///
+  /// This type fully conforms to the \ref concepts::BpGraph "BpGraph concept",
+  /// thus it can be used by the algorithms for general graphs (e.g.
+  /// \ref MaxMatching or \ref MaxWeightedMatching) and, through the
+  /// \ref graph_adaptors "adaptors" (e.g. \ref Orienter), by the
+  /// algorithms for digraphs.
+  /// Most of its member functions and nested classes are documented
+  /// only in the concept class.
+  ///
+  /// This class provides constant time counting for nodes, edges and arcs.
+  ///
+  /// \sa concepts::BpGraph
+  /// \sa StaticGraph
+  class StaticBpGraph : public ExtendedStaticBpGraphBase {
+
+  private:
+    /// Graphs are \e not copy constructible. Use BpGraphCopy instead.
+    StaticBpGraph(const StaticBpGraph &) : ExtendedStaticBpGraphBase() {};
+    /// \brief Assignment of a graph to another one is \e not allowed.
+    /// Use BpGraphCopy instead.
+    void operator=(const StaticBpGraph&) {}
+
+  public:
+
+    typedef ExtendedStaticBpGraphBase Parent;
+
+  public:
+
+    /// \brief Constructor
+    ///
+    /// Default constructor.
+    StaticBpGraph() : Parent() {}
+
+    /// \brief The red node with the given index.
+    ///
+    /// This function returns the red node with the given index.
+    /// \sa index()
+    static RedNode redNode(int ix) { return Parent::redNode(ix); }
+
+    /// \brief The blue node with the given index.
+    ///
+    /// This function returns the blue node with the given index.
+    /// \sa index()
+    BlueNode blueNode(int ix) const { return Parent::blueNode(ix); }
+
+    using Parent::redNode;
+    using Parent::blueNode;
+
+    /// \brief The edge with the given index.
+    ///
+    /// This function returns the edge with the given index.
+    /// \sa index()
+    static Edge edge(int ix) { return Parent::edgeFromId(ix); }
+
+    /// \brief The arc with the given index.
+    ///
+    /// This function returns the arc with the given index.
+    /// \sa index()
+    static Arc arc(int ix) { return Parent::arcFromId(ix); }
+
+    /// \brief The index of the given red node.
+    ///
+    /// This function returns the index of the the given red node.
+    /// \sa redNode()
+    static int index(RedNode node) { return Parent::index(node); }
+
+    /// \brief The index of the given blue node.
+    ///
+    /// This function returns the index of the the given blue node.
+    /// \sa blueNode()
+    int index(BlueNode node) const { return Parent::index(node); }
+
+    /// \brief The index of the given edge.
+    ///
+    /// This function returns the index of the the given edge.
+    /// \sa edge()
+    static int index(Edge edge) { return Parent::id(edge); }
+
+    /// \brief The index of the given arc.
+    ///
+    /// This function returns the index of the the given arc.
+    /// \sa arc()
+    static int index(Arc arc) { return Parent::id(arc); }
+
+    /// \brief Number of nodes.
+    ///
+    /// This function returns the number of nodes.
+    int nodeNum() const { return node_num; }
+
+    /// \brief Number of red nodes.
+    ///
+    /// This function returns the number of red nodes.
+    int redNum() const { return red_num; }
+
+    /// \brief Number of blue nodes.
+    ///
+    /// This function returns the number of blue nodes.
+    int blueNum() const { return node_num - red_num; }
+
+    /// \brief Number of edges.
+    ///
+    /// This function returns the number of edges.
+    int edgeNum() const { return edge_num; }
+
+    /// \brief Number of arcs.
+    ///
+    /// This function returns the number of arcs.
+    int arcNum() const { return 2 * edge_num; }
+
+    /// \brief Build the graph copying another bipartite graph.
+    ///
+    /// This function builds the graph copying another bipartite graph
+    /// of any kind. It can be called more than once, but in such case,
+    /// the whole structure and all maps will be cleared and rebuilt.
+    ///
+    /// This method also makes possible to copy a graph to a StaticBpGraph
+    /// structure using \ref BpGraphCopy.
+    ///
+    /// \param graph An existing bipartite graph to be copied.
+    /// \param redRef The red node references will be copied into this map.
+    /// Its key type must be \c BpGraph::RedNode and its value type must be
+    /// \c StaticBpGraph::RedNode.
+    /// It must conform to the \ref concepts::ReadWriteMap "ReadWriteMap"
+    /// concept.
+    /// \param blueRef The blue node references will be copied into this
+    /// map. Its key type must be \c BpGraph::BlueNode and its value type
+    /// must be \c StaticBpGraph::BlueNode.
+    /// It must conform to the \ref concepts::ReadWriteMap "ReadWriteMap"
+    /// concept.
+    /// \param edgeRef The edge references will be copied into this map.
+    /// Its key type must be \c BpGraph::Edge and its value type must be
+    /// \c StaticBpGraph::Edge.
+    /// It must conform to the \ref concepts::WriteMap "WriteMap" concept.
+    template <typename BpGraph, typename RedNodeRefMap,
+              typename BlueNodeRefMap, typename EdgeRefMap>
+    void build(const BpGraph& graph, RedNodeRefMap& redRef,
+               BlueNodeRefMap& blueRef, EdgeRefMap& edgeRef) {
+      if (built) Parent::clear();
+      StaticBpGraphBase::build(graph, redRef, blueRef, edgeRef);
+      notifier(RedNode()).build();
+      notifier(BlueNode()).build();
+      notifier(Node()).build();
+      notifier(Edge()).build();
+      notifier(Arc()).build();
+    }
+
+    /// \brief Build the graph from an edge list.
+    ///
+    /// This function builds the graph from the given edge list.
+    /// It can be called more than once, but in such case, the whole
+    /// structure and all maps will be cleared and rebuilt.
+    ///
+    /// The list of the edges must be given in the range <tt>[begin, end)</tt>
+    /// specified by STL compatible itartors whose \c value_type must be
+    /// <tt>std::pair<int,int></tt>.
+    /// Each edge must be specified by a pair of a red node index from
+    /// the range <tt>[0..redNum-1]</tt> and a blue node index from the
+    /// range <tt>[0..blueNum-1]</tt>. The pairs can be given in
+    /// arbitrary order.
+    /// If the k-th pair in the list is <tt>(i,j)</tt>, then
+    /// <tt>edge(k-1)</tt> will connect <tt>redNode(i)</tt> and
+    /// <tt>blueNode(j)</tt>.
+    ///
+    /// \param redNum The number of red nodes.
+    /// \param blueNum The number of blue nodes.
+    /// \param begin An iterator pointing to the beginning of the edge list.
+    /// \param end An iterator pointing to the end of the edge list.
+    template <typename EdgeListIterator>
+    void build(int redNum, int blueNum,
+               EdgeListIterator begin, EdgeListIterator end) {
+      if (built) Parent::clear();
+      StaticBpGraphBase::build(redNum, blueNum, begin, end);
+      notifier(RedNode()).build();
+      notifier(BlueNode()).build();
+      notifier(Node()).build();
+      notifier(Edge()).build();
+      notifier(Arc()).build();
+    }
+
+    /// \brief Clear the graph.
+    ///
+    /// This function erases all nodes and edges from the graph.
+    void clear() {
+      Parent::clear();
+    }
+
+  };
+
 }
 
 #endif
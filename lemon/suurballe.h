@@ -31,6 +31,7 @@
 #include <lemon/list_graph.h>
 #include <lemon/dijkstra.h>
 #include <lemon/maps.h>
+#include <lemon/bits/parallel.h>
 
 namespace lemon {
 
@@ -146,7 +147,8 @@ namespace lemon {
     // Dijkstra algorithm for finding shortest paths in the
     // residual network with respect to the reduced arc lengths
     // and modifying the node potentials according to the
-    // distance of the nodes.
+    // distance of the nodes. It uses the work maps of the Suurballe
+    // instance, so they are not reallocated for each search.
     class ResidualDijkstra
     {
     private:
@@ -159,8 +161,9 @@ namespace lemon {
       Node _s;
       Node _t;
 
-      PotentialMap _dist;
-      std::vector<Node> _proc_nodes;
+      PotentialMap &_dist;
+      HeapCrossRef &_heap_cross_ref;
+      std::vector<Node> &_proc_nodes;
 
     public:
 
@@ -168,7 +171,9 @@ namespace lemon {
       ResidualDijkstra(Suurballe &srb) :
         _graph(srb._graph), _length(srb._length),
         _flow(*srb._flow), _pi(*srb._potential), _pred(srb._pred),
-        _s(srb._s), _t(srb._t), _dist(_graph) {}
+        _s(srb._s), _t(srb._t), _dist(*srb._res_dist),
+        _heap_cross_ref(*srb._heap_cross_ref),
+        _proc_nodes(srb._proc_nodes) {}
 
       // Run the algorithm and return true if a path is found
       // from the source node to the target node.
@@ -181,8 +186,7 @@ namespace lemon {
       // Execute the algorithm for the first time (the flow and potential
       // functions have to be identically zero).
       bool startFirst() {
-        HeapCrossRef heap_cross_ref(_graph, Heap::PRE_HEAP);
-        Heap heap(heap_cross_ref);
+        Heap heap(_heap_cross_ref);
         heap.push(_s, 0);
         _pred[_s] = INVALID;
         _proc_nodes.clear();
@@ -215,19 +219,22 @@ namespace lemon {
             }
           }
         }
-        if (heap.empty()) return false;
+        if (heap.empty()) {
+          clear(heap);
+          return false;
+        }
 
         // Update potentials of processed nodes
         Length t_dist = heap.prio();
         for (int i = 0; i < int(_proc_nodes.size()); ++i)
           _pi[_proc_nodes[i]] = _dist[_proc_nodes[i]] - t_dist;
+        clear(heap);
         return true;
       }
 
       // Execute the algorithm.
       bool start() {
-        HeapCrossRef heap_cross_ref(_graph, Heap::PRE_HEAP);
-        Heap heap(heap_cross_ref);
+        Heap heap(_heap_cross_ref);
         heap.push(_s, 0);
         _pred[_s] = INVALID;
         _proc_nodes.clear();
@@ -284,15 +291,30 @@ namespace lemon {
             }
           }
         }
-        if (heap.empty()) return false;
+        if (heap.empty()) {
+          clear(heap);
+          return false;
+        }
 
         // Update potentials of processed nodes
         Length t_dist = heap.prio();
         for (int i = 0; i < int(_proc_nodes.size()); ++i)
           _pi[_proc_nodes[i]] += _dist[_proc_nodes[i]] - t_dist;
+        clear(heap);
         return true;
       }
 
+      // Reset the heap cross reference map for the next search
+      void clear(Heap& heap) {
+        for (int i = 0; i < int(_proc_nodes.size()); ++i)
+          _heap_cross_ref.set(_proc_nodes[i], Heap::PRE_HEAP);
+        while (!heap.empty()) {
+          Node u = heap.top();
+          heap.pop();
+          _heap_cross_ref.set(u, Heap::PRE_HEAP);
+        }
+      }
+
     }; //class ResidualDijkstra
 
   public:
@@ -403,6 +425,12 @@ namespace lemon {
     PredMap *_init_pred;
     bool _full_init;
 
+    // Work maps of the residual Dijkstra searches and findPaths()
+    PotentialMap *_res_dist;
+    HeapCrossRef *_heap_cross_ref;
+    FlowMap *_res_flow;
+    std::vector<Node> _proc_nodes;
+
   protected:
 
     Suurballe() {}
@@ -419,7 +447,8 @@ namespace lemon {
                const LengthMap &length ) :
       _graph(graph), _length(length), _flow(0), _local_flow(false),
       _potential(0), _local_potential(false), _pred(graph),
-      _init_dist(0), _init_pred(0)
+      _init_dist(0), _init_pred(0),
+      _res_dist(0), _heap_cross_ref(0), _res_flow(0)
     {}
 
     /// Destructor.
@@ -428,6 +457,9 @@ namespace lemon {
       if (_local_potential) delete _potential;
       delete _init_dist;
       delete _init_pred;
+      delete _res_dist;
+      delete _heap_cross_ref;
+      delete _res_flow;
     }
 
     /// \brief Set the flow map.
@@ -523,6 +555,15 @@ namespace lemon {
         _potential = new PotentialMap(_graph);
         _local_potential = true;
       }
+      if (!_res_dist) {
+        _res_dist = new PotentialMap(_graph);
+        _heap_cross_ref = new HeapCrossRef(_graph, Heap::PRE_HEAP);
+        _res_flow = new FlowMap(_graph);
+      }
+      // The digraph may have been changed since the previous run
+      for (NodeIt u(_graph); u != INVALID; ++u) {
+        _heap_cross_ref->set(u, Heap::PRE_HEAP);
+      }
       _full_init = false;
     }
 
@@ -652,7 +693,7 @@ namespace lemon {
     /// \pre \ref init() and \ref findFlow() must be called before using
     /// this function.
     void findPaths() {
-      FlowMap res_flow(_graph);
+      FlowMap& res_flow = *_res_flow;
       for(ArcIt a(_graph); a != INVALID; ++a) res_flow[a] = (*_flow)[a];
 
       _paths.clear();
@@ -771,6 +812,513 @@ namespace lemon {
 
   ///@}
 
+  namespace _suurballe_bits {
+
+    // Static adjacency arrays of the digraph shared by the threads of
+    // SuurballeBatch. The arcs are indexed in the order of their source
+    // nodes, and the incoming arcs of the nodes are listed in in_arc.
+    template <typename V>
+    struct SuurballeData {
+      std::vector<int> out_first, source, target;
+      std::vector<int> in_first, in_arc;
+      std::vector<V> length;
+    };
+
+    // The work arrays of one thread of SuurballeBatch. They are
+    // allocated once, and only the modified entries are restored after
+    // each search, so a query costs only its k Dijkstra searches
+    // (the first one is shared by the queries of the same source).
+    template <typename V>
+    class SuurballeWorkspace {
+    public:
+
+      typedef BinHeap<V, RangeMap<int> > Heap;
+
+      SuurballeWorkspace(const SuurballeData<V>& data)
+        : _data(data), _n(data.out_first.size() - 1),
+          _cross(_n, Heap::PRE_HEAP), _heap(_cross),
+          _init_dist(_n, 0), _pot(_n, 0), _dist(_n, 0),
+          _init_pred(_n, -1), _pred(_n, -1),
+          _flow(data.source.size(), 0), _s(-1) {}
+
+      // Performs a full Dijkstra search from the given source node. Its
+      // result is the first path and the initial potentials of all
+      // queries of this source.
+      void source(int s) {
+        for (int i = 0; i < int(_reached.size()); ++i) {
+          int u = _reached[i];
+          _init_dist[u] = _pot[u] = 0;
+          _init_pred[u] = -1;
+        }
+        _reached.clear();
+        _s = s;
+        _heap.push(s, 0);
+        while (!_heap.empty()) {
+          int u = _heap.top();
+          V d = _heap.prio();
+          _heap.pop();
+          _init_dist[u] = _pot[u] = d;
+          _reached.push_back(u);
+          for (int a = _data.out_first[u]; a < _data.out_first[u + 1]; ++a) {
+            int v = _data.target[a];
+            V dn = d + _data.length[a];
+            switch (_heap.state(v)) {
+            case Heap::PRE_HEAP:
+              _heap.push(v, dn);
+              _init_pred[v] = a;
+              break;
+            case Heap::IN_HEAP:
+              if (dn < _heap[v]) {
+                _heap.decrease(v, dn);
+                _init_pred[v] = a;
+              }
+              break;
+            case Heap::POST_HEAP:
+              break;
+            }
+          }
+        }
+        for (int i = 0; i < int(_reached.size()); ++i) {
+          _cross[_reached[i]] = Heap::PRE_HEAP;
+        }
+      }
+
+      // Finds at most k arc-disjoint paths from the current source node
+      // to t, and stores their arcs and the first arc index of each path
+      // in the given vectors. Returns the number of found paths.
+      int query(int t, int k, std::vector<int>& arcs,
+                std::vector<int>& first, V& length) {
+        arcs.clear();
+        first.clear();
+        length = 0;
+        if (k <= 0) return 0;
+        if (t == _s) {
+          // k empty paths, like in Suurballe
+          first.assign(k, 0);
+          return k;
+        }
+        if (_init_pred[t] == -1) return 0;
+
+        // The first path is the shortest path found by source()
+        for (int u = t; u != _s; u = _data.source[_init_pred[u]]) {
+          setFlow(_init_pred[u], 1);
+        }
+        int path_num = 1;
+
+        // Find the further paths in the residual network
+        while (path_num < k && residualSearch(t)) {
+          ++path_num;
+          int u = t, a;
+          while ((a = _pred[u]) != -1) {
+            if (u == _data.target[a]) {
+              setFlow(a, 1);
+              u = _data.source[a];
+            } else {
+              setFlow(a, 0);
+              u = _data.target[a];
+            }
+          }
+        }
+
+        // Decompose the flow into paths
+        for (int i = 0; i < path_num; ++i) {
+          first.push_back(arcs.size());
+          for (int u = _s; u != t; ) {
+            int a = _data.out_first[u];
+            while (_flow[a] == 0) ++a;
+            _flow[a] = 0;
+            arcs.push_back(a);
+            length += _data.length[a];
+            u = _data.target[a];
+          }
+        }
+
+        // Restore the work arrays
+        for (int i = 0; i < int(_flow_arcs.size()); ++i) {
+          _flow[_flow_arcs[i]] = 0;
+        }
+        _flow_arcs.clear();
+        for (int i = 0; i < int(_pot_nodes.size()); ++i) {
+          int u = _pot_nodes[i];
+          _pot[u] = _init_dist[u];
+        }
+        _pot_nodes.clear();
+        return path_num;
+      }
+
+    private:
+
+      void setFlow(int a, char value) {
+        if (value) _flow_arcs.push_back(a);
+        _flow[a] = value;
+      }
+
+      void relax(int v, int a, V dn) {
+        switch (_heap.state(v)) {
+        case Heap::PRE_HEAP:
+          _heap.push(v, dn);
+          _pred[v] = a;
+          break;
+        case Heap::IN_HEAP:
+          if (dn < _heap[v]) {
+            _heap.decrease(v, dn);
+            _pred[v] = a;
+          }
+          break;
+        case Heap::POST_HEAP:
+          break;
+        }
+      }
+
+      // Dijkstra search in the residual network with respect to the
+      // reduced arc lengths (see Suurballe::ResidualDijkstra)
+      bool residualSearch(int t) {
+        _heap.push(_s, 0);
+        _pred[_s] = -1;
+        _proc.clear();
+        while (!_heap.empty() && _heap.top() != t) {
+          int u = _heap.top();
+          V d = _heap.prio() + _pot[u];
+          _dist[u] = _heap.prio();
+          _proc.push_back(u);
+          _heap.pop();
+          for (int a = _data.out_first[u]; a < _data.out_first[u + 1]; ++a) {
+            if (_flow[a] == 0) {
+              int v = _data.target[a];
+              relax(v, a, d + _data.length[a] - _pot[v]);
+            }
+          }
+          for (int i = _data.in_first[u]; i < _data.in_first[u + 1]; ++i) {
+            int a = _data.in_arc[i];
+            if (_flow[a] == 1) {
+              int v = _data.source[a];
+              relax(v, a, d - _data.length[a] - _pot[v]);
+            }
+          }
+        }
+        bool found = !_heap.empty();
+        if (found) {
+          V t_dist = _heap.prio();
+          for (int i = 0; i < int(_proc.size()); ++i) {
+            int u = _proc[i];
+            _pot[u] += _dist[u] - t_dist;
+            _pot_nodes.push_back(u);
+          }
+        }
+        for (int i = 0; i < int(_proc.size()); ++i) {
+          _cross[_proc[i]] = Heap::PRE_HEAP;
+        }
+        while (!_heap.empty()) {
+          int u = _heap.top();
+          _heap.pop();
+          _cross[u] = Heap::PRE_HEAP;
+        }
+        return found;
+      }
+
+      const SuurballeData<V>& _data;
+      int _n;
+      RangeMap<int> _cross;
+      Heap _heap;
+      std::vector<V> _init_dist, _pot, _dist;
+      std::vector<int> _init_pred, _pred;
+      std::vector<char> _flow;
+      int _s;
+      std::vector<int> _reached, _proc, _flow_arcs, _pot_nodes;
+    };
+
+    // Processes the query groups of SuurballeBatch on several threads.
+    // The queries of a source node are processed by one thread.
+    template <typename V>
+    class SuurballeDispatcher {
+    public:
+
+      SuurballeDispatcher(const SuurballeData<V>& data,
+                          const std::vector<int>& group_first,
+                          const std::vector<int>& order,
+                          const std::vector<int>& source,
+                          const std::vector<int>& target,
+                          const std::vector<int>& k,
+                          std::vector<int>& path_num,
+                          std::vector<V>& length,
+                          std::vector<std::vector<int> >& arcs,
+                          std::vector<std::vector<int> >& path_first)
+        : _data(data), _group_first(group_first), _order(order),
+          _source(source), _target(target), _k(k), _path_num(path_num),
+          _length(length), _arcs(arcs), _path_first(path_first),
+          _next(0) {}
+
+      void operator()(int) {
+        SuurballeWorkspace<V> ws(_data);
+        int group_num = int(_group_first.size()) - 1;
+        int g;
+        while ((g = bits::atomicFetchAdd(&_next, 1)) < group_num) {
+          ws.source(_source[_order[_group_first[g]]]);
+          for (int i = _group_first[g]; i < _group_first[g + 1]; ++i) {
+            int q = _order[i];
+            _path_num[q] = ws.query(_target[q], _k[q], _arcs[q],
+                                    _path_first[q], _length[q]);
+          }
+        }
+      }
+
+    private:
+      const SuurballeData<V>& _data;
+      const std::vector<int>& _group_first;
+      const std::vector<int>& _order;
+      const std::vector<int>& _source;
+      const std::vector<int>& _target;
+      const std::vector<int>& _k;
+      std::vector<int>& _path_num;
+      std::vector<V>& _length;
+      std::vector<std::vector<int> >& _arcs;
+      std::vector<std::vector<int> >& _path_first;
+      int _next;
+    };
+
+  }
+
+  /// \addtogroup shortest_path
+  /// @{
+
+  /// \brief Batched computation of arc-disjoint paths for many node
+  /// pairs.
+  ///
+  /// \ref lemon::SuurballeBatch "SuurballeBatch" solves the problem of
+  /// \ref Suurballe for many source-target pairs of the same digraph.
+  /// The queries are added with \ref addQuery() and solved together by
+  /// \ref run().
+  ///
+  /// The queries are grouped by their source nodes. The full
+  /// %Dijkstra search from a source node (the first path and the initial
+  /// node potentials) is performed only once and reused for all targets
+  /// of this source, like \ref Suurballe::fullInit() "fullInit()" does.
+  /// The source groups are processed on several threads (see
+  /// \ref threads()). Each thread has its own workspace, which is
+  /// allocated once in \ref run() and restored after each query, so
+  /// the work maps are not reallocated for each pair.
+  /// The results do not depend on the number of threads, and they are
+  /// the same as those of \ref Suurballe (e.g. a query with the same
+  /// source and target node has \c k empty paths).
+  ///
+  /// \tparam GR The digraph type the algorithm runs on.
+  /// \tparam LEN The type of the length map.
+  /// The default value is <tt>GR::ArcMap<int></tt>.
+  ///
+  /// \warning Length values should be \e non-negative.
+  template < typename GR,
+             typename LEN = typename GR::template ArcMap<int> >
+  class SuurballeBatch
+  {
+    TEMPLATE_DIGRAPH_TYPEDEFS(GR);
+
+  public:
+
+    /// The type of the digraph.
+    typedef GR Digraph;
+    /// The type of the length map.
+    typedef LEN LengthMap;
+    /// The type of the lengths.
+    typedef typename LengthMap::Value Length;
+    /// The type of the found paths.
+    typedef SimplePath<Digraph> Path;
+
+  private:
+
+    const Digraph &_graph;
+    const LengthMap &_length;
+    int _threads;
+
+    // The queries
+    std::vector<Node> _query_source, _query_target;
+    std::vector<int> _query_k;
+
+    // The results
+    std::vector<Arc> _arcs;
+    std::vector<int> _path_num;
+    std::vector<Length> _total_length;
+    std::vector<std::vector<int> > _path_arcs, _path_first;
+
+  public:
+
+    /// \brief Constructor.
+    ///
+    /// Constructor.
+    ///
+    /// \param graph The digraph the algorithm runs on.
+    /// \param length The length (cost) values of the arcs.
+    SuurballeBatch(const Digraph &graph, const LengthMap &length)
+      : _graph(graph), _length(length), _threads(0) {}
+
+    /// \brief Set the number of threads.
+    ///
+    /// This function sets the number of threads used by \ref run().
+    /// The value 0 (default) stands for the number of hardware threads.
+    ///
+    /// \return <tt>(*this)</tt>
+    SuurballeBatch& threads(int num) {
+      _threads = num;
+      return *this;
+    }
+
+    /// \name Execution Control
+    /// The queries have to be added with \ref addQuery(), then
+    /// \ref run() solves all of them.
+
+    /// @{
+
+    /// \brief Add a query.
+    ///
+    /// This function adds a query for finding \c k arc-disjoint paths
+    /// from \c s to \c t.
+    ///
+    /// \return The index of the query.
+    int addQuery(const Node& s, const Node& t, int k = 2) {
+      _query_source.push_back(s);
+      _query_target.push_back(t);
+      _query_k.push_back(k);
+      return _query_source.size() - 1;
+    }
+
+    /// \brief Remove all queries.
+    ///
+    /// This function removes all queries (and their results).
+    void clearQueries() {
+      _query_source.clear();
+      _query_target.clear();
+      _query_k.clear();
+      _path_num.clear();
+      _total_length.clear();
+      _path_arcs.clear();
+      _path_first.clear();
+    }
+
+    /// \brief Return the number of queries.
+    ///
+    /// This function returns the number of queries.
+    int queryNum() const {
+      return _query_source.size();
+    }
+
+    /// \brief Run the algorithm.
+    ///
+    /// This function solves all queries.
+    /// It can be called more than once (e.g. if the underlying digraph
+    /// and/or the arc lengths have been modified).
+    void run() {
+      typedef _suurballe_bits::SuurballeData<Length> Data;
+      typedef _suurballe_bits::SuurballeDispatcher<Length> Dispatcher;
+
+      // Build the adjacency arrays
+      Data data;
+      IntNodeMap index(_graph);
+      int n = 0;
+      for (NodeIt u(_graph); u != INVALID; ++u) {
+        index[u] = n++;
+      }
+      _arcs.clear();
+      data.out_first.resize(n + 1);
+      data.in_first.assign(n + 1, 0);
+      int i = 0;
+      for (NodeIt u(_graph); u != INVALID; ++u, ++i) {
+        data.out_first[i] = _arcs.size();
+        for (OutArcIt a(_graph, u); a != INVALID; ++a) {
+          _arcs.push_back(a);
+          data.source.push_back(i);
+          data.target.push_back(index[_graph.target(a)]);
+          data.length.push_back(_length[a]);
+          ++data.in_first[data.target.back() + 1];
+        }
+      }
+      int m = _arcs.size();
+      data.out_first[n] = m;
+      for (int v = 0; v < n; ++v) {
+        data.in_first[v + 1] += data.in_first[v];
+      }
+      data.in_arc.resize(m);
+      std::vector<int> pos(data.in_first.begin(), data.in_first.end() - 1);
+      for (int a = 0; a < m; ++a) {
+        data.in_arc[pos[data.target[a]]++] = a;
+      }
+
+      // Group the queries by their source nodes
+      int query_num = _query_source.size();
+      std::vector<int> source(query_num), target(query_num);
+      std::vector<int> group_first, order(query_num);
+      pos.assign(n + 1, 0);
+      for (int q = 0; q < query_num; ++q) {
+        source[q] = index[_query_source[q]];
+        target[q] = index[_query_target[q]];
+        ++pos[source[q] + 1];
+      }
+      for (int v = 0; v < n; ++v) {
+        if (pos[v + 1] > 0) group_first.push_back(pos[v]);
+        pos[v + 1] += pos[v];
+      }
+      group_first.push_back(query_num);
+      for (int q = 0; q < query_num; ++q) {
+        order[pos[source[q]]++] = q;
+      }
+
+      _path_num.assign(query_num, 0);
+      _total_length.assign(query_num, 0);
+      _path_arcs.resize(query_num);
+      _path_first.resize(query_num);
+      Dispatcher dispatcher(data, group_first, order, source, target,
+                            _query_k, _path_num, _total_length,
+                            _path_arcs, _path_first);
+      bits::parallelRun(bits::parallelThreadNum(_threads,
+                          int(group_first.size()) - 1, 1), dispatcher);
+    }
+
+    /// @}
+
+    /// \name Query Functions
+    /// The results of the algorithm can be obtained using these
+    /// functions.
+    /// \n run() should be called before using them.
+
+    /// @{
+
+    /// \brief Return the number of the found paths for a query.
+    ///
+    /// This function returns the number of the arc-disjoint paths found
+    /// for the given query. It is \c k if there are at least \c k
+    /// arc-disjoint paths between the nodes of the query.
+    int pathNum(int query) const {
+      return _path_num[query];
+    }
+
+    /// \brief Return the total length of the found paths for a query.
+    ///
+    /// This function returns the total length of the paths found for
+    /// the given query.
+    Length totalLength(int query) const {
+      return _total_length[query];
+    }
+
+    /// \brief Return a path found for a query.
+    ///
+    /// This function returns the <tt>i</tt>-th path found for the
+    /// given query. \c i must be between \c 0 and
+    /// <tt>%pathNum(query)-1</tt>.
+    Path path(int query, int i) const {
+      const std::vector<int>& arcs = _path_arcs[query];
+      const std::vector<int>& first = _path_first[query];
+      int last = i + 1 < int(first.size()) ? first[i + 1] : arcs.size();
+      Path p;
+      for (int j = first[i]; j < last; ++j) {
+        p.addBack(_arcs[arcs[j]]);
+      }
+      return p;
+    }
+
+    /// @}
+
+  }; //class SuurballeBatch
+
+  ///@}
+
 } //namespace lemon
 
 #endif //LEMON_SUURBALLE_H
@@ -0,0 +1,1155 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_TIME_DEPENDENT_DIJKSTRA_H
+#define LEMON_TIME_DEPENDENT_DIJKSTRA_H
+
+///\ingroup shortest_path
+///\file
+///\brief Time-dependent Dijkstra algorithm and profile search.
+
+#include <vector>
+#include <algorithm>
+#include <lemon/core.h>
+#include <lemon/error.h>
+#include <lemon/bin_heap.h>
+#include <lemon/path.h>
+#include <lemon/tolerance.h>
+
+namespace lemon {
+
+  template <typename V>
+  class PiecewiseLinearArena;
+
+  /// \addtogroup shortest_path
+  /// @{
+
+  /// \brief Piecewise linear function stored in a
+  /// \ref PiecewiseLinearArena "flat arena".
+  ///
+  /// This class is a lightweight handle of a piecewise linear function
+  /// whose breakpoints are stored in a \ref PiecewiseLinearArena.
+  /// It is used as the travel time function of the arcs in
+  /// \ref TimeDependentDijkstra and \ref TimeDependentProfile:
+  /// the value of the function at time \c t is the travel time of the
+  /// arc if it is entered at time \c t.
+  ///
+  /// The function is linear between the consecutive breakpoints and
+  /// it is constant before the first and after the last breakpoint.
+  /// The function of zero breakpoints is constant zero.
+  ///
+  /// The handle remains valid while the arena is not cleared, even if
+  /// new functions are added to the arena.
+  ///
+  /// \tparam V The type of the time values.
+  template <typename V>
+  class PiecewiseLinearFunction
+  {
+  public:
+
+    /// The type of the time values.
+    typedef V Value;
+
+    /// \brief Default constructor.
+    ///
+    /// Default constructor. It creates a constant zero function.
+    PiecewiseLinearFunction() : _arena(0), _first(0), _size(0) {}
+
+    /// \brief Return the number of the breakpoints.
+    int size() const { return _size; }
+
+    /// \brief Return the time of a breakpoint.
+    ///
+    /// This function returns the time of the <tt>i</tt>-th breakpoint.
+    Value x(int i) const { return _arena->_x[_first + i]; }
+
+    /// \brief Return the value of a breakpoint.
+    ///
+    /// This function returns the value of the function at the
+    /// <tt>i</tt>-th breakpoint.
+    Value y(int i) const { return _arena->_y[_first + i]; }
+
+    /// \brief Evaluate the function.
+    ///
+    /// This function returns the value of the function at time \c t.
+    /// Its running time is logarithmic in the number of breakpoints.
+    Value operator()(const Value& t) const {
+      if (_size == 0) return Value();
+      const Value* xs = &_arena->_x[_first];
+      const Value* ys = &_arena->_y[_first];
+      int i = std::upper_bound(xs, xs + _size, t) - xs;
+      if (i == 0) return ys[0];
+      if (i == _size) return ys[_size - 1];
+      return ys[i - 1] +
+        (ys[i] - ys[i - 1]) * (t - xs[i - 1]) / (xs[i] - xs[i - 1]);
+    }
+
+  private:
+
+    friend class PiecewiseLinearArena<V>;
+
+    PiecewiseLinearFunction(const PiecewiseLinearArena<V>* arena,
+                            int first, int size)
+      : _arena(arena), _first(first), _size(size) {}
+
+    const PiecewiseLinearArena<V>* _arena;
+    int _first;
+    int _size;
+  };
+
+  /// \brief Flat storage of piecewise linear functions.
+  ///
+  /// This class stores the breakpoints of many
+  /// \ref PiecewiseLinearFunction "piecewise linear functions" in two
+  /// contiguous arrays, so the travel time functions of all arcs of a
+  /// digraph take only a few allocations and they are evaluated with a
+  /// good locality of reference.
+  ///
+  /// \tparam V The type of the time values.
+  template <typename V>
+  class PiecewiseLinearArena
+  {
+  public:
+
+    /// The type of the time values.
+    typedef V Value;
+    /// The type of the stored functions.
+    typedef PiecewiseLinearFunction<V> Function;
+
+    /// \brief Default constructor.
+    PiecewiseLinearArena() {}
+
+    /// \brief Add a function to the arena.
+    ///
+    /// This function adds a piecewise linear function to the arena.
+    /// The breakpoints are given by the range <tt>[xs, xs + size)</tt>
+    /// of their times and the range <tt>[ys, ys + size)</tt> of the
+    /// values.
+    ///
+    /// \pre The times must be strictly increasing.
+    template <typename XIt, typename YIt>
+    Function add(XIt xs, YIt ys, int size) {
+      int first = _x.size();
+      for (int i = 0; i < size; ++i, ++xs, ++ys) {
+        LEMON_ASSERT(i == 0 || _x.back() < Value(*xs),
+                     "The breakpoints must be increasing");
+        _x.push_back(*xs);
+        _y.push_back(*ys);
+      }
+      return Function(this, first, size);
+    }
+
+    /// \brief Add a constant function to the arena.
+    ///
+    /// This function adds a constant function to the arena.
+    Function addConstant(const Value& value) {
+      Value x = Value();
+      return add(&x, &value, 1);
+    }
+
+    /// \brief Return the total number of the stored breakpoints.
+    int size() const { return _x.size(); }
+
+    /// \brief Reserve storage for the given number of breakpoints.
+    void reserve(int size) {
+      _x.reserve(size);
+      _y.reserve(size);
+    }
+
+    /// \brief Remove all functions.
+    ///
+    /// This function removes all functions from the arena.
+    /// The handles of the removed functions become invalid.
+    void clear() {
+      _x.clear();
+      _y.clear();
+    }
+
+  private:
+
+    friend class PiecewiseLinearFunction<V>;
+
+    PiecewiseLinearArena(const PiecewiseLinearArena&);
+    PiecewiseLinearArena& operator=(const PiecewiseLinearArena&);
+
+    std::vector<Value> _x;
+    std::vector<Value> _y;
+  };
+
+  /// @}
+
+  ///Default traits class of TimeDependentDijkstra class.
+
+  ///Default traits class of TimeDependentDijkstra class.
+  ///\tparam GR The type of the digraph.
+  ///\tparam TTM The type of the travel time map.
+  template <typename GR, typename TTM>
+  struct TimeDependentDijkstraDefaultTraits
+  {
+    ///The type of the digraph the algorithm runs on.
+    typedef GR Digraph;
+
+    ///The type of the map that stores the travel time functions.
+
+    ///The type of the map that stores the travel time functions of
+    ///the arcs.
+    ///It must conform to the \ref concepts::ReadMap "ReadMap" concept.
+    typedef TTM TravelTimeMap;
+    ///The type of the travel time functions.
+
+    ///The type of the travel time functions. It must define the
+    ///type \c Value and the function call operator, which returns the
+    ///travel time for the given entering time.
+    typedef typename TTM::Value Function;
+    ///The type of the time values.
+    typedef typename Function::Value Value;
+
+    /// The cross reference type used by the heap.
+
+    /// The cross reference type used by the heap.
+    /// Usually it is \c Digraph::NodeMap<int>.
+    typedef typename Digraph::template NodeMap<int> HeapCrossRef;
+    ///Instantiates a \c HeapCrossRef.
+
+    ///This function instantiates a \ref HeapCrossRef.
+    /// \param g is the digraph, to which we would like to define the
+    /// \ref HeapCrossRef.
+    static HeapCrossRef *createHeapCrossRef(const Digraph &g)
+    {
+      return new HeapCrossRef(g);
+    }
+
+    ///The heap type used by the algorithm.
+
+    ///The heap type used by the algorithm.
+    ///
+    ///\sa BinHeap
+    typedef BinHeap<Value, HeapCrossRef, std::less<Value> > Heap;
+    ///Instantiates a \c Heap.
+
+    ///This function instantiates a \ref Heap.
+    static Heap *createHeap(HeapCrossRef& r)
+    {
+      return new Heap(r);
+    }
+
+    ///\brief The type of the map that stores the predecessor
+    ///arcs of the earliest arrival paths.
+    ///
+    ///The type of the map that stores the predecessor
+    ///arcs of the earliest arrival paths.
+    ///It must conform to the \ref concepts::WriteMap "WriteMap" concept.
+    typedef typename Digraph::template NodeMap<typename Digraph::Arc> PredMap;
+    ///Instantiates a \c PredMap.
+
+    ///This function instantiates a \ref PredMap.
+    ///\param g is the digraph, to which we would like to define the
+    ///\ref PredMap.
+    static PredMap *createPredMap(const Digraph &g)
+    {
+      return new PredMap(g);
+    }
+
+    ///The type of the map that stores the arrival times of the nodes.
+
+    ///The type of the map that stores the arrival times of the nodes.
+    ///It must conform to the \ref concepts::WriteMap "WriteMap" concept.
+    typedef typename Digraph::template NodeMap<Value> ArrivalMap;
+    ///Instantiates an \c ArrivalMap.
+
+    ///This function instantiates an \ref ArrivalMap.
+    ///\param g is the digraph, to which we would like to define
+    ///the \ref ArrivalMap.
+    static ArrivalMap *createArrivalMap(const Digraph &g)
+    {
+      return new ArrivalMap(g);
+    }
+  };
+
+  /// \addtogroup shortest_path
+  /// @{
+
+  ///Time-dependent %Dijkstra algorithm class.
+
+  ///This class implements the time-dependent variant of the %Dijkstra
+  ///algorithm. The travel time of an arc depends on the time it is
+  ///entered, and the algorithm computes the earliest arrival time at
+  ///each node for a given departure time from the source node(s).
+  ///
+  ///The travel times are given by a map that assigns a function
+  ///(e.g. a \ref PiecewiseLinearFunction) to each arc. The functions
+  ///must satisfy the \e FIFO (first-in-first-out) property, i.e.
+  ///entering an arc later must not result in leaving it earlier:
+  ///<tt>t + f(t)</tt> must be non-decreasing, which means that the
+  ///slopes of a piecewise linear function must be at least \c -1.
+  ///Under this condition, the labels of the nodes are permanent when
+  ///they are processed, just like in the original algorithm, and each
+  ///arc function is evaluated once.
+  ///
+  ///The interface of the class follows the one of \ref Dijkstra.
+  ///
+  ///\tparam GR The type of the digraph the algorithm runs on.
+  ///\tparam TTM A \ref concepts::ReadMap "readable" arc map that
+  ///specifies the travel time functions of the arcs.
+  ///\tparam TR The traits class that defines various types used by the
+  ///algorithm. By default, it is \ref TimeDependentDijkstraDefaultTraits
+  ///"TimeDependentDijkstraDefaultTraits<GR, TTM>".
+  ///In most cases, this parameter should not be set directly,
+  ///consider to use the named template parameters instead.
+  ///
+  ///\warning The travel times should be \e non-negative.
+  ///
+  ///\sa TimeDependentProfile
+#ifdef DOXYGEN
+  template <typename GR, typename TTM, typename TR>
+#else
+  template <typename GR,
+            typename TTM,
+            typename TR=TimeDependentDijkstraDefaultTraits<GR,TTM> >
+#endif
+  class TimeDependentDijkstra {
+  public:
+
+    ///The type of the digraph the algorithm runs on.
+    typedef typename TR::Digraph Digraph;
+
+    ///The type of the time values.
+    typedef typename TR::Value Value;
+    ///The type of the map that stores the travel time functions.
+    typedef typename TR::TravelTimeMap TravelTimeMap;
+    ///\brief The type of the map that stores the predecessor arcs of the
+    ///earliest arrival paths.
+    typedef typename TR::PredMap PredMap;
+    ///The type of the map that stores the arrival times of the nodes.
+    typedef typename TR::ArrivalMap ArrivalMap;
+    ///The type of the paths.
+    typedef PredMapPath<Digraph, PredMap> Path;
+    ///The cross reference type used for the current heap.
+    typedef typename TR::HeapCrossRef HeapCrossRef;
+    ///The heap type used by the algorithm.
+    typedef typename TR::Heap Heap;
+
+    ///The \ref lemon::TimeDependentDijkstraDefaultTraits "traits class"
+    ///of the algorithm.
+    typedef TR Traits;
+
+  private:
+
+    typedef typename Digraph::Node Node;
+    typedef typename Digraph::NodeIt NodeIt;
+    typedef typename Digraph::Arc Arc;
+    typedef typename Digraph::OutArcIt OutArcIt;
+
+    //Pointer to the underlying digraph.
+    const Digraph *G;
+    //Pointer to the travel time map.
+    const TravelTimeMap *_travel_time;
+    //Pointer to the map of predecessors arcs.
+    PredMap *_pred;
+    //Indicates if _pred is locally allocated (true) or not.
+    bool local_pred;
+    //Pointer to the map of arrival times.
+    ArrivalMap *_arrival;
+    //Indicates if _arrival is locally allocated (true) or not.
+    bool local_arrival;
+    //Pointer to the heap cross references.
+    HeapCrossRef *_heap_cross_ref;
+    //Indicates if _heap_cross_ref is locally allocated (true) or not.
+    bool local_heap_cross_ref;
+    //Pointer to the heap.
+    Heap *_heap;
+    //Indicates if _heap is locally allocated (true) or not.
+    bool local_heap;
+
+    //Creates the maps if necessary.
+    void create_maps()
+    {
+      if(!_pred) {
+        local_pred = true;
+        _pred = Traits::createPredMap(*G);
+      }
+      if(!_arrival) {
+        local_arrival = true;
+        _arrival = Traits::createArrivalMap(*G);
+      }
+      if (!_heap_cross_ref) {
+        local_heap_cross_ref = true;
+        _heap_cross_ref = Traits::createHeapCrossRef(*G);
+      }
+      if (!_heap) {
+        local_heap = true;
+        _heap = Traits::createHeap(*_heap_cross_ref);
+      }
+    }
+
+  public:
+
+    typedef TimeDependentDijkstra Create;
+
+    ///\name Named Template Parameters
+
+    ///@{
+
+    template <class T>
+    struct SetPredMapTraits : public Traits {
+      typedef T PredMap;
+      static PredMap *createPredMap(const Digraph &)
+      {
+        LEMON_ASSERT(false, "PredMap is not initialized");
+        return 0; // ignore warnings
+      }
+    };
+    ///\brief \ref named-templ-param "Named parameter" for setting
+    ///\c PredMap type.
+    ///
+    ///\ref named-templ-param "Named parameter" for setting
+    ///\c PredMap type.
+    ///It must conform to the \ref concepts::WriteMap "WriteMap" concept.
+    template <class T>
+    struct SetPredMap
+      : public TimeDependentDijkstra< Digraph, TravelTimeMap,
+                                      SetPredMapTraits<T> > {
+      typedef TimeDependentDijkstra< Digraph, TravelTimeMap,
+                                     SetPredMapTraits<T> > Create;
+    };
+
+    template <class T>
+    struct SetArrivalMapTraits : public Traits {
+      typedef T ArrivalMap;
+      static ArrivalMap *createArrivalMap(const Digraph &)
+      {
+        LEMON_ASSERT(false, "ArrivalMap is not initialized");
+        return 0; // ignore warnings
+      }
+    };
+    ///\brief \ref named-templ-param "Named parameter" for setting
+    ///\c ArrivalMap type.
+    ///
+    ///\ref named-templ-param "Named parameter" for setting
+    ///\c ArrivalMap type.
+    ///It must conform to the \ref concepts::WriteMap "WriteMap" concept.
+    template <class T>
+    struct SetArrivalMap
+      : public TimeDependentDijkstra< Digraph, TravelTimeMap,
+                                      SetArrivalMapTraits<T> > {
+      typedef TimeDependentDijkstra< Digraph, TravelTimeMap,
+                                     SetArrivalMapTraits<T> > Create;
+    };
+
+    template <class H, class CR>
+    struct SetHeapTraits : public Traits {
+      typedef CR HeapCrossRef;
+      typedef H Heap;
+      static HeapCrossRef *createHeapCrossRef(const Digraph &) {
+        LEMON_ASSERT(false, "HeapCrossRef is not initialized");
+        return 0; // ignore warnings
+      }
+      static Heap *createHeap(HeapCrossRef &)
+      {
+        LEMON_ASSERT(false, "Heap is not initialized");
+        return 0; // ignore warnings
+      }
+    };
+    ///\brief \ref named-templ-param "Named parameter" for setting
+    ///heap and cross reference types
+    ///
+    ///\ref named-templ-param "Named parameter" for setting heap and cross
+    ///reference types. If this named parameter is used, then external
+    ///heap and cross reference objects must be passed to the algorithm
+    ///using the \ref heap() function before calling \ref run(Node, Value)
+    ///"run()" or \ref init().
+    ///\sa SetStandardHeap
+    template <class H, class CR = typename Digraph::template NodeMap<int> >
+    struct SetHeap
+      : public TimeDependentDijkstra< Digraph, TravelTimeMap,
+                                      SetHeapTraits<H, CR> > {
+      typedef TimeDependentDijkstra< Digraph, TravelTimeMap,
+                                     SetHeapTraits<H, CR> > Create;
+    };
+
+    template <class H, class CR>
+    struct SetStandardHeapTraits : public Traits {
+      typedef CR HeapCrossRef;
+      typedef H Heap;
+      static HeapCrossRef *createHeapCrossRef(const Digraph &G) {
+        return new HeapCrossRef(G);
+      }
+      static Heap *createHeap(HeapCrossRef &R)
+      {
+        return new Heap(R);
+      }
+    };
+    ///\brief \ref named-templ-param "Named parameter" for setting
+    ///heap and cross reference types with automatic allocation
+    ///
+    ///\ref named-templ-param "Named parameter" for setting heap and cross
+    ///reference types with automatic allocation.
+    ///They should have standard constructor interfaces to be able to
+    ///automatically created by the algorithm (i.e. the digraph should be
+    ///passed to the constructor of the cross reference and the cross
+    ///reference should be passed to the constructor of the heap).
+    ///\sa SetHeap
+    template <class H, class CR = typename Digraph::template NodeMap<int> >
+    struct SetStandardHeap
+      : public TimeDependentDijkstra< Digraph, TravelTimeMap,
+                                      SetStandardHeapTraits<H, CR> > {
+      typedef TimeDependentDijkstra< Digraph, TravelTimeMap,
+                                     SetStandardHeapTraits<H, CR> > Create;
+    };
+
+    ///@}
+
+  protected:
+
+    TimeDependentDijkstra() {}
+
+  public:
+
+    ///Constructor.
+
+    ///Constructor.
+    ///\param g The digraph the algorithm runs on.
+    ///\param travel_time The travel time functions of the arcs.
+    TimeDependentDijkstra(const Digraph& g,
+                          const TravelTimeMap& travel_time) :
+      G(&g), _travel_time(&travel_time),
+      _pred(NULL), local_pred(false),
+      _arrival(NULL), local_arrival(false),
+      _heap_cross_ref(NULL), local_heap_cross_ref(false),
+      _heap(NULL), local_heap(false)
+    { }
+
+    ///Destructor.
+    ~TimeDependentDijkstra()
+    {
+      if(local_pred) delete _pred;
+      if(local_arrival) delete _arrival;
+      if(local_heap_cross_ref) delete _heap_cross_ref;
+      if(local_heap) delete _heap;
+    }
+
+    ///Sets the travel time map.
+
+    ///Sets the travel time map.
+    ///\return <tt> (*this) </tt>
+    TimeDependentDijkstra &travelTimeMap(const TravelTimeMap &m)
+    {
+      _travel_time = &m;
+      return *this;
+    }
+
+    ///Sets the map that stores the predecessor arcs.
+
+    ///Sets the map that stores the predecessor arcs.
+    ///If you don't use this function before calling
+    ///\ref run(Node, Value) "run()" or \ref init(), an instance will be
+    ///allocated automatically.
+    ///The destructor deallocates this automatically allocated map,
+    ///of course.
+    ///\return <tt> (*this) </tt>
+    TimeDependentDijkstra &predMap(PredMap &m)
+    {
+      if(local_pred) {
+        delete _pred;
+        local_pred=false;
+      }
+      _pred = &m;
+      return *this;
+    }
+
+    ///Sets the map that stores the arrival times of the nodes.
+
+    ///Sets the map that stores the arrival times of the nodes calculated
+    ///by the algorithm.
+    ///If you don't use this function before calling
+    ///\ref run(Node, Value) "run()" or \ref init(), an instance will be
+    ///allocated automatically.
+    ///The destructor deallocates this automatically allocated map,
+    ///of course.
+    ///\return <tt> (*this) </tt>
+    TimeDependentDijkstra &arrivalMap(ArrivalMap &m)
+    {
+      if(local_arrival) {
+        delete _arrival;
+        local_arrival=false;
+      }
+      _arrival = &m;
+      return *this;
+    }
+
+    ///Sets the heap and the cross reference used by algorithm.
+
+    ///Sets the heap and the cross reference used by algorithm.
+    ///If you don't use this function before calling
+    ///\ref run(Node, Value) "run()" or \ref init(), heap and cross
+    ///reference instances will be allocated automatically.
+    ///The destructor deallocates these automatically allocated objects,
+    ///of course.
+    ///\return <tt> (*this) </tt>
+    TimeDependentDijkstra &heap(Heap& hp, HeapCrossRef &cr)
+    {
+      if(local_heap_cross_ref) {
+        delete _heap_cross_ref;
+        local_heap_cross_ref=false;
+      }
+      _heap_cross_ref = &cr;
+      if(local_heap) {
+        delete _heap;
+        local_heap=false;
+      }
+      _heap = &hp;
+      return *this;
+    }
+
+    ///\name Execution Control
+    ///The simplest way to execute the algorithm is to use
+    ///one of the member functions called \ref run(Node, Value) "run()".\n
+    ///If you need better control on the execution, you have to call
+    ///\ref init() first, then you can add several source nodes with
+    ///\ref addSource(). Finally the actual path computation can be
+    ///performed with one of the \ref start() functions.
+
+    ///@{
+
+    ///\brief Initializes the internal data structures.
+    ///
+    ///Initializes the internal data structures.
+    void init()
+    {
+      create_maps();
+      _heap->clear();
+      for ( NodeIt u(*G) ; u!=INVALID ; ++u ) {
+        _pred->set(u,INVALID);
+        _heap_cross_ref->set(u,Heap::PRE_HEAP);
+      }
+    }
+
+    ///Adds a new source node.
+
+    ///Adds a new source node with the given departure time to the
+    ///priority heap.
+    ///
+    ///The function checks if the node has already been added to the heap
+    ///and it is pushed to the heap only if either it was not in the heap
+    ///or its departure time given till then is later than \c time.
+    void addSource(Node s, Value time)
+    {
+      if(_heap->state(s) != Heap::IN_HEAP) {
+        _heap->push(s,time);
+      } else if(time < (*_heap)[s]) {
+        _heap->set(s,time);
+        _pred->set(s,INVALID);
+      }
+    }
+
+    ///Processes the next node in the priority heap
+
+    ///Processes the next node in the priority heap.
+    ///
+    ///\return The processed node.
+    ///
+    ///\warning The priority heap must not be empty.
+    Node processNextNode()
+    {
+      Node v=_heap->top();
+      Value time=_heap->prio();
+      _heap->pop();
+      _arrival->set(v, time);
+
+      for(OutArcIt e(*G,v); e!=INVALID; ++e) {
+        Node w=G->target(e);
+        switch(_heap->state(w)) {
+        case Heap::PRE_HEAP:
+          _heap->push(w, time + (*_travel_time)[e](time));
+          _pred->set(w,e);
+          break;
+        case Heap::IN_HEAP:
+          {
+            Value newtime = time + (*_travel_time)[e](time);
+            if (newtime < (*_heap)[w]) {
+              _heap->decrease(w, newtime);
+              _pred->set(w,e);
+            }
+          }
+          break;
+        case Heap::POST_HEAP:
+          break;
+        }
+      }
+      return v;
+    }
+
+    ///The next node to be processed.
+
+    ///Returns the next node to be processed or \c INVALID if the
+    ///priority heap is empty.
+    Node nextNode() const
+    {
+      return !_heap->empty()?_heap->top():INVALID;
+    }
+
+    ///Returns \c false if there are nodes to be processed.
+
+    ///Returns \c false if there are nodes to be processed
+    ///in the priority heap.
+    bool emptyQueue() const { return _heap->empty(); }
+
+    ///Returns the number of the nodes to be processed.
+
+    ///Returns the number of the nodes to be processed
+    ///in the priority heap.
+    int queueSize() const { return _heap->size(); }
+
+    ///Executes the algorithm.
+
+    ///Executes the algorithm.
+    ///
+    ///This method runs the time-dependent %Dijkstra algorithm from the
+    ///root node(s) in order to compute the earliest arrival time at
+    ///each node.
+    ///
+    ///\pre init() must be called and at least one root node should be
+    ///added with addSource() before using this function.
+    void start()
+    {
+      while ( !emptyQueue() ) processNextNode();
+    }
+
+    ///Executes the algorithm until the given target node is processed.
+
+    ///Executes the algorithm until the given target node is processed.
+    ///
+    ///\pre init() must be called and at least one root node should be
+    ///added with addSource() before using this function.
+    void start(Node t)
+    {
+      while ( !_heap->empty() && _heap->top()!=t ) processNextNode();
+      if ( !_heap->empty() ) processNextNode();
+    }
+
+    ///Runs the algorithm from the given source node.
+
+    ///This method runs the time-dependent %Dijkstra algorithm from node
+    ///\c s with departure time \c time in order to compute the earliest
+    ///arrival time at each node.
+    ///
+    ///\note <tt>d.run(s, time)</tt> is just a shortcut of the following
+    ///code.
+    ///\code
+    ///  d.init();
+    ///  d.addSource(s, time);
+    ///  d.start();
+    ///\endcode
+    void run(Node s, Value time) {
+      init();
+      addSource(s, time);
+      start();
+    }
+
+    ///Finds the earliest arrival path between \c s and \c t.
+
+    ///This method runs the time-dependent %Dijkstra algorithm from node
+    ///\c s with departure time \c time in order to compute the earliest
+    ///arrival path to node \c t (it stops searching when \c t is
+    ///processed).
+    ///
+    ///\return \c true if \c t is reachable form \c s.
+    bool run(Node s, Node t, Value time) {
+      init();
+      addSource(s, time);
+      start(t);
+      return (*_heap_cross_ref)[t] == Heap::POST_HEAP;
+    }
+
+    ///@}
+
+    ///\name Query Functions
+    ///The results of the algorithm can be obtained using these
+    ///functions.\n
+    ///Either \ref run(Node, Value) "run()" or \ref init() should be
+    ///called before using them.
+
+    ///@{
+
+    ///The earliest arrival path to the given node.
+
+    ///Returns the earliest arrival path to the given node from the
+    ///root(s).
+    ///
+    ///\warning \c t should be reached from the root(s).
+    Path path(Node t) const { return Path(*G, *_pred, t); }
+
+    ///The earliest arrival time at the given node.
+
+    ///Returns the earliest arrival time at the given node.
+    ///
+    ///\warning \c v should be processed by the algorithm.
+    Value arrivalTime(Node v) const { return (*_arrival)[v]; }
+
+    ///\brief Returns the 'previous arc' of the earliest arrival path
+    ///tree for the given node.
+    ///
+    ///This function returns the 'previous arc' of the earliest arrival
+    ///path tree for the node \c v, i.e. it returns the last arc of an
+    ///earliest arrival path from a root to \c v. It is \c INVALID if
+    ///\c v is not reached from the root(s) or if \c v is a root.
+    Arc predArc(Node v) const { return (*_pred)[v]; }
+
+    ///\brief Returns the 'previous node' of the earliest arrival path
+    ///tree for the given node.
+    ///
+    ///This function returns the 'previous node' of the earliest arrival
+    ///path tree for the node \c v. It is \c INVALID if \c v is not
+    ///reached from the root(s) or if \c v is a root.
+    Node predNode(Node v) const { return (*_pred)[v]==INVALID ? INVALID:
+                                  G->source((*_pred)[v]); }
+
+    ///\brief Returns a const reference to the node map that stores the
+    ///arrival times of the nodes.
+    const ArrivalMap &arrivalMap() const { return *_arrival;}
+
+    ///\brief Returns a const reference to the node map that stores the
+    ///predecessor arcs.
+    const PredMap &predMap() const { return *_pred;}
+
+    ///Checks if the given node is reached from the root(s).
+
+    ///Returns \c true if \c v is reached from the root(s).
+    bool reached(Node v) const { return (*_heap_cross_ref)[v] !=
+                                        Heap::PRE_HEAP; }
+
+    ///Checks if a node is processed.
+
+    ///Returns \c true if \c v is processed, i.e. its earliest arrival
+    ///time is already calculated.
+    bool processed(Node v) const { return (*_heap_cross_ref)[v] ==
+                                          Heap::POST_HEAP; }
+
+    ///@}
+  };
+
+  ///Time-dependent profile search.
+
+  ///This class computes the travel time profiles from a source node,
+  ///i.e. the travel time to each node as a function of the departure
+  ///time from the source node over a given time interval.
+  ///The travel time functions of the arcs are
+  ///\ref PiecewiseLinearFunction "piecewise linear functions" with
+  ///the \e FIFO property (see \ref TimeDependentDijkstra), and so are
+  ///the computed profiles.
+  ///
+  ///The algorithm is a label correcting variant of %Dijkstra's
+  ///algorithm, whose labels are functions. The profile of the target
+  ///node of an arc is the minimum of its current profile and the
+  ///profile of the source node linked with the function of the arc.
+  ///The nodes are processed in the order of their earliest arrival
+  ///times, and a node is processed again only if its profile is
+  ///improved for some departure times.
+  ///
+  ///The computed profiles are stored in a \ref PiecewiseLinearArena,
+  ///so they can also be used as travel time functions (e.g. as
+  ///shortcut arcs).
+  ///
+  ///\tparam GR The type of the digraph the algorithm runs on.
+  ///\tparam TTM A \ref concepts::ReadMap "readable" arc map whose values
+  ///are \ref PiecewiseLinearFunction "PiecewiseLinearFunction<V>"
+  ///objects.
+  ///
+  ///\warning The travel times should be \e non-negative and the time
+  ///values should be of floating point type.
+  ///
+  ///\sa TimeDependentDijkstra
+  template <typename GR, typename TTM>
+  class TimeDependentProfile
+  {
+    TEMPLATE_DIGRAPH_TYPEDEFS(GR);
+
+  public:
+
+    ///The type of the digraph the algorithm runs on.
+    typedef GR Digraph;
+    ///The type of the map that stores the travel time functions.
+    typedef TTM TravelTimeMap;
+    ///The type of the travel time functions.
+    typedef typename TTM::Value Function;
+    ///The type of the time values.
+    typedef typename Function::Value Value;
+    ///The type of the arena that stores the profiles.
+    typedef PiecewiseLinearArena<Value> Arena;
+
+  private:
+
+    typedef std::pair<Value, Value> Point;
+    typedef std::vector<Point> Points;
+    typedef BinHeap<Value, IntNodeMap> Heap;
+
+    const Digraph &_graph;
+    const TravelTimeMap &_travel_time;
+    Tolerance<Value> _tolerance;
+
+    typename Digraph::template NodeMap<Points> _profile;
+    IntNodeMap _heap_cross_ref;
+    Heap _heap;
+    Points _link, _merge;
+    std::vector<Value> _xs, _ys;
+
+    Arena _arena;
+    typename Digraph::template NodeMap<Function> _result;
+
+  public:
+
+    ///Constructor.
+
+    ///Constructor.
+    ///\param graph The digraph the algorithm runs on.
+    ///\param travel_time The travel time functions of the arcs.
+    TimeDependentProfile(const Digraph &graph,
+                         const TravelTimeMap &travel_time)
+      : _graph(graph), _travel_time(travel_time), _profile(graph),
+        _heap_cross_ref(graph), _heap(_heap_cross_ref), _result(graph) {}
+
+    ///Sets the tolerance used by the algorithm.
+
+    ///Sets the tolerance that is used for comparing the profiles and
+    ///for removing the redundant breakpoints.
+    ///\return <tt> (*this) </tt>
+    TimeDependentProfile &tolerance(const Tolerance<Value>& tol) {
+      _tolerance = tol;
+      return *this;
+    }
+
+    ///Returns the tolerance used by the algorithm.
+    const Tolerance<Value>& tolerance() const {
+      return _tolerance;
+    }
+
+    ///\name Execution Control
+
+    ///@{
+
+    ///Runs the algorithm from the given source node.
+
+    ///This method computes the travel time profiles from node \c s to
+    ///all nodes for the departure times in the interval
+    ///<tt>[begin, end]</tt>.
+    ///
+    ///\note The profiles of the previous run are discarded, thus the
+    ///functions obtained from \ref travelTime() before become invalid.
+    void run(const Node& s, const Value& begin, const Value& end) {
+      search(s, INVALID, begin, end);
+    }
+
+    ///Runs the algorithm from the given source node to a target node.
+
+    ///This method computes the travel time profile from node \c s to
+    ///node \c t for the departure times in the interval
+    ///<tt>[begin, end]</tt>. It stops when no other profile can
+    ///improve the profile of \c t.
+    ///
+    ///\note The profiles of the other nodes may not be complete.
+    ///The profiles of the previous run are discarded, thus the
+    ///functions obtained from \ref travelTime() before become invalid.
+    ///
+    ///\return \c true if \c t is reachable form \c s.
+    bool run(const Node& s, const Node& t,
+             const Value& begin, const Value& end) {
+      search(s, t, begin, end);
+      return reached(t);
+    }
+
+    ///@}
+
+    ///\name Query Functions
+    ///The results of the algorithm can be obtained using these
+    ///functions.\n
+    ///\ref run() must be called before using them.
+
+    ///@{
+
+    ///Checks if the given node is reached from the source node.
+    bool reached(const Node& v) const {
+      return _result[v].size() > 0;
+    }
+
+    ///The travel time profile of the given node.
+
+    ///Returns the travel time from the source node to \c v as a
+    ///function of the departure time. It is valid for the departure
+    ///times in the interval given to \ref run(), and it is constant
+    ///outside of it.
+    ///
+    ///The returned function (and each copy of it) refers to the
+    ///breakpoints stored in this class, so it is valid only until the
+    ///next call of \ref run(). Copy the breakpoints if the profile is
+    ///needed later.
+    ///
+    ///\warning \c v should be reached from the source node.
+    const Function& travelTime(const Node& v) const {
+      return _result[v];
+    }
+
+    ///The earliest arrival time at the given node.
+
+    ///Returns the earliest arrival time at \c v for the given
+    ///departure time from the source node.
+    ///
+    ///\warning \c v should be reached from the source node.
+    Value arrivalTime(const Node& v, const Value& time) const {
+      return time + _result[v](time);
+    }
+
+    ///@}
+
+  private:
+
+    void search(const Node& s, const Node& t,
+                const Value& begin, const Value& end) {
+      _heap.clear();
+      for (NodeIt u(_graph); u != INVALID; ++u) {
+        _profile[u].clear();
+        _heap_cross_ref[u] = Heap::PRE_HEAP;
+      }
+
+      // The profile of the source node is constant zero
+      _profile[s].push_back(Point(begin, Value()));
+      if (begin < end) _profile[s].push_back(Point(end, Value()));
+      _heap.push(s, begin);
+
+      while (!_heap.empty()) {
+        if (t != INVALID && !_profile[t].empty() &&
+            !(_heap.prio() < _profile[t].back().first +
+                             _profile[t].back().second)) break;
+        Node u = _heap.top();
+        _heap.pop();
+        for (OutArcIt a(_graph, u); a != INVALID; ++a) {
+          Node v = _graph.target(a);
+          link(_profile[u], _travel_time[a], _link);
+          Points& prof = _profile[v];
+          if (prof.empty()) {
+            prof.swap(_link);
+          } else if (merge(prof, _link, _merge)) {
+            prof.swap(_merge);
+          } else {
+            continue;
+          }
+          Value key = prof[0].first + prof[0].second;
+          if (_heap.state(v) == Heap::IN_HEAP) {
+            _heap.set(v, key);
+          } else {
+            _heap.push(v, key);
+          }
+        }
+      }
+
+      // Store the profiles in the arena
+      _arena.clear();
+      for (NodeIt u(_graph); u != INVALID; ++u) {
+        const Points& prof = _profile[u];
+        _xs.clear();
+        _ys.clear();
+        for (int i = 0; i < int(prof.size()); ++i) {
+          _xs.push_back(prof[i].first);
+          _ys.push_back(prof[i].second);
+        }
+        _result[u] = _arena.add(_xs.begin(), _ys.begin(), prof.size());
+      }
+    }
+
+    // Append a breakpoint, skipping the ones at the same time and
+    // removing the redundant collinear ones
+    void append(Points& f, const Value& x, const Value& y) {
+      if (!f.empty() && !_tolerance.less(f.back().first, x)) return;
+      int n = f.size();
+      if (n >= 2) {
+        const Point& a = f[n - 2];
+        const Point& b = f[n - 1];
+        Value yb = a.second +
+          (y - a.second) * (b.first - a.first) / (x - a.first);
+        if (!_tolerance.different(yb, b.second)) f.pop_back();
+      }
+      f.push_back(Point(x, y));
+    }
+
+    // The value of f at x, where p is a breakpoint index that is
+    // advanced for increasing values of x
+    static Value eval(const Points& f, int& p, const Value& x) {
+      int n = f.size();
+      while (p + 1 < n && !(x < f[p + 1].first)) ++p;
+      if (x < f[0].first || p + 1 == n) return f[p].second;
+      return f[p].second + (f[p + 1].second - f[p].second) *
+        (x - f[p].first) / (f[p + 1].first - f[p].first);
+    }
+
+    // The profile of traversing f, then the arc of function g
+    void link(const Points& f, const Function& g, Points& res) {
+      res.clear();
+      int n = f.size();
+      int k = 0;
+      for (int i = 0; i < n; ++i) {
+        Value x0 = f[i].first, a0 = x0 + f[i].second;
+        while (k < g.size() && !(a0 < g.x(k))) ++k;
+        append(res, x0, f[i].second + g(a0));
+        if (i + 1 == n) break;
+
+        // The breakpoints of g between the arrival times at x0 and x1
+        Value x1 = f[i + 1].first, a1 = x1 + f[i + 1].second;
+        for (; k < g.size() && g.x(k) < a1; ++k) {
+          Value x = x0 + (x1 - x0) * (g.x(k) - a0) / (a1 - a0);
+          append(res, x, g.x(k) - x + g.y(k));
+        }
+      }
+    }
+
+    // The minimum of f and g; returns true if g is less than f
+    // somewhere
+    bool merge(const Points& f, const Points& g, Points& res) {
+      res.clear();
+      int n = f.size(), m = g.size();
+      int i = 0, j = 0, p = 0, q = 0;
+      bool improved = false;
+      Value px = Value(), pa = Value(), pd = Value();
+      while (i < n || j < m) {
+        Value x = (j == m || (i < n && !(g[j].first < f[i].first))) ?
+          f[i].first : g[j].first;
+        while (i < n && !(x < f[i].first)) ++i;
+        while (j < m && !(x < g[j].first)) ++j;
+        Value a = eval(f, p, x), b = eval(g, q, x);
+        Value d = a - b;
+        if (!res.empty() &&
+            ((_tolerance.positive(pd) && _tolerance.negative(d)) ||
+             (_tolerance.negative(pd) && _tolerance.positive(d)))) {
+          // The functions cross each other
+          Value xc = px + (x - px) * pd / (pd - d);
+          append(res, xc, pa + (a - pa) * (xc - px) / (x - px));
+        }
+        append(res, x, _tolerance.positive(d) ? b : a);
+        if (_tolerance.positive(d)) improved = true;
+        px = x;
+        pa = a;
+        pd = d;
+      }
+      return improved;
+    }
+
+  };
+
+  /// @}
+
+} //namespace lemon
+
+#endif //LEMON_TIME_DEPENDENT_DIJKSTRA_H
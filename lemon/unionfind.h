@@ -31,6 +31,7 @@
 #include <functional>
 
 #include <lemon/core.h>
+#include <lemon/bits/parallel.h>
 
 namespace lemon {
 
@@ -1817,6 +1818,108 @@ namespace lemon {
 
   };
 
+  /// \ingroup auxdat
+  ///
+  /// \brief A concurrent \e Union-Find data structure implementation
+  ///
+  /// This class implements a lock-free \e Union-Find data structure
+  /// on the integers <tt>[0..n-1]</tt>. Contrary to the other
+  /// union-find classes, the \ref find(), \ref join() and
+  /// \ref sameSet() methods can be called concurrently from several
+  /// threads.
+  ///
+  /// The parent of each element is stored in a plain integer array.
+  /// The union operation links the root with the larger index under
+  /// the other root using an atomic compare-and-swap operation, and it
+  /// is retried if one of the roots has been linked in the meantime.
+  /// The find operation uses path splitting, which is also performed
+  /// with compare-and-swap operations, so concurrent finds never
+  /// corrupt the structure. Since the parent of each element has
+  /// smaller index than the element itself, no cycles can be formed.
+  ///
+  /// It is primarily used in the parallel graph algorithms, like
+  /// \ref parallelKruskal().
+  class ConcurrentUnionFind {
+  private:
+    std::vector<int> _parent;
+
+  public:
+
+    /// \brief Constructor
+    ///
+    /// Constructor. It creates \c n singleton sets.
+    explicit ConcurrentUnionFind(int n = 0) {
+      init(n);
+    }
+
+    /// \brief Resets the data structure
+    ///
+    /// This function resets the data structure to \c n singleton sets.
+    void init(int n) {
+      _parent.resize(n);
+      for (int i = 0; i < n; ++i) {
+        _parent[i] = i;
+      }
+    }
+
+    /// \brief The number of the elements
+    ///
+    /// This function returns the number of the elements.
+    int size() const {
+      return _parent.size();
+    }
+
+    /// \brief Returns the representative of the element's set.
+    ///
+    /// This function returns the representative of the set containing
+    /// element \c i. It can be called concurrently, but if some
+    /// \ref join() operations are performed at the same time, the
+    /// returned element may not be the representative any more when
+    /// the function returns.
+    int find(int i) {
+      while (true) {
+        int p = bits::atomicLoad(&_parent[i]);
+        int g = bits::atomicLoad(&_parent[p]);
+        if (p == g) return p;
+        bits::atomicCompareAndSwap(&_parent[i], p, g);
+        i = p;
+      }
+    }
+
+    /// \brief Unites the sets of two elements.
+    ///
+    /// This function unites the sets containing the elements \c a
+    /// and \c b. It can be called concurrently.
+    ///
+    /// \return \c true if the two elements were in different sets
+    /// (and this call united them), \c false otherwise.
+    bool join(int a, int b) {
+      while (true) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (a < b) std::swap(a, b);
+        if (bits::atomicCompareAndSwap(&_parent[a], a, b)) return true;
+      }
+    }
+
+    /// \brief Checks if two elements are in the same set.
+    ///
+    /// This function returns \c true if the elements \c a and \c b
+    /// are in the same set. It can be called concurrently with
+    /// \ref join(), in which case the result is valid at some point
+    /// of the execution of the function.
+    bool sameSet(int a, int b) {
+      while (true) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return true;
+        if (bits::atomicLoad(&_parent[a]) == a) return false;
+      }
+    }
+
+  };
+
   //! @}
 
 } //namespace lemon
@@ -0,0 +1,773 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef LEMON_VIECUT_H
+#define LEMON_VIECUT_H
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <functional>
+
+#include <lemon/core.h>
+#include <lemon/maps.h>
+#include <lemon/bin_heap.h>
+#include <lemon/unionfind.h>
+#include <lemon/smart_graph.h>
+#include <lemon/nagamochi_ibaraki.h>
+#include <lemon/concept_check.h>
+#include <lemon/concepts/maps.h>
+#include <lemon/bits/parallel.h>
+
+/// \file
+/// \ingroup min_cut
+/// \brief Minimum cut with graph reductions in undirected graphs.
+
+namespace lemon {
+
+  namespace _viecut_bits {
+
+    // Cross reference map of a heap stored in a vector, so that the
+    // vector can be reused by the consecutive heaps of a thread
+    class VectorRefMap {
+    public:
+      typedef int Key;
+      typedef int Value;
+      typedef int& Reference;
+      typedef const int& ConstReference;
+      typedef True ReferenceMapTag;
+
+      explicit VectorRefMap(std::vector<int>& vector) : _vector(vector) {}
+
+      Reference operator[](const Key& k) { return _vector[k]; }
+      ConstReference operator[](const Key& k) const { return _vector[k]; }
+      void set(const Key& k, const Value& v) { _vector[k] = v; }
+
+    private:
+      std::vector<int>& _vector;
+    };
+
+    // The reduction steps on the current (contracted) graph, which is
+    // stored in a compact adjacency array (CSR) format. The original
+    // nodes are mapped to the current ones by _label, and the best
+    // cut found so far is stored by the side of the original nodes.
+    // The per-thread steps are called through operator()(id) on
+    // parallelRun() according to the current phase.
+    template <typename V>
+    class KernelEngine {
+    public:
+
+      KernelEngine(int threads, bool inexact)
+        : _threads(threads), _inexact(inexact) {}
+
+      void init(int node_num, const std::vector<int>& u,
+                const std::vector<int>& v, const std::vector<V>& w) {
+        _label.resize(node_num);
+        for (int i = 0; i < node_num; ++i) _label[i] = i;
+        _best.assign(node_num, 0);
+        _bound = std::numeric_limits<V>::max();
+        build(node_num, u, v, w);
+
+        // The per-thread buffers are allocated for the largest graph
+        // and reused by all steps, since the node numbers decrease
+        int threads = bits::parallelThreadNum(_threads, node_num, GRAIN);
+        _epoch = 0;
+        _stamp.assign(threads, std::vector<int>(node_num, 0));
+        _acc.assign(threads, std::vector<V>(node_num));
+        _cross.assign(threads, std::vector<int>(node_num, Heap::PRE_HEAP));
+        _order.resize(threads);
+        _cut.resize(threads);
+        _sep.resize(threads);
+      }
+
+      void run() {
+        if (_node_num < 2 || !connected()) return;
+        trivialCut();
+        while (_node_num > 2 && V(0) < _bound) {
+          int old_num = _node_num;
+          labelPropagation();
+          if (_node_num > 2 && V(0) < _bound) padbergRinaldi();
+          if (_node_num > 2 && V(0) < _bound) capForest();
+          if (10 * (old_num - _node_num) < old_num) break;
+        }
+      }
+
+      // Records the given cut of the current graph if it is better
+      // than the best one found so far
+      void improve(const V& value, const std::vector<char>& inside) {
+        if (!(value < _bound)) return;
+        _bound = value;
+        for (int i = 0; i < int(_label.size()); ++i) {
+          _best[i] = inside[_label[i]];
+        }
+      }
+
+      int nodeNum() const { return _node_num; }
+      const std::vector<int>& first() const { return _first; }
+      const std::vector<int>& target() const { return _target; }
+      const std::vector<V>& weight() const { return _weight; }
+
+      const V& bound() const { return _bound; }
+      bool side(int i) const { return _best[i] != 0; }
+
+      void operator()(int id) {
+        switch (_phase) {
+        case LABEL:
+          labelStep(id);
+          break;
+        case TRIANGLE:
+          triangleStep(id);
+          break;
+        case FOREST:
+          forestStep(id);
+          break;
+        }
+      }
+
+    private:
+
+      enum { LABEL, TRIANGLE, FOREST };
+
+      // The number of label propagation rounds
+      static const int LABEL_ROUNDS = 2;
+      // The minimum number of nodes per thread
+      static const int GRAIN = 256;
+
+      typedef BinHeap<V, VectorRefMap, std::greater<V> > Heap;
+
+      // Builds the current graph from an edge list merging the
+      // parallel edges and dropping the loops
+      void build(int node_num, const std::vector<int>& u,
+                 const std::vector<int>& v, const std::vector<V>& w) {
+        int m = u.size();
+        std::vector<int> start(node_num + 1, 0), order(m);
+        for (int e = 0; e < m; ++e) {
+          if (u[e] != v[e]) ++start[std::min(u[e], v[e]) + 1];
+        }
+        for (int i = 0; i < node_num; ++i) start[i + 1] += start[i];
+        for (int e = 0; e < m; ++e) {
+          if (u[e] != v[e]) order[start[std::min(u[e], v[e])]++] = e;
+        }
+        for (int i = node_num; i > 0; --i) start[i] = start[i - 1];
+        start[0] = 0;
+
+        std::vector<int> eu, ev, mark(node_num, -1), pos(node_num);
+        std::vector<V> ew;
+        for (int a = 0; a < node_num; ++a) {
+          for (int k = start[a]; k < start[a + 1]; ++k) {
+            int e = order[k];
+            int b = u[e] == a ? v[e] : u[e];
+            if (mark[b] == a) {
+              ew[pos[b]] += w[e];
+            } else {
+              mark[b] = a;
+              pos[b] = eu.size();
+              eu.push_back(a);
+              ev.push_back(b);
+              ew.push_back(w[e]);
+            }
+          }
+        }
+
+        _node_num = node_num;
+        _first.assign(node_num + 1, 0);
+        for (int e = 0; e < int(eu.size()); ++e) {
+          ++_first[eu[e] + 1];
+          ++_first[ev[e] + 1];
+        }
+        for (int i = 0; i < node_num; ++i) _first[i + 1] += _first[i];
+        std::vector<int> cursor(_first.begin(), _first.end() - 1);
+        _target.resize(2 * eu.size());
+        _weight.resize(2 * eu.size());
+        _degree.assign(node_num, 0);
+        for (int e = 0; e < int(eu.size()); ++e) {
+          int k = cursor[eu[e]]++;
+          _target[k] = ev[e];
+          _weight[k] = ew[e];
+          k = cursor[ev[e]]++;
+          _target[k] = eu[e];
+          _weight[k] = ew[e];
+          _degree[eu[e]] += ew[e];
+          _degree[ev[e]] += ew[e];
+        }
+      }
+
+      // Contracts the current graph according to the given mapping
+      // to the nodes of the new graph
+      void contract(const std::vector<int>& comp, int comp_num) {
+        std::vector<int> u, v;
+        std::vector<V> w;
+        for (int x = 0; x < _node_num; ++x) {
+          for (int k = _first[x]; k < _first[x + 1]; ++k) {
+            int y = _target[k];
+            if (x < y && comp[x] != comp[y]) {
+              u.push_back(comp[x]);
+              v.push_back(comp[y]);
+              w.push_back(_weight[k]);
+            }
+          }
+        }
+        for (int i = 0; i < int(_label.size()); ++i) {
+          _label[i] = comp[_label[i]];
+        }
+        build(comp_num, u, v, w);
+        trivialCut();
+      }
+
+      // Contracts the sets of the union-find structure
+      void contract(ConcurrentUnionFind& uf) {
+        std::vector<int> comp(_node_num);
+        int comp_num = 0;
+        for (int x = 0; x < _node_num; ++x) {
+          if (uf.find(x) == x) comp[x] = comp_num++;
+        }
+        if (comp_num == _node_num) return;
+        for (int x = 0; x < _node_num; ++x) {
+          comp[x] = comp[uf.find(x)];
+        }
+        contract(comp, comp_num);
+      }
+
+      // Checks the connectivity of the graph, and stores a component
+      // as a cut of zero value if it is not connected
+      bool connected() {
+        std::vector<char> reached(_node_num, 0);
+        std::vector<int> queue(1, 0);
+        reached[0] = 1;
+        for (int i = 0; i < int(queue.size()); ++i) {
+          int x = queue[i];
+          for (int k = _first[x]; k < _first[x + 1]; ++k) {
+            if (!reached[_target[k]]) {
+              reached[_target[k]] = 1;
+              queue.push_back(_target[k]);
+            }
+          }
+        }
+        if (int(queue.size()) == _node_num) return true;
+        improve(V(0), reached);
+        return false;
+      }
+
+      // The cuts of the single nodes. The reductions rely on that the
+      // bound is not greater than the weighted degree of any node.
+      void trivialCut() {
+        if (_node_num < 2) return;
+        int best = 0;
+        for (int x = 1; x < _node_num; ++x) {
+          if (_degree[x] < _degree[best]) best = x;
+        }
+        if (_degree[best] < _bound) {
+          std::vector<char> inside(_node_num, 0);
+          inside[best] = 1;
+          improve(_degree[best], inside);
+        }
+      }
+
+      void runThreads(int phase) {
+        _phase = phase;
+        _step_threads = bits::parallelThreadNum(_threads, _node_num, GRAIN);
+        bits::parallelRun(_step_threads, *this);
+      }
+
+      int stepFirst(int id) const {
+        return static_cast<int>(
+          static_cast<long long>(_node_num) * id / _step_threads);
+      }
+
+      // Starts a new pass on the nodes, in which node x uses the stamp
+      // _base + x + 1, so the stamps of the earlier passes need not be
+      // cleared
+      void nextPass() {
+        if (_epoch > std::numeric_limits<int>::max() - _node_num) {
+          for (int t = 0; t < int(_stamp.size()); ++t) {
+            std::fill(_stamp[t].begin(), _stamp[t].end(), 0);
+          }
+          _epoch = 0;
+        }
+        _base = _epoch;
+        _epoch += _node_num;
+      }
+
+      // Label propagation: each node joins the cluster to which it
+      // is connected with the largest weight. The cuts of the
+      // clusters are upper bounds, and in the inexact mode the
+      // clusters are contracted.
+      void labelPropagation() {
+        int n = _node_num;
+        _cluster.resize(n);
+        for (int x = 0; x < n; ++x) _cluster[x] = x;
+        for (int r = 0; r < LABEL_ROUNDS; ++r) {
+          nextPass();
+          runThreads(LABEL);
+        }
+
+        std::vector<int> id(n, -1), comp(n);
+        int comp_num = 0;
+        for (int x = 0; x < n; ++x) {
+          int c = _cluster[x];
+          if (id[c] == -1) id[c] = comp_num++;
+          comp[x] = id[c];
+        }
+        if (comp_num < 2 || comp_num == n) return;
+
+        std::vector<V> cut(comp_num, V(0));
+        for (int x = 0; x < n; ++x) {
+          for (int k = _first[x]; k < _first[x + 1]; ++k) {
+            if (comp[_target[k]] != comp[x]) cut[comp[x]] += _weight[k];
+          }
+        }
+        int best = 0;
+        for (int c = 1; c < comp_num; ++c) {
+          if (cut[c] < cut[best]) best = c;
+        }
+        if (cut[best] < _bound) {
+          std::vector<char> inside(n);
+          for (int x = 0; x < n; ++x) inside[x] = comp[x] == best;
+          improve(cut[best], inside);
+        }
+        if (_inexact) contract(comp, comp_num);
+      }
+
+      void labelStep(int id) {
+        std::vector<int>& stamp = _stamp[id];
+        std::vector<V>& acc = _acc[id];
+        int last = stepFirst(id + 1);
+        for (int x = stepFirst(id); x < last; ++x) {
+          int s = _base + x + 1;
+          int best = bits::atomicLoad(&_cluster[x]);
+          stamp[best] = s;
+          acc[best] = V(0);
+          for (int k = _first[x]; k < _first[x + 1]; ++k) {
+            int c = bits::atomicLoad(&_cluster[_target[k]]);
+            if (stamp[c] != s) {
+              stamp[c] = s;
+              acc[c] = _weight[k];
+            } else {
+              acc[c] += _weight[k];
+            }
+            if (acc[best] < acc[c]) best = c;
+          }
+          bits::atomicStore(&_cluster[x], best);
+        }
+      }
+
+      // Padberg-Rinaldi tests with the current bound. An edge is
+      // contracted if its weight, or its weight and the paths through
+      // the common neighbors of its end nodes, reach the bound. These
+      // edges are not cut by any cut smaller than the bound, so they
+      // are contracted at once. In addition, a set of node disjoint
+      // edges is contracted whose weight is at least half of the
+      // degree of an end node.
+      void padbergRinaldi() {
+        int n = _node_num;
+        _uf.init(n);
+        nextPass();
+        runThreads(TRIANGLE);
+
+        std::vector<char> used(n, 0);
+        for (int x = 0; x < n; ++x) {
+          for (int k = _first[x]; k < _first[x + 1] && !used[x]; ++k) {
+            int y = _target[k];
+            if (x > y || used[y]) continue;
+            V d = _degree[y] < _degree[x] ? _degree[y] : _degree[x];
+            if (!(_weight[k] + _weight[k] < d)) {
+              _uf.join(x, y);
+              used[x] = used[y] = 1;
+            }
+          }
+        }
+        contract(_uf);
+      }
+
+      void triangleStep(int id) {
+        std::vector<int>& stamp = _stamp[id];
+        std::vector<V>& acc = _acc[id];
+        int last = stepFirst(id + 1);
+        for (int x = stepFirst(id); x < last; ++x) {
+          int s = _base + x + 1;
+          int dx = _first[x + 1] - _first[x];
+          for (int k = _first[x]; k < _first[x + 1]; ++k) {
+            stamp[_target[k]] = s;
+            acc[_target[k]] = _weight[k];
+          }
+          // Each edge is checked at its end node of larger degree, so
+          // the triangles are listed in O(m sqrt(m)) time
+          for (int k = _first[x]; k < _first[x + 1]; ++k) {
+            int y = _target[k];
+            int dy = _first[y + 1] - _first[y];
+            if (dy > dx || (dy == dx && y > x)) continue;
+            V sum = _weight[k];
+            for (int l = _first[y]; l < _first[y + 1] && sum < _bound; ++l) {
+              int z = _target[l];
+              if (stamp[z] == s) {
+                sum += acc[z] < _weight[l] ? acc[z] : _weight[l];
+              }
+            }
+            if (!(sum < _bound)) _uf.join(x, y);
+          }
+        }
+      }
+
+      // Maximum adjacency (MA) orderings with a priority queue per
+      // thread. The threads start from different nodes, and each node
+      // is scanned by the thread that first pops it. When the priority
+      // of a node reaches the bound, the connectivity between it and
+      // the scanned node is at least the bound, so they are contracted.
+      // The prefixes of the orderings are cuts of the graph.
+      void capForest() {
+        int n = _node_num;
+        _uf.init(n);
+        _owner.assign(n, -1);
+        _forest_threads = bits::parallelThreadNum(_threads, n, GRAIN);
+        _phase = FOREST;
+        bits::parallelRun(_forest_threads, *this);
+
+        for (int t = 0; t < _forest_threads; ++t) {
+          if (_sep[t] > 0 && _cut[t] < _bound) {
+            std::vector<char> inside(n, 0);
+            for (int i = 0; i < _sep[t]; ++i) inside[_order[t][i]] = 1;
+            improve(_cut[t], inside);
+          }
+        }
+        contract(_uf);
+      }
+
+      void forestStep(int id) {
+        int n = _node_num;
+        VectorRefMap cross(_cross[id]);
+        Heap heap(cross);
+        std::vector<int>& order = _order[id];
+        order.clear();
+        _sep[id] = 0;
+        _cut[id] = std::numeric_limits<V>::max();
+        V alpha = 0;
+
+        int start = static_cast<int>(
+          static_cast<long long>(n) * id / _forest_threads);
+        heap.push(start, V(0));
+        while (!heap.empty()) {
+          int x = heap.top();
+          V r = heap.prio();
+          heap.pop();
+          if (!bits::atomicCompareAndSwap(&_owner[x], -1, id)) continue;
+
+          order.push_back(x);
+          alpha += _degree[x];
+          alpha -= 2 * r;
+          if (int(order.size()) < n && alpha < _cut[id]) {
+            _cut[id] = alpha;
+            _sep[id] = order.size();
+          }
+
+          for (int k = _first[x]; k < _first[x + 1]; ++k) {
+            int y = _target[k];
+            if (bits::atomicLoad(&_owner[y]) != -1) continue;
+            V p;
+            switch (heap.state(y)) {
+            case Heap::PRE_HEAP:
+              p = _weight[k];
+              heap.push(y, p);
+              break;
+            case Heap::IN_HEAP:
+              p = heap[y] + _weight[k];
+              heap.decrease(y, p);
+              break;
+            default:
+              continue;
+            }
+            if (!(p < _bound)) _uf.join(x, y);
+          }
+        }
+
+        // Each pushed node is the start node or a neighbor of a
+        // scanned node
+        cross[start] = Heap::PRE_HEAP;
+        for (int i = 0; i < int(order.size()); ++i) {
+          int x = order[i];
+          for (int k = _first[x]; k < _first[x + 1]; ++k) {
+            cross[_target[k]] = Heap::PRE_HEAP;
+          }
+        }
+      }
+
+      int _threads;
+      bool _inexact;
+      int _phase;
+
+      // The current graph
+      int _node_num;
+      std::vector<int> _first, _target;
+      std::vector<V> _weight, _degree;
+
+      // The current node of each original node and the best cut
+      std::vector<int> _label;
+      std::vector<char> _best;
+      V _bound;
+
+      int _step_threads;
+      int _epoch, _base;
+      std::vector<int> _cluster;
+      std::vector<std::vector<int> > _stamp;
+      std::vector<std::vector<V> > _acc;
+      ConcurrentUnionFind _uf;
+
+      int _forest_threads;
+      std::vector<int> _owner;
+      std::vector<std::vector<int> > _cross;
+      std::vector<std::vector<int> > _order;
+      std::vector<V> _cut;
+      std::vector<int> _sep;
+    };
+
+  }
+
+  /// \ingroup min_cut
+  ///
+  /// \brief Minimum cut in undirected graphs using graph reductions.
+  ///
+  /// This class calculates a minimum cut in an undirected graph with
+  /// non-negative edge capacities. Before the exact computation, the
+  /// graph is reduced by contracting edges that are not cut by any
+  /// cut smaller than the best one found so far (Henzinger, Noe,
+  /// Schulz and Strash, "Practical minimum cut algorithms", based on
+  /// the VieCut algorithm). The reduced graph (the kernel) is then
+  /// solved by \ref NagamochiIbaraki. On large sparse graphs the kernel
+  /// is usually much smaller than the input graph.
+  ///
+  /// The reduction consists of rounds of the following steps.
+  /// - Label propagation clusters the nodes. The cuts of the clusters
+  /// give upper bounds on the minimum cut value, and in the
+  /// \ref inexact() "inexact" mode the clusters are also contracted.
+  /// - The tests of Padberg and Rinaldi contract the heavy edges and
+  /// the edges of heavy triangles with respect to the current bound.
+  /// - Maximum adjacency orderings (the CAPFOREST procedure of
+  /// Nagamochi and Ibaraki) contract the edges whose end nodes are
+  /// connected at least as strongly as the current bound. These
+  /// orderings run on several threads with a priority queue per
+  /// thread, each thread starting from a different node.
+  ///
+  /// The reduction stops when a round decreases the number of nodes
+  /// by less than 10 percent. The steps of the rounds run in parallel
+  /// on the given number of \ref threads() "threads".
+  ///
+  /// By default, the algorithm is exact: only the contractions of the
+  /// Padberg-Rinaldi tests and the orderings are performed, which keep
+  /// a minimum cut. In the inexact mode, the contraction of the
+  /// clusters may destroy all minimum cuts, so the result is the value
+  /// of a cut which is not necessarily minimal, but usually it is.
+  ///
+  /// \tparam GR The type of the undirected graph the algorithm runs on.
+  /// \tparam CM The type of the edge map containing the capacities.
+  /// The default map type is \ref concepts::Graph::EdgeMap
+  /// "GR::EdgeMap<int>".
+  ///
+  /// \warning The value type of the capacity map should be able to
+  /// hold any cut value of the graph, otherwise the result can
+  /// overflow.
+#ifdef DOXYGEN
+  template <typename GR, typename CM>
+#else
+  template <typename GR,
+            typename CM = typename GR::template EdgeMap<int> >
+#endif
+  class VieCut {
+  public:
+
+    /// The graph type of the algorithm
+    typedef GR Graph;
+    /// The capacity map type of the algorithm
+    typedef CM CapacityMap;
+    /// The value type of capacities
+    typedef typename CapacityMap::Value Value;
+
+  private:
+
+    TEMPLATE_GRAPH_TYPEDEFS(Graph);
+
+    const Graph& _graph;
+    const CapacityMap& _capacity;
+
+    int _threads;
+    bool _inexact;
+
+    Value _min_cut;
+    typename Graph::template NodeMap<bool> _cut_map;
+    int _kernel_node_num;
+    int _kernel_edge_num;
+
+  public:
+
+    /// \brief Constructor.
+    ///
+    /// Constructor.
+    /// \param graph The undirected graph the algorithm runs on.
+    /// \param capacity The edge capacity map.
+    VieCut(const Graph& graph, const CapacityMap& capacity)
+      : _graph(graph), _capacity(capacity), _threads(0),
+        _inexact(false), _min_cut(), _cut_map(graph),
+        _kernel_node_num(0), _kernel_edge_num(0)
+    {
+      checkConcept<concepts::ReadMap<Edge, Value>, CapacityMap>();
+    }
+
+    /// \brief Sets the number of threads.
+    ///
+    /// This function sets the number of threads. The value 0 (the
+    /// default) stands for the number of hardware threads.
+    /// \return <tt>(*this)</tt>
+    VieCut& threads(int num) {
+      _threads = num;
+      return *this;
+    }
+
+    /// \brief Sets the inexact mode.
+    ///
+    /// This function sets whether the clusters found by label
+    /// propagation are contracted (it is \c false by default).
+    /// It makes the reduction faster, but the result may not be a
+    /// minimum cut.
+    /// \return <tt>(*this)</tt>
+    VieCut& inexact(bool b = true) {
+      _inexact = b;
+      return *this;
+    }
+
+    /// \name Execution Control
+
+    ///@{
+
+    /// \brief Runs the algorithm.
+    ///
+    /// This function reduces the graph, then runs the
+    /// \ref NagamochiIbaraki algorithm on the kernel.
+    void run() {
+      std::vector<Node> nodes;
+      IntNodeMap index(_graph);
+      for (NodeIt n(_graph); n != INVALID; ++n) {
+        index[n] = nodes.size();
+        nodes.push_back(n);
+      }
+      int n = nodes.size();
+
+      std::vector<int> u, v;
+      std::vector<Value> w;
+      for (EdgeIt e(_graph); e != INVALID; ++e) {
+        u.push_back(index[_graph.u(e)]);
+        v.push_back(index[_graph.v(e)]);
+        w.push_back(_capacity[e]);
+      }
+
+      _viecut_bits::KernelEngine<Value> engine(_threads, _inexact);
+      engine.init(n, u, v, w);
+      engine.run();
+
+      _kernel_node_num = engine.nodeNum();
+      _kernel_edge_num = engine.target().size() / 2;
+      if (_kernel_node_num > 2 && Value(0) < engine.bound()) {
+        typedef SmartGraph::EdgeMap<Value> KernelCapacity;
+        SmartGraph kernel;
+        KernelCapacity capacity(kernel);
+        kernel.reserveNode(_kernel_node_num);
+        kernel.reserveEdge(_kernel_edge_num);
+        for (int x = 0; x < _kernel_node_num; ++x) kernel.addNode();
+        const std::vector<int>& first = engine.first();
+        const std::vector<int>& target = engine.target();
+        for (int x = 0; x < _kernel_node_num; ++x) {
+          for (int k = first[x]; k < first[x + 1]; ++k) {
+            if (x < target[k]) {
+              capacity[kernel.addEdge(kernel.nodeFromId(x),
+                                      kernel.nodeFromId(target[k]))] =
+                engine.weight()[k];
+            }
+          }
+        }
+
+        NagamochiIbaraki<SmartGraph, KernelCapacity> ni(kernel, capacity);
+        ni.run();
+        SmartGraph::NodeMap<bool> cut(kernel);
+        ni.minCutMap(cut);
+        std::vector<char> inside(_kernel_node_num);
+        for (int x = 0; x < _kernel_node_num; ++x) {
+          inside[x] = cut[kernel.nodeFromId(x)];
+        }
+        engine.improve(ni.minCutValue(), inside);
+      }
+
+      _min_cut = engine.bound();
+      for (int i = 0; i < n; ++i) {
+        _cut_map[nodes[i]] = engine.side(i);
+      }
+    }
+
+    ///@}
+
+    /// \name Query Functions
+    /// The results of the algorithm can be obtained using these
+    /// functions.\n
+    /// \ref run() must be called before using them.
+
+    ///@{
+
+    /// \brief Returns the value of the minimum cut.
+    ///
+    /// This function returns the value of the minimum cut, or the
+    /// largest value of the value type if the graph has less than two
+    /// nodes.
+    Value minCutValue() const {
+      return _min_cut;
+    }
+
+    /// \brief Returns a minimum cut in a node map.
+    ///
+    /// This function sets the nodes of one side of the minimum cut
+    /// to \c true and the other nodes to \c false in the given map.
+    /// \param cutMap A \ref concepts::WriteMap "writable" node map with
+    /// \c bool (or convertible) value type.
+    /// \return The value of the minimum cut.
+    template <typename CutMap>
+    Value minCutMap(CutMap& cutMap) const {
+      for (NodeIt n(_graph); n != INVALID; ++n) {
+        cutMap.set(n, _cut_map[n]);
+      }
+      return _min_cut;
+    }
+
+    /// \brief Returns the number of nodes of the kernel.
+    ///
+    /// This function returns the number of nodes of the reduced graph
+    /// that was passed to \ref NagamochiIbaraki.
+    int kernelNodeNum() const {
+      return _kernel_node_num;
+    }
+
+    /// \brief Returns the number of edges of the kernel.
+    ///
+    /// This function returns the number of edges of the reduced graph
+    /// that was passed to \ref NagamochiIbaraki (after merging the
+    /// parallel edges).
+    int kernelEdgeNum() const {
+      return _kernel_edge_num;
+    }
+
+    ///@}
+
+  };
+
+} //namespace lemon
+
+#endif //LEMON_VIECUT_H
@@ -0,0 +1,260 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include <lemon/assignment.h>
+#include <lemon/matching.h>
+#include <lemon/smart_graph.h>
+#include <lemon/full_graph.h>
+#include <lemon/concepts/bpgraph.h>
+#include <lemon/concepts/maps.h>
+#include <lemon/random.h>
+#include <lemon/math.h>
+
+#include "test_tools.h"
+
+using namespace lemon;
+
+template <typename Alg>
+void checkAssignmentCompile(Alg& alg)
+{
+  typedef concepts::BpGraph BpGraph;
+  typedef BpGraph::Node Node;
+  typedef BpGraph::Edge Edge;
+
+  Node n;
+  Edge e;
+  int w;
+  bool b;
+
+  const Alg& const_alg = alg;
+  b = alg.run();
+
+  w = const_alg.matchingWeight();
+  w = const_alg.matchingSize();
+  b = const_alg.matching(e);
+  e = const_alg.matching(n);
+  const typename Alg::MatchingMap& mmap = const_alg.matchingMap();
+  e = mmap[n];
+  n = const_alg.mate(n);
+
+  ignore_unused_variable_warning(w, b);
+}
+
+void checkCompile() {
+  typedef concepts::BpGraph BpGraph;
+  typedef concepts::ReadMap<BpGraph::Edge, int> WeightMap;
+
+  BpGraph g;
+  WeightMap w;
+
+  HungarianAssignment<BpGraph, WeightMap> hung(g, w);
+  checkAssignmentCompile(hung);
+  AuctionAssignment<BpGraph, WeightMap> auct(g, w);
+  auct.threadNum(2);
+  checkAssignmentCompile(auct);
+
+  int matrix[6] = { 1, 2, 3, 4, 5, 6 };
+  int mate[2];
+  hungarianAssignment(2, 3, matrix, mate);
+  auctionAssignment(2, 3, matrix, mate, 2);
+}
+
+// Checks that the found matching covers the smaller color class
+template <typename BGR, typename Alg>
+void checkMatching(const BGR& g, const Alg& alg) {
+  typedef typename BGR::NodeIt NodeIt;
+  typedef typename BGR::EdgeIt EdgeIt;
+  int num = 0;
+  for (NodeIt n(g); n != INVALID; ++n) {
+    if (alg.matching(n) != INVALID) {
+      check(g.source(alg.matching(n)) == n, "Wrong matching arc");
+      check(alg.mate(alg.mate(n)) == n, "Wrong matching");
+      ++num;
+    }
+  }
+  check(num == 2 * std::min(countRedNodes(g), countBlueNodes(g)),
+        "Wrong matching size");
+  check(num == 2 * alg.matchingSize(), "Wrong matching size");
+  int matched = 0;
+  for (EdgeIt e(g); e != INVALID; ++e) {
+    if (alg.matching(e)) ++matched;
+  }
+  check(matched == alg.matchingSize(), "Wrong matching");
+}
+
+// Brute force maximum weight assignment of the rows (rows <= cols)
+int bruteForce(int rows, int cols, const std::vector<int>& w) {
+  std::vector<int> perm(cols);
+  for (int j = 0; j < cols; ++j) perm[j] = j;
+  int best = 0;
+  bool first = true;
+  do {
+    int sum = 0;
+    for (int i = 0; i < rows; ++i) sum += w[i * cols + perm[i]];
+    if (first || sum > best) best = sum;
+    first = false;
+  } while (std::next_permutation(perm.begin(), perm.end()));
+  return best;
+}
+
+void checkDenseMatrices() {
+  for (int t = 0; t < 30; ++t) {
+    int rows = 1 + rnd[6], cols = 1 + rnd[6];
+    std::vector<int> w(rows * cols);
+    for (int k = 0; k < rows * cols; ++k) w[k] = rnd[41] - 20;
+    int opt;
+    if (rows <= cols) {
+      opt = bruteForce(rows, cols, w);
+    } else {
+      std::vector<int> tw(rows * cols);
+      for (int i = 0; i < rows; ++i)
+        for (int j = 0; j < cols; ++j) tw[j * rows + i] = w[i * cols + j];
+      opt = bruteForce(cols, rows, tw);
+    }
+    for (int alg = 0; alg < 2; ++alg) {
+      std::vector<int> mate(rows);
+      int value = alg == 0 ?
+        hungarianAssignment(rows, cols, w.begin(), mate.begin()) :
+        auctionAssignment(rows, cols, &w[0], &mate[0], 4);
+      check(value == opt, "Wrong assignment weight");
+      std::vector<int> used(cols, 0);
+      int sum = 0, num = 0;
+      for (int i = 0; i < rows; ++i) {
+        if (mate[i] != -1) {
+          check(!used[mate[i]], "Wrong assignment");
+          used[mate[i]] = 1;
+          sum += w[i * cols + mate[i]];
+          ++num;
+        }
+      }
+      check(sum == opt && num == std::min(rows, cols), "Wrong assignment");
+    }
+  }
+
+  std::vector<double> w(12);
+  for (int k = 0; k < 12; ++k) w[k] = rnd();
+  std::vector<int> mate(4);
+  double hv = hungarianAssignment(4, 3, &w[0], &mate[0]);
+  double av = auctionAssignment(4, 3, &w[0], &mate[0], 2);
+  check(std::abs(hv - av) < 1e-6, "Wrong assignment weight");
+}
+
+void checkFullBpGraph(int red_num, int blue_num) {
+  FullBpGraph g(red_num, blue_num);
+  FullBpGraph::EdgeMap<int> w(g);
+  for (FullBpGraph::EdgeIt e(g); e != INVALID; ++e) {
+    w[e] = rnd[1000];
+  }
+
+  HungarianAssignment<FullBpGraph> hung(g, w);
+  check(hung.run(), "Wrong result");
+  checkMatching(g, hung);
+
+  for (int threads = 1; threads <= 4; threads *= 2) {
+    AuctionAssignment<FullBpGraph> auct(g, w);
+    check(auct.threadNum(threads).run(), "Wrong result");
+    checkMatching(g, auct);
+    check(auct.matchingWeight() == hung.matchingWeight(),
+          "Wrong matching weight");
+  }
+
+  if (red_num == blue_num) {
+    MaxWeightedPerfectMatching<FullBpGraph, FullBpGraph::EdgeMap<int> >
+      mwpm(g, w);
+    check(mwpm.run(), "Wrong result");
+    check(mwpm.matchingWeight() == hung.matchingWeight(),
+          "Wrong matching weight");
+  }
+}
+
+void checkSparseGraph() {
+  typedef SmartBpGraph::RedNode RedNode;
+  typedef SmartBpGraph::BlueNode BlueNode;
+
+  for (int t = 0; t < 10; ++t) {
+    SmartBpGraph g;
+    SmartBpGraph::EdgeMap<int> w(g);
+    int red_num = 20 + rnd[20], blue_num = 20 + rnd[20];
+    std::vector<RedNode> reds;
+    std::vector<BlueNode> blues;
+    for (int i = 0; i < red_num; ++i) reds.push_back(g.addRedNode());
+    for (int i = 0; i < blue_num; ++i) blues.push_back(g.addBlueNode());
+    // A matching covering the smaller class, plus random edges
+    for (int i = 0; i < std::min(red_num, blue_num); ++i) {
+      w[g.addEdge(reds[i], blues[(i * 7) % blue_num])] = rnd[100] - 50;
+    }
+    for (int i = 0; i < 3 * (red_num + blue_num); ++i) {
+      w[g.addEdge(reds[rnd[red_num]], blues[rnd[blue_num]])] =
+        rnd[100] - 50;
+    }
+
+    HungarianAssignment<SmartBpGraph> hung(g, w);
+    check(hung.run(), "Wrong result");
+    checkMatching(g, hung);
+    AuctionAssignment<SmartBpGraph> auct(g, w);
+    check(auct.threadNum(4).run(), "Wrong result");
+    checkMatching(g, auct);
+    check(auct.matchingWeight() == hung.matchingWeight(),
+          "Wrong matching weight");
+  }
+
+  // No matching covers the red nodes
+  SmartBpGraph g;
+  SmartBpGraph::EdgeMap<int> w(g, 1);
+  RedNode r1 = g.addRedNode(), r2 = g.addRedNode();
+  BlueNode b1 = g.addBlueNode();
+  g.addBlueNode();
+  g.addBlueNode();
+  g.addEdge(r1, b1);
+  g.addEdge(r2, b1);
+  HungarianAssignment<SmartBpGraph> hung(g, w);
+  check(!hung.run(), "Wrong result");
+  AuctionAssignment<SmartBpGraph> auct(g, w);
+  check(!auct.run(), "Wrong result");
+
+  // Parallel edges: as many edges as node pairs, but no perfect matching
+  SmartBpGraph pg;
+  SmartBpGraph::EdgeMap<int> pw(pg, 1);
+  RedNode pr1 = pg.addRedNode(), pr2 = pg.addRedNode();
+  BlueNode pb1 = pg.addBlueNode();
+  pg.addBlueNode();
+  pg.addEdge(pr1, pb1);
+  pg.addEdge(pr1, pb1);
+  pg.addEdge(pr2, pb1);
+  pg.addEdge(pr2, pb1);
+  AuctionAssignment<SmartBpGraph> pauct(pg, pw);
+  check(!pauct.run(), "Wrong result");
+}
+
+int main() {
+  checkDenseMatrices();
+
+  checkFullBpGraph(1, 1);
+  checkFullBpGraph(8, 8);
+  checkFullBpGraph(30, 20);
+  checkFullBpGraph(20, 50);
+  checkFullBpGraph(60, 60);
+
+  checkSparseGraph();
+
+  return 0;
+}
@@ -22,6 +22,7 @@
 #include <lemon/lgf_reader.h>
 #include <lemon/bellman_ford.h>
 #include <lemon/path.h>
+#include <lemon/random.h>
 
 #include "graph_test.h"
 #include "test_tools.h"
@@ -86,10 +87,12 @@ void checkBellmanFordCompile()
     bf_test.addSource(s, 1);
     b = bf_test.processNextRound();
     b = bf_test.processNextWeakRound();
+    b = bf_test.processNextParallelRound();
 
     bf_test.start();
     bf_test.checkedStart();
     bf_test.limitedStart(k);
+    b = bf_test.spfaStart();
 
     l  = const_bf_test.dist(t);
     e  = const_bf_test.predArc(t);
@@ -121,7 +124,8 @@ void checkBellmanFordCompile()
     bf_test
       .lengthMap(length_map)
       .predMap(pred_map)
-      .distMap(dist_map);
+      .distMap(dist_map)
+      .threadNum(2);
 
     bf_test.run(s);
     bf_test.run(s,k);
@@ -131,10 +135,12 @@ void checkBellmanFordCompile()
     bf_test.addSource(s, 1);
     b = bf_test.processNextRound();
     b = bf_test.processNextWeakRound();
+    b = bf_test.processNextParallelRound();
 
     bf_test.start();
     bf_test.checkedStart();
     bf_test.limitedStart(k);
+    b = bf_test.spfaStart();
 
     l  = bf_test.dist(t);
     e  = bf_test.predArc(t);
@@ -230,6 +236,25 @@ void checkBellmanFord() {
       }
     }
   }
+
+  {
+    BellmanFord<Digraph, LengthMap> pbf(gr, length);
+    pbf.threadNum(4).init();
+    pbf.addSource(s);
+    check(pbf.checkedStart(), "Wrong negative cycle detection.");
+    BellmanFord<Digraph, LengthMap> sbf(gr, length);
+    sbf.init();
+    sbf.addSource(s);
+    check(sbf.spfaStart(), "Wrong negative cycle detection.");
+    for (NodeIt v(gr); v != INVALID; ++v) {
+      check(pbf.reached(v) == bf.reached(v) &&
+            sbf.reached(v) == bf.reached(v), "Wrong reached nodes.");
+      if (bf.reached(v)) {
+        check(pbf.dist(v) == bf.dist(v) && sbf.dist(v) == bf.dist(v),
+              "Wrong distances.");
+      }
+    }
+  }
 }
 
 void checkBellmanFordNegativeCycle() {
@@ -257,6 +282,15 @@ void checkBellmanFordNegativeCycle() {
           "Wrong negative cycle.");
   }
 
+  {
+    BellmanFord<SmartDigraph, IntArcMap> bf(gr, length);
+    bf.init();
+    bf.addSource(n1);
+    check(!bf.spfaStart(), "Negative cycle should be found.");
+    StaticPath<SmartDigraph> p = bf.negativeCycle();
+    check(p.length() == 1 && p.front() == a2, "Wrong negative cycle.");
+  }
+
   length[a2] = 0;
 
   {
@@ -285,11 +319,91 @@ void checkBellmanFordNegativeCycle() {
     check(length[p.nth(0)] + length[p.nth(1)] + length[p.nth(2)] == -1,
           "Wrong negative cycle.");
   }
+
+  {
+    BellmanFord<SmartDigraph, IntArcMap> bf(gr, length);
+    bf.init();
+    bf.addSource(n1);
+    check(!bf.spfaStart(), "Negative cycle should be found.");
+    StaticPath<SmartDigraph> p = bf.negativeCycle();
+    check(p.length() == 3, "Wrong negative cycle.");
+    check(length[p.nth(0)] + length[p.nth(1)] + length[p.nth(2)] == -1,
+          "Wrong negative cycle.");
+  }
+}
+
+void checkNegativeCycleLength(const SmartDigraph& gr,
+                              const SmartDigraph::ArcMap<int>& length,
+                              const Path<SmartDigraph>& p) {
+  check(!p.empty() && checkPath(gr, p) &&
+        pathSource(gr, p) == pathTarget(gr, p), "Wrong negative cycle.");
+  int sum = 0;
+  for (Path<SmartDigraph>::ArcIt a(p); a != INVALID; ++a) {
+    sum += length[a];
+  }
+  check(sum < 0, "Wrong negative cycle.");
+}
+
+void checkBellmanFordRandom() {
+  DIGRAPH_TYPEDEFS(SmartDigraph);
+
+  for (int t = 0; t < 6; ++t) {
+    SmartDigraph gr;
+    IntArcMap length(gr);
+    int n = 2000, m = 10000;
+    std::vector<Node> nodes;
+    for (int i = 0; i < n; ++i) nodes.push_back(gr.addNode());
+    // Random potentials make most arcs negative without negative cycles
+    std::vector<int> pot(n);
+    for (int i = 0; i < n; ++i) pot[i] = rnd[10000];
+    for (int i = 0; i < m; ++i) {
+      int u = rnd[n], v = rnd[n];
+      length[gr.addArc(nodes[u], nodes[v])] = rnd[100] + pot[u] - pot[v];
+    }
+    if (t % 2 == 1) {
+      // Add a negative cycle
+      int u = rnd[n], v = rnd[n], w = rnd[n];
+      length[gr.addArc(nodes[u], nodes[v])] = pot[u] - pot[v];
+      length[gr.addArc(nodes[v], nodes[w])] = pot[v] - pot[w];
+      length[gr.addArc(nodes[w], nodes[u])] = pot[w] - pot[u] - 1;
+    }
+
+    BellmanFord<SmartDigraph, IntArcMap> bf(gr, length);
+    bf.init(0);
+    bool ok = bf.checkedStart();
+    check(ok == (t % 2 == 0), "Wrong negative cycle detection.");
+
+    BellmanFord<SmartDigraph, IntArcMap> pbf(gr, length);
+    pbf.threadNum(4).init(0);
+    check(pbf.checkedStart() == ok, "Wrong negative cycle detection.");
+
+    BellmanFord<SmartDigraph, IntArcMap> sbf(gr, length);
+    sbf.init(0);
+    check(sbf.spfaStart() == ok, "Wrong negative cycle detection.");
+
+    if (ok) {
+      for (NodeIt v(gr); v != INVALID; ++v) {
+        check(pbf.dist(v) == bf.dist(v) && sbf.dist(v) == bf.dist(v),
+              "Wrong distances.");
+      }
+      for (ArcIt a(gr); a != INVALID; ++a) {
+        check(sbf.dist(gr.target(a)) <=
+              sbf.dist(gr.source(a)) + length[a], "Wrong distances.");
+      }
+      check(pbf.negativeCycle().empty() && sbf.negativeCycle().empty(),
+            "Negative cycle should not be found.");
+    } else {
+      checkNegativeCycleLength(gr, length, bf.negativeCycle());
+      checkNegativeCycleLength(gr, length, pbf.negativeCycle());
+      checkNegativeCycleLength(gr, length, sbf.negativeCycle());
+    }
+  }
 }
 
 int main() {
   checkBellmanFord<ListDigraph, int>();
   checkBellmanFord<SmartDigraph, double>();
   checkBellmanFordNegativeCycle();
+  checkBellmanFordRandom();
   return 0;
 }
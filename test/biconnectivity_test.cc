@@ -0,0 +1,186 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include <vector>
+
+#include <lemon/biconnectivity.h>
+#include <lemon/connectivity.h>
+#include <lemon/list_graph.h>
+#include <lemon/smart_graph.h>
+#include <lemon/random.h>
+
+#include "test_tools.h"
+
+using namespace lemon;
+
+// Checks that two labelings define the same partition
+template <typename It, typename Map1, typename Map2>
+void checkPartition(It it, const Map1& m1, int num1,
+                    const Map2& m2, int num2, const char* msg) {
+  check(num1 == num2, msg);
+  std::vector<int> a(num1, -1), b(num2, -1);
+  for (; it != INVALID; ++it) {
+    check(m1[it] >= 0 && m1[it] < num1 && m2[it] >= 0 && m2[it] < num2, msg);
+    if (a[m1[it]] == -1) a[m1[it]] = m2[it];
+    if (b[m2[it]] == -1) b[m2[it]] = m1[it];
+    check(a[m1[it]] == m2[it] && b[m2[it]] == m1[it], msg);
+  }
+}
+
+template <typename Graph>
+void checkBiconnectivity(const Graph& g, int threads) {
+  TEMPLATE_GRAPH_TYPEDEFS(Graph);
+
+  IntEdgeMap blocks(g);
+  int block_num = biNodeConnectedComponents(g, blocks);
+  BoolNodeMap cuts(g, false);
+  int cut_num = biNodeConnectedCutNodes(g, cuts);
+  IntNodeMap ecomps(g);
+  int ecomp_num = biEdgeConnectedComponents(g, ecomps);
+  BoolEdgeMap bridges(g, false);
+  int bridge_num = biEdgeConnectedCutEdges(g, bridges);
+
+  Biconnectivity<Graph> bc(g);
+  for (int k = 0; k < 2; ++k) {
+    if (k == 0) {
+      bc.run();
+    } else {
+      bc.runParallel(threads);
+    }
+
+    IntEdgeMap b(g);
+    bc.blockMap(b);
+    checkPartition(EdgeIt(g), blocks, block_num, b, bc.blockNum(),
+                   "Wrong blocks");
+    for (EdgeIt e(g); e != INVALID; ++e) {
+      check(bc.block(e) == b[e], "Wrong blocks");
+    }
+
+    IntNodeMap c(g);
+    bc.biEdgeComponentMap(c);
+    checkPartition(NodeIt(g), ecomps, ecomp_num, c, bc.biEdgeComponentNum(),
+                   "Wrong bi-edge-connected components");
+
+    BoolNodeMap cn(g);
+    bc.cutNodeMap(cn);
+    check(bc.cutNodeNum() == cut_num, "Wrong number of cut nodes");
+    for (NodeIt n(g); n != INVALID; ++n) {
+      check(cn[n] == cuts[n] && bc.cutNode(n) == cuts[n], "Wrong cut nodes");
+    }
+
+    BoolEdgeMap br(g);
+    bc.bridgeMap(br);
+    check(bc.bridgeNum() == bridge_num, "Wrong number of bridges");
+    for (EdgeIt e(g); e != INVALID; ++e) {
+      check(br[e] == bridges[e] && bc.bridge(e) == bridges[e],
+            "Wrong bridges");
+    }
+  }
+}
+
+void checkRandom(int n, int m, int loops) {
+  ListGraph g;
+  std::vector<ListGraph::Node> nodes;
+  for (int i = 0; i < n; ++i) nodes.push_back(g.addNode());
+  // A random tree-like part with a few extra (also parallel) edges
+  for (int i = 1; i < n; ++i) {
+    if (rnd[10] != 0) g.addEdge(nodes[i], nodes[rnd[i]]);
+  }
+  for (int i = 0; i < m; ++i) {
+    int a = rnd[n];
+    g.addEdge(nodes[a], nodes[rnd.boolean() ? rnd[n] : (a + 1) % n]);
+  }
+  for (int i = 0; i < loops; ++i) {
+    int a = rnd[n];
+    g.addEdge(nodes[a], nodes[a]);
+  }
+  // Erased items make the ids sparse
+  g.erase(nodes[n / 2]);
+
+  for (int threads = 1; threads <= 4; threads *= 2) {
+    checkBiconnectivity(g, threads);
+  }
+}
+
+int main() {
+  {
+    ListGraph g;
+    Biconnectivity<ListGraph> bc(g);
+    bc.run();
+    check(bc.blockNum() == 0 && bc.cutNodeNum() == 0 &&
+          bc.bridgeNum() == 0 && bc.biEdgeComponentNum() == 0,
+          "Wrong result for the empty graph");
+    bc.runParallel(2);
+    check(bc.blockNum() == 0 && bc.cutNodeNum() == 0 &&
+          bc.bridgeNum() == 0 && bc.biEdgeComponentNum() == 0,
+          "Wrong result for the empty graph");
+  }
+
+  {
+    // Two triangles joined by a bridge, and an isolated node
+    SmartGraph g;
+    SmartGraph::Node n[7];
+    for (int i = 0; i < 7; ++i) n[i] = g.addNode();
+    g.addEdge(n[0], n[1]);
+    g.addEdge(n[1], n[2]);
+    g.addEdge(n[2], n[0]);
+    SmartGraph::Edge b = g.addEdge(n[2], n[3]);
+    g.addEdge(n[3], n[4]);
+    g.addEdge(n[4], n[5]);
+    g.addEdge(n[5], n[3]);
+
+    Biconnectivity<SmartGraph> bc(g);
+    bc.run();
+    check(bc.blockNum() == 3, "Wrong number of blocks");
+    check(bc.cutNodeNum() == 2 && bc.cutNode(n[2]) && bc.cutNode(n[3]),
+          "Wrong cut nodes");
+    check(bc.bridgeNum() == 1 && bc.bridge(b), "Wrong bridges");
+    check(bc.biEdgeComponentNum() == 3, "Wrong bi-edge-connected components");
+    check(bc.biEdgeComponent(n[0]) == bc.biEdgeComponent(n[2]) &&
+          bc.biEdgeComponent(n[2]) != bc.biEdgeComponent(n[3]),
+          "Wrong bi-edge-connected components");
+    checkBiconnectivity(g, 2);
+  }
+
+  {
+    // A long path
+    SmartGraph g;
+    SmartGraph::Node prev = g.addNode();
+    for (int i = 0; i < 100000; ++i) {
+      SmartGraph::Node next = g.addNode();
+      g.addEdge(prev, next);
+      prev = next;
+    }
+    Biconnectivity<SmartGraph> bc(g);
+    bc.run();
+    check(bc.blockNum() == 100000 && bc.bridgeNum() == 100000 &&
+          bc.cutNodeNum() == 99999 && bc.biEdgeComponentNum() == 100001,
+          "Wrong result for a path");
+    bc.runParallel(3);
+    check(bc.blockNum() == 100000 && bc.bridgeNum() == 100000 &&
+          bc.cutNodeNum() == 99999 && bc.biEdgeComponentNum() == 100001,
+          "Wrong result for a path");
+  }
+
+  checkRandom(10, 3, 1);
+  checkRandom(100, 20, 5);
+  checkRandom(1000, 100, 10);
+  checkRandom(5000, 2000, 20);
+
+  return 0;
+}
@@ -0,0 +1,219 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include <iostream>
+#include <vector>
+
+#include <lemon/bipartite_matching.h>
+#include <lemon/smart_graph.h>
+#include <lemon/static_graph.h>
+#include <lemon/full_graph.h>
+#include <lemon/concepts/bpgraph.h>
+#include <lemon/random.h>
+
+#include "test_tools.h"
+
+using namespace lemon;
+
+void checkMaxBipartiteMatchingCompile()
+{
+  typedef concepts::BpGraph BpGraph;
+  typedef BpGraph::Node Node;
+  typedef BpGraph::Edge Edge;
+  typedef BpGraph::EdgeMap<bool> MatMap;
+
+  BpGraph g;
+  Node n;
+  Edge e;
+  MatMap mat(g);
+
+  MaxBipartiteMatching<BpGraph> mat_test(g);
+  const MaxBipartiteMatching<BpGraph>&
+    const_mat_test = mat_test;
+
+  mat_test.init();
+  mat_test.greedyInit();
+  mat_test.matchingInit(mat);
+  mat_test.start();
+  mat_test.run();
+
+  const_mat_test.matchingSize();
+  const_mat_test.matching(e);
+  const_mat_test.matching(n);
+  const MaxBipartiteMatching<BpGraph>::MatchingMap& mmap =
+    const_mat_test.matchingMap();
+  e = mmap[n];
+  const_mat_test.mate(n);
+  const_mat_test.cover(n);
+}
+
+void checkPrBipartiteMatchingCompile()
+{
+  typedef concepts::BpGraph BpGraph;
+  typedef BpGraph::Node Node;
+  typedef BpGraph::Edge Edge;
+
+  BpGraph g;
+  Node n;
+  Edge e;
+
+  PrBipartiteMatching<BpGraph> mat_test(g);
+  const PrBipartiteMatching<BpGraph>&
+    const_mat_test = mat_test;
+
+  mat_test.threadNum(2).run();
+
+  const_mat_test.matchingSize();
+  const_mat_test.matching(e);
+  const_mat_test.matching(n);
+  const PrBipartiteMatching<BpGraph>::MatchingMap& mmap =
+    const_mat_test.matchingMap();
+  e = mmap[n];
+  const_mat_test.mate(n);
+  const_mat_test.cover(n);
+}
+
+// Checks that the matching is valid and that the cover is a vertex
+// cover of the same size, which proves the optimality of both.
+template <typename BGR, typename MAT>
+void checkBipartiteMatching(const BGR& graph, const MAT& mat, int size) {
+  TEMPLATE_BPGRAPH_TYPEDEFS(BGR);
+
+  int num = 0;
+  for (NodeIt n(graph); n != INVALID; ++n) {
+    if (mat.matching(n) != INVALID) {
+      check(graph.source(mat.matching(n)) == n, "Wrong matching arc");
+      check(mat.mate(mat.mate(n)) == n, "Wrong matching");
+      if (graph.red(n)) ++num;
+    }
+  }
+  check(num == mat.matchingSize(), "Wrong matching size");
+  int matched = 0;
+  for (EdgeIt e(graph); e != INVALID; ++e) {
+    if (mat.matching(e)) {
+      ++matched;
+      check(mat.mate(graph.redNode(e)) == graph.blueNode(e),
+            "Wrong matching");
+    }
+    check(mat.cover(graph.redNode(e)) || mat.cover(graph.blueNode(e)),
+          "Wrong vertex cover");
+  }
+  check(matched == num, "Wrong matching");
+  int cover = 0;
+  for (NodeIt n(graph); n != INVALID; ++n) {
+    if (mat.cover(n)) ++cover;
+  }
+  check(cover == num, "Wrong vertex cover size");
+  if (size >= 0) {
+    check(num == size, "Wrong maximum matching size");
+  }
+}
+
+template <typename BGR>
+void checkAlgorithms(const BGR& graph, int size) {
+  MaxBipartiteMatching<BGR> hk(graph);
+  hk.run();
+  checkBipartiteMatching(graph, hk, size);
+  int max = hk.matchingSize();
+
+  hk.init();
+  hk.start();
+  checkBipartiteMatching(graph, hk, max);
+
+  typename BGR::template EdgeMap<bool> init(graph, false);
+  for (typename BGR::EdgeIt e(graph); e != INVALID; ++e) {
+    if (hk.matching(e)) {
+      init[e] = true;
+      break;
+    }
+  }
+  check(hk.matchingInit(init), "Wrong matchingInit()");
+  hk.start();
+  checkBipartiteMatching(graph, hk, max);
+
+  for (int threads = 1; threads <= 4; threads *= 2) {
+    PrBipartiteMatching<BGR> pr(graph);
+    pr.threadNum(threads).run();
+    checkBipartiteMatching(graph, pr, max);
+  }
+}
+
+void checkRandomGraphs() {
+  for (int i = 0; i < 10; ++i) {
+    int red_num = 50 + rnd[2000];
+    int blue_num = 50 + rnd[2000];
+    int edge_num = rnd[4 * (red_num + blue_num)];
+
+    SmartBpGraph g;
+    std::vector<SmartBpGraph::RedNode> reds;
+    std::vector<SmartBpGraph::BlueNode> blues;
+    for (int j = 0; j < red_num; ++j) reds.push_back(g.addRedNode());
+    for (int j = 0; j < blue_num; ++j) blues.push_back(g.addBlueNode());
+    for (int j = 0; j < edge_num; ++j) {
+      g.addEdge(reds[rnd[red_num]], blues[rnd[blue_num]]);
+    }
+    checkAlgorithms(g, -1);
+
+    StaticBpGraph sg;
+    bpGraphCopy(g, sg).run();
+    MaxBipartiteMatching<SmartBpGraph> hk(g);
+    hk.run();
+    checkAlgorithms(sg, hk.matchingSize());
+  }
+}
+
+int main() {
+  // Empty graph and isolated nodes
+  {
+    SmartBpGraph g;
+    checkAlgorithms(g, 0);
+    g.addRedNode();
+    g.addBlueNode();
+    checkAlgorithms(g, 0);
+  }
+
+  // A graph in which the greedy initial matching is not maximum
+  {
+    SmartBpGraph g;
+    SmartBpGraph::RedNode r1 = g.addRedNode(), r2 = g.addRedNode(),
+      r3 = g.addRedNode();
+    SmartBpGraph::BlueNode b1 = g.addBlueNode(), b2 = g.addBlueNode(),
+      b3 = g.addBlueNode();
+    g.addEdge(r1, b1);
+    g.addEdge(r1, b2);
+    g.addEdge(r2, b1);
+    g.addEdge(r3, b2);
+    g.addEdge(r3, b3);
+    g.addEdge(r2, b3);
+    checkAlgorithms(g, 3);
+    g.addRedNode();
+    checkAlgorithms(g, 3);
+  }
+
+  // Complete bipartite graphs
+  {
+    FullBpGraph g(7, 4);
+    checkAlgorithms(g, 4);
+    g.resize(30, 40);
+    checkAlgorithms(g, 30);
+  }
+
+  checkRandomGraphs();
+
+  return 0;
+}
@@ -19,6 +19,7 @@
 #include <lemon/concepts/bpgraph.h>
 #include <lemon/list_graph.h>
 #include <lemon/smart_graph.h>
+#include <lemon/static_graph.h>
 #include <lemon/full_graph.h>
 
 #include "test_tools.h"
@@ -354,6 +355,10 @@ void checkConcepts() {
     checkConcept<ExtendableBpGraphComponent<>, SmartBpGraph>();
     checkConcept<ClearableBpGraphComponent<>, SmartBpGraph>();
   }
+  { // Checking StaticBpGraph
+    checkConcept<BpGraph, StaticBpGraph>();
+    checkConcept<ClearableBpGraphComponent<>, StaticBpGraph>();
+  }
 }
 
 void checkFullBpGraph(int redNum, int blueNum) {
@@ -430,6 +435,132 @@ void checkFullBpGraph(int redNum, int blueNum) {
 
 }
 
+void checkStaticBpGraph() {
+  SmartBpGraph g;
+  SmartBpGraph::RedNodeMap<StaticBpGraph::RedNode> rref(g);
+  SmartBpGraph::BlueNodeMap<StaticBpGraph::BlueNode> bref(g);
+  SmartBpGraph::EdgeMap<StaticBpGraph::Edge> eref(g);
+
+  StaticBpGraph G;
+
+  checkGraphNodeList(G, 0);
+  checkGraphRedNodeList(G, 0);
+  checkGraphBlueNodeList(G, 0);
+  checkGraphEdgeList(G, 0);
+  checkGraphArcList(G, 0);
+
+  SmartBpGraph::RedNode
+    rn1 = g.addRedNode(),
+    rn2 = g.addRedNode();
+  SmartBpGraph::BlueNode
+    bn1 = g.addBlueNode(),
+    bn2 = g.addBlueNode(),
+    bn3 = g.addBlueNode();
+
+  G.build(g, rref, bref, eref);
+
+  checkGraphNodeList(G, 5);
+  checkGraphRedNodeList(G, 2);
+  checkGraphBlueNodeList(G, 3);
+  checkGraphEdgeList(G, 0);
+  checkGraphArcList(G, 0);
+
+  g.addEdge(rn1, bn2);
+  g.addEdge(bn1, rn1);
+  g.addEdge(rn2, bn2);
+  g.addEdge(rn1, bn2);
+
+  bpGraphCopy(g, G).redRef(rref).blueRef(bref).edgeRef(eref).run();
+
+  checkGraphNodeList(G, 5);
+  checkGraphRedNodeList(G, 2);
+  checkGraphBlueNodeList(G, 3);
+  checkGraphEdgeList(G, 4);
+  checkGraphArcList(G, 8);
+
+  checkGraphIncEdgeArcLists(G, rref[rn1], 3);
+  checkGraphIncEdgeArcLists(G, rref[rn2], 1);
+  checkGraphIncEdgeArcLists(G, bref[bn1], 1);
+  checkGraphIncEdgeArcLists(G, bref[bn2], 3);
+  checkGraphIncEdgeArcLists(G, bref[bn3], 0);
+
+  checkGraphConEdgeList(G, 4);
+  checkGraphConArcList(G, 8);
+
+  for (SmartBpGraph::EdgeIt e(g); e != INVALID; ++e) {
+    check(G.redNode(eref[e]) == rref[g.redNode(e)] &&
+          G.blueNode(eref[e]) == bref[g.blueNode(e)],
+          "Wrong edge references");
+  }
+
+  const int redNum = 5, blueNum = 7;
+  std::vector<std::pair<int,int> > edges;
+  for (int j = blueNum - 1; j >= 0; --j) {
+    for (int i = 0; i < redNum; ++i) {
+      if ((i + j) % 3 != 0) edges.push_back(std::make_pair(i, j));
+    }
+  }
+
+  G.build(redNum, blueNum, edges.begin(), edges.end());
+
+  checkGraphNodeList(G, redNum + blueNum);
+  checkGraphRedNodeList(G, redNum);
+  checkGraphBlueNodeList(G, blueNum);
+  checkGraphEdgeList(G, edges.size());
+  checkGraphArcList(G, 2 * edges.size());
+
+  for (int i = 0; i < redNum; ++i) {
+    int deg = 0;
+    for (int j = 0; j < blueNum; ++j) deg += (i + j) % 3 != 0 ? 1 : 0;
+    checkGraphIncEdgeArcLists(G, G.redNode(i), deg);
+  }
+  for (int j = 0; j < blueNum; ++j) {
+    int deg = 0;
+    for (int i = 0; i < redNum; ++i) deg += (i + j) % 3 != 0 ? 1 : 0;
+    checkGraphIncEdgeArcLists(G, G.blueNode(j), deg);
+  }
+
+  for (int k = 0; k < int(edges.size()); ++k) {
+    StaticBpGraph::Edge e = G.edge(k);
+    check(G.index(G.redNode(e)) == edges[k].first &&
+          G.index(G.blueNode(e)) == edges[k].second, "Wrong edge");
+    check(G.u(e) == G.redNode(e) && G.v(e) == G.blueNode(e), "Wrong edge");
+  }
+
+  checkGraphConArcList(G, 2 * edges.size());
+  checkGraphConEdgeList(G, edges.size());
+
+  checkArcDirections(G);
+
+  checkNodeIds(G);
+  checkRedNodeIds(G);
+  checkBlueNodeIds(G);
+  checkArcIds(G);
+  checkEdgeIds(G);
+
+  checkGraphNodeMap(G);
+  checkGraphRedNodeMap(G);
+  checkGraphBlueNodeMap(G);
+  checkGraphArcMap(G);
+  checkGraphEdgeMap(G);
+
+  for (int i = 0; i < G.redNum(); ++i) {
+    check(G.red(G.redNode(i)), "Wrong node");
+    check(G.index(G.redNode(i)) == i, "Wrong index");
+  }
+
+  for (int i = 0; i < G.blueNum(); ++i) {
+    check(G.blue(G.blueNode(i)), "Wrong node");
+    check(G.index(G.blueNode(i)) == i, "Wrong index");
+  }
+
+  G.clear();
+  checkGraphNodeList(G, 0);
+  checkGraphRedNodeList(G, 0);
+  checkGraphBlueNodeList(G, 0);
+  checkGraphEdgeList(G, 0);
+}
+
 void checkGraphs() {
   { // Checking ListGraph
     checkBpGraphBuild<ListBpGraph>();
@@ -443,6 +574,9 @@ void checkGraphs() {
     checkBpGraphSnapshot<SmartBpGraph>();
     checkBpGraphValidity<SmartBpGraph>();
   }
+  { // Checking StaticBpGraph
+    checkStaticBpGraph();
+  }
   { // Checking FullBpGraph
     checkFullBpGraph(6, 8);
     checkFullBpGraph(7, 4);
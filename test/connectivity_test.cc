@@ -18,12 +18,98 @@
 
 #include <lemon/connectivity.h>
 #include <lemon/list_graph.h>
+#include <lemon/static_graph.h>
 #include <lemon/adaptors.h>
+#include <lemon/random.h>
 
 #include "test_tools.h"
 
 using namespace lemon;
 
+template <typename Digraph>
+void checkParallelScc(const Digraph& d, int threads) {
+  typedef typename Digraph::template NodeMap<int> IntNodeMap;
+  IntNodeMap comp(d), pcomp(d);
+  int num = stronglyConnectedComponents(d, comp);
+  check(parallelStronglyConnectedComponents(d, pcomp, threads) == num,
+        "Wrong parallelStronglyConnectedComponents()");
+
+  std::vector<int> map(num, -1);
+  for (typename Digraph::NodeIt n(d); n != INVALID; ++n) {
+    check(pcomp[n] >= 0 && pcomp[n] < num,
+          "Wrong parallelStronglyConnectedComponents()");
+    if (map[pcomp[n]] == -1) map[pcomp[n]] = comp[n];
+    check(map[pcomp[n]] == comp[n],
+          "Wrong parallelStronglyConnectedComponents()");
+  }
+  for (typename Digraph::ArcIt a(d); a != INVALID; ++a) {
+    check(pcomp[d.source(a)] <= pcomp[d.target(a)],
+          "Wrong parallelStronglyConnectedComponents()");
+  }
+}
+
+void checkParallelScc(int n, int m, int cycles) {
+  ListDigraph d;
+  std::vector<ListDigraph::Node> nodes;
+  for (int i = 0; i < n; ++i) nodes.push_back(d.addNode());
+  for (int i = 0; i < m; ++i) {
+    d.addArc(nodes[rnd[n]], nodes[rnd[n]]);
+  }
+  // Short cycles and chains of them
+  for (int i = 0; i < cycles; ++i) {
+    int a = rnd[n], b = rnd[n], c = rnd[n];
+    d.addArc(nodes[a], nodes[b]);
+    d.addArc(nodes[b], nodes[c]);
+    d.addArc(nodes[c], nodes[a]);
+  }
+
+  for (int threads = 1; threads <= 4; threads *= 2) {
+    checkParallelScc(d, threads);
+  }
+
+  StaticDigraph sd;
+  ListDigraph::NodeMap<StaticDigraph::Node> nref(d);
+  ListDigraph::ArcMap<StaticDigraph::Arc> aref(d);
+  sd.build(d, nref, aref);
+  checkParallelScc(sd, 3);
+}
+
+
+template <typename Graph>
+void checkParallelCc(const Graph& g, int threads) {
+  typedef typename Graph::template NodeMap<int> IntNodeMap;
+  IntNodeMap comp(g), pcomp(g);
+  int num = connectedComponents(g, comp);
+  check(parallelConnectedComponents(g, pcomp, threads) == num,
+        "Wrong parallelConnectedComponents()");
+  for (typename Graph::NodeIt n(g); n != INVALID; ++n) {
+    check(pcomp[n] == comp[n], "Wrong parallelConnectedComponents()");
+  }
+}
+
+void checkParallelCc(int n, int m, int giant) {
+  ListGraph g;
+  std::vector<ListGraph::Node> nodes;
+  for (int i = 0; i < n; ++i) nodes.push_back(g.addNode());
+  // A giant component on the first nodes and small ones on the others
+  for (int i = 0; i < 3 * giant; ++i) {
+    g.addEdge(nodes[rnd[giant]], nodes[rnd[giant]]);
+  }
+  for (int i = 0; i < m; ++i) {
+    int a = giant + rnd[n - giant];
+    g.addEdge(nodes[a], nodes[std::min(n - 1, a + rnd[3])]);
+  }
+
+  for (int threads = 1; threads <= 4; threads *= 2) {
+    checkParallelCc(g, threads);
+  }
+
+  StaticGraph sg;
+  ListGraph::NodeMap<StaticGraph::Node> nref(g);
+  ListGraph::EdgeMap<StaticGraph::Edge> eref(g);
+  sg.build(g, nref, eref);
+  checkParallelCc(sg, 3);
+}
 
 int main()
 {
@@ -240,6 +326,13 @@ int main()
           scomp2[n8] == 1, "Wrong stronglyConnectedComponents()");
     check(scomp2[n4] == 2 && scomp2[n6] == 2 && scomp2[n7] == 2,
           "Wrong stronglyConnectedComponents()");
+    Digraph::NodeMap<int> scomp3(d);
+    check(parallelStronglyConnectedComponents(d, scomp3, 2) == 3,
+          "This digraph has 3 strongly connected components");
+    for (Digraph::NodeIt n(d); n != INVALID; ++n) {
+      check(scomp3[n] == scomp2[n],
+            "Wrong parallelStronglyConnectedComponents()");
+    }
     Digraph::ArcMap<bool> scut2(d, false);
     check(stronglyConnectedCutArcs(d, scut2) == 5,
           "This digraph has 5 strongly connected cut arcs.");
@@ -312,5 +405,28 @@ int main()
           "Wrong bipartitePartitions()");
   }
 
+  {
+    Digraph d;
+    Digraph::NodeMap<int> comp(d);
+    check(parallelStronglyConnectedComponents(d, comp) == 0,
+          "The empty digraph has 0 strongly connected components");
+  }
+
+  {
+    ListGraph g;
+    ListGraph::NodeMap<int> comp(g);
+    check(parallelConnectedComponents(g, comp) == 0,
+          "The empty graph has 0 connected components");
+  }
+
+  checkParallelCc(100, 20, 0);
+  checkParallelCc(2000, 1000, 1000);
+  checkParallelCc(30000, 5000, 20000);
+
+  checkParallelScc(1000, 900, 0);
+  checkParallelScc(1000, 1100, 50);
+  checkParallelScc(5000, 2000, 2000);
+  checkParallelScc(20000, 60000, 100);
+
   return 0;
 }
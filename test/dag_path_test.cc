@@ -0,0 +1,226 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include <vector>
+#include <algorithm>
+
+#include <lemon/dag_path.h>
+#include <lemon/bellman_ford.h>
+#include <lemon/list_graph.h>
+#include <lemon/static_graph.h>
+#include <lemon/random.h>
+#include <lemon/concepts/digraph.h>
+
+#include "test_tools.h"
+
+using namespace lemon;
+
+void checkDagPathCompile()
+{
+  typedef concepts::Digraph Digraph;
+  typedef concepts::ReadMap<Digraph::Arc, int> LengthMap;
+  TEMPLATE_DIGRAPH_TYPEDEFS(Digraph);
+
+  Digraph g;
+  Node n;
+  Arc a;
+  int k;
+  bool b;
+  LengthMap len;
+  Digraph::NodeMap<int> order(g);
+  Digraph::NodeMap<Arc> pred(g);
+  ::lemon::ignore_unused_variable_warning(a, k, b);
+
+  b = parallelTopologicalSort(g, order);
+  b = parallelTopologicalSort(g, order, 2);
+
+  TopologicalLevels<Digraph> tl(g);
+  b = tl.run();
+  b = tl.run(2);
+  b = tl.dag();
+  k = tl.levelNum() + tl.levelNodeNum(0) + tl.level(n) + tl.orderNodeNum();
+  n = tl.levelNode(0, 0);
+  n = tl.orderNode(0);
+  tl.orderMap(order);
+  tl.levelMap(order);
+
+  DagPath<Digraph, LengthMap> dp(g, len);
+  dp.threads(2).longest().longest(false);
+  b = dp.init();
+  dp.addSource(n);
+  dp.addSource(n, 1);
+  b = dp.start();
+  b = dp.run(n);
+  b = dp.run();
+  k = dp.dist(n);
+  b = dp.reached(n);
+  a = dp.predArc(n);
+  n = dp.predNode(n);
+  Path<Digraph> p = dp.path(n);
+  const TopologicalLevels<Digraph>& levels = dp.levels();
+  ::lemon::ignore_unused_variable_warning(levels);
+  dp.distMap(order);
+  dp.predMap(pred);
+}
+
+template <typename Digraph, typename LengthMap>
+void checkDag(const Digraph& g, const LengthMap& len, int threads)
+{
+  TEMPLATE_DIGRAPH_TYPEDEFS(Digraph);
+
+  // Levels and topological order
+  TopologicalLevels<Digraph> tl(g);
+  check(tl.run(threads), "Wrong TopologicalLevels");
+  check(tl.orderNodeNum() == countNodes(g), "Wrong TopologicalLevels");
+  IntNodeMap order(g, -1), level(g);
+  tl.orderMap(order);
+  tl.levelMap(level);
+  int k = 0;
+  for (int l = 0; l < tl.levelNum(); ++l) {
+    check(tl.levelNodeNum(l) > 0, "Wrong TopologicalLevels");
+    for (int i = 0; i < tl.levelNodeNum(l); ++i) {
+      Node v = tl.levelNode(l, i);
+      check(tl.orderNode(k) == v && order[v] == k++,
+            "Wrong TopologicalLevels");
+      check(tl.level(v) == l && level[v] == l, "Wrong TopologicalLevels");
+    }
+  }
+  for (ArcIt a(g); a != INVALID; ++a) {
+    check(level[g.source(a)] < level[g.target(a)],
+          "Wrong TopologicalLevels");
+  }
+  for (NodeIt v(g); v != INVALID; ++v) {
+    bool tight = level[v] == 0;
+    for (InArcIt a(g, v); a != INVALID; ++a) {
+      if (level[g.source(a)] + 1 == level[v]) tight = true;
+    }
+    check(tight, "Wrong TopologicalLevels");
+  }
+
+  IntNodeMap order2(g);
+  check(parallelTopologicalSort(g, order2, threads),
+        "Wrong parallelTopologicalSort()");
+  for (ArcIt a(g); a != INVALID; ++a) {
+    check(order2[g.source(a)] < order2[g.target(a)],
+          "Wrong parallelTopologicalSort()");
+  }
+
+  // Shortest and longest paths compared to BellmanFord
+  Node s = tl.levelNode(0, 0);
+  typedef typename LengthMap::Value Value;
+  typedef typename Digraph::template ArcMap<Value> ValueArcMap;
+  ValueArcMap neg(g);
+  for (ArcIt a(g); a != INVALID; ++a) neg[a] = -len[a];
+  BellmanFord<Digraph, LengthMap> bf(g, len);
+  bf.run(s);
+  BellmanFord<Digraph, ValueArcMap> bfl(g, neg);
+  bfl.run(s);
+
+  DagPath<Digraph, LengthMap> dp(g, len);
+  dp.threads(threads);
+  check(dp.run(s), "Wrong DagPath");
+  DagPath<Digraph, LengthMap> dpl(g, len);
+  dpl.threads(threads).longest();
+  check(dpl.run(s), "Wrong DagPath");
+  for (NodeIt v(g); v != INVALID; ++v) {
+    check(dp.reached(v) == bf.reached(v) && dpl.reached(v) == bf.reached(v),
+          "Wrong DagPath");
+    if (!bf.reached(v)) continue;
+    check(dp.dist(v) == bf.dist(v), "Wrong DagPath");
+    check(dpl.dist(v) == -bfl.dist(v), "Wrong DagPath");
+    if (v == s) {
+      check(dp.predArc(v) == INVALID && dpl.predArc(v) == INVALID,
+            "Wrong DagPath");
+    } else {
+      Arc a = dp.predArc(v);
+      check(dp.predNode(v) == g.source(a) &&
+            dp.dist(g.source(a)) + len[a] == dp.dist(v), "Wrong DagPath");
+      a = dpl.predArc(v);
+      check(dpl.dist(g.source(a)) + len[a] == dpl.dist(v), "Wrong DagPath");
+    }
+    Path<Digraph> p = dp.path(v);
+    check(checkPath(g, p) && (p.empty() ? v == s : pathSource(g, p) == s &&
+                              pathTarget(g, p) == v), "Wrong DagPath");
+    Value sum = 0;
+    for (typename Path<Digraph>::ArcIt a(p); a != INVALID; ++a) sum += len[a];
+    check(sum == dp.dist(v), "Wrong DagPath");
+  }
+
+  // Critical path values
+  DagPath<Digraph, LengthMap> cp(g, len);
+  cp.threads(threads).longest();
+  check(cp.run(), "Wrong DagPath");
+  for (int i = 0; i < tl.orderNodeNum(); ++i) {
+    Node v = tl.orderNode(i);
+    Value d = 0;
+    for (InArcIt a(g, v); a != INVALID; ++a) {
+      d = std::max(d, cp.dist(g.source(a)) + len[a]);
+    }
+    check(cp.dist(v) == d, "Wrong critical path values");
+    // All nodes are sources, the improved ones have predecessors
+    Arc a = cp.predArc(v);
+    check(a == INVALID ? d == 0 :
+          cp.dist(g.source(a)) + len[a] == d, "Wrong critical path values");
+  }
+}
+
+void checkRandom(int n, int m, int threads)
+{
+  ListDigraph g;
+  std::vector<ListDigraph::Node> nodes;
+  for (int i = 0; i < n; ++i) nodes.push_back(g.addNode());
+  std::vector<int> perm(n);
+  for (int i = 0; i < n; ++i) perm[i] = i;
+  for (int i = n - 1; i > 0; --i) std::swap(perm[i], perm[rnd[i + 1]]);
+  ListDigraph::ArcMap<int> len(g);
+  for (int i = 0; i < m; ++i) {
+    int a = rnd[n], b = rnd[n];
+    if (a == b) continue;
+    if (a > b) std::swap(a, b);
+    len[g.addArc(nodes[perm[a]], nodes[perm[b]])] = rnd[200] - 50;
+  }
+  checkDag(g, len, threads);
+
+  StaticDigraph sg;
+  ListDigraph::NodeMap<StaticDigraph::Node> nref(g);
+  ListDigraph::ArcMap<StaticDigraph::Arc> aref(g);
+  sg.build(g, nref, aref);
+  StaticDigraph::ArcMap<int> slen(sg);
+  for (ListDigraph::ArcIt a(g); a != INVALID; ++a) slen[aref[a]] = len[a];
+  checkDag(sg, slen, threads);
+
+  // A cycle is detected
+  g.addArc(nodes[perm[0]], nodes[perm[n - 1]]);
+  g.addArc(nodes[perm[n - 1]], nodes[perm[0]]);
+  ListDigraph::NodeMap<int> order(g);
+  check(!parallelTopologicalSort(g, order, threads),
+        "Wrong parallelTopologicalSort()");
+  TopologicalLevels<ListDigraph> tl(g);
+  check(!tl.run(threads) && !tl.dag() && tl.orderNodeNum() < n &&
+        tl.level(nodes[perm[0]]) == -1, "Wrong TopologicalLevels");
+}
+
+int main()
+{
+  checkRandom(10, 20, 1);
+  checkRandom(100, 300, 2);
+  checkRandom(1000, 5000, 4);
+  checkRandom(5000, 10000, 3);
+
+  return 0;
+}
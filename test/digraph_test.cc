@@ -28,6 +28,13 @@
 using namespace lemon;
 using namespace lemon::concepts;
 
+struct PairFirstLess {
+  bool operator()(const std::pair<int,int>& a,
+                  const std::pair<int,int>& b) const {
+    return a.first < b.first;
+  }
+};
+
 template <class Digraph>
 void checkDigraphBuild() {
   TEMPLATE_DIGRAPH_TYPEDEFS(Digraph);
@@ -502,6 +509,98 @@ void checkStaticDigraph() {
   check(G.index(G.arc(m-1)) == m-1, "Wrong index.");
 }
 
+void checkStaticDigraphParallelBuild() {
+  std::vector<std::pair<int,int> > arcs;
+  arcs.push_back(std::make_pair(3,0));
+  arcs.push_back(std::make_pair(0,1));
+  arcs.push_back(std::make_pair(4,2));
+  arcs.push_back(std::make_pair(1,3));
+  arcs.push_back(std::make_pair(3,3));
+  arcs.push_back(std::make_pair(0,2));
+  arcs.push_back(std::make_pair(4,3));
+  arcs.push_back(std::make_pair(1,2));
+  arcs.push_back(std::make_pair(4,1));
+
+  StaticDigraph G;
+  std::vector<StaticDigraph::Arc> aref(arcs.size());
+  G.parallelBuild(6, arcs.begin(), arcs.end(), aref);
+
+  checkGraphNodeList(G, 6);
+  checkGraphArcList(G, 9);
+
+  checkGraphOutArcList(G, G.node(0), 2);
+  checkGraphOutArcList(G, G.node(1), 2);
+  checkGraphOutArcList(G, G.node(2), 0);
+  checkGraphOutArcList(G, G.node(3), 2);
+  checkGraphOutArcList(G, G.node(4), 3);
+  checkGraphOutArcList(G, G.node(5), 0);
+
+  checkGraphInArcList(G, G.node(0), 1);
+  checkGraphInArcList(G, G.node(1), 2);
+  checkGraphInArcList(G, G.node(2), 3);
+  checkGraphInArcList(G, G.node(3), 3);
+  checkGraphInArcList(G, G.node(4), 0);
+  checkGraphInArcList(G, G.node(5), 0);
+
+  checkGraphConArcList(G, 9);
+
+  checkNodeIds(G);
+  checkArcIds(G);
+  checkGraphNodeMap(G);
+  checkGraphArcMap(G);
+
+  for (int k = 0; k < int(arcs.size()); ++k) {
+    check(G.index(G.source(aref[k])) == arcs[k].first &&
+          G.index(G.target(aref[k])) == arcs[k].second,
+          "Wrong arc reference");
+  }
+  check(G.arc(0) == aref[1] && G.arc(1) == aref[5] &&
+        G.arc(6) == aref[2] && G.arc(8) == aref[8],
+        "Wrong arc order");
+
+  // A larger instance compared to the sequential build
+  const int n = 1000;
+  std::vector<std::pair<int,int> > list;
+  unsigned int seed = 12345;
+  for (int k = 0; k < 30000; ++k) {
+    seed = seed * 1103515245 + 12345;
+    int i = (seed >> 8) % n;
+    seed = seed * 1103515245 + 12345;
+    int j = (seed >> 8) % n;
+    list.push_back(std::make_pair(i, j));
+  }
+  std::vector<std::pair<int,int> > sorted(list);
+  std::stable_sort(sorted.begin(), sorted.end(), PairFirstLess());
+
+  StaticDigraph G1, G2;
+  G1.build(n, sorted.begin(), sorted.end());
+  G2.parallelBuild(n, list.begin(), list.end(), 4);
+  G2.parallelBuild(n, sorted.begin(), sorted.end(), 4);
+
+  check(G2.nodeNum() == n && G2.arcNum() == 30000, "Wrong size");
+  for (int a = 0; a < G1.arcNum(); ++a) {
+    check(G1.source(G1.arc(a)) == G2.source(G2.arc(a)) &&
+          G1.target(G1.arc(a)) == G2.target(G2.arc(a)),
+          "Wrong parallel build");
+  }
+  for (int i = 0; i < n; ++i) {
+    StaticDigraph::InArcIt a1(G1, G1.node(i)), a2(G2, G2.node(i));
+    for ( ; a1 != INVALID && a2 != INVALID; ++a1, ++a2) {
+      check(a1 == a2, "Wrong incoming arcs");
+    }
+    check(a1 == INVALID && a2 == INVALID, "Wrong incoming arcs");
+  }
+
+  std::vector<StaticDigraph::Arc> lref(list.size());
+  G2.parallelBuild(n, list.begin(), list.end(), lref, 4);
+  checkGraphArcList(G2, 30000);
+  for (int k = 0; k < int(list.size()); ++k) {
+    check(G2.index(G2.source(lref[k])) == list[k].first &&
+          G2.index(G2.target(lref[k])) == list[k].second,
+          "Wrong arc reference");
+  }
+}
+
 void checkFullDigraph(int num) {
   typedef FullDigraph Digraph;
   DIGRAPH_TYPEDEFS(Digraph);
@@ -556,6 +655,7 @@ void checkDigraphs() {
   }
   { // Checking StaticDigraph
     checkStaticDigraph();
+    checkStaticDigraphParallelBuild();
   }
   { // Checking FullDigraph
     checkFullDigraph(8);
@@ -23,6 +23,7 @@
 #include <lemon/dijkstra.h>
 #include <lemon/path.h>
 #include <lemon/bin_heap.h>
+#include <lemon/random.h>
 
 #include "graph_test.h"
 #include "test_tools.h"
@@ -239,8 +240,45 @@ void checkDijkstra() {
   }
 }
 
+// The default heap for integer lengths is MonotoneBucketHeap,
+// compare it to BinHeap with various ranges of arc lengths.
+template <typename Value>
+void checkDijkstraDefaultHeap(const Value& range) {
+  typedef SmartDigraph::ArcMap<Value> LengthMap;
+  typedef typename Dijkstra<SmartDigraph, LengthMap>
+    ::template SetStandardHeap<BinHeap<Value, SmartDigraph::NodeMap<int> > >
+    ::Create BinDijkstra;
+
+  SmartDigraph g;
+  LengthMap length(g);
+  for (int i = 0; i < 200; ++i) g.addNode();
+  for (int i = 0; i < 1000; ++i) {
+    SmartDigraph::Arc a = g.addArc(g.nodeFromId(rnd[200]),
+                                   g.nodeFromId(rnd[200]));
+    length[a] = rnd[range];
+  }
+  Dijkstra<SmartDigraph, LengthMap> dijkstra(g, length);
+  BinDijkstra bin_dijkstra(g, length);
+  for (int k = 0; k < 5; ++k) {
+    SmartDigraph::Node s = g.nodeFromId(rnd[200]);
+    dijkstra.run(s);
+    bin_dijkstra.run(s);
+    for (SmartDigraph::NodeIt v(g); v != INVALID; ++v) {
+      check(dijkstra.reached(v) == bin_dijkstra.reached(v),
+            "Wrong reached nodes.");
+      check(!dijkstra.reached(v) ||
+            dijkstra.dist(v) == bin_dijkstra.dist(v), "Wrong distance.");
+    }
+  }
+}
+
 int main() {
   checkDijkstra<ListDigraph>();
   checkDijkstra<SmartDigraph>();
+  const int ranges[] = { 1, 10, 1000, 1000000, 100000000 };
+  for (int r = 0; r < 5; ++r) {
+    checkDijkstraDefaultHeap<int>(ranges[r]);
+  }
+  checkDijkstraDefaultHeap<long long>(1000000000000000000LL);
   return 0;
 }
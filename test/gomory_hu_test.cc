@@ -17,6 +17,7 @@
  */
 
 #include <iostream>
+#include <sstream>
 
 #include "test_tools.h"
 #include <lemon/smart_graph.h>
@@ -24,6 +25,7 @@
 #include <lemon/concepts/maps.h>
 #include <lemon/lgf_reader.h>
 #include <lemon/gomory_hu.h>
+#include <lemon/random.h>
 #include <cstdlib>
 
 using namespace std;
@@ -75,12 +77,23 @@ void checkGomoryHuCompile()
     const_gh_test = gh_test;
 
   gh_test.run();
+  gh_test.runParallel();
+  gh_test.runParallel(2);
 
   n = const_gh_test.predNode(n);
   v = const_gh_test.predValue(n);
   d = const_gh_test.rootDist(n);
   v = const_gh_test.minCutValue(n, n);
   v = const_gh_test.minCutMap(n, n, cut);
+
+  std::ostringstream os;
+  const_gh_test.writeTree(os);
+  std::istringstream is(os.str());
+  gh_test.readTree(is);
+
+  GomoryHuIndex<Graph, Value> index(g);
+  index.build(const_gh_test);
+  v = index.minCutValue(n, n);
 }
 
 GRAPH_TYPEDEFS(Graph);
@@ -103,18 +116,13 @@ int cutValue(const Graph& graph, const BoolNodeMap& cut,
 }
 
 
-int main() {
-  Graph graph;
-  IntEdgeMap capacity(graph);
-
-  std::istringstream input(test_lgf);
-  GraphReader<Graph>(graph, input).
-    edgeMap("capacity", capacity).run();
-
-  GomoryHu<Graph> ght(graph, capacity);
-  ght.run();
-
+void checkGomoryHu(const Graph& graph, const IntEdgeMap& capacity,
+                   const GomoryHu<Graph>& ght) {
+  GomoryHuIndex<Graph> index(graph);
+  index.build(ght);
   for (NodeIt u(graph); u != INVALID; ++u) {
+    check(index.minCutValue(u, u) == ght.minCutValue(u, u),
+          "Wrong indexed cut");
     for (NodeIt v(graph); v != u; ++v) {
       Preflow<Graph, IntEdgeMap> pf(graph, capacity, u, v);
       pf.runMinCut();
@@ -123,6 +131,7 @@ int main() {
       check(pf.flowValue() == ght.minCutValue(u, v), "Wrong cut 1");
       check(cm[u] != cm[v], "Wrong cut 2");
       check(pf.flowValue() == cutValue(graph, cm, capacity), "Wrong cut 3");
+      check(pf.flowValue() == index.minCutValue(u, v), "Wrong indexed cut");
 
       int sum=0;
       for(GomoryHu<Graph>::MinCutEdgeIt a(ght, u, v);a!=INVALID;++a)
@@ -137,6 +146,74 @@ int main() {
       check(sum == countNodes(graph), "Problem with MinCutNodeIt");
     }
   }
+}
+
+int main() {
+  Graph graph;
+  IntEdgeMap capacity(graph);
+
+  std::istringstream input(test_lgf);
+  GraphReader<Graph>(graph, input).
+    edgeMap("capacity", capacity).run();
+
+  GomoryHu<Graph> ght(graph, capacity);
+  ght.run();
+  checkGomoryHu(graph, capacity, ght);
+  for (int threads = 1; threads <= 4; threads *= 2) {
+    ght.runParallel(threads);
+    checkGomoryHu(graph, capacity, ght);
+  }
+
+  // Random graphs with a few dense parts
+  for (int k = 0; k < 3; ++k) {
+    Graph rgraph;
+    IntEdgeMap rcapacity(rgraph);
+    std::vector<Node> nodes;
+    for (int i = 0; i < 40; ++i) nodes.push_back(rgraph.addNode());
+    for (int i = 0; i < 100; ++i) {
+      int a = rnd[40], b = i < 60 ? (a / 10) * 10 + rnd[10] : rnd[40];
+      rcapacity[rgraph.addEdge(nodes[a], nodes[b])] = 1 + rnd[20];
+    }
+    GomoryHu<Graph> rght(rgraph, rcapacity);
+    rght.runParallel(k + 2);
+    checkGomoryHu(rgraph, rcapacity, rght);
+
+    // Save and reload the tree
+    std::ostringstream os;
+    rght.writeTree(os);
+    GomoryHu<Graph> lght(rgraph, rcapacity);
+    std::istringstream is(os.str());
+    lght.readTree(is);
+    for (NodeIt u(rgraph); u != INVALID; ++u) {
+      check(lght.predNode(u) == rght.predNode(u), "Wrong reloaded tree");
+      check(lght.rootDist(u) == rght.rootDist(u), "Wrong reloaded tree");
+      if (rght.predNode(u) != INVALID) {
+        check(lght.predValue(u) == rght.predValue(u), "Wrong reloaded tree");
+      }
+    }
+    checkGomoryHu(rgraph, rcapacity, lght);
+  }
+
+  // Invalid tree files
+  {
+    const char* bad[] = {
+      "@gomory_hu\n3\n-1\n0 1\n",
+      "@gomory_hu\n5\n-1\n-1\n0 1\n0 1\n0 1\n",
+      "@gomory_hu\n5\n-1\n2 1\n1 1\n0 1\n0 1\n",
+      "@gomory_hu\n5\n-1\n7 1\n0 1\n0 1\n0 1\n",
+      "@gomory_hu\n5\n-1\n0 1\n0 x\n"
+    };
+    for (int i = 0; i < 5; ++i) {
+      std::istringstream is(bad[i]);
+      bool error = false;
+      try {
+        ght.readTree(is);
+      } catch (const FormatError&) {
+        error = true;
+      }
+      check(error, "Invalid tree accepted");
+    }
+  }
 
   return 0;
 }
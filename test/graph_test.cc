@@ -19,6 +19,7 @@
 #include <lemon/concepts/graph.h>
 #include <lemon/list_graph.h>
 #include <lemon/smart_graph.h>
+#include <lemon/static_graph.h>
 #include <lemon/full_graph.h>
 #include <lemon/grid_graph.h>
 #include <lemon/hypercube_graph.h>
@@ -278,6 +279,143 @@ void checkGraphSnapshot() {
   checkGraphArcList(G, 6);
 }
 
+void checkStaticGraph() {
+  SmartGraph g;
+  SmartGraph::NodeMap<StaticGraph::Node> nref(g);
+  SmartGraph::EdgeMap<StaticGraph::Edge> eref(g);
+
+  StaticGraph G;
+
+  checkGraphNodeList(G, 0);
+  checkGraphEdgeList(G, 0);
+  checkGraphArcList(G, 0);
+
+  G.build(g, nref, eref);
+
+  checkGraphNodeList(G, 0);
+  checkGraphEdgeList(G, 0);
+  checkGraphArcList(G, 0);
+
+  SmartGraph::Node
+    n1 = g.addNode(),
+    n2 = g.addNode(),
+    n3 = g.addNode();
+
+  G.build(g, nref, eref);
+
+  checkGraphNodeList(G, 3);
+  checkGraphEdgeList(G, 0);
+  checkGraphArcList(G, 0);
+
+  SmartGraph::Edge e1 = g.addEdge(n1, n2);
+
+  G.build(g, nref, eref);
+
+  check(G.u(eref[e1]) == nref[n1] && G.v(eref[e1]) == nref[n2],
+        "Wrong edge or wrong references");
+  checkGraphNodeList(G, 3);
+  checkGraphEdgeList(G, 1);
+  checkGraphArcList(G, 2);
+
+  checkGraphIncEdgeArcLists(G, nref[n1], 1);
+  checkGraphIncEdgeArcLists(G, nref[n2], 1);
+  checkGraphIncEdgeArcLists(G, nref[n3], 0);
+
+  checkGraphConEdgeList(G, 1);
+  checkGraphConArcList(G, 2);
+
+  SmartGraph::Edge
+    e2 = g.addEdge(n2, n1),
+    e3 = g.addEdge(n2, n3),
+    e4 = g.addEdge(n3, n3);
+  ::lemon::ignore_unused_variable_warning(e2,e3,e4);
+
+  graphCopy(g, G).nodeRef(nref).edgeRef(eref).run();
+
+  checkGraphNodeList(G, 3);
+  checkGraphEdgeList(G, 4);
+  checkGraphArcList(G, 8);
+
+  checkGraphIncEdgeArcLists(G, nref[n1], 2);
+  checkGraphIncEdgeArcLists(G, nref[n2], 3);
+  checkGraphIncEdgeArcLists(G, nref[n3], 3);
+
+  checkGraphConEdgeList(G, 4);
+  checkGraphConArcList(G, 8);
+
+  for (SmartGraph::EdgeIt e(g); e != INVALID; ++e) {
+    check(G.u(eref[e]) == nref[g.u(e)] && G.v(eref[e]) == nref[g.v(e)],
+          "Wrong edge references");
+  }
+
+  std::vector<std::pair<int,int> > edges;
+  edges.push_back(std::make_pair(3,0));
+  edges.push_back(std::make_pair(0,1));
+  edges.push_back(std::make_pair(0,2));
+  edges.push_back(std::make_pair(1,3));
+  edges.push_back(std::make_pair(1,2));
+  edges.push_back(std::make_pair(3,3));
+  edges.push_back(std::make_pair(4,2));
+  edges.push_back(std::make_pair(4,3));
+  edges.push_back(std::make_pair(4,1));
+
+  G.build(6, edges.begin(), edges.end());
+
+  checkGraphNodeList(G, 6);
+  checkGraphEdgeList(G, 9);
+  checkGraphArcList(G, 18);
+
+  checkGraphIncEdgeArcLists(G, G.node(0), 3);
+  checkGraphIncEdgeArcLists(G, G.node(1), 4);
+  checkGraphIncEdgeArcLists(G, G.node(2), 3);
+  checkGraphIncEdgeArcLists(G, G.node(3), 5);
+  checkGraphIncEdgeArcLists(G, G.node(4), 3);
+  checkGraphIncEdgeArcLists(G, G.node(5), 0);
+
+  checkGraphConEdgeList(G, 9);
+  checkGraphConArcList(G, 18);
+
+  for (int k = 0; k < int(edges.size()); ++k) {
+    StaticGraph::Edge e = G.edge(k);
+    check(G.index(G.u(e)) == edges[k].first &&
+          G.index(G.v(e)) == edges[k].second, "Wrong edge");
+    check(G.source(G.arc(2 * k + 1)) == G.u(e) &&
+          G.target(G.arc(2 * k + 1)) == G.v(e), "Wrong arc pairing");
+    check(G.oppositeArc(G.arc(2 * k)) == G.arc(2 * k + 1),
+          "Wrong arc pairing");
+  }
+
+  for (StaticGraph::NodeIt n(G); n != INVALID; ++n) {
+    for (StaticGraph::OutArcIt a(G, n); a != INVALID; ++a) {
+      StaticGraph::OutArcIt b(G, static_cast<StaticGraph::Arc>(a));
+      check(a == b, "Wrong OutArcIt");
+      ++a; ++b;
+      check(a == b, "Wrong OutArcIt");
+      if (a == INVALID) break;
+    }
+  }
+
+  checkArcDirections(G);
+
+  checkNodeIds(G);
+  checkArcIds(G);
+  checkEdgeIds(G);
+  checkGraphNodeMap(G);
+  checkGraphArcMap(G);
+  checkGraphEdgeMap(G);
+
+  int n = G.nodeNum();
+  int m = G.edgeNum();
+  check(G.index(G.node(n-1)) == n-1, "Wrong index.");
+  check(G.index(G.edge(m-1)) == m-1, "Wrong index.");
+  check(G.index(G.arc(2*m-1)) == 2*m-1, "Wrong index.");
+
+  G.clear();
+  checkGraphNodeList(G, 0);
+  checkGraphEdgeList(G, 0);
+  checkGraphArcList(G, 0);
+}
+
 void checkFullGraph(int num) {
   typedef FullGraph Graph;
   GRAPH_TYPEDEFS(Graph);
@@ -361,6 +499,10 @@ void checkConcepts() {
     checkConcept<ExtendableGraphComponent<>, SmartGraph>();
     checkConcept<ClearableGraphComponent<>, SmartGraph>();
   }
+  { // Checking StaticGraph
+    checkConcept<Graph, StaticGraph>();
+    checkConcept<ClearableGraphComponent<>, StaticGraph>();
+  }
   { // Checking FullGraph
     checkConcept<Graph, FullGraph>();
   }
@@ -577,6 +719,9 @@ void checkGraphs() {
     checkGraphSnapshot<SmartGraph>();
     checkGraphValidity<SmartGraph>();
   }
+  { // Checking StaticGraph
+    checkStaticGraph();
+  }
   { // Checking FullGraph
     checkFullGraph(7);
     checkFullGraph(8);
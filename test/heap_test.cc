@@ -32,11 +32,14 @@
 #include <lemon/bin_heap.h>
 #include <lemon/quad_heap.h>
 #include <lemon/dheap.h>
+#include <lemon/aligned_dheap.h>
+#include <lemon/lazy_heap.h>
 #include <lemon/fib_heap.h>
 #include <lemon/pairing_heap.h>
 #include <lemon/radix_heap.h>
 #include <lemon/binomial_heap.h>
 #include <lemon/bucket_heap.h>
+#include <lemon/monotone_bucket_heap.h>
 
 #include "test_tools.h"
 
@@ -209,6 +212,35 @@ int main() {
     dijkstraHeapTest<NodeHeap>(digraph, length, source);
   }
 
+  // AlignedDHeap
+  {
+    typedef AlignedDHeap<Prio, ItemIntMap> IntHeap;
+    checkConcept<Heap<Prio, ItemIntMap>, IntHeap>();
+    heapSortTest<IntHeap>();
+    heapIncreaseTest<IntHeap>();
+
+    typedef AlignedDHeap<Prio, ItemIntMap, 4> QuadIntHeap;
+    checkConcept<Heap<Prio, ItemIntMap>, QuadIntHeap>();
+    heapSortTest<QuadIntHeap>();
+    heapIncreaseTest<QuadIntHeap>();
+
+    typedef AlignedDHeap<Prio, IntNodeMap > NodeHeap;
+    checkConcept<Heap<Prio, IntNodeMap >, NodeHeap>();
+    dijkstraHeapTest<NodeHeap>(digraph, length, source);
+  }
+
+  // LazyHeap
+  {
+    typedef LazyHeap<Prio, ItemIntMap> IntHeap;
+    checkConcept<Heap<Prio, ItemIntMap>, IntHeap>();
+    heapSortTest<IntHeap>();
+    heapIncreaseTest<IntHeap>();
+
+    typedef LazyHeap<Prio, IntNodeMap > NodeHeap;
+    checkConcept<Heap<Prio, IntNodeMap >, NodeHeap>();
+    dijkstraHeapTest<NodeHeap>(digraph, length, source);
+  }
+
   // FibHeap
   {
     typedef FibHeap<Prio, ItemIntMap> IntHeap;
@@ -305,6 +337,18 @@ int main() {
     dijkstraHeapTest<NodeHeap>(digraph, length, source);
   }
 
+  // MonotoneBucketHeap
+  {
+    typedef MonotoneBucketHeap<Prio, ItemIntMap> IntHeap;
+    checkConcept<Heap<Prio, ItemIntMap>, IntHeap>();
+    heapSortTest<IntHeap>();
+    heapIncreaseTest<IntHeap>();
+
+    typedef MonotoneBucketHeap<Prio, IntNodeMap > NodeHeap;
+    checkConcept<Heap<Prio, IntNodeMap >, NodeHeap>();
+    dijkstraHeapTest<NodeHeap>(digraph, length, source);
+  }
+
 
   return 0;
 }
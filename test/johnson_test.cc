@@ -0,0 +1,237 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include <vector>
+
+#include <lemon/concepts/digraph.h>
+#include <lemon/concepts/maps.h>
+#include <lemon/smart_graph.h>
+#include <lemon/list_graph.h>
+#include <lemon/static_graph.h>
+#include <lemon/johnson.h>
+#include <lemon/floyd_warshall.h>
+#include <lemon/bellman_ford.h>
+#include <lemon/random.h>
+
+#include "test_tools.h"
+
+using namespace lemon;
+
+struct CountVisitor {
+  int count;
+  CountVisitor() : count(0) {}
+  template <typename Node, typename Value>
+  void operator()(const Node&, const Node&, const Value&) {
+    bits::atomicFetchAdd(&count, 1);
+  }
+};
+
+void checkJohnsonCompile()
+{
+  typedef int Value;
+  typedef concepts::Digraph Digraph;
+  typedef concepts::ReadMap<Digraph::Arc, Value> LengthMap;
+  typedef Digraph::Node Node;
+
+  Digraph g;
+  LengthMap length;
+  Node s, t;
+  bool b;
+  Value d;
+  int i;
+  std::vector<Value> matrix;
+  CountVisitor visitor;
+
+  Johnson<Digraph, LengthMap> johnson(g, length);
+  const Johnson<Digraph, LengthMap>& const_johnson = johnson;
+  johnson.threadNum(2);
+  b = johnson.run();
+  b = johnson.init();
+  johnson.start();
+  johnson.start(matrix.begin());
+  johnson.startVisit(visitor);
+
+  i = const_johnson.index(s);
+  d = const_johnson.dist(s, t);
+  b = const_johnson.reached(s, t);
+  d = const_johnson.potential(s);
+  const Johnson<Digraph, LengthMap>::PotentialMap& pot =
+    const_johnson.potentialMap();
+  d = pot[s];
+  Path<Digraph> p = const_johnson.negativeCycle();
+
+  FloydWarshall<Digraph, LengthMap> fw(g, length);
+  const FloydWarshall<Digraph, LengthMap>& const_fw = fw;
+  fw.threadNum(2).blockSize(16);
+  b = fw.run();
+  i = const_fw.index(s);
+  d = const_fw.dist(s, t);
+  b = const_fw.reached(s, t);
+
+  ignore_unused_variable_warning(b, d, i);
+}
+
+template <typename Digraph>
+void checkAllPairs(const Digraph& g,
+                   const typename Digraph::template ArcMap<int>& length,
+                   bool negative_cycle) {
+  TEMPLATE_DIGRAPH_TYPEDEFS(Digraph);
+  typedef typename Digraph::template ArcMap<int> LengthMap;
+
+  Johnson<Digraph, LengthMap> johnson(g, length);
+  FloydWarshall<Digraph, LengthMap> fw(g, length);
+  fw.blockSize(7).threadNum(4);
+  check(johnson.threadNum(4).run() == !negative_cycle,
+        "Wrong negative cycle detection");
+  check(fw.run() == !negative_cycle, "Wrong negative cycle detection");
+  if (negative_cycle) {
+    Path<Digraph> p = johnson.negativeCycle();
+    int sum = 0;
+    for (typename Path<Digraph>::ArcIt a(p); a != INVALID; ++a) {
+      sum += length[a];
+    }
+    check(!p.empty() && sum < 0, "Wrong negative cycle");
+    return;
+  }
+
+  for (ArcIt a(g); a != INVALID; ++a) {
+    check(length[a] + johnson.potential(g.source(a)) -
+          johnson.potential(g.target(a)) >= 0, "Wrong potentials");
+  }
+
+  int n = countNodes(g);
+  std::vector<int> matrix(n * n);
+  check(johnson.init(), "Wrong negative cycle detection");
+  johnson.start(&matrix[0]);
+  CountVisitor visitor;
+  johnson.startVisit(visitor);
+
+  int reached = 0;
+  for (NodeIt s(g); s != INVALID; ++s) {
+    BellmanFord<Digraph, LengthMap> bf(g, length);
+    bf.run(s);
+    for (NodeIt t(g); t != INVALID; ++t) {
+      int m = matrix[johnson.index(s) * n + johnson.index(t)];
+      check(bf.reached(t) == johnson.reached(s, t) &&
+            bf.reached(t) == fw.reached(s, t), "Wrong reachability");
+      if (bf.reached(t)) {
+        ++reached;
+        check(johnson.dist(s, t) == bf.dist(t) &&
+              fw.dist(s, t) == bf.dist(t) && m == bf.dist(t),
+              "Wrong distance");
+      } else {
+        check(m == std::numeric_limits<int>::max(), "Wrong distance");
+      }
+    }
+  }
+  check(visitor.count == reached, "Wrong visitor calls");
+}
+
+void checkRandomDigraphs() {
+  for (int t = 0; t < 8; ++t) {
+    SmartDigraph g;
+    SmartDigraph::ArcMap<int> length(g);
+    int n = 10 + rnd[150];
+    int m = rnd[5 * n];
+    std::vector<SmartDigraph::Node> nodes;
+    std::vector<int> pot(n);
+    for (int i = 0; i < n; ++i) {
+      nodes.push_back(g.addNode());
+      pot[i] = rnd[1000];
+    }
+    for (int i = 0; i < m; ++i) {
+      int u = rnd[n], v = rnd[n];
+      length[g.addArc(nodes[u], nodes[v])] = rnd[50] + pot[u] - pot[v];
+    }
+    bool negative = t % 4 == 3;
+    if (negative) {
+      int u = rnd[n], v = rnd[n];
+      length[g.addArc(nodes[u], nodes[v])] = pot[u] - pot[v];
+      length[g.addArc(nodes[v], nodes[u])] = pot[v] - pot[u] - 1;
+    }
+    checkAllPairs(g, length, negative);
+
+    if (!negative) {
+      StaticDigraph sg;
+      SmartDigraph::ArcMap<StaticDigraph::Arc> aref(g);
+      digraphCopy(g, sg).arcRef(aref).run();
+      StaticDigraph::ArcMap<int> slength(sg);
+      for (SmartDigraph::ArcIt a(g); a != INVALID; ++a) {
+        slength[aref[a]] = length[a];
+      }
+      checkAllPairs(sg, slength, false);
+    }
+  }
+}
+
+// Several block rows of the default block size on several threads
+void checkParallelFloydWarshall() {
+  SmartDigraph g;
+  SmartDigraph::ArcMap<int> length(g);
+  int n = 300;
+  std::vector<SmartDigraph::Node> nodes;
+  for (int i = 0; i < n; ++i) nodes.push_back(g.addNode());
+  for (int i = 0; i < 4 * n; ++i) {
+    length[g.addArc(nodes[rnd[n]], nodes[rnd[n]])] = rnd[1000];
+  }
+  FloydWarshall<SmartDigraph> fw1(g, length), fw3(g, length);
+  check(fw1.threadNum(1).run() && fw3.threadNum(3).run(),
+        "Wrong negative cycle detection");
+  Johnson<SmartDigraph> johnson(g, length);
+  check(johnson.run(), "Wrong negative cycle detection");
+  for (SmartDigraph::NodeIt s(g); s != INVALID; ++s) {
+    for (SmartDigraph::NodeIt t(g); t != INVALID; ++t) {
+      check(fw3.reached(s, t) == johnson.reached(s, t) &&
+            fw3.reached(s, t) == fw1.reached(s, t), "Wrong reachability");
+      check(!johnson.reached(s, t) ||
+            (fw3.dist(s, t) == johnson.dist(s, t) &&
+             fw1.dist(s, t) == johnson.dist(s, t)), "Wrong distance");
+    }
+  }
+}
+
+int main() {
+  {
+    SmartDigraph g;
+    SmartDigraph::ArcMap<int> length(g);
+    checkAllPairs(g, length, false);
+    SmartDigraph::Node n1 = g.addNode(), n2 = g.addNode();
+    g.addNode();
+    length[g.addArc(n1, n2)] = -3;
+    length[g.addArc(n2, n2)] = 2;
+    length[g.addArc(n2, n1)] = 5;
+    checkAllPairs(g, length, false);
+    length[g.addArc(n2, n1)] = 2;
+    checkAllPairs(g, length, true);
+  }
+  {
+    ListDigraph g;
+    ListDigraph::ArcMap<int> length(g);
+    ListDigraph::Node n1 = g.addNode(), n2 = g.addNode(),
+      n3 = g.addNode();
+    length[g.addArc(n1, n3)] = 4;
+    length[g.addArc(n3, n2)] = -1;
+    g.erase(n2);
+    checkAllPairs(g, length, false);
+  }
+
+  checkRandomDigraphs();
+  checkParallelFloydWarshall();
+
+  return 0;
+}
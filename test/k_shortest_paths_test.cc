@@ -0,0 +1,237 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+
+#include <lemon/list_graph.h>
+#include <lemon/lgf_reader.h>
+#include <lemon/path.h>
+#include <lemon/random.h>
+#include <lemon/k_shortest_paths.h>
+#include <lemon/concepts/digraph.h>
+#include <lemon/concepts/maps.h>
+
+#include "test_tools.h"
+
+using namespace lemon;
+
+char test_lgf[] =
+  "@nodes\n"
+  "label\n"
+  "1\n"
+  "2\n"
+  "3\n"
+  "4\n"
+  "5\n"
+  "6\n"
+  "@arcs\n"
+  "      length\n"
+  "1 2   3\n"
+  "1 3   2\n"
+  "2 4   4\n"
+  "3 2   1\n"
+  "3 4   2\n"
+  "3 5   3\n"
+  "4 5   2\n"
+  "4 6   1\n"
+  "5 6   2\n"
+  "6 1   1\n"
+  "@attributes\n"
+  "source 1\n"
+  "target 6\n";
+
+void checkKShortestPathsCompile()
+{
+  typedef int VType;
+  typedef concepts::Digraph Digraph;
+
+  typedef Digraph::Node Node;
+  typedef Digraph::Arc Arc;
+  typedef concepts::ReadMap<Arc, VType> LengthMap;
+
+  typedef KShortestPaths<Digraph, LengthMap> KspType;
+
+  Digraph g;
+  Node n;
+  LengthMap len;
+
+  KspType ksp(g, len);
+  const KspType& const_ksp = ksp;
+
+  int k;
+  bool b;
+  VType c;
+  ksp.threads(2);
+  k = ksp.run(n, n, 3);
+  ksp.init(n, n);
+  b = ksp.findNext();
+  k = const_ksp.pathNum();
+  c = const_ksp.length(k);
+  const KspType::Path& p = const_ksp.path(k);
+
+  ::lemon::ignore_unused_variable_warning(b, c);
+  ::lemon::ignore_unused_variable_warning(p);
+}
+
+// Check that a path is a simple path from s to t with the given length
+template <typename Digraph, typename LengthMap, typename Path>
+bool checkPath(const Digraph& gr, const LengthMap& length, const Path& path,
+               typename Digraph::Node s, typename Digraph::Node t,
+               typename LengthMap::Value len)
+{
+  typename Digraph::template NodeMap<bool> visited(gr, false);
+  typename Digraph::Node n = s;
+  typename LengthMap::Value sum = 0;
+  visited[n] = true;
+  for (int i = 0; i < path.length(); ++i) {
+    if (gr.source(path.nth(i)) != n) return false;
+    n = gr.target(path.nth(i));
+    if (visited[n]) return false;
+    visited[n] = true;
+    sum += length[path.nth(i)];
+  }
+  return n == t && sum == len;
+}
+
+template <typename Path>
+bool samePath(const Path& p1, const Path& p2)
+{
+  if (p1.length() != p2.length()) return false;
+  for (int i = 0; i < p1.length(); ++i) {
+    if (p1.nth(i) != p2.nth(i)) return false;
+  }
+  return true;
+}
+
+// Enumerate the lengths of all simple paths from u to t
+void allPathLengths(const ListDigraph& gr,
+                    const ListDigraph::ArcMap<int>& length,
+                    ListDigraph::Node u, ListDigraph::Node t, int len,
+                    ListDigraph::NodeMap<bool>& visited,
+                    std::vector<int>& lengths)
+{
+  if (u == t) {
+    lengths.push_back(len);
+    return;
+  }
+  visited[u] = true;
+  for (ListDigraph::OutArcIt a(gr, u); a != INVALID; ++a) {
+    ListDigraph::Node v = gr.target(a);
+    if (!visited[v]) {
+      allPathLengths(gr, length, v, t, len + length[a], visited, lengths);
+    }
+  }
+  visited[u] = false;
+}
+
+int main()
+{
+  DIGRAPH_TYPEDEFS(ListDigraph);
+
+  // Read the test digraph
+  {
+    ListDigraph gr;
+    ListDigraph::ArcMap<int> length(gr);
+    Node s, t;
+
+    std::istringstream input(test_lgf);
+    digraphReader(gr, input).
+      arcMap("length", length).
+      node("source", s).
+      node("target", t).
+      run();
+
+    // The simple paths from 1 to 6 have lengths 5, 7, 8, 8, 8, 11, 11
+    int lengths[] = { 5, 7, 8, 8, 8, 11, 11 };
+
+    KShortestPaths<ListDigraph> ksp(gr, length);
+    check(ksp.run(s, t, 3) == 3, "Wrong number of paths");
+    for (int i = 0; i < 3; ++i) {
+      check(ksp.length(i) == lengths[i], "Wrong path length");
+      check(checkPath(gr, length, ksp.path(i), s, t, lengths[i]),
+            "Wrong path");
+    }
+
+    // Continue the search lazily
+    while (ksp.findNext()) {}
+    check(ksp.pathNum() == 7, "Wrong number of paths");
+    for (int i = 0; i < 7; ++i) {
+      check(ksp.length(i) == lengths[i], "Wrong path length");
+      check(checkPath(gr, length, ksp.path(i), s, t, lengths[i]),
+            "Wrong path");
+    }
+    check(!ksp.findNext(), "Wrong result");
+
+    // No path in the opposite direction without using node 1 twice
+    check(ksp.run(t, s, 5) == 1, "Wrong number of paths");
+    check(ksp.length(0) == 1, "Wrong path length");
+    check(ksp.run(s, s, 5) == 1 && ksp.path(0).empty(),
+          "Wrong path");
+  }
+
+  // Compare with the enumeration of all simple paths
+  for (int test = 0; test < 10; ++test) {
+    ListDigraph gr;
+    ListDigraph::ArcMap<int> length(gr);
+    std::vector<Node> nodes;
+    for (int i = 0; i < 12; ++i) {
+      nodes.push_back(gr.addNode());
+    }
+    for (int i = 0; i < 40; ++i) {
+      Node u = nodes[rnd[12]], v = nodes[rnd[12]];
+      if (u != v) length[gr.addArc(u, v)] = rnd[20];
+    }
+    Node s = nodes[0], t = nodes[11];
+
+    std::vector<int> lengths;
+    ListDigraph::NodeMap<bool> visited(gr, false);
+    allPathLengths(gr, length, s, t, 0, visited, lengths);
+    std::sort(lengths.begin(), lengths.end());
+    int k = std::min(int(lengths.size()), 50);
+
+    std::vector<int> found;
+    for (int threads = 1; threads <= 4; threads *= 2) {
+      KShortestPaths<ListDigraph> ksp(gr, length);
+      ksp.threads(threads);
+      check(ksp.run(s, t, 50) == k, "Wrong number of paths");
+      for (int i = 0; i < k; ++i) {
+        check(ksp.length(i) == lengths[i], "Wrong path length");
+        check(checkPath(gr, length, ksp.path(i), s, t, lengths[i]),
+              "Wrong path");
+        for (int j = 0; j < i; ++j) {
+          check(!samePath(ksp.path(i), ksp.path(j)), "Repeated path");
+        }
+      }
+
+      // The result does not depend on the number of threads
+      std::vector<int> arcs;
+      for (int i = 0; i < k; ++i) {
+        for (int j = 0; j < ksp.path(i).length(); ++j)
+          arcs.push_back(gr.id(ksp.path(i).nth(j)));
+        arcs.push_back(-1);
+      }
+      if (threads == 1) found = arcs;
+      check(arcs == found, "Wrong paths");
+    }
+  }
+
+  return 0;
+}
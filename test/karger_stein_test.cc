@@ -0,0 +1,187 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include <sstream>
+#include <vector>
+
+#include <lemon/smart_graph.h>
+#include <lemon/list_graph.h>
+#include <lemon/concepts/graph.h>
+#include <lemon/concepts/maps.h>
+#include <lemon/lgf_reader.h>
+#include <lemon/nagamochi_ibaraki.h>
+#include <lemon/karger_stein.h>
+#include <lemon/random.h>
+
+#include "test_tools.h"
+
+using namespace lemon;
+using namespace std;
+
+const std::string lgf =
+  "@nodes\n"
+  "label\n"
+  "0\n"
+  "1\n"
+  "2\n"
+  "3\n"
+  "4\n"
+  "5\n"
+  "@edges\n"
+  "     cap1 cap2 cap3\n"
+  "0 1  1    1    1   \n"
+  "0 2  2    2    4   \n"
+  "1 2  4    4    4   \n"
+  "3 4  1    1    1   \n"
+  "3 5  2    2    4   \n"
+  "4 5  4    4    4   \n"
+  "2 3  1    6    6   \n";
+
+void checkKargerSteinCompile()
+{
+  typedef int Value;
+  typedef concepts::Graph Graph;
+
+  typedef Graph::Node Node;
+  typedef Graph::Edge Edge;
+  typedef concepts::ReadMap<Edge, Value> CapMap;
+  typedef concepts::WriteMap<Node, bool> CutMap;
+
+  Graph g;
+  CapMap cap;
+  CutMap cut;
+  Value v;
+  int k;
+  double p;
+  ::lemon::ignore_unused_variable_warning(v,k,p);
+
+  KargerStein<Graph, CapMap> ks_test(g, cap);
+  const KargerStein<Graph, CapMap>& const_ks_test = ks_test;
+
+  ks_test.threads(2).confidence(0.9).maxTrials(10).seed(1);
+  ks_test.run();
+
+  v = const_ks_test.minCutValue();
+  v = const_ks_test.minCutMap(cut);
+  k = const_ks_test.trialNum();
+  p = const_ks_test.successProbability();
+}
+
+template <typename Graph, typename CapMap, typename CutMap>
+typename CapMap::Value
+  cutValue(const Graph& graph, const CapMap& cap, const CutMap& cut)
+{
+  typename CapMap::Value sum = 0;
+  for (typename Graph::EdgeIt e(graph); e != INVALID; ++e) {
+    if (cut[graph.u(e)] != cut[graph.v(e)]) {
+      sum += cap[e];
+    }
+  }
+  return sum;
+}
+
+template <typename Graph, typename CapMap>
+void checkKargerStein(const Graph& graph, const CapMap& cap,
+                      typename CapMap::Value value)
+{
+  typename Graph::template NodeMap<bool> cut(graph);
+  int trials = -1;
+  for (int threads = 1; threads <= 3; ++threads) {
+    KargerStein<Graph, CapMap> ks(graph, cap);
+    ks.threads(threads).run();
+    ks.minCutMap(cut);
+    check(ks.minCutValue() == value, "Wrong cut value");
+    check(ks.minCutValue() == cutValue(graph, cap, cut), "Wrong cut map");
+    check(!(ks.successProbability() < 0.99), "Wrong probability");
+    check(trials == -1 || trials == ks.trialNum(),
+          "The result depends on the number of threads");
+    trials = ks.trialNum();
+
+    int num = 0;
+    for (typename Graph::NodeIt n(graph); n != INVALID; ++n) {
+      if (cut[n]) ++num;
+    }
+    check(num > 0 && num < countNodes(graph), "Wrong cut map");
+  }
+
+  KargerStein<Graph, CapMap> ks(graph, cap);
+  ks.threads(2).maxTrials(3).run();
+  ks.minCutMap(cut);
+  check(ks.trialNum() == 3, "Wrong number of trials");
+  check(!(ks.minCutValue() < value), "Wrong cut value");
+  check(ks.minCutValue() == cutValue(graph, cap, cut), "Wrong cut map");
+
+  ks.confidence(1.0).maxTrials(5).run();
+  check(ks.trialNum() == 5, "Wrong number of trials");
+  ks.maxTrials(0).run();
+  check(ks.minCutValue() == value, "Wrong cut value");
+  check(!(ks.successProbability() < 0.999999), "Wrong probability");
+}
+
+int main() {
+  SmartGraph graph;
+  SmartGraph::EdgeMap<int> cap1(graph), cap2(graph), cap3(graph);
+
+  istringstream input(lgf);
+  graphReader(graph, input)
+    .edgeMap("cap1", cap1)
+    .edgeMap("cap2", cap2)
+    .edgeMap("cap3", cap3)
+    .run();
+
+  checkKargerStein(graph, cap1, 1);
+  checkKargerStein(graph, cap2, 3);
+  checkKargerStein(graph, cap3, 5);
+
+  // Random graphs compared to NagamochiIbaraki
+  for (int k = 0; k < 4; ++k) {
+    ListGraph rgraph;
+    ListGraph::EdgeMap<int> rcap(rgraph);
+    std::vector<ListGraph::Node> nodes;
+    int n = 20 + 10 * k;
+    for (int i = 0; i < n; ++i) nodes.push_back(rgraph.addNode());
+    for (int i = 0; i < n; ++i) {
+      rcap[rgraph.addEdge(nodes[i], nodes[(i + 1) % n])] = 1 + rnd[5];
+    }
+    for (int i = 0; i < 3 * n; ++i) {
+      rcap[rgraph.addEdge(nodes[rnd[n]], nodes[rnd[n]])] = 1 + rnd[5];
+    }
+    NagamochiIbaraki<ListGraph> ni(rgraph, rcap);
+    ni.run();
+    checkKargerStein(rgraph, rcap, ni.minCutValue());
+  }
+
+  // Disconnected graph
+  {
+    SmartGraph rgraph;
+    SmartGraph::EdgeMap<int> rcap(rgraph);
+    SmartGraph::NodeMap<bool> cut(rgraph);
+    for (int i = 0; i < 10; ++i) rgraph.addNode();
+    for (int i = 0; i < 9; ++i) {
+      if (i == 4) continue;
+      rcap[rgraph.addEdge(rgraph.nodeFromId(i), rgraph.nodeFromId(i + 1))] = 3;
+    }
+    KargerStein<SmartGraph> ks(rgraph, rcap);
+    ks.run();
+    check(ks.minCutValue() == 0, "Wrong cut value");
+    check(ks.minCutMap(cut) == cutValue(rgraph, rcap, cut), "Wrong cut map");
+    check(ks.successProbability() == 1.0, "Wrong probability");
+  }
+
+  return 0;
+}
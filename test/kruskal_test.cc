@@ -23,6 +23,9 @@
 #include <lemon/maps.h>
 #include <lemon/kruskal.h>
 #include <lemon/list_graph.h>
+#include <lemon/static_graph.h>
+#include <lemon/smart_graph.h>
+#include <lemon/random.h>
 
 #include <lemon/concepts/maps.h>
 #include <lemon/concepts/digraph.h>
@@ -56,6 +59,41 @@ void checkCompileKruskal()
 
   kruskal(g, r, ws.begin());
   kruskal(ug, ur, uws.begin());
+
+  parallelKruskal(g, r, w);
+  parallelKruskal(ug, ur, uw, 4);
+}
+
+// Compares parallelKruskal() to kruskal() on random graphs
+void checkParallelKruskal(int node_num, int edge_num, int max_cost,
+                          int threads) {
+  SmartGraph g;
+  SmartGraph::EdgeMap<int> cost(g);
+  for (int i = 0; i < node_num; ++i) g.addNode();
+  for (int i = 0; i < edge_num; ++i) {
+    SmartGraph::Edge e = g.addEdge(g.nodeFromId(rnd[node_num]),
+                                   g.nodeFromId(rnd[node_num]));
+    cost[e] = rnd[max_cost];
+  }
+  SmartGraph::EdgeMap<bool> tree(g), par_tree(g);
+  int value = kruskal(g, cost, tree);
+  check(parallelKruskal(g, cost, par_tree, threads) == value,
+        "Wrong cost of the parallel Kruskal tree.");
+
+  SmartGraph::NodeMap<int> index(g);
+  UnionFind<SmartGraph::NodeMap<int> > uf(index);
+  for (SmartGraph::NodeIt n(g); n != INVALID; ++n) uf.insert(n);
+  int tree_num = 0, par_tree_num = 0, par_value = 0;
+  for (SmartGraph::EdgeIt e(g); e != INVALID; ++e) {
+    if (tree[e]) ++tree_num;
+    if (par_tree[e]) {
+      ++par_tree_num;
+      par_value += cost[e];
+      check(uf.join(g.u(e), g.v(e)), "The parallel Kruskal tree has a cycle.");
+    }
+  }
+  check(tree_num == par_tree_num && par_value == value,
+        "Wrong parallel Kruskal tree.");
 }
 
 int main() {
@@ -143,5 +181,24 @@ int main() {
         tree_edge_vec[4]==e9,
         "Wrong tree.");
 
+  //Test with a static graph.
+  StaticGraph SG;
+  StaticGraph::EdgeMap<int> static_cost_map(SG);
+  StaticGraph::EdgeMap<bool> static_tree_map(SG);
+  graphCopy(G, SG).edgeMap(edge_cost_map, static_cost_map).run();
+  check(kruskal(SG, static_cost_map, static_tree_map)==-31,
+        "Total cost should be -31.");
+
+  //Test the parallel version.
+  check(parallelKruskal(G, edge_cost_map, tree_map)==-31,
+        "Total cost should be -31.");
+  check(parallelKruskal(SG, static_cost_map, static_tree_map, 2)==-31,
+        "Total cost should be -31.");
+  checkParallelKruskal(100, 50, 1000, 1);
+  checkParallelKruskal(300, 20000, 1000, 1);
+  checkParallelKruskal(300, 20000, 1000, 4);
+  checkParallelKruskal(3000, 60000, 5, 4);
+  checkParallelKruskal(1000, 50000, 1000000, 3);
+
   return 0;
 }
@@ -24,6 +24,7 @@
 
 #include <lemon/matching.h>
 #include <lemon/smart_graph.h>
+#include <lemon/static_graph.h>
 #include <lemon/concepts/graph.h>
 #include <lemon/concepts/maps.h>
 #include <lemon/lgf_reader.h>
@@ -416,6 +417,26 @@ int main() {
       checkWeightedMatching(graph, weight, mwm);
     }
 
+    {
+      StaticGraph sgraph;
+      StaticGraph::EdgeMap<int> sweight(sgraph);
+      graphCopy(graph, sgraph).edgeMap(weight, sweight).run();
+
+      MaxMatching<SmartGraph> mm(graph);
+      mm.run();
+      MaxMatching<StaticGraph> smm(sgraph);
+      smm.run();
+      check(smm.matchingSize() == mm.matchingSize(),
+            "Wrong matching size on StaticGraph");
+
+      MaxWeightedMatching<SmartGraph> mwm(graph, weight);
+      mwm.run();
+      MaxWeightedMatching<StaticGraph> smwm(sgraph, sweight);
+      smwm.run();
+      check(smwm.matchingWeight() == mwm.matchingWeight(),
+            "Wrong matching weight on StaticGraph");
+    }
+
     {
       MaxWeightedMatching<SmartGraph> mwm(graph, weight);
       mwm.init();
@@ -445,5 +466,28 @@ int main() {
     }
   }
 
+  {
+    std::vector<std::pair<int,int> > edges;
+    edges.push_back(std::make_pair(0, 0));
+    edges.push_back(std::make_pair(0, 1));
+    edges.push_back(std::make_pair(1, 0));
+    edges.push_back(std::make_pair(2, 0));
+    edges.push_back(std::make_pair(2, 2));
+    edges.push_back(std::make_pair(3, 2));
+    StaticBpGraph bpgraph;
+    bpgraph.build(4, 3, edges.begin(), edges.end());
+    StaticBpGraph::EdgeMap<int> weight(bpgraph, 1);
+    weight[bpgraph.edge(5)] = 5;
+
+    MaxMatching<StaticBpGraph> mm(bpgraph);
+    mm.run();
+    check(mm.matchingSize() == 3, "Wrong matching size on StaticBpGraph");
+
+    MaxWeightedMatching<StaticBpGraph> mwm(bpgraph, weight);
+    mwm.run();
+    check(mwm.matchingWeight() == 7,
+          "Wrong matching weight on StaticBpGraph");
+  }
+
   return 0;
 }
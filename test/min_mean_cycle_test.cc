@@ -20,8 +20,10 @@
 #include <sstream>
 
 #include <lemon/smart_graph.h>
+#include <lemon/list_graph.h>
 #include <lemon/lgf_reader.h>
 #include <lemon/path.h>
+#include <lemon/random.h>
 #include <lemon/concepts/digraph.h>
 #include <lemon/concept_check.h>
 
@@ -105,11 +107,9 @@ struct MmcClassConcept
 
 // Perform a test with the given parameters
 template <typename MMC>
-void checkMmcAlg(const SmartDigraph& gr,
-                 const SmartDigraph::ArcMap<int>& lm,
-                 const SmartDigraph::ArcMap<int>& cm,
-                 int cost, int size) {
-  MMC alg(gr, lm);
+void checkMmcResult(MMC& alg, const SmartDigraph& gr,
+                    const SmartDigraph::ArcMap<int>& cm,
+                    int cost, int size) {
   check(alg.findCycleMean(), "Wrong result");
   check(alg.cycleMean() == static_cast<double>(cost) / size,
         "Wrong cycle mean");
@@ -125,6 +125,79 @@ void checkMmcAlg(const SmartDigraph& gr,
   }
 }
 
+template <typename MMC>
+void checkMmcAlg(const SmartDigraph& gr,
+                 const SmartDigraph::ArcMap<int>& lm,
+                 const SmartDigraph::ArcMap<int>& cm,
+                 int cost, int size) {
+  MMC alg(gr, lm);
+  checkMmcResult(alg, gr, cm, cost, size);
+}
+
+// Compare the parallel Howard algorithm with the sequential one on a
+// digraph having a large and many small strongly connected components
+void checkParallelHoward(int threads) {
+  typedef ListDigraph GR;
+  DIGRAPH_TYPEDEFS(GR);
+
+  GR gr;
+  const int large = 5000;
+  for (int i = 0; i < large; ++i) {
+    gr.addNode();
+  }
+  for (int i = 0; i < large; ++i) {
+    gr.addArc(gr.nodeFromId(i), gr.nodeFromId((i + 1) % large));
+    gr.addArc(gr.nodeFromId(i), gr.nodeFromId(rnd[large]));
+  }
+  for (int k = 0; k < 40; ++k) {
+    int first = countNodes(gr), size = 1 + rnd[20];
+    for (int i = 0; i < size; ++i) {
+      gr.addNode();
+    }
+    for (int i = 0; i < size; ++i) {
+      Node u = gr.nodeFromId(first + i);
+      if (size > 1 || rnd.boolean()) {
+        gr.addArc(u, gr.nodeFromId(first + (i + 1) % size));
+      }
+      gr.addArc(u, gr.nodeFromId(first + rnd[size]));
+    }
+    gr.addArc(gr.nodeFromId(rnd[first]), gr.nodeFromId(first + rnd[size]));
+  }
+  IntArcMap len(gr);
+  for (ArcIt a(gr); a != INVALID; ++a) {
+    len[a] = rnd[1000] - 200;
+  }
+
+  HowardMmc<GR, IntArcMap> seq(gr, len);
+  check((seq.findCycleMean() == HowardMmc<GR, IntArcMap>::OPTIMAL),
+        "Wrong termination cause");
+
+  HowardMmc<GR, IntArcMap> par(gr, len);
+  par.threads(threads);
+  check(par.run(), "Wrong result");
+  check(par.cycleCost() * seq.cycleSize() ==
+        seq.cycleCost() * par.cycleSize(), "Wrong cycle mean");
+
+  int cost = 0, size = 0;
+  Node prev = INVALID;
+  for (Path<GR>::ArcIt a(par.cycle()); a != INVALID; ++a) {
+    check(prev == INVALID || gr.source(a) == prev, "Wrong cycle");
+    prev = gr.target(a);
+    cost += len[a];
+    ++size;
+  }
+  check(prev == gr.source(par.cycle().front()), "Wrong cycle");
+  check(cost == par.cycleCost() && size == par.cycleSize(), "Wrong cycle");
+
+  check(par.componentNum() == seq.componentNum(),
+        "Wrong number of components");
+  for (NodeIt n(gr); n != INVALID; ++n) {
+    int k = par.component(n);
+    check(k >= 0 && k < par.componentNum(), "Wrong component");
+    check(par.iterationNum(k) > 0, "Wrong number of iterations");
+  }
+}
+
 // Class for comparing types
 template <typename T1, typename T2>
 struct IsSameType {
@@ -217,7 +290,25 @@ int main() {
       "Wrong termination cause");
     check((mmc.findCycleMean(4) == HowardMmc<GR, IntArcMap>::OPTIMAL),
       "Wrong termination cause");
+    int iter = 0;
+    for (int k = 0; k < mmc.componentNum(); ++k) {
+      iter += mmc.iterationNum(k);
+    }
+    check(iter == 4, "Wrong number of iterations");
+
+    // Howard on several threads
+    HowardMmc<GR, IntArcMap> pmmc1(gr, l1), pmmc2(gr, l2);
+    HowardMmc<GR, IntArcMap> pmmc3(gr, l3), pmmc4(gr, l4);
+    checkMmcResult(pmmc1.threads(2), gr, c1,  6, 3);
+    checkMmcResult(pmmc2.threads(2), gr, c2,  5, 2);
+    checkMmcResult(pmmc3.threads(2), gr, c3,  0, 1);
+    checkMmcResult(pmmc4.threads(2), gr, c4, -1, 1);
   }
 
+  // Compare the parallel and the sequential Howard algorithm
+  checkParallelHoward(2);
+  checkParallelHoward(4);
+  checkParallelHoward(0);
+
   return 0;
 }
@@ -0,0 +1,263 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include <iostream>
+#include <sstream>
+#include <cmath>
+
+#include <lemon/smart_graph.h>
+#include <lemon/list_graph.h>
+#include <lemon/lgf_reader.h>
+#include <lemon/path.h>
+#include <lemon/random.h>
+#include <lemon/concepts/digraph.h>
+#include <lemon/concept_check.h>
+
+#include <lemon/howard_mmc.h>
+#include <lemon/howard_mrc.h>
+#include <lemon/lawler_mrc.h>
+
+#include "test_tools.h"
+
+using namespace lemon;
+
+char test_lgf[] =
+  "@nodes\n"
+  "label\n"
+  "1\n"
+  "2\n"
+  "3\n"
+  "4\n"
+  "5\n"
+  "@arcs\n"
+  "    cost time  c1 c2\n"
+  "1 2    3    1   0  0\n"
+  "2 1    3    1   0  0\n"
+  "2 3    4    2   1  0\n"
+  "3 2    4    2   1  0\n"
+  "3 4    1    0   0  1\n"
+  "4 3    2    1   0  1\n"
+  "4 4    7    3   0  0\n"
+  "4 5   -9    0   0  0\n";
+
+
+// Check the interface of an MRC algorithm
+template <typename GR, typename Cost>
+struct MrcClassConcept
+{
+  template <typename MRC>
+  struct Constraints {
+    void constraints() {
+      const Constraints& me = *this;
+
+      typedef typename MRC
+        ::template SetPath<ListPath<GR> >
+        ::template SetLargeCost<Cost>
+        ::Create MrcAlg;
+      MrcAlg mrc(me.g, me.cost, me.time);
+      const MrcAlg& const_mrc = mrc;
+
+      typename MrcAlg::Tolerance tol = const_mrc.tolerance();
+      mrc.tolerance(tol);
+
+      b = mrc.cycle(p).run();
+      b = mrc.findCycleRatio();
+      b = mrc.findCycle();
+
+      v = const_mrc.cycleCost();
+      t = const_mrc.cycleTime();
+      d = const_mrc.cycleRatio();
+      i = const_mrc.iterationNum();
+      p = const_mrc.cycle();
+    }
+
+    typedef concepts::ReadMap<typename GR::Arc, Cost> CM;
+
+    GR g;
+    CM cost, time;
+    ListPath<GR> p;
+    Cost v, t;
+    int i;
+    double d;
+    bool b;
+  };
+};
+
+// Perform a test with the given parameters
+template <typename MRC>
+void checkMrcAlg(const SmartDigraph& gr,
+                 const SmartDigraph::ArcMap<int>& cost,
+                 const SmartDigraph::ArcMap<int>& time,
+                 const SmartDigraph::ArcMap<int>& cm,
+                 int cycle_cost, int cycle_time) {
+  MRC alg(gr, cost, time);
+  check(alg.findCycleRatio() == MRC::OPTIMAL, "Wrong result");
+  check(alg.cycleRatio() ==
+        static_cast<double>(cycle_cost) / cycle_time, "Wrong cycle ratio");
+  alg.findCycle();
+  check(alg.cycleCost() == cycle_cost && alg.cycleTime() == cycle_time,
+        "Wrong path");
+  SmartDigraph::ArcMap<int> cycle(gr, 0);
+  for (typename MRC::Path::ArcIt a(alg.cycle()); a != INVALID; ++a) {
+    ++cycle[a];
+  }
+  for (SmartDigraph::ArcIt a(gr); a != INVALID; ++a) {
+    check(cm[a] == cycle[a], "Wrong path");
+  }
+}
+
+// Check that the found cycle is a directed cycle with the given cost
+// and transit time
+template <typename GR, typename MRC, typename CM, typename TM>
+void checkCycle(const GR& gr, const MRC& alg, const CM& cost,
+                const TM& time) {
+  typename CM::Value c = 0;
+  typename TM::Value t = 0;
+  typename GR::Node prev = INVALID;
+  for (typename MRC::Path::ArcIt a(alg.cycle()); a != INVALID; ++a) {
+    check(prev == INVALID || gr.source(a) == prev, "Wrong cycle");
+    prev = gr.target(a);
+    c += cost[a];
+    t += time[a];
+  }
+  check(prev == gr.source(alg.cycle().front()), "Wrong cycle");
+  check(c == alg.cycleCost() && t == alg.cycleTime(), "Wrong cycle");
+}
+
+// Compare the algorithms on random digraphs. The forward arcs (with
+// respect to the node order) have zero or positive transit times, the
+// backward arcs have positive transit times, so every cycle has
+// positive total transit time.
+void checkRandom(int n, int m, bool unit) {
+  typedef ListDigraph GR;
+  DIGRAPH_TYPEDEFS(GR);
+
+  GR gr;
+  for (int i = 0; i < n; ++i) {
+    gr.addNode();
+  }
+  IntArcMap cost(gr), time(gr);
+  DoubleArcMap real_cost(gr);
+  for (int k = 0; k < m; ++k) {
+    int i = rnd[n], j = rnd[n];
+    Arc a = gr.addArc(gr.nodeFromId(i), gr.nodeFromId(j));
+    cost[a] = rnd[200] - 50;
+    time[a] = unit ? 1 : (i < j ? rnd[3] : 1 + rnd[5]);
+    real_cost[a] = cost[a] + rnd();
+  }
+
+  HowardMrc<GR> howard(gr, cost, time);
+  LawlerMrc<GR> lawler(gr, cost, time);
+  bool found = howard.run();
+  check(lawler.run() == found, "Wrong result");
+  if (!found) return;
+  checkCycle(gr, howard, cost, time);
+  checkCycle(gr, lawler, cost, time);
+  check(static_cast<long long>(howard.cycleCost()) * lawler.cycleTime() ==
+        static_cast<long long>(lawler.cycleCost()) * howard.cycleTime(),
+        "Wrong cycle ratio");
+
+  if (unit) {
+    HowardMmc<GR> mmc(gr, cost);
+    check(mmc.run(), "Wrong result");
+    check(static_cast<long long>(mmc.cycleCost()) * howard.cycleTime() ==
+          static_cast<long long>(howard.cycleCost()) * mmc.cycleSize(),
+          "Wrong cycle ratio");
+  }
+
+  HowardMrc<GR, DoubleArcMap> real_howard(gr, real_cost, time);
+  LawlerMrc<GR, DoubleArcMap> real_lawler(gr, real_cost, time);
+  check(real_howard.run() && real_lawler.run(), "Wrong result");
+  check(std::fabs(real_howard.cycleRatio() - real_lawler.cycleRatio())
+        < 1e-6, "Wrong cycle ratio");
+}
+
+int main() {
+  // Check the interface
+  {
+    typedef concepts::Digraph GR;
+
+    // HowardMrc
+    checkConcept< MrcClassConcept<GR, int>,
+                  HowardMrc<GR, concepts::ReadMap<GR::Arc, int>,
+                            concepts::ReadMap<GR::Arc, int> > >();
+    checkConcept< MrcClassConcept<GR, float>,
+                  HowardMrc<GR, concepts::ReadMap<GR::Arc, float>,
+                            concepts::ReadMap<GR::Arc, float> > >();
+
+    // LawlerMrc
+    checkConcept< MrcClassConcept<GR, int>,
+                  LawlerMrc<GR, concepts::ReadMap<GR::Arc, int>,
+                            concepts::ReadMap<GR::Arc, int> > >();
+    checkConcept< MrcClassConcept<GR, float>,
+                  LawlerMrc<GR, concepts::ReadMap<GR::Arc, float>,
+                            concepts::ReadMap<GR::Arc, float> > >();
+  }
+
+  // Run various tests
+  {
+    typedef SmartDigraph GR;
+    DIGRAPH_TYPEDEFS(GR);
+
+    GR gr;
+    IntArcMap cost(gr), time(gr);
+    IntArcMap c1(gr), c2(gr);
+
+    std::istringstream input(test_lgf);
+    digraphReader(gr, input).
+      arcMap("cost", cost).
+      arcMap("time", time).
+      arcMap("c1", c1).
+      arcMap("c2", c2).
+      run();
+    IntArcMap unit(gr, 1);
+
+    // Howard
+    checkMrcAlg<HowardMrc<GR> >(gr, cost, time, c1, 8, 4);
+    checkMrcAlg<HowardMrc<GR> >(gr, cost, unit, c2, 3, 2);
+
+    // Lawler
+    checkMrcAlg<LawlerMrc<GR> >(gr, cost, time, c1, 8, 4);
+    checkMrcAlg<LawlerMrc<GR> >(gr, cost, unit, c2, 3, 2);
+
+    // Iteration limit
+    LawlerMrc<GR> lawler(gr, cost, time);
+    check(lawler.findCycleRatio(1) == LawlerMrc<GR>::ITERATION_LIMIT,
+          "Wrong termination cause");
+    check(lawler.iterationNum() == 1, "Wrong number of iterations");
+    check(lawler.findCycleRatio() == LawlerMrc<GR>::OPTIMAL,
+          "Wrong termination cause");
+
+    // Acyclic digraph
+    GR dag;
+    Node u = dag.addNode(), v = dag.addNode();
+    dag.addArc(u, v);
+    IntArcMap dc(dag, 1), dt(dag, 1);
+    check(!HowardMrc<GR>(dag, dc, dt).run(), "Wrong result");
+    check(!LawlerMrc<GR>(dag, dc, dt).run(), "Wrong result");
+  }
+
+  // Compare the algorithms on random digraphs
+  for (int i = 0; i < 10; ++i) {
+    checkRandom(30, 80, false);
+    checkRandom(30, 80, true);
+    checkRandom(200, 600, false);
+  }
+
+  return 0;
+}
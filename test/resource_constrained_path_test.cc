@@ -0,0 +1,268 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#include <lemon/list_graph.h>
+#include <lemon/lgf_reader.h>
+#include <lemon/path.h>
+#include <lemon/random.h>
+#include <lemon/resource_constrained_path.h>
+#include <lemon/concepts/digraph.h>
+#include <lemon/concepts/maps.h>
+
+#include "test_tools.h"
+
+using namespace lemon;
+
+char test_lgf[] =
+  "@nodes\n"
+  "label\n"
+  "1\n"
+  "2\n"
+  "3\n"
+  "4\n"
+  "5\n"
+  "@arcs\n"
+  "      time  toll\n"
+  "1 2   1     5\n"
+  "1 3   3     1\n"
+  "2 3   1     1\n"
+  "2 4   4     1\n"
+  "3 4   1     4\n"
+  "3 5   6     0\n"
+  "4 5   1     1\n"
+  "@attributes\n"
+  "source 1\n"
+  "target 5\n";
+
+void checkResourceConstrainedPathCompile()
+{
+  typedef int VType;
+  typedef concepts::Digraph Digraph;
+
+  typedef Digraph::Node Node;
+  typedef Digraph::Arc Arc;
+  typedef concepts::ReadMap<Arc, VType> CostMap;
+  typedef concepts::ReadMap<Arc, double> ResourceMap;
+
+  typedef ResourceConstrainedPath<Digraph, CostMap, ResourceMap> RcpType;
+
+  Digraph g;
+  Node n;
+  CostMap cost;
+  ResourceMap res;
+
+  RcpType rcp(g, cost, res);
+  const RcpType& const_rcp = rcp;
+
+  int k;
+  bool b;
+  VType c;
+  double r;
+  rcp.resourceLimit(1.5).noResourceLimit();
+  rcp.run(n);
+  rcp.run(n, n);
+  k = const_rcp.pathNum(n);
+  c = const_rcp.cost(n, k);
+  r = const_rcp.resource(n, k);
+  b = const_rcp.reached(n);
+  k = const_rcp.labelNum();
+  RcpType::Path p = const_rcp.path(n, k);
+
+  ::lemon::ignore_unused_variable_warning(b, c, r);
+  ::lemon::ignore_unused_variable_warning(p);
+}
+
+typedef std::pair<int, int> Label;
+
+// Enumerate the (cost, resource) values of all simple paths from u
+template <typename CM, typename RM>
+void allPaths(const ListDigraph& gr, const CM& cost, const RM& res,
+              ListDigraph::Node u, Label label,
+              ListDigraph::NodeMap<bool>& visited,
+              ListDigraph::NodeMap<std::vector<Label> >& labels)
+{
+  labels[u].push_back(label);
+  visited[u] = true;
+  for (ListDigraph::OutArcIt a(gr, u); a != INVALID; ++a) {
+    ListDigraph::Node v = gr.target(a);
+    if (!visited[v]) {
+      allPaths(gr, cost, res, v,
+               Label(label.first + int(cost[a]),
+                     label.second + int(res[a])),
+               visited, labels);
+    }
+  }
+  visited[u] = false;
+}
+
+// The Pareto-optimal labels ordered by increasing cost
+std::vector<Label> paretoFront(std::vector<Label> labels, int limit)
+{
+  std::sort(labels.begin(), labels.end());
+  std::vector<Label> front;
+  for (int i = 0; i < int(labels.size()); ++i) {
+    if (labels[i].second > limit) continue;
+    if (front.empty() || labels[i].second < front.back().second) {
+      front.push_back(labels[i]);
+    }
+  }
+  return front;
+}
+
+// Check the Pareto-optimal paths found to a node
+template <typename RCP, typename CM, typename RM>
+void checkFront(const RCP& rcp, const ListDigraph& gr,
+                const CM& cost, const RM& res,
+                ListDigraph::Node s, ListDigraph::Node v,
+                const std::vector<Label>& front)
+{
+  check(rcp.pathNum(v) == int(front.size()), "Wrong number of paths");
+  check(rcp.reached(v) == !front.empty(), "Wrong reached()");
+  for (int i = 0; i < rcp.pathNum(v); ++i) {
+    check(int(rcp.cost(v, i)) == front[i].first, "Wrong cost");
+    check(int(rcp.resource(v, i)) == front[i].second, "Wrong resource");
+    typename RCP::Path p = rcp.path(v, i);
+    check(p.empty() ? v == s : checkPath(gr, p) &&
+          pathSource(gr, p) == s && pathTarget(gr, p) == v, "Wrong path");
+    int c = 0, r = 0;
+    for (typename RCP::Path::ArcIt a(p); a != INVALID; ++a) {
+      c += int(cost[a]);
+      r += int(res[a]);
+    }
+    check(c == front[i].first && r == front[i].second,
+          "Wrong path");
+  }
+}
+
+template <typename CM, typename RM>
+void checkRandom(const ListDigraph& gr, const CM& cost, const RM& res)
+{
+  typedef ListDigraph::Node Node;
+  const int INF = std::numeric_limits<int>::max();
+
+  ListDigraph::NodeMap<bool> visited(gr, false);
+  ListDigraph::NodeMap<std::vector<Label> > labels(gr);
+  Node s = gr.nodeFromId(0);
+  Node t = gr.nodeFromId(countNodes(gr) - 1);
+  allPaths(gr, cost, res, s, Label(0, 0), visited, labels);
+
+  // All Pareto-optimal paths from the source node
+  ResourceConstrainedPath<ListDigraph, CM, RM> rcp(gr, cost, res);
+  rcp.run(s);
+  for (ListDigraph::NodeIt v(gr); v != INVALID; ++v) {
+    checkFront(rcp, gr, cost, res, s, v, paretoFront(labels[v], INF));
+  }
+
+  // The Pareto-optimal paths to the target node
+  rcp.run(s, t);
+  checkFront(rcp, gr, cost, res, s, t, paretoFront(labels[t], INF));
+
+  // Resource constrained paths
+  std::vector<Label> front = paretoFront(labels[t], INF);
+  for (int i = 0; i < int(front.size()); ++i) {
+    int limit = front[i].second;
+    rcp.resourceLimit(limit);
+    rcp.run(s, t);
+    checkFront(rcp, gr, cost, res, s, t, paretoFront(labels[t], limit));
+    check(rcp.cost(t, 0) == front[i].first, "Wrong constrained path");
+    rcp.resourceLimit(limit - 1);
+    rcp.run(s);
+    checkFront(rcp, gr, cost, res, s, t,
+               paretoFront(labels[t], limit - 1));
+    rcp.noResourceLimit();
+  }
+}
+
+int main()
+{
+  DIGRAPH_TYPEDEFS(ListDigraph);
+
+  // Read the test digraph
+  {
+    ListDigraph gr;
+    ListDigraph::ArcMap<int> time(gr), toll(gr);
+    Node s, t;
+
+    std::istringstream input(test_lgf);
+    digraphReader(gr, input).
+      arcMap("time", time).
+      arcMap("toll", toll).
+      node("source", s).
+      node("target", t).
+      run();
+
+    // The Pareto-optimal paths from 1 to 5: 1-2-3-4-5 (4, 11),
+    // 1-3-4-5 (5, 6), 1-2-4-5 (6, 7) is dominated, 1-3-5 (9, 1)
+    ResourceConstrainedPath<ListDigraph> rcp(gr, time, toll);
+    rcp.run(s, t);
+    check(rcp.pathNum(t) == 3, "Wrong number of paths");
+    check(rcp.cost(t, 0) == 4 && rcp.resource(t, 0) == 11, "Wrong path");
+    check(rcp.cost(t, 1) == 5 && rcp.resource(t, 1) == 6, "Wrong path");
+    check(rcp.cost(t, 2) == 9 && rcp.resource(t, 2) == 1, "Wrong path");
+    check(rcp.path(t, 1).length() == 3, "Wrong path");
+
+    rcp.resourceLimit(8).run(s, t);
+    check(rcp.pathNum(t) == 2 && rcp.cost(t, 0) == 5, "Wrong path");
+    rcp.resourceLimit(0).run(s, t);
+    check(!rcp.reached(t), "Wrong reached()");
+    rcp.run(s);
+    check(!rcp.reached(t), "Wrong reached()");
+    check(rcp.reached(s) && rcp.pathNum(s) == 1 &&
+          rcp.cost(s, 0) == 0 && rcp.path(s, 0).empty(), "Wrong path");
+
+    rcp.noResourceLimit().run(s, s);
+    check(rcp.pathNum(s) == 1 && rcp.path(s, 0).empty(), "Wrong path");
+    rcp.run(t);
+    check(!rcp.reached(s) && rcp.reached(t), "Wrong reached()");
+  }
+
+  // Compare with the enumeration of all simple paths
+  for (int test = 0; test < 20; ++test) {
+    ListDigraph gr;
+    ListDigraph::ArcMap<int> cost(gr), res(gr);
+    ListDigraph::ArcMap<double> dcost(gr);
+    ListDigraph::ArcMap<long long> lcost(gr);
+    std::vector<Node> nodes;
+    for (int i = 0; i < 10; ++i) {
+      nodes.push_back(gr.addNode());
+    }
+    for (int i = 0; i < 30; ++i) {
+      Node u = nodes[rnd[10]], v = nodes[rnd[10]];
+      if (u == v) continue;
+      Arc a = gr.addArc(u, v);
+      cost[a] = rnd[test < 10 ? 3 : 20];
+      res[a] = rnd[test < 10 ? 3 : 20];
+      dcost[a] = cost[a];
+      lcost[a] = cost[a] * 100000;
+    }
+
+    // Bucket queue
+    checkRandom(gr, cost, res);
+    // Binary heap
+    checkRandom(gr, dcost, res);
+    checkRandom(gr, lcost, res);
+  }
+
+  return 0;
+}
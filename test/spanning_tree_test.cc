@@ -0,0 +1,174 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include <lemon/smart_graph.h>
+#include <lemon/list_graph.h>
+#include <lemon/static_graph.h>
+#include <lemon/kruskal.h>
+#include <lemon/boruvka.h>
+#include <lemon/prim.h>
+#include <lemon/fib_heap.h>
+#include <lemon/random.h>
+#include <lemon/unionfind.h>
+
+#include <lemon/concepts/maps.h>
+#include <lemon/concepts/digraph.h>
+#include <lemon/concepts/graph.h>
+
+#include "test_tools.h"
+
+using namespace lemon;
+
+void checkSpanningTreeCompile()
+{
+  concepts::WriteMap<concepts::Digraph::Arc,bool> w;
+  concepts::WriteMap<concepts::Graph::Edge,bool> uw;
+  concepts::ReadMap<concepts::Digraph::Arc,int> r;
+  concepts::ReadMap<concepts::Graph::Edge,int> ur;
+
+  concepts::Digraph g;
+  concepts::Graph ug;
+
+  boruvka(g, r, w);
+  boruvka(ug, ur, uw, 4);
+  prim(ug, ur, uw);
+
+  typedef concepts::Graph::Node Node;
+  typedef concepts::Graph::Edge Edge;
+  Prim<concepts::Graph, concepts::ReadMap<Edge,int> > prim_test(ug, ur);
+  const Prim<concepts::Graph, concepts::ReadMap<Edge,int> >&
+    const_prim_test = prim_test;
+  Node n;
+  Edge e;
+  bool b;
+  int v;
+  ::lemon::ignore_unused_variable_warning(b,v);
+
+  prim_test.run();
+  prim_test.run(n);
+  prim_test.init();
+  prim_test.addSource(n);
+  n = prim_test.processNextNode();
+  prim_test.start();
+  b = const_prim_test.emptyQueue();
+  v = const_prim_test.treeValue();
+  e = const_prim_test.predEdge(n);
+  b = const_prim_test.tree(e);
+  b = const_prim_test.reached(n);
+  b = const_prim_test.processed(n);
+  const_prim_test.treeMap(uw);
+}
+
+// Checks that the given map is a spanning forest with the given cost
+template <typename Graph, typename CostMap, typename TreeMap>
+void checkTree(const Graph& g, const CostMap& cost, const TreeMap& tree,
+               int value, int tree_size, const char* msg) {
+  typename Graph::template NodeMap<int> index(g);
+  UnionFind<typename Graph::template NodeMap<int> > uf(index);
+  for (typename Graph::NodeIt n(g); n != INVALID; ++n) uf.insert(n);
+  int num = 0, sum = 0;
+  for (typename Graph::EdgeIt e(g); e != INVALID; ++e) {
+    if (tree[e]) {
+      ++num;
+      sum += cost[e];
+      check(uf.join(g.u(e), g.v(e)), msg << ": the tree has a cycle.");
+    }
+  }
+  check(num == tree_size, msg << ": wrong tree size.");
+  check(sum == value, msg << ": wrong tree cost.");
+}
+
+void checkRandom(int node_num, int edge_num, int max_cost) {
+  SmartGraph g;
+  SmartGraph::EdgeMap<int> cost(g);
+  for (int i = 0; i < node_num; ++i) g.addNode();
+  for (int i = 0; i < edge_num; ++i) {
+    SmartGraph::Edge e = g.addEdge(g.nodeFromId(rnd[node_num]),
+                                   g.nodeFromId(rnd[node_num]));
+    cost[e] = rnd[max_cost] - max_cost / 4;
+  }
+
+  SmartGraph::EdgeMap<bool> tree(g);
+  int value = kruskal(g, cost, tree);
+  int size = 0;
+  for (SmartGraph::EdgeIt e(g); e != INVALID; ++e) {
+    if (tree[e]) ++size;
+  }
+
+  const int threads[] = { 1, 2, 4 };
+  for (int t = 0; t < 3; ++t) {
+    check(boruvka(g, cost, tree, threads[t]) == value,
+          "Wrong Boruvka tree cost.");
+    checkTree(g, cost, tree, value, size, "Boruvka");
+  }
+
+  check(prim(g, cost, tree) == value, "Wrong Prim tree cost.");
+  checkTree(g, cost, tree, value, size, "Prim");
+
+  Prim<SmartGraph, SmartGraph::EdgeMap<int>,
+       FibHeap<int, SmartGraph::NodeMap<int> > > fib_prim(g, cost);
+  fib_prim.run();
+  check(fib_prim.treeValue() == value, "Wrong Prim tree cost.");
+  fib_prim.treeMap(tree);
+  checkTree(g, cost, tree, value, size, "Prim with FibHeap");
+
+  // Directed version
+  SmartDigraph dg;
+  SmartDigraph::ArcMap<int> dcost(dg);
+  SmartDigraph::ArcMap<bool> dtree(dg);
+  for (int i = 0; i < node_num; ++i) dg.addNode();
+  for (SmartGraph::EdgeIt e(g); e != INVALID; ++e) {
+    SmartDigraph::Arc a = dg.addArc(dg.nodeFromId(g.id(g.v(e))),
+                                    dg.nodeFromId(g.id(g.u(e))));
+    dcost[a] = cost[e];
+  }
+  check(boruvka(dg, dcost, dtree, 3) == value, "Wrong Boruvka tree cost.");
+}
+
+int main() {
+  ListGraph g;
+  ListGraph::Node n1 = g.addNode(), n2 = g.addNode(),
+    n3 = g.addNode(), n4 = g.addNode();
+  g.addNode();
+  ListGraph::Edge e1 = g.addEdge(n1, n2), e2 = g.addEdge(n2, n3),
+    e3 = g.addEdge(n3, n1), e4 = g.addEdge(n3, n4), e5 = g.addEdge(n4, n4);
+  ListGraph::EdgeMap<int> cost(g);
+  cost[e1] = 3; cost[e2] = 1; cost[e3] = 2; cost[e4] = 5; cost[e5] = -1;
+  ListGraph::EdgeMap<bool> tree(g);
+
+  check(boruvka(g, cost, tree) == 8, "Wrong Boruvka tree cost.");
+  check(!tree[e1] && tree[e2] && tree[e3] && tree[e4] && !tree[e5],
+        "Wrong Boruvka tree.");
+  check(prim(g, cost, tree) == 8, "Wrong Prim tree cost.");
+  check(!tree[e1] && tree[e2] && tree[e3] && tree[e4] && !tree[e5],
+        "Wrong Prim tree.");
+
+  StaticGraph sg;
+  StaticGraph::EdgeMap<int> scost(sg);
+  StaticGraph::EdgeMap<bool> stree(sg);
+  graphCopy(g, sg).edgeMap(cost, scost).run();
+  check(boruvka(sg, scost, stree, 2) == 8, "Wrong Boruvka tree cost.");
+
+  checkRandom(1, 0, 10);
+  checkRandom(50, 30, 10);
+  checkRandom(200, 1000, 3);
+  checkRandom(1000, 20000, 1000);
+  checkRandom(5000, 30000, 1000000);
+
+  return 0;
+}
@@ -21,6 +21,7 @@
 #include <lemon/list_graph.h>
 #include <lemon/lgf_reader.h>
 #include <lemon/path.h>
+#include <lemon/random.h>
 #include <lemon/suurballe.h>
 #include <lemon/concepts/digraph.h>
 #include <lemon/concepts/heap.h>
@@ -133,6 +134,40 @@ void checkSuurballeCompile()
   ::lemon::ignore_unused_variable_warning(pm);
 }
 
+void checkSuurballeBatchCompile()
+{
+  typedef int VType;
+  typedef concepts::Digraph Digraph;
+
+  typedef Digraph::Node Node;
+  typedef Digraph::Arc Arc;
+  typedef concepts::ReadMap<Arc, VType> LengthMap;
+
+  typedef SuurballeBatch<Digraph, LengthMap> BatchType;
+
+  Digraph g;
+  Node n;
+  LengthMap len;
+
+  BatchType batch(g, len);
+  const BatchType& const_batch = batch;
+
+  int q, k;
+  batch.threads(2);
+  q = batch.addQuery(n, n);
+  q = batch.addQuery(n, n, 3);
+  batch.run();
+
+  VType c;
+  k = const_batch.queryNum();
+  k = const_batch.pathNum(q);
+  c = const_batch.totalLength(q);
+  BatchType::Path p = const_batch.path(q, k);
+  batch.clearQueries();
+
+  ::lemon::ignore_unused_variable_warning(c);
+}
+
 // Check the feasibility of the flow
 template <typename Digraph, typename FlowMap>
 bool checkFlow( const Digraph& gr, const FlowMap& flow,
@@ -263,5 +298,97 @@ int main()
     check(suurballe.totalLength() == 1040, "The flow is not optimal");
   }
 
+  // Check SuurballeBatch
+  {
+    SuurballeBatch<ListDigraph> batch(digraph, length);
+    batch.threads(2);
+    check(batch.addQuery(s, t) == 0, "Wrong query index");
+    batch.addQuery(s, t, 3);
+    batch.addQuery(s, t, 5);
+    batch.addQuery(t, s);
+    batch.run();
+    check(batch.queryNum() == 4, "Wrong number of queries");
+    check(batch.pathNum(0) == 2 && batch.totalLength(0) == 510,
+          "The flow is not optimal");
+    check(batch.pathNum(1) == 3 && batch.totalLength(1) == 1040,
+          "The flow is not optimal");
+    check(batch.pathNum(2) == 3 && batch.totalLength(2) == 1040,
+          "The flow is not optimal");
+    for (int q = 0; q < 3; ++q) {
+      for (int i = 0; i < batch.pathNum(q); ++i)
+        check(checkPath(digraph, batch.path(q, i), s, t), "Wrong path");
+    }
+    Suurballe<ListDigraph> suurballe(digraph, length);
+    check(batch.pathNum(3) == suurballe.run(t, s), "Wrong number of paths");
+  }
+
+  // Modify the digraph between two executions
+  {
+    ListDigraph gr;
+    ListDigraph::ArcMap<int> len(gr);
+    Node u = gr.addNode(), v = gr.addNode();
+    len[gr.addArc(u, v)] = 5;
+    Suurballe<ListDigraph> suurballe(gr, len);
+    check(suurballe.run(u, v, 2) == 1 && suurballe.totalLength() == 5,
+          "Wrong result");
+    for (int i = 0; i < 20; ++i) {
+      Node m = gr.addNode();
+      len[gr.addArc(u, m)] = 0;
+      len[gr.addArc(m, v)] = 0;
+    }
+    check(suurballe.run(u, v, 3) == 3 && suurballe.totalLength() == 0,
+          "Wrong result");
+    for (int i = 0; i < 3; ++i)
+      check(checkPath(gr, suurballe.path(i), u, v), "Wrong path");
+  }
+
+  // Compare SuurballeBatch with Suurballe on a random digraph
+  {
+    ListDigraph gr;
+    ListDigraph::ArcMap<int> len(gr);
+    std::vector<Node> nodes;
+    for (int i = 0; i < 60; ++i) {
+      nodes.push_back(gr.addNode());
+    }
+    for (int i = 0; i < 300; ++i) {
+      Arc a = gr.addArc(nodes[rnd[60]], nodes[rnd[60]]);
+      len[a] = rnd[100];
+    }
+    std::vector<Node> src, trg;
+    std::vector<int> num;
+    for (int i = 0; i < 100; ++i) {
+      src.push_back(nodes[rnd[8]]);
+      trg.push_back(nodes[rnd[60]]);
+      num.push_back(2 + rnd[3]);
+    }
+    // Queries with the same source and target node
+    trg[0] = src[0];
+    trg[1] = src[1];
+
+    for (int threads = 1; threads <= 4; threads *= 2) {
+      SuurballeBatch<ListDigraph> batch(gr, len);
+      batch.threads(threads);
+      for (int i = 0; i < 100; ++i) {
+        batch.addQuery(src[i], trg[i], num[i]);
+      }
+      batch.run();
+
+      Suurballe<ListDigraph> suurballe(gr, len);
+      for (int i = 0; i < 100; ++i) {
+        int k = suurballe.run(src[i], trg[i], num[i]);
+        check(batch.pathNum(i) == k, "Wrong number of paths");
+        check(batch.totalLength(i) == suurballe.totalLength(),
+              "The flow is not optimal");
+        ListDigraph::ArcMap<int> used(gr, 0);
+        for (int j = 0; j < k; ++j) {
+          SuurballeBatch<ListDigraph>::Path p = batch.path(i, j);
+          check(checkPath(gr, p, src[i], trg[i]), "Wrong path");
+          for (int l = 0; l < p.length(); ++l)
+            check(++used[p.nth(l)] == 1, "The paths are not disjoint");
+        }
+      }
+    }
+  }
+
   return 0;
 }
@@ -0,0 +1,279 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <lemon/list_graph.h>
+#include <lemon/path.h>
+#include <lemon/random.h>
+#include <lemon/dijkstra.h>
+#include <lemon/time_dependent_dijkstra.h>
+#include <lemon/concepts/digraph.h>
+#include <lemon/concepts/maps.h>
+#include <lemon/concepts/heap.h>
+
+#include "test_tools.h"
+
+using namespace lemon;
+
+typedef PiecewiseLinearFunction<double> Function;
+typedef PiecewiseLinearArena<double> Arena;
+
+void checkTimeDependentDijkstraCompile()
+{
+  typedef concepts::Digraph Digraph;
+  typedef Digraph::Node Node;
+  typedef Digraph::Arc Arc;
+  typedef concepts::ReadMap<Arc, Function> TravelTimeMap;
+  typedef TimeDependentDijkstra<Digraph, TravelTimeMap> DType;
+
+  Digraph G;
+  Node s, t, n;
+  Arc e;
+  double d;
+  bool b;
+  TravelTimeMap tt;
+  DType::ArrivalMap am(G);
+  DType::PredMap pm(G);
+  ::lemon::ignore_unused_variable_warning(d, b, e, n);
+
+  {
+    DType dijkstra_test(G, tt);
+    const DType& const_dijkstra_test = dijkstra_test;
+
+    dijkstra_test.run(s, 1.0);
+    b = dijkstra_test.run(s, t, 1.0);
+
+    dijkstra_test.init();
+    dijkstra_test.addSource(s, 2.0);
+    n = dijkstra_test.processNextNode();
+    n = const_dijkstra_test.nextNode();
+    b = const_dijkstra_test.emptyQueue();
+    d = const_dijkstra_test.queueSize();
+    dijkstra_test.start();
+    dijkstra_test.start(t);
+
+    d = const_dijkstra_test.arrivalTime(t);
+    e = const_dijkstra_test.predArc(t);
+    s = const_dijkstra_test.predNode(t);
+    b = const_dijkstra_test.reached(t);
+    b = const_dijkstra_test.processed(t);
+    am = const_dijkstra_test.arrivalMap();
+    pm = const_dijkstra_test.predMap();
+    Path<Digraph> p = const_dijkstra_test.path(t);
+    ::lemon::ignore_unused_variable_warning(p);
+  }
+  {
+    DType
+      ::SetPredMap<concepts::ReadWriteMap<Node,Arc> >
+      ::SetArrivalMap<concepts::ReadWriteMap<Node,double> >
+      ::SetHeap<concepts::Heap<double, concepts::ReadWriteMap<Node,int> >,
+                concepts::ReadWriteMap<Node,int> >
+      ::Create dijkstra_test(G, tt);
+
+    concepts::ReadWriteMap<Node,Arc> pred_map;
+    concepts::ReadWriteMap<Node,double> arr_map;
+    concepts::ReadWriteMap<Node,int> cref;
+    concepts::Heap<double, concepts::ReadWriteMap<Node,int> > heap(cref);
+
+    dijkstra_test
+      .travelTimeMap(tt)
+      .predMap(pred_map)
+      .arrivalMap(arr_map)
+      .heap(heap, cref);
+    dijkstra_test.run(s, 1.0);
+  }
+}
+
+void checkTimeDependentProfileCompile()
+{
+  typedef concepts::Digraph Digraph;
+  typedef Digraph::Node Node;
+  typedef Digraph::Arc Arc;
+  typedef concepts::ReadMap<Arc, Function> TravelTimeMap;
+  typedef TimeDependentProfile<Digraph, TravelTimeMap> PType;
+
+  Digraph G;
+  Node s, t;
+  TravelTimeMap tt;
+  double d;
+  bool b;
+
+  PType profile(G, tt);
+  const PType& const_profile = profile;
+  profile.tolerance(Tolerance<double>(1e-8));
+  profile.run(s, 0.0, 1.0);
+  b = profile.run(s, t, 0.0, 1.0);
+  b = const_profile.reached(t);
+  d = const_profile.travelTime(t)(0.5);
+  d = const_profile.arrivalTime(t, 0.5);
+  d = const_profile.tolerance().epsilon();
+  ::lemon::ignore_unused_variable_warning(d, b);
+}
+
+// A random travel time function with the FIFO property
+Function randomFunction(Arena& arena, int size)
+{
+  std::vector<double> xs, ys;
+  double x = rnd(10.0), y = 1 + rnd(10.0);
+  for (int i = 0; i < size; ++i) {
+    xs.push_back(x);
+    ys.push_back(y);
+    double dx = 1 + rnd(10.0);
+    x += dx;
+    y = std::max(1.0, y + rnd(-dx, 2 * dx));
+  }
+  return arena.add(xs.begin(), ys.begin(), size);
+}
+
+// Earliest arrival times using label correcting relaxation
+void bruteArrival(const ListDigraph& g,
+                  const ListDigraph::ArcMap<Function>& tt,
+                  ListDigraph::Node s, double time,
+                  ListDigraph::NodeMap<double>& arr)
+{
+  for (ListDigraph::NodeIt v(g); v != INVALID; ++v) arr[v] = 1e100;
+  arr[s] = time;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (ListDigraph::ArcIt a(g); a != INVALID; ++a) {
+      double t = arr[g.source(a)];
+      if (t == 1e100) continue;
+      double at = t + tt[a](t);
+      if (at < arr[g.target(a)] - 1e-9) {
+        arr[g.target(a)] = at;
+        changed = true;
+      }
+    }
+  }
+}
+
+int main()
+{
+  DIGRAPH_TYPEDEFS(ListDigraph);
+
+  // Piecewise linear functions
+  {
+    Arena arena;
+    double xs[] = { 0, 10, 20 };
+    double ys[] = { 5, 15, 5 };
+    Function f = arena.add(xs, ys, 3);
+    Function c = arena.addConstant(7);
+    Function z;
+    check(arena.size() == 4, "Wrong arena size");
+    check(f.size() == 3 && f.x(1) == 10 && f.y(1) == 15, "Wrong function");
+    check(f(-5) == 5 && f(0) == 5 && f(5) == 10 && f(10) == 15 &&
+          f(12) == 13 && f(20) == 5 && f(100) == 5, "Wrong value");
+    check(c(-10) == 7 && c(10) == 7, "Wrong value");
+    check(z(10) == 0, "Wrong value");
+  }
+
+  // Constant travel times
+  for (int test = 0; test < 5; ++test) {
+    ListDigraph g;
+    Arena arena;
+    ListDigraph::ArcMap<Function> tt(g);
+    ListDigraph::ArcMap<int> len(g);
+    std::vector<Node> nodes;
+    for (int i = 0; i < 30; ++i) nodes.push_back(g.addNode());
+    for (int i = 0; i < 100; ++i) {
+      Arc a = g.addArc(nodes[rnd[30]], nodes[rnd[30]]);
+      len[a] = rnd[100];
+      tt[a] = arena.addConstant(len[a]);
+    }
+    Dijkstra<ListDigraph> dijk(g, len);
+    TimeDependentDijkstra<ListDigraph, ListDigraph::ArcMap<Function> >
+      td(g, tt);
+    dijk.run(nodes[0]);
+    td.run(nodes[0], 100);
+    for (NodeIt v(g); v != INVALID; ++v) {
+      check(dijk.reached(v) == td.reached(v), "Wrong reached()");
+      if (!td.reached(v)) continue;
+      check(td.arrivalTime(v) == 100 + dijk.dist(v), "Wrong arrival time");
+    }
+    check(td.run(nodes[0], nodes[29], 100) == dijk.reached(nodes[29]),
+          "Wrong result");
+  }
+
+  // Time-dependent travel times
+  for (int test = 0; test < 10; ++test) {
+    ListDigraph g;
+    Arena arena;
+    ListDigraph::ArcMap<Function> tt(g);
+    std::vector<Node> nodes;
+    int n = test < 5 ? 8 : 40;
+    for (int i = 0; i < n; ++i) nodes.push_back(g.addNode());
+    for (int i = 0; i < 4 * n; ++i) {
+      Node u = nodes[rnd[n]], v = nodes[rnd[n]];
+      if (u != v) tt[g.addArc(u, v)] = randomFunction(arena, 1 + rnd[6]);
+    }
+    Node s = nodes[0], t = nodes[n - 1];
+
+    // Earliest arrival times
+    TimeDependentDijkstra<ListDigraph, ListDigraph::ArcMap<Function> >
+      td(g, tt);
+    ListDigraph::NodeMap<double> arr(g);
+    for (int k = 0; k < 5; ++k) {
+      double time = rnd(50.0);
+      td.run(s, time);
+      bruteArrival(g, tt, s, time, arr);
+      for (NodeIt v(g); v != INVALID; ++v) {
+        check(td.reached(v) == (arr[v] != 1e100), "Wrong reached()");
+        if (!td.reached(v)) continue;
+        check(std::fabs(td.arrivalTime(v) - arr[v]) < 1e-6,
+              "Wrong arrival time");
+        double at = time;
+        Path<ListDigraph> p = td.path(v);
+        for (Path<ListDigraph>::ArcIt a(p); a != INVALID; ++a) {
+          at += tt[a](at);
+        }
+        check(std::fabs(at - arr[v]) < 1e-6, "Wrong path");
+      }
+    }
+
+    // Profiles
+    TimeDependentProfile<ListDigraph, ListDigraph::ArcMap<Function> >
+      prof(g, tt);
+    prof.run(s, 0, 50);
+    for (int k = 0; k <= 20; ++k) {
+      double time = k == 20 ? rnd(50.0) : k * 2.5;
+      td.run(s, time);
+      for (NodeIt v(g); v != INVALID; ++v) {
+        check(prof.reached(v) == td.reached(v), "Wrong reached()");
+        if (!td.reached(v)) continue;
+        check(std::fabs(prof.arrivalTime(v, time) - td.arrivalTime(v))
+              < 1e-6, "Wrong profile");
+      }
+    }
+    check(prof.travelTime(s)(10) == 0 && prof.arrivalTime(s, 10) == 10,
+          "Wrong profile");
+
+    bool reached = prof.run(s, t, 10, 20);
+    for (int k = 0; k <= 10; ++k) {
+      double time = 10 + k;
+      check(td.run(s, t, time) == reached, "Wrong reached()");
+      if (!reached) continue;
+      check(std::fabs(prof.arrivalTime(t, time) - td.arrivalTime(t))
+            < 1e-6, "Wrong profile");
+    }
+  }
+
+  return 0;
+}
@@ -26,6 +26,52 @@ using namespace std;
 
 typedef UnionFindEnum<ListGraph::NodeMap<int> > UFE;
 
+// Joins the pairs (i, i + step) for the indices i of the given thread
+class JoinTask {
+public:
+  JoinTask(ConcurrentUnionFind& uf, int num, int step, int threads,
+           std::vector<int>& joined)
+    : _uf(uf), _num(num), _step(step), _threads(threads),
+      _joined(joined) {}
+  void operator()(int id) {
+    int cnt = 0;
+    for (int i = id; i + _step < _num; i += _threads) {
+      if (_uf.join(i, i + _step)) ++cnt;
+    }
+    _joined[id] = cnt;
+  }
+private:
+  ConcurrentUnionFind& _uf;
+  int _num, _step, _threads;
+  std::vector<int>& _joined;
+};
+
+void checkConcurrentUnionFind() {
+  ConcurrentUnionFind uf(10);
+  check(uf.size() == 10, "Wrong size of ConcurrentUnionFind");
+  check(uf.join(1, 2), "Something is wrong with ConcurrentUnionFind");
+  check(uf.join(4, 3), "Something is wrong with ConcurrentUnionFind");
+  check(uf.join(2, 4), "Something is wrong with ConcurrentUnionFind");
+  check(!uf.join(1, 3), "Something is wrong with ConcurrentUnionFind");
+  check(uf.sameSet(1, 4), "Something is wrong with ConcurrentUnionFind");
+  check(!uf.sameSet(1, 5), "Something is wrong with ConcurrentUnionFind");
+  check(uf.find(3) == uf.find(2),
+        "Something is wrong with ConcurrentUnionFind");
+
+  // Concurrent joins: the pairs (i, i + 3) form three classes
+  const int num = 30000, threads = 4;
+  uf.init(num);
+  std::vector<int> joined(threads);
+  JoinTask task(uf, num, 3, threads, joined);
+  bits::parallelRun(threads, task);
+  int total = 0;
+  for (int i = 0; i < threads; ++i) total += joined[i];
+  check(total == num - 3, "Wrong number of successful joins");
+  for (int i = 0; i < num; ++i) {
+    check(uf.find(i) == i % 3, "Wrong class in ConcurrentUnionFind");
+  }
+}
+
 int main() {
   ListGraph g;
   ListGraph::NodeMap<int> base(g);
@@ -98,5 +144,7 @@ int main() {
   U.eraseClass(U.find(n[4]));
   U.eraseClass(U.find(n[7]));
 
+  checkConcurrentUnionFind();
+
   return 0;
 }
@@ -0,0 +1,184 @@
+/* -*- mode: C++; indent-tabs-mode: nil; -*-
+ *
+ * This file is a part of LEMON, a generic C++ optimization library.
+ *
+ * Copyright (C) 2003-2013
+ * Egervary Jeno Kombinatorikus Optimalizalasi Kutatocsoport
+ * (Egervary Research Group on Combinatorial Optimization, EGRES).
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include <sstream>
+#include <vector>
+
+#include <lemon/smart_graph.h>
+#include <lemon/list_graph.h>
+#include <lemon/concepts/graph.h>
+#include <lemon/concepts/maps.h>
+#include <lemon/lgf_reader.h>
+#include <lemon/nagamochi_ibaraki.h>
+#include <lemon/viecut.h>
+#include <lemon/random.h>
+
+#include "test_tools.h"
+
+using namespace lemon;
+using namespace std;
+
+const std::string lgf =
+  "@nodes\n"
+  "label\n"
+  "0\n"
+  "1\n"
+  "2\n"
+  "3\n"
+  "4\n"
+  "5\n"
+  "@edges\n"
+  "     cap1 cap2 cap3\n"
+  "0 1  1    1    1   \n"
+  "0 2  2    2    4   \n"
+  "1 2  4    4    4   \n"
+  "3 4  1    1    1   \n"
+  "3 5  2    2    4   \n"
+  "4 5  4    4    4   \n"
+  "2 3  1    6    6   \n";
+
+void checkVieCutCompile()
+{
+  typedef int Value;
+  typedef concepts::Graph Graph;
+
+  typedef Graph::Node Node;
+  typedef Graph::Edge Edge;
+  typedef concepts::ReadMap<Edge, Value> CapMap;
+  typedef concepts::WriteMap<Node, bool> CutMap;
+
+  Graph g;
+  CapMap cap;
+  CutMap cut;
+  Value v;
+  int k;
+  ::lemon::ignore_unused_variable_warning(v,k);
+
+  VieCut<Graph, CapMap> vc_test(g, cap);
+  const VieCut<Graph, CapMap>& const_vc_test = vc_test;
+
+  vc_test.threads(2).inexact().inexact(false);
+  vc_test.run();
+
+  v = const_vc_test.minCutValue();
+  v = const_vc_test.minCutMap(cut);
+  k = const_vc_test.kernelNodeNum();
+  k = const_vc_test.kernelEdgeNum();
+}
+
+template <typename Graph, typename CapMap, typename CutMap>
+typename CapMap::Value
+  cutValue(const Graph& graph, const CapMap& cap, const CutMap& cut)
+{
+  typename CapMap::Value sum = 0;
+  for (typename Graph::EdgeIt e(graph); e != INVALID; ++e) {
+    if (cut[graph.u(e)] != cut[graph.v(e)]) {
+      sum += cap[e];
+    }
+  }
+  return sum;
+}
+
+template <typename Graph, typename CapMap>
+void checkVieCut(const Graph& graph, const CapMap& cap,
+                 typename CapMap::Value value)
+{
+  typename Graph::template NodeMap<bool> cut(graph);
+  for (int threads = 1; threads <= 4; threads *= 2) {
+    VieCut<Graph, CapMap> vc(graph, cap);
+    vc.threads(threads).run();
+    vc.minCutMap(cut);
+    check(vc.minCutValue() == value, "Wrong cut value");
+    check(vc.minCutValue() == cutValue(graph, cap, cut), "Wrong cut map");
+
+    int num = 0;
+    for (typename Graph::NodeIt n(graph); n != INVALID; ++n) {
+      if (cut[n]) ++num;
+    }
+    check(num > 0 && num < countNodes(graph), "Wrong cut map");
+    check(vc.kernelNodeNum() <= countNodes(graph), "Wrong kernel");
+
+    VieCut<Graph, CapMap> ivc(graph, cap);
+    ivc.threads(threads).inexact().run();
+    ivc.minCutMap(cut);
+    check(!(ivc.minCutValue() < value), "Wrong inexact cut value");
+    check(ivc.minCutValue() == cutValue(graph, cap, cut),
+          "Wrong inexact cut map");
+  }
+}
+
+// Random graph with dense clusters connected by a few edges
+template <typename Graph>
+void randomGraph(Graph& graph, typename Graph::template EdgeMap<int>& cap,
+                 int clusters, int size, int inner, int outer)
+{
+  std::vector<typename Graph::Node> nodes;
+  for (int i = 0; i < clusters * size; ++i) {
+    nodes.push_back(graph.addNode());
+  }
+  for (int c = 0; c < clusters; ++c) {
+    for (int i = 0; i < size; ++i) {
+      int a = c * size + i, b = c * size + (i + 1) % size;
+      cap[graph.addEdge(nodes[a], nodes[b])] = 1 + rnd[10];
+    }
+    for (int i = 0; i < inner * size; ++i) {
+      int a = c * size + rnd[size], b = c * size + rnd[size];
+      cap[graph.addEdge(nodes[a], nodes[b])] = 1 + rnd[10];
+    }
+  }
+  for (int i = 0; i < outer; ++i) {
+    int a = rnd[clusters * size], b = rnd[clusters * size];
+    cap[graph.addEdge(nodes[a], nodes[b])] = 1 + rnd[10];
+  }
+}
+
+int main() {
+  SmartGraph graph;
+  SmartGraph::EdgeMap<int> cap1(graph), cap2(graph), cap3(graph);
+
+  istringstream input(lgf);
+  graphReader(graph, input)
+    .edgeMap("cap1", cap1)
+    .edgeMap("cap2", cap2)
+    .edgeMap("cap3", cap3)
+    .run();
+
+  checkVieCut(graph, cap1, 1);
+  checkVieCut(graph, cap2, 3);
+  checkVieCut(graph, cap3, 5);
+
+  // Random graphs compared to NagamochiIbaraki
+  for (int k = 0; k < 6; ++k) {
+    ListGraph rgraph;
+    ListGraph::EdgeMap<int> rcap(rgraph);
+    randomGraph(rgraph, rcap, 2 + k, 50 + 100 * (k % 3), 3, 10 + k);
+    NagamochiIbaraki<ListGraph> ni(rgraph, rcap);
+    ni.run();
+    checkVieCut(rgraph, rcap, ni.minCutValue());
+  }
+
+  // Disconnected graph
+  {
+    SmartGraph rgraph;
+    SmartGraph::EdgeMap<int> rcap(rgraph);
+    randomGraph(rgraph, rcap, 3, 40, 2, 0);
+    checkVieCut(rgraph, rcap, 0);
+  }
+
+  return 0;
+}